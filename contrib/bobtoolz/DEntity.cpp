@@ -33,6 +33,9 @@
 #include "misc.h"
 #include "CPortals.h"
 
+#include "gtkr_vector.h"
+#include <algorithm>
+
 const char* brushEntityList[] = {
 	"worldspawn",
 	"trigger_always",
@@ -236,52 +239,221 @@ void DEntity::LoadSelectedPatches(){
 	g_FuncTable.m_pfnReleasePatchHandles();
 }
 
-bool* DEntity::BuildIntersectList(){
-	int max = GetIDMax();
-	if ( max == 0 ) {
-		return NULL;
+//////////////////////////////////////////////////////////////////////
+// Intersect / duplicate checks
+//////////////////////////////////////////////////////////////////////
+
+// the brushes are swept along x in order of their mins, only the ones whose bounds overlap
+// get the full test, the sweep is cut in chunks that run on a thread pool
+
+#define BRUSHCHECK_CHUNK    256     // brushes swept per work item
+
+struct brushCheck_t
+{
+	DBrush *brush;
+	int order;                  // position in brushList, the duplicate test is one sided
+	vec3_t mins, maxs;
+	vector<DPlane *> planes;    // by distance, a plane can only match the ones within MAX_ROUND_ERROR of it
+};
+
+struct brushCheckJob_t
+{
+	vector<brushCheck_t> *checks;
+	int start, end;
+	bool duplicates;
+	vector<int> hits;           // brush IDs
+	gint *done;
+};
+
+struct PlaneByDist
+{
+	bool operator()( const DPlane *a, const DPlane *b ) const { return a->_d < b->_d; }
+	bool operator()( const DPlane *a, vec_t d ) const { return a->_d < d; }
+};
+
+struct BrushCheckByMins
+{
+	bool operator()( const brushCheck_t &a, const brushCheck_t &b ) const { return a.mins[0] < b.mins[0]; }
+};
+
+/*
+   same as DBrush::operator==, every plane of a is also in b
+ */
+static bool BrushCheck_PlanesIn( const brushCheck_t &a, const brushCheck_t &b ){
+	for ( vector<DPlane *>::const_iterator chkPlane = a.planes.begin(); chkPlane != a.planes.end(); chkPlane++ )
+	{
+		vector<DPlane *>::const_iterator brushPlane = lower_bound( b.planes.begin(), b.planes.end(), ( *chkPlane )->_d - MAX_ROUND_ERROR, PlaneByDist() );
+		for (; brushPlane != b.planes.end() && ( *brushPlane )->_d <= ( *chkPlane )->_d + MAX_ROUND_ERROR; brushPlane++ )
+		{
+			if ( **brushPlane == **chkPlane ) {
+				break;
+			}
+		}
+		if ( brushPlane == b.planes.end() || ( *brushPlane )->_d > ( *chkPlane )->_d + MAX_ROUND_ERROR ) {
+			return FALSE;
+		}
 	}
 
-	bool* pbIntList = new bool[max];
-	memset( pbIntList, 0, sizeof( bool ) * ( max ) );
+	return TRUE;
+}
+
+static void BrushCheck_Run( brushCheckJob_t *job ){
+	vector<brushCheck_t> &checks = *job->checks;
+	int count = (int)checks.size();
 
-	for ( list<DBrush *>::const_iterator pB1 = brushList.begin(); pB1 != brushList.end(); pB1++ )
+	for ( int i = job->start; i < job->end; i++ )
 	{
-		list<DBrush *>::const_iterator pB2 = pB1;
-		for ( pB2++; pB2 != brushList.end(); pB2++ )
+		const brushCheck_t &b1 = checks[i];
+
+		for ( int j = i + 1; j < count && checks[j].mins[0] <= b1.maxs[0] + MAX_ROUND_ERROR; j++ )
 		{
-			if ( ( *pB1 )->IntersectsWith( ( *pB2 ) ) ) {
-				pbIntList[( *pB1 )->m_nBrushID] = TRUE;
-				pbIntList[( *pB2 )->m_nBrushID] = TRUE;
+			const brushCheck_t &b2 = checks[j];
+
+			if ( b2.mins[1] > b1.maxs[1] + MAX_ROUND_ERROR || b1.mins[1] > b2.maxs[1] + MAX_ROUND_ERROR ) {
+				continue;
+			}
+			if ( b2.mins[2] > b1.maxs[2] + MAX_ROUND_ERROR || b1.mins[2] > b2.maxs[2] + MAX_ROUND_ERROR ) {
+				continue;
+			}
+
+			bool hit;
+			if ( job->duplicates ) {
+				hit = b1.order < b2.order ? BrushCheck_PlanesIn( b1, b2 ) : BrushCheck_PlanesIn( b2, b1 );
+			}
+			else{
+				hit = b1.brush->IntersectsWith( b2.brush );
+			}
+
+			if ( hit ) {
+				job->hits.push_back( b1.brush->m_nBrushID );
+				job->hits.push_back( b2.brush->m_nBrushID );
 			}
 		}
 	}
 
-	return pbIntList;
+	g_atomic_int_inc( job->done );
 }
 
-bool* DEntity::BuildDuplicateList(){
-	int max = GetIDMax();
-	if ( max == 0 ) {
-		return NULL;
+static void BrushCheck_Thread( gpointer data, gpointer user_data ){
+	BrushCheck_Run( (brushCheckJob_t *)data );
+}
+
+static bool* BuildCheckList( list<DBrush *> &brushList, int max, bool duplicates, BrushCheckProgressFunc progress ){
+	vector<brushCheck_t> checks;
+	vector<brushCheckJob_t> jobs;
+	gint done = 0;
+	int order = 0;
+
+	// points and bounds are built here, the threads only read them
+	checks.reserve( brushList.size() );
+	for ( list<DBrush *>::const_iterator pB = brushList.begin(); pB != brushList.end(); pB++, order++ )
+	{
+		brushCheck_t chk;
+
+		chk.brush = *pB;
+		chk.order = order;
+
+		if ( !( *pB )->GetBounds( chk.mins, chk.maxs ) ) {
+			if ( !duplicates ) {
+				continue;   // invalid brush, it never intersects
+			}
+			// the plane test does not need points, so it is checked against everything
+			VectorSet( chk.mins, -HUGE_VAL, -HUGE_VAL, -HUGE_VAL );
+			VectorSet( chk.maxs, HUGE_VAL, HUGE_VAL, HUGE_VAL );
+		}
+
+		checks.push_back( chk );
+
+		if ( duplicates ) {
+			vector<DPlane *> &planes = checks.back().planes;
+			planes.assign( ( *pB )->faceList.begin(), ( *pB )->faceList.end() );
+			sort( planes.begin(), planes.end(), PlaneByDist() );
+		}
 	}
 
-	bool* pbDupList = new bool[max];
-	memset( pbDupList, 0, sizeof( bool ) * ( max ) );
+	stable_sort( checks.begin(), checks.end(), BrushCheckByMins() );
 
-	for ( list<DBrush *>::const_iterator pB1 = brushList.begin(); pB1 != brushList.end(); pB1++ )
+	for ( int start = 0; start < (int)checks.size(); start += BRUSHCHECK_CHUNK )
 	{
-		list<DBrush *>::const_iterator pB2 = pB1;
-		for ( pB2++; pB2 != brushList.end(); pB2++ )
+		brushCheckJob_t job;
+		job.checks = &checks;
+		job.start = start;
+		job.end = start + BRUSHCHECK_CHUNK;
+		if ( job.end > (int)checks.size() ) {
+			job.end = (int)checks.size();
+		}
+		job.duplicates = duplicates;
+		job.done = &done;
+		jobs.push_back( job );
+	}
+
+	int nThreads;
+#if GLIB_CHECK_VERSION( 2, 36, 0 )
+	nThreads = g_get_num_processors();
+#else
+	nThreads = 2;
+#endif
+	GThreadPool *pool = NULL;
+	if ( jobs.size() > 1 ) {
+		pool = g_thread_pool_new( BrushCheck_Thread, NULL, nThreads, TRUE, NULL );
+	}
+
+	if ( pool ) {
+		for ( size_t i = 0; i < jobs.size(); i++ )
+			g_thread_pool_push( pool, &jobs[i], NULL );
+
+		if ( progress ) {
+			while ( g_atomic_int_get( &done ) < (gint)jobs.size() )
+			{
+				progress( g_atomic_int_get( &done ), (int)jobs.size() );
+				g_usleep( 100000 );
+			}
+		}
+		g_thread_pool_free( pool, FALSE, TRUE );
+	}
+	else
+	{
+		for ( size_t i = 0; i < jobs.size(); i++ )
 		{
-			if ( **pB1 == *pB2 ) {
-				pbDupList[( *pB1 )->m_nBrushID] = TRUE;
-				pbDupList[( *pB2 )->m_nBrushID] = TRUE;
+			if ( progress ) {
+				progress( (int)i, (int)jobs.size() );
 			}
+			BrushCheck_Run( &jobs[i] );
 		}
 	}
 
-	return pbDupList;
+	if ( progress ) {
+		progress( (int)jobs.size(), (int)jobs.size() );
+	}
+
+	bool* pbList = new bool[max];
+	memset( pbList, 0, sizeof( bool ) * ( max ) );
+
+	for ( size_t i = 0; i < jobs.size(); i++ )
+	{
+		for ( size_t j = 0; j < jobs[i].hits.size(); j++ )
+			pbList[jobs[i].hits[j]] = TRUE;
+	}
+
+	return pbList;
+}
+
+bool* DEntity::BuildIntersectList( BrushCheckProgressFunc progress ){
+	int max = GetIDMax();
+	if ( max == 0 ) {
+		return NULL;
+	}
+
+	return BuildCheckList( brushList, max, FALSE, progress );
+}
+
+bool* DEntity::BuildDuplicateList( BrushCheckProgressFunc progress ){
+	int max = GetIDMax();
+	if ( max == 0 ) {
+		return NULL;
+	}
+
+	return BuildCheckList( brushList, max, TRUE, progress );
 }
 
 void DEntity::SelectBrushes( bool *selectList ){
@@ -33,6 +33,9 @@
 #pragma once
 #endif // _MSC_VER > 1000
 
+// done and total are work items, called on the main thread
+typedef void ( *BrushCheckProgressFunc )( int done, int total );
+
 class DEntity
 {
 public:
@@ -70,8 +73,8 @@ DBrush* FindBrushByPointer( brush_t* brush );
 
 //	bool list functions
 void SelectBrushes( bool* selectList );
-bool* BuildDuplicateList();
-bool* BuildIntersectList();
+bool* BuildDuplicateList( BrushCheckProgressFunc progress = NULL );
+bool* BuildIntersectList( BrushCheckProgressFunc progress = NULL );
 //	---------------------------------------------
 
 
@@ -34,7 +34,9 @@
 DVisDrawer::DVisDrawer(){
 	refCount = 1;
 	m_bHooked = FALSE;
-	m_list = NULL;
+	m_cluster = -1;
+	m_bFollowCamera = false;
+	VectorClear( m_origin );
 }
 
 DVisDrawer::~DVisDrawer(){
@@ -43,14 +45,43 @@ DVisDrawer::~DVisDrawer(){
 	}
 
 	g_VisView = NULL;
+
+	VisFind_Free();
 }
 
 //////////////////////////////////////////////////////////////////////
 // Implementation
 //////////////////////////////////////////////////////////////////////
 
+// the trace only changes when the point moves into another cluster
+void DVisDrawer::Update(){
+	if ( m_bFollowCamera ) {
+		vec3_t angles;
+		g_CameraTable.m_pfnGetCamera( m_origin, angles );
+	}
+
+	int cluster = VisFind_ClusterForPoint( m_origin );
+	if ( cluster != m_cluster ) {
+		m_cluster = cluster;
+		VisFind_Trace( m_cluster, m_indexes, m_colours );
+	}
+}
+
+void DVisDrawer::DrawTrace(){
+	g_QglTable.m_pfn_qglEnableClientState( GL_VERTEX_ARRAY );
+	g_QglTable.m_pfn_qglEnableClientState( GL_COLOR_ARRAY );
+	g_QglTable.m_pfn_qglVertexPointer( 3, GL_FLOAT, 0, VisFind_Points() );
+	g_QglTable.m_pfn_qglColorPointer( 4, GL_UNSIGNED_BYTE, 0, &m_colours[0] );
+
+	g_QglTable.m_pfn_qglDrawElements( GL_TRIANGLES, m_indexes.size(), GL_UNSIGNED_INT, &m_indexes[0] );
+
+	g_QglTable.m_pfn_qglDisableClientState( GL_COLOR_ARRAY );
+	g_QglTable.m_pfn_qglDisableClientState( GL_VERTEX_ARRAY );
+}
+
 void DVisDrawer::Draw2D( VIEWTYPE vt ){
-	if ( !m_list ) {
+	Update();
+	if ( m_indexes.empty() ) {
 		return;
 	}
 
@@ -75,7 +106,6 @@ void DVisDrawer::Draw2D( VIEWTYPE vt ){
 	}
 
 	g_QglTable.m_pfn_qglLineWidth( 1.0f );
-	g_QglTable.m_pfn_qglColor4f( 1.0f, 0.0f, 0.0f, 0.5f );
 
 	g_QglTable.m_pfn_qglEnable( GL_BLEND );
 	g_QglTable.m_pfn_qglBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
@@ -83,22 +113,7 @@ void DVisDrawer::Draw2D( VIEWTYPE vt ){
 
 	g_QglTable.m_pfn_qglDepthFunc( GL_ALWAYS );
 
-	//bleh
-	list<DWinding *>::const_iterator l = m_list->begin();
-
-	for (; l != m_list->end(); l++ )
-	{
-		DWinding* w = *l;
-
-		g_QglTable.m_pfn_qglColor4f( w->clr[0], w->clr[1], w->clr[2], 0.5f );
-
-		g_QglTable.m_pfn_qglBegin( GL_POLYGON );
-		for ( int i = 0; i < w->numpoints; i++ ) {
-			g_QglTable.m_pfn_qglVertex3f( ( w->p[i] )[0], ( w->p[i] )[1], ( w->p[i] )[2] );
-		}
-		g_QglTable.m_pfn_qglEnd();
-	}
-
+	DrawTrace();
 
 	g_QglTable.m_pfn_qglPopMatrix();
 
@@ -106,14 +121,13 @@ void DVisDrawer::Draw2D( VIEWTYPE vt ){
 }
 
 void DVisDrawer::Draw3D(){
-	if ( !m_list ) {
+	Update();
+	if ( m_indexes.empty() ) {
 		return;
 	}
 
 	g_QglTable.m_pfn_qglPushAttrib( GL_ALL_ATTRIB_BITS );
 
-	g_QglTable.m_pfn_qglColor4f( 1.0, 0.0, 0.0, 0.5f );
-
 //	g_QglTable.m_pfn_qglHint(GL_FOG_HINT, GL_NICEST);
 
 //	g_QglTable.m_pfn_qglDisable(GL_CULL_FACE);
@@ -128,21 +142,7 @@ void DVisDrawer::Draw3D(){
 
 	g_QglTable.m_pfn_qglDepthFunc( GL_ALWAYS );
 
-	//bleh
-	list<DWinding *>::const_iterator l = m_list->begin();
-
-	for (; l != m_list->end(); l++ )
-	{
-		DWinding* w = *l;
-
-		g_QglTable.m_pfn_qglColor4f( w->clr[0], w->clr[1], w->clr[2], 0.5f );
-
-		g_QglTable.m_pfn_qglBegin( GL_POLYGON );
-		for ( int i = 0; i < w->numpoints; i++ ) {
-			g_QglTable.m_pfn_qglVertex3f( ( w->p[i] )[0], ( w->p[i] )[1], ( w->p[i] )[2] );
-		}
-		g_QglTable.m_pfn_qglEnd();
-	}
+	DrawTrace();
 
 	g_QglTable.m_pfn_qglPopAttrib();
 }
@@ -159,17 +159,19 @@ void DVisDrawer::UnRegister(){
 	m_bHooked = FALSE;
 }
 
-void DVisDrawer::SetList( list<DWinding*> *pointList ){
-	if ( m_list ) {
-		ClearPoints();
-	}
+void DVisDrawer::SetOrigin( vec3_t origin ){
+	m_bFollowCamera = false;
+	VectorCopy( origin, m_origin );
+	Reload();
+}
 
-	m_list = pointList;
+void DVisDrawer::FollowCamera(){
+	m_bFollowCamera = true;
+	Reload();
 }
 
-void DVisDrawer::ClearPoints(){
-	list<DWinding *>::const_iterator deadPoint = m_list->begin();
-	for (; deadPoint != m_list->end(); deadPoint++ )
-		delete *deadPoint;
-	m_list->clear();
+// the bsp was (re)loaded, trace again even if the cluster number is the same
+void DVisDrawer::Reload(){
+	m_cluster = -2;
+	Update();
 }
@@ -24,7 +24,7 @@
 #if !defined( AFX_VISDRAWER_H__6E36062A_EF0B_11D4_ACF7_004095A18133__INCLUDED_ )
 #define AFX_VISDRAWER_H__6E36062A_EF0B_11D4_ACF7_004095A18133__INCLUDED_
 
-#include "DWinding.h"
+#include "visfind.h"
 
 #if _MSC_VER > 1000
 
@@ -40,11 +40,19 @@ DVisDrawer();
 virtual ~DVisDrawer();
 
 protected:
-list<DWinding*>* m_list;
+vector<unsigned int> m_indexes;     // triangles into VisFind_Points
+vector<byte> m_colours;
+int m_cluster;
+bool m_bFollowCamera;
+vec3_t m_origin;
 int refCount;
+
+void Update();
+void DrawTrace();
 public:
-void ClearPoints();
-void SetList( list<DWinding*>* pointList );
+void SetOrigin( vec3_t origin );
+void FollowCamera();
+void Reload();
 void UnRegister();
 void Register();
 void Draw3D();
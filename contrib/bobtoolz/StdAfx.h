@@ -136,6 +136,7 @@ typedef uint UINT;
 #include "igl.h"
 #include "itoolbar.h"
 #include "ientity.h"
+#include "icamera.h"
 
 #include "mathlib.h"
 
@@ -147,6 +148,7 @@ extern _QERShadersTable g_ShadersTable;
 extern _QERQglTable g_QglTable;
 extern _QERUITable g_MessageTable;
 extern _QEREntityTable g_EntityTable;
+extern _QERCameraTable g_CameraTable;
 
 #define MAX_ROUND_ERROR 0.05
 
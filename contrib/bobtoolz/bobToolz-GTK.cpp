@@ -36,6 +36,7 @@ _QERSelectedFaceTable g_SelectedFaceTable;  // to get texture sizes
 _QERQglTable g_QglTable;                                // for path plotting (hooking to DBobView)
 _QERUITable g_MessageTable;                             // for path plotting (listening for update)
 _QEREntityTable g_EntityTable;
+_QERCameraTable g_CameraTable;                          // to follow the camera with the vis trace
 
 // plugin name
 const char* PLUGIN_NAME = "bobToolz";
@@ -253,6 +254,7 @@ extern "C" CSynapseClient * SYNAPSE_DLL_EXPORT Synapse_EnumerateInterfaces( cons
 	g_SynapseClient.AddAPI( UI_MAJOR, NULL, sizeof( g_MessageTable ), SYN_REQUIRE, &g_MessageTable );
 	g_SynapseClient.AddAPI( RADIANT_MAJOR, NULL, sizeof( g_FuncTable ), SYN_REQUIRE, &g_FuncTable );
 	g_SynapseClient.AddAPI( QGL_MAJOR, NULL, sizeof( g_QglTable ), SYN_REQUIRE, &g_QglTable );
+	g_SynapseClient.AddAPI( CAMERA_MAJOR, NULL, sizeof( g_CameraTable ), SYN_REQUIRE, &g_CameraTable );
 
 	return &g_SynapseClient;
 }
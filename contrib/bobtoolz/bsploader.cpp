@@ -48,47 +48,8 @@ int                 *dleafbrushes =     NULL;
 #define Q3_BSP_VERSION          46
 #define WOLF_BSP_VERSION            47
 
-/*
-   ================
-   FileLength
-   ================
- */
-int FileLength( FILE *f ){
-	int pos;
-	int end;
-
-	pos = ftell( f );
-	fseek( f, 0, SEEK_END );
-	end = ftell( f );
-	fseek( f, pos, SEEK_SET );
-
-	return end;
-}
-
-/*
-   ==============
-   LoadFile
-   ==============
- */
-qboolean    LoadFile( const char *filename, byte **bufferptr ){
-	FILE    *f;
-	int length;
-	byte    *buffer;
-
-	f = fopen( filename, "rb" );
-	if ( !f ) {
-		return false;
-	}
-
-	length = FileLength( f );
-	buffer = new byte[length + 1];
-	buffer[length] = 0;
-	fread( buffer, 1, length, f );
-	fclose( f );
-
-	*bufferptr = buffer;
-	return true;
-}
+// the file stays mapped until FreeBSPData, little endian hosts read the lumps in place
+static GMappedFile  *bspFile =          NULL;
 
 /*int    LittleLong (int l)
    {
@@ -187,23 +148,39 @@ void SwapBSPFile( void ) {
 //	}
 }
 
+static void FreeBSPFile(){
+	if ( bspFile ) {
+#if GLIB_CHECK_VERSION( 2, 22, 0 )
+		g_mapped_file_unref( bspFile );
+#else
+		g_mapped_file_free( bspFile );
+#endif
+		bspFile = NULL;
+	}
+}
+
 /*
    =============
    CopyLump
    =============
  */
-int CopyLump( dheader_t *header, int lump, void **dest, int size ) {
+int CopyLump( dheader_t *header, byte *base, int lump, void **dest, int size ) {
 	int length, ofs;
 
 	length = header->lumps[lump].filelen;
 	ofs = header->lumps[lump].fileofs;
 
 	if ( length == 0 ) {
+		*dest = NULL;
 		return 0;
 	}
 
+#if G_BYTE_ORDER == G_LITTLE_ENDIAN
+	*dest = base + ofs;
+#else
 	*dest = new byte[length];
-	memcpy( *dest, (byte *)header + ofs, length );
+	memcpy( *dest, base + ofs, length );
+#endif
 
 	return length / size;
 }
@@ -214,74 +191,98 @@ int CopyLump( dheader_t *header, int lump, void **dest, int size ) {
    =============
  */
 qboolean    LoadBSPFile( const char *filename ) {
-	dheader_t   *header;
+	dheader_t header;
+	byte        *base;
+	gsize length;
+	int i;
 
-	// load the file header
-	if ( !LoadFile( filename, (byte **)&header ) ) {
+	FreeBSPData();
+
+	bspFile = g_mapped_file_new( filename, FALSE, NULL );
+	if ( !bspFile ) {
+		return false;
+	}
+
+	base = (byte *)g_mapped_file_get_contents( bspFile );
+	length = g_mapped_file_get_length( bspFile );
+
+	if ( length < sizeof( header ) ) {
+		DoMessageBox( "Cant find a valid IBSP file", "Error", MB_OK );
+		FreeBSPData();
 		return false;
 	}
 
-	// swap the header
-	SwapBlock( (int *)header, sizeof( *header ) );
+	// swap the header, the mapping itself is read only
+	memcpy( &header, base, sizeof( header ) );
+	SwapBlock( (int *)&header, sizeof( header ) );
 
-	if ( header->ident != BSP_IDENT ) {
+	if ( header.ident != BSP_IDENT ) {
 		DoMessageBox( "Cant find a valid IBSP file", "Error", MB_OK );
+		FreeBSPData();
 		return false;
 	}
-	if ( ( header->version != Q3_BSP_VERSION ) &&
-		 ( header->version != WOLF_BSP_VERSION ) ) {
+	if ( ( header.version != Q3_BSP_VERSION ) &&
+		 ( header.version != WOLF_BSP_VERSION ) ) {
 		DoMessageBox( "File is incorrect version", "Error", MB_OK );
+		FreeBSPData();
 		return false;
 	}
+	for ( i = 0; i < HEADER_LUMPS; i++ )
+	{
+		if ( header.lumps[i].fileofs < 0 || header.lumps[i].filelen < 0 ||
+			 (gsize)header.lumps[i].fileofs + header.lumps[i].filelen > length ) {
+			DoMessageBox( "BSP file is truncated", "Error", MB_OK );
+			FreeBSPData();
+			return false;
+		}
+	}
 
-	numbrushsides =     CopyLump( header, LUMP_BRUSHES,         (void**)&dbrushsides,   sizeof( dbrushside_t ) );
-	numbrushes =        CopyLump( header, LUMP_BRUSHES,         (void**)&dbrushes,      sizeof( dbrush_t ) );
-	numplanes =         CopyLump( header, LUMP_PLANES,          (void**)&dplanes,       sizeof( dplane_t ) );
-	numleafs =          CopyLump( header, LUMP_LEAFS,           (void**)&dleafs,        sizeof( dleaf_t ) );
-	numnodes =          CopyLump( header, LUMP_NODES,           (void**)&dnodes,        sizeof( dnode_t ) );
-	numDrawVerts =      CopyLump( header, LUMP_DRAWVERTS,       (void**)&drawVerts,     sizeof( qdrawVert_t ) );
-	numDrawSurfaces =   CopyLump( header, LUMP_SURFACES,        (void**)&drawSurfaces,  sizeof( dsurface_t ) );
-	numleafsurfaces =   CopyLump( header, LUMP_LEAFSURFACES,    (void**)&dleafsurfaces, sizeof( int ) );
-	numVisBytes =       CopyLump( header, LUMP_VISIBILITY,      (void**)&visBytes,      1 );
-	numleafbrushes =    CopyLump( header, LUMP_LEAFBRUSHES,     (void**)&dleafbrushes,  sizeof( int ) );
-
-	delete header;      // everything has been copied out
-
-	// swap everything
+	numbrushsides =     CopyLump( &header, base, LUMP_BRUSHES,          (void**)&dbrushsides,   sizeof( dbrushside_t ) );
+	numbrushes =        CopyLump( &header, base, LUMP_BRUSHES,          (void**)&dbrushes,      sizeof( dbrush_t ) );
+	numplanes =         CopyLump( &header, base, LUMP_PLANES,           (void**)&dplanes,       sizeof( dplane_t ) );
+	numleafs =          CopyLump( &header, base, LUMP_LEAFS,            (void**)&dleafs,        sizeof( dleaf_t ) );
+	numnodes =          CopyLump( &header, base, LUMP_NODES,            (void**)&dnodes,        sizeof( dnode_t ) );
+	numDrawVerts =      CopyLump( &header, base, LUMP_DRAWVERTS,        (void**)&drawVerts,     sizeof( qdrawVert_t ) );
+	numDrawSurfaces =   CopyLump( &header, base, LUMP_SURFACES,         (void**)&drawSurfaces,  sizeof( dsurface_t ) );
+	numleafsurfaces =   CopyLump( &header, base, LUMP_LEAFSURFACES,     (void**)&dleafsurfaces, sizeof( int ) );
+	numVisBytes =       CopyLump( &header, base, LUMP_VISIBILITY,       (void**)&visBytes,      1 );
+	numleafbrushes =    CopyLump( &header, base, LUMP_LEAFBRUSHES,      (void**)&dleafbrushes,  sizeof( int ) );
+
+#if G_BYTE_ORDER != G_LITTLE_ENDIAN
+	// everything has been copied out, swap it
+	FreeBSPFile();
 	SwapBSPFile();
+#endif
 
 	return true;
 }
 
 void FreeBSPData(){
-	if ( visBytes ) {
-		delete visBytes;
-	}
-	if ( dnodes ) {
-		delete dnodes;
-	}
-	if ( dplanes ) {
-		delete dplanes;
-	}
-	if ( dleafs ) {
-		delete dleafs;
-	}
-	if ( drawVerts ) {
-		delete drawVerts;
-	}
-	if ( drawSurfaces ) {
-		delete drawSurfaces;
-	}
-	if ( dleafsurfaces ) {
-		delete dleafsurfaces;
-	}
-	if ( dleafbrushes ) {
-		delete dleafbrushes;
-	}
-	if ( dbrushes ) {
-		delete dbrushes;
-	}
-	if ( dbrushsides ) {
-		delete dbrushsides;
-	}
+#if G_BYTE_ORDER != G_LITTLE_ENDIAN
+	delete[] visBytes;
+	delete[] (byte *)dnodes;
+	delete[] (byte *)dplanes;
+	delete[] (byte *)dleafs;
+	delete[] (byte *)drawVerts;
+	delete[] (byte *)drawSurfaces;
+	delete[] (byte *)dleafsurfaces;
+	delete[] (byte *)dleafbrushes;
+	delete[] (byte *)dbrushes;
+	delete[] (byte *)dbrushsides;
+#endif
+	FreeBSPFile();
+
+	visBytes = NULL;
+	dnodes = NULL;
+	dplanes = NULL;
+	dleafs = NULL;
+	drawVerts = NULL;
+	drawSurfaces = NULL;
+	dleafsurfaces = NULL;
+	dleafbrushes = NULL;
+	dbrushes = NULL;
+	dbrushsides = NULL;
+
+	numVisBytes = numnodes = numplanes = numleafs = numDrawVerts = 0;
+	numDrawSurfaces = numleafsurfaces = numleafbrushes = numbrushes = numbrushsides = 0;
 }
@@ -70,6 +70,16 @@ void LoadLists(){
 //     Main Functions     //
 //========================//
 
+static void IntersectProgress( int done, int total ){
+	char buffer[256];
+
+	sprintf( buffer, "Checking brushes: %i%%", total ? ( done * 100 ) / total : 100 );
+	Sys_Status( buffer, 0 );
+
+	while ( gtk_events_pending() )
+		gtk_main_iteration();
+}
+
 void DoIntersect(){
 	IntersectRS rs;
 
@@ -104,10 +114,10 @@ void DoIntersect(){
 
 	bool* pbSelectList;
 	if ( rs.bDuplicateOnly ) {
-		pbSelectList = world.BuildDuplicateList();
+		pbSelectList = world.BuildDuplicateList( IntersectProgress );
 	}
 	else{
-		pbSelectList = world.BuildIntersectList();
+		pbSelectList = world.BuildIntersectList( IntersectProgress );
 	}
 
 	world.SelectBrushes( pbSelectList );
@@ -519,34 +529,35 @@ void DoSplitPatch() {
 
 void DoVisAnalyse(){
 	char filename[1024];
+	vec3_t origin;
 
-	if ( g_FuncTable.m_pfnSelectedBrushCount() == 0 ) {
-		if ( g_VisView ) {
-			delete g_VisView;
-			return;
-		}
+	// nothing selected: turn it off, or follow the camera
+	int count = g_FuncTable.m_pfnSelectedBrushCount();
+	if ( count == 0 && g_VisView ) {
+		delete g_VisView;
+		return;
 	}
 
-	if ( g_FuncTable.m_pfnSelectedBrushCount() != 1 ) {
-		DoMessageBox( "Invalid number of objects selected, select 1 only", "Error", MB_OK );
+	if ( count > 1 ) {
+		DoMessageBox( "Invalid number of objects selected, select 1 only\n(or none to follow the camera)", "Error", MB_OK );
 		return;
 	}
 
-	g_FuncTable.m_pfnAllocateSelectedBrushHandles();
+	if ( count == 1 ) {
+		g_FuncTable.m_pfnAllocateSelectedBrushHandles();
 
-	brush_t *brush = (brush_t*)g_FuncTable.m_pfnGetSelectedBrushHandle( 0 );
+		brush_t *brush = (brush_t*)g_FuncTable.m_pfnGetSelectedBrushHandle( 0 );
 
-	DBrush orgBrush;
-	orgBrush.LoadFromBrush_t( brush, false );
+		DBrush orgBrush;
+		orgBrush.LoadFromBrush_t( brush, false );
 
-	g_FuncTable.m_pfnReleaseSelectedBrushHandles();
-
-	orgBrush.BuildBounds();
-	vec3_t origin;
-	origin[0] = ( orgBrush.bbox_max[0] + orgBrush.bbox_min[0] ) / 2.f;
-	origin[1] = ( orgBrush.bbox_max[1] + orgBrush.bbox_min[1] ) / 2.f;
-	origin[2] = ( orgBrush.bbox_max[2] + orgBrush.bbox_min[2] ) / 2.f;
+		g_FuncTable.m_pfnReleaseSelectedBrushHandles();
 
+		orgBrush.BuildBounds();
+		origin[0] = ( orgBrush.bbox_max[0] + orgBrush.bbox_min[0] ) / 2.f;
+		origin[1] = ( orgBrush.bbox_max[1] + orgBrush.bbox_min[1] ) / 2.f;
+		origin[2] = ( orgBrush.bbox_max[2] + orgBrush.bbox_min[2] ) / 2.f;
+	}
 
 	char* rad_filename = g_FuncTable.m_pfnGetMapName();
 	if ( !rad_filename ) {
@@ -559,14 +570,25 @@ void DoVisAnalyse(){
 	char* ext = strrchr( filename, '.' ) + 1;
 	strcpy( ext, "bsp" ); // rename the extension
 
-	list<DWinding*> *pointList = BuildTrace( filename, origin );
+	// reuses the loaded bsp if it hasn't been recompiled
+	if ( !VisFind_Load( filename ) ) {
+		if ( g_VisView ) {
+			delete g_VisView;
+		}
+		return;
+	}
 
 	if ( !g_VisView ) {
 		g_VisView = new DVisDrawer;
 		g_VisView->Register();
 	}
 
-	g_VisView->SetList( pointList );
+	if ( count == 1 ) {
+		g_VisView->SetOrigin( origin );
+	}
+	else{
+		g_VisView->FollowCamera();
+	}
 }
 
 void DoTrainPathPlot() {
@@ -4,47 +4,84 @@
 
 #include "StdAfx.h"
 #include "dialogs/dialogs-gtk.h"
-#include "DWinding.h"
 #include "bsploader.h"
+#include "visfind.h"
+
+#include <sys/stat.h>
 
 typedef struct {
 	int portalclusters;
 	int leafbytes;           //leafbytes = ((portalclusters+63)&~63)>>3;
 } vis_header;
 
-// added because int shift = 32; i = 0xFFFFFFFF >> shift;
-// then i = 0xFFFFFFFF, when it should = 0
-const unsigned long bitmasks[33] =
-{
-	0x00000000,
-	0x00000001, 0x00000003, 0x00000007, 0x0000000F,
-	0x0000001F, 0x0000003F, 0x0000007F, 0x000000FF,
-	0x000001FF, 0x000003FF, 0x000007FF, 0x00000FFF,
-	0x00001FFF, 0x00003FFF, 0x00007FFF, 0x0000FFFF,
-	0x0001FFFF, 0x0003FFFF, 0x0007FFFF, 0x000FFFFF,
-	0x001FFFFF, 0x003FFFFF, 0x007FFFFF, 0x00FFFFFF,
-	0x01FFFFFF, 0x03FFFFFF, 0x07FFFFFF, 0x0FFFFFFF,
-	0x1FFFFFFF, 0x3FFFFFFF, 0x7FFFFFFF, 0xFFFFFFFF
-};
-
-int bsp_leafnumfororigin( vec3_t origin ){
+// leaf1 = origin leaf
+// leaf2 = leaf to test for
+/*int bsp_InPVS(int cluster1, int cluster2)
+   {
+    vis_header		*vheader;
+    byte			*visdata;
+
+    vheader = (vis_header *) visBytes;
+    visdata = visBytes + VIS_HEADER_SIZE;
+
+    return( *( visdata + ( cluster1 * vheader->leafbytes ) + (cluster2 / 8) ) & ( 1 << ( cluster2 % 8 ) ) );
+   }*/
+
+//
+// the bsp is read once and only read again when the file changes,
+// everything a trace needs is copied out of it and worked out once per load:
+// the bsp tree, the planar surfaces of each cluster, their points in one flat array,
+// the pvs rows as 64 bit words and an area mask over the clusters
+// the file is unmapped right after, q3map2 has to be able to replace it (not possible on win32 while mapped)
+//
+
+static char s_bspName[1024];
+static time_t s_bspTime;
+static off_t s_bspSize;
+static bool s_bspLoaded = false;
+
+static int s_numClusters;
+static int s_rowWords;
+
+static vector<dnode_t> s_nodes;
+static vector<dplane_t> s_planes;
+static vector<int> s_leafCluster;
+static vector<guint64> s_vis;                   // s_rowWords per cluster
+static vector<int> s_clusterArea;               // area of the first leaf of each cluster
+static vector<int> s_clusterSurfStart;          // numClusters + 1 entries into s_clusterSurfs
+static vector<int> s_clusterSurfs;              // planar surfaces of every leaf in the cluster
+static vector<int> s_surfFirst;                 // first point of each surface, -1 if it isn't drawn
+static vector<int> s_surfNumPoints;
+static vector<float> s_points;                  // xyz of every planar surface
+static vector<guint64> s_areaMasks;             // s_rowWords per area, the clusters in that area
+static vector<guint64> s_lastSet;               // what the last trace saw
+static vector<int> s_surfStamp;
+static int s_stamp;
+
+static inline guint64 Vis_Word( const byte *row, int w ){
+	guint64 v;
+	memcpy( &v, row + w * sizeof( guint64 ), sizeof( guint64 ) );
+	return GUINT64_FROM_LE( v );
+}
+
+static int bsp_leafnumfororigin( vec3_t origin ){
 	dnode_t     *node;
 	dplane_t    *plane;
 	float d;
 
 	// TODO: check if origin is in the map??
 
-	node = dnodes;
+	node = &s_nodes[0];
 	while ( true )
 	{
-		plane = &dplanes[node->planeNum];
+		plane = &s_planes[node->planeNum];
 		d = DotProduct( origin, plane->normal ) - plane->dist;
 		if ( d >= 0 ) {
 			if ( node->children[0] < 0 ) {
 				return -( node->children[0] + 1 );
 			}
 			else{
-				node = &dnodes[node->children[0]];
+				node = &s_nodes[node->children[0]];
 			}
 		}
 		else
@@ -52,200 +89,350 @@ int bsp_leafnumfororigin( vec3_t origin ){
 			return -( node->children[1] + 1 );
 		}
 		else{
-			node = &dnodes[node->children[1]];
+			node = &s_nodes[node->children[1]];
 		}
 	}
 	return 0;
 }
 
-int bsp_leafnumforcluster( int cluster ){
-	dleaf_t *l;
-	int i;
-
-	for ( i = 0, l = dleafs; i < numleafs; i++, l++ )
-		if ( l->cluster == cluster ) {
-			return( i );
-		}
-	return( 0 );
+static inline int Vis_CountBits( guint64 v ){
+#if defined( __GNUC__ )
+	return __builtin_popcountll( v );
+#else
+	v = v - ( ( v >> 1 ) & G_GUINT64_CONSTANT( 0x5555555555555555 ) );
+	v = ( v & G_GUINT64_CONSTANT( 0x3333333333333333 ) ) + ( ( v >> 2 ) & G_GUINT64_CONSTANT( 0x3333333333333333 ) );
+	v = ( v + ( v >> 4 ) ) & G_GUINT64_CONSTANT( 0x0F0F0F0F0F0F0F0F );
+	return (int)( ( v * G_GUINT64_CONSTANT( 0x0101010101010101 ) ) >> 56 );
+#endif
 }
 
-// leaf1 = origin leaf
-// leaf2 = leaf to test for
-/*int bsp_InPVS(int cluster1, int cluster2)
-   {
-    vis_header		*vheader;
-    byte			*visdata;
-
-    vheader = (vis_header *) visBytes;
-    visdata = visBytes + VIS_HEADER_SIZE;
-
-    return( *( visdata + ( cluster1 * vheader->leafbytes ) + (cluster2 / 8) ) & ( 1 << ( cluster2 % 8 ) ) );
-   }*/
-
-void bsp_setbitvectorlength( byte *v, int length_bits, int length_vector ){
-	int i;
-
-	i = length_bits / 8;
-
-	*( v + i ) = (byte) bitmasks[length_bits % 8];
-
-	memset( ( v + i + 1 ), 0, length_vector - i - 1 );
+static inline int Vis_LowestBit( guint64 v ){
+#if defined( __GNUC__ )
+	return __builtin_ctzll( v );
+#else
+	int n = 0;
+	while ( !( v & 1 ) )
+	{
+		v >>= 1;
+		n++;
+	}
+	return n;
+#endif
 }
 
-
-void bsp_bitvectorsubtract( byte *first, byte *second, byte *out, int length ){
-
-	int i;
-
-	for ( i = 0; i < length; i++ )
-		*( out + i ) = *( first + i ) & ~( *( second + i ) );
+void VisFind_Free(){
+	s_bspLoaded = false;
+	s_bspName[0] = '\0';
+	s_numClusters = 0;
+
+	vector<dnode_t>().swap( s_nodes );
+	vector<dplane_t>().swap( s_planes );
+	vector<int>().swap( s_leafCluster );
+	vector<guint64>().swap( s_vis );
+	vector<int>().swap( s_clusterArea );
+	vector<int>().swap( s_clusterSurfStart );
+	vector<int>().swap( s_clusterSurfs );
+	vector<int>().swap( s_surfFirst );
+	vector<int>().swap( s_surfNumPoints );
+	vector<float>().swap( s_points );
+	vector<guint64>().swap( s_areaMasks );
+	vector<guint64>().swap( s_lastSet );
+	vector<int>().swap( s_surfStamp );
 }
 
-int bsp_countclusters( byte *bitvector, int length ){
-	int i, j, c;
+static bool VisFind_Build(){
+	vis_header      *vheader;
+	int i, k, c, numAreas;
 
-	c = 0;
-	for ( i = 0; i < length; i++ )
-		for ( j = 0; j < 8; j++ )
-			if ( ( *( bitvector + i ) & ( 1 << j ) ) ) {
-				c++;
-			}
-	return( c );
-}
+	if ( numVisBytes < (int)sizeof( vis_header ) || !numnodes || !numleafs ) {
+		DoMessageBox( "The BSP file has no visibility data", "Error", MB_OK );
+		return false;
+	}
 
-int bsp_countclusters_mask( byte *bitvector, byte *maskvector, int length ){
-	int i, j, c;
+	vheader = (vis_header *) visBytes;
+	s_numClusters = vheader->portalclusters;
+	int leafbytes = vheader->leafbytes;
+	if ( s_numClusters <= 0 || leafbytes % sizeof( guint64 ) || leafbytes * 8 < s_numClusters ||
+		 numVisBytes < (int)sizeof( vis_header ) + s_numClusters * leafbytes ) {
+		DoMessageBox( "The BSP file has no visibility data", "Error", MB_OK );
+		return false;
+	}
+	s_rowWords = leafbytes / sizeof( guint64 );
 
-	c = 0;
-	for ( i = 0; i < length; i++ )
-		for ( j = 0; j < 8; j++ )
-			if ( ( *( bitvector + i ) & ( 1 << j ) ) && ( *( maskvector + i ) & ( 1 << j ) ) ) {
-				c++;
+	// the tree, checked once so the point lookup can't run off it
+	for ( i = 0; i < numnodes; i++ )
+	{
+		if ( dnodes[i].planeNum < 0 || dnodes[i].planeNum >= numplanes ) {
+			break;
+		}
+		for ( k = 0; k < 2; k++ )
+			if ( dnodes[i].children[k] >= numnodes || -( dnodes[i].children[k] + 1 ) >= numleafs ) {
+				break;
 			}
-	return( c );
-}
-
-void AddCluster( list<DWinding*> *pointlist, dleaf_t *cl, qboolean* repeatlist, vec3_t clr ){
-	DWinding*   w;
-
-	int* leafsurf = &dleafsurfaces[cl->firstLeafSurface];
-	for ( int k = 0; k < cl->numLeafSurfaces; k++, leafsurf++ )
+		if ( k < 2 ) {
+			break;
+		}
+	}
+	if ( i < numnodes ) {
+		DoMessageBox( "The BSP tree is corrupt", "Error", MB_OK );
+		return false;
+	}
+	s_nodes.assign( dnodes, dnodes + numnodes );
+	s_planes.assign( dplanes, dplanes + numplanes );
+	s_leafCluster.resize( numleafs );
+	for ( i = 0; i < numleafs; i++ )
+		s_leafCluster[i] = dleafs[i].cluster;
+
+	const byte *visData = visBytes + sizeof( vis_header );
+	s_vis.resize( (size_t)s_numClusters * s_rowWords );
+	for ( c = 0; c < s_numClusters; c++ )
+		for ( k = 0; k < s_rowWords; k++ )
+			s_vis[(size_t)c * s_rowWords + k] = Vis_Word( visData + (size_t)c * leafbytes, k );
+
+	// the leafs of each cluster, and the first one for its area
+	vector<int> leafStart( s_numClusters + 1, 0 );
+	vector<int> clusterLeafs( numleafs );
+	s_clusterArea.assign( s_numClusters, -1 );
+	vector<bool> seen( s_numClusters, false );
+	numAreas = 0;
+	for ( i = 0; i < numleafs; i++ )
 	{
-		if ( repeatlist[*leafsurf] ) {
+		c = dleafs[i].cluster;
+		if ( c < 0 || c >= s_numClusters ) {
 			continue;
 		}
+		leafStart[c + 1]++;
+		if ( !seen[c] ) {
+			seen[c] = true;
+			s_clusterArea[c] = dleafs[i].area;
+			if ( dleafs[i].area >= numAreas ) {
+				numAreas = dleafs[i].area + 1;
+			}
+		}
+	}
+	for ( c = 0; c < s_numClusters; c++ )
+		leafStart[c + 1] += leafStart[c];
+	vector<int> fill( leafStart.begin(), leafStart.end() - 1 );
+	for ( i = 0; i < numleafs; i++ )
+	{
+		c = dleafs[i].cluster;
+		if ( c >= 0 && c < s_numClusters ) {
+			clusterLeafs[fill[c]++] = i;
+		}
+	}
+
+	s_areaMasks.assign( (size_t)numAreas * s_rowWords, 0 );
+	for ( c = 0; c < s_numClusters; c++ )
+	{
+		if ( s_clusterArea[c] >= 0 ) {
+			s_areaMasks[(size_t)s_clusterArea[c] * s_rowWords + ( c >> 6 )] |= (guint64)1 << ( c & 63 );
+		}
+	}
 
-		dsurface_t* surf = &drawSurfaces[*leafsurf];
-		if ( surf->surfaceType != MST_PLANAR ) {
+	// the points of every planar surface, in winding order
+	s_surfFirst.assign( numDrawSurfaces, -1 );
+	s_surfNumPoints.assign( numDrawSurfaces, 0 );
+	s_points.clear();
+	for ( i = 0; i < numDrawSurfaces; i++ )
+	{
+		dsurface_t* surf = &drawSurfaces[i];
+		if ( surf->surfaceType != MST_PLANAR || surf->numVerts < 3 ||
+			 surf->firstVert < 0 || surf->firstVert + surf->numVerts > numDrawVerts ) {
 			continue;
 		}
 
+		s_surfFirst[i] = s_points.size() / 3;
+		s_surfNumPoints[i] = surf->numVerts;
 		qdrawVert_t* vert = &drawVerts[surf->firstVert];
-		if ( surf->firstVert + surf->numVerts > numDrawVerts ) {
-			DoMessageBox( "Warning", "Warning", MB_OK );
+		for ( k = 0; k < surf->numVerts; k++, vert++ )
+		{
+			s_points.push_back( vert->xyz[0] );
+			s_points.push_back( vert->xyz[1] );
+			s_points.push_back( vert->xyz[2] );
 		}
+	}
 
-		w = new DWinding();
-		w->AllocWinding( surf->numVerts );
-
-		for ( int l = 0; l < surf->numVerts; l++, vert++ )
+	// the surfaces each cluster touches, once per cluster
+	s_surfStamp.assign( numDrawSurfaces, -1 );
+	s_clusterSurfStart.assign( s_numClusters + 1, 0 );
+	s_clusterSurfs.clear();
+	for ( c = 0; c < s_numClusters; c++ )
+	{
+		s_clusterSurfStart[c] = s_clusterSurfs.size();
+		for ( i = leafStart[c]; i < leafStart[c + 1]; i++ )
 		{
-			( w->p[l] )[0] = vert->xyz[0];
-			( w->p[l] )[1] = vert->xyz[1];
-			( w->p[l] )[2] = vert->xyz[2];
-
-			w->clr[0] = clr[0];
-			w->clr[1] = clr[1];
-			w->clr[2] = clr[2];
+			dleaf_t* leaf = &dleafs[clusterLeafs[i]];
+			for ( k = 0; k < leaf->numLeafSurfaces; k++ )
+			{
+				if ( leaf->firstLeafSurface + k < 0 || leaf->firstLeafSurface + k >= numleafsurfaces ) {
+					break;
+				}
+				int surf = dleafsurfaces[leaf->firstLeafSurface + k];
+				if ( surf < 0 || surf >= numDrawSurfaces || s_surfFirst[surf] < 0 || s_surfStamp[surf] == c ) {
+					continue;
+				}
+				s_surfStamp[surf] = c;
+				s_clusterSurfs.push_back( surf );
+			}
 		}
-		pointlist->push_back( w );
-
-		repeatlist[*leafsurf] = true;
 	}
+	s_clusterSurfStart[s_numClusters] = s_clusterSurfs.size();
+
+	s_surfStamp.assign( numDrawSurfaces, 0 );
+	s_stamp = 0;
+	s_lastSet.clear();
+
+	return true;
 }
 
 /*
    =============
-   CreateTrace
+   VisFind_Load
+
+   loads the bsp, unless it is the one loaded already and hasn't changed since
    =============
  */
-list<DWinding*> *CreateTrace( dleaf_t *leaf, int c, vis_header *header, byte *visdata, byte *seen ){
-	byte        *vis;
-	int i, j, clusterNum;
-	list<DWinding*> *pointlist = new list<DWinding*>;
-	qboolean*   repeatlist = new qboolean[numDrawSurfaces];
-	dleaf_t     *cl;
-
-	vec3_t clrRnd[5] =  {
-		{0.f, 0.f, 1.f},
-		{0.f, 1.f, 1.f},
-		{1.f, 0.f, 0.f},
-		{1.f, 0.f, 1.f},
-		{1.f, 1.f, 0.f},
-	};
+bool VisFind_Load( const char* filename ){
+	struct stat st;
 
-	vec3_t clrGreen =   {0.f, 1.f, 0.f};
+	if ( stat( filename, &st ) != 0 ) {
+		DoMessageBox( "Could not find the BSP file, compile the map first", "Error", MB_OK );
+		return false;
+	}
 
-	memset( repeatlist, 0, sizeof( qboolean ) * numDrawSurfaces );
+	if ( s_bspLoaded && !strcmp( s_bspName, filename ) && st.st_mtime == s_bspTime && st.st_size == s_bspSize ) {
+		return true;
+	}
 
-	vis = visdata + ( c * header->leafbytes );
+	VisFind_Free();
 
-	clusterNum = 0;
+	if ( !LoadBSPFile( filename ) ) {
+		return false;
+	}
 
-	AddCluster( pointlist, &( dleafs[bsp_leafnumforcluster( c )] ), repeatlist, clrGreen );
+	bool ok = VisFind_Build();
+	FreeBSPData();
+	if ( !ok ) {
+		VisFind_Free();
+		return false;
+	}
+	s_bspLoaded = true;
 
-	for ( i = 0; i < header->leafbytes; i++ )
-	{
-		for ( j = 0; j < 8; j++ )
-		{
-			cl = &( dleafs[bsp_leafnumforcluster( clusterNum )] );
+	strncpy( s_bspName, filename, sizeof( s_bspName ) - 1 );
+	s_bspName[sizeof( s_bspName ) - 1] = '\0';
+	s_bspTime = st.st_mtime;
+	s_bspSize = st.st_size;
 
-			if ( ( *( vis + i ) & ( 1 << j ) ) && ( *( seen + i ) & ( 1 << j ) ) && ( leaf->area == cl->area ) ) {
-				AddCluster( pointlist, cl, repeatlist, clrRnd[rand() % 5] );
-			}
-			clusterNum++;
-		}
+	return true;
+}
+
+/*!
+   \return the cluster the point is in, -1 if it is in the void or nothing is loaded
+ */
+int VisFind_ClusterForPoint( vec3_t origin ){
+	if ( !s_bspLoaded ) {
+		return -1;
 	}
 
-	delete[] repeatlist;
+	int c = s_leafCluster[bsp_leafnumfororigin( origin )];
+	if ( c >= s_numClusters ) {
+		return -1;
+	}
+	return c;
+}
+
+const float* VisFind_Points(){
+	return s_points.empty() ? NULL : &s_points[0];
+}
 
-	return pointlist;
+int VisFind_NumPoints(){
+	return s_points.size() / 3;
+}
+
+static void VisFind_AddCluster( int c, const byte* clr, vector<unsigned int>& indexes, vector<byte>& colours ){
+	for ( int i = s_clusterSurfStart[c]; i < s_clusterSurfStart[c + 1]; i++ )
+	{
+		int surf = s_clusterSurfs[i];
+		if ( s_surfStamp[surf] == s_stamp ) {
+			continue;
+		}
+		s_surfStamp[surf] = s_stamp;
+
+		unsigned int first = s_surfFirst[surf];
+		int numVerts = s_surfNumPoints[surf];
+		for ( int k = 1; k < numVerts - 1; k++ )
+		{
+			indexes.push_back( first );
+			indexes.push_back( first + k );
+			indexes.push_back( first + k + 1 );
+		}
+		for ( int k = 0; k < numVerts; k++ )
+			memcpy( &colours[( first + k ) * 4], clr, 4 );
+	}
 }
 
 /*
    =============
-   TraceCluster
+   VisFind_Trace
 
-   setup for CreateTrace
+   triangles and colours for what cluster c sees in its own area,
+   c itself is green, colours index the points from VisFind_Points
    =============
  */
-list<DWinding*> *TraceCluster( int leafnum ){
-	byte seen[( MAX_MAP_LEAFS / 8 ) + 1];
-	vis_header      *vheader;
-	byte            *visdata;
-	dleaf_t         *leaf;
-
-	vheader = (vis_header *) visBytes;
-	visdata = visBytes + sizeof( vis_header );
+void VisFind_Trace( int c, vector<unsigned int>& indexes, vector<byte>& colours ){
+	const byte clrRnd[5][4] =  {
+		{0,   0,   255, 128},
+		{0,   255, 255, 128},
+		{255, 0,   0,   128},
+		{255, 0,   255, 128},
+		{255, 255, 0,   128},
+	};
 
-	memset( seen, 0xFF, sizeof( seen ) );
-	bsp_setbitvectorlength( seen, vheader->portalclusters, sizeof( seen ) );
+	const byte clrGreen[4] =   {0, 255, 0, 128};
 
-	leaf = &( dleafs[leafnum] );
+	indexes.clear();
+	colours.resize( s_points.size() / 3 * 4 );
 
-	return CreateTrace( leaf, leaf->cluster, vheader, visdata, seen );
-}
+	if ( !s_bspLoaded || c < 0 || c >= s_numClusters ) {
+		s_lastSet.clear();
+		return;
+	}
 
-list<DWinding *>* BuildTrace( char* filename, vec3_t v_origin ){
-	if ( !LoadBSPFile( filename ) ) {
-		return NULL;
+	if ( ++s_stamp == 0 ) {
+		s_surfStamp.assign( s_surfStamp.size(), 0 );
+		s_stamp = 1;
 	}
 
-	int leafnum = bsp_leafnumfororigin( v_origin );
+	VisFind_AddCluster( c, clrGreen, indexes, colours );
 
-	list<DWinding*> *pointlist = TraceCluster( leafnum );
+	const guint64* row = &s_vis[(size_t)c * s_rowWords];
+	int area = s_clusterArea[c];
+	const guint64* mask = area >= 0 ? &s_areaMasks[(size_t)area * s_rowWords] : NULL;
 
-	FreeBSPData();
+	vector<guint64> set( s_rowWords );
+	int visible = 0, gained = 0, lost = 0;
+	for ( int w = 0; w < s_rowWords; w++ )
+	{
+		set[w] = mask ? row[w] & mask[w] : 0;
+		visible += Vis_CountBits( set[w] );
+		if ( (int)s_lastSet.size() == s_rowWords ) {
+			gained += Vis_CountBits( set[w] & ~s_lastSet[w] );
+			lost += Vis_CountBits( s_lastSet[w] & ~set[w] );
+		}
+
+		for ( guint64 bits = set[w]; bits; bits &= bits - 1 )
+		{
+			int cl = w * 64 + Vis_LowestBit( bits );
+			VisFind_AddCluster( cl, clrRnd[cl % 5], indexes, colours );
+		}
+	}
+
+	if ( (int)s_lastSet.size() == s_rowWords ) {
+		Sys_Printf( "Vis: cluster %i sees %i of %i clusters, %i hidden (+%i -%i)\n", c, visible, s_numClusters, s_numClusters - visible, gained, lost );
+	}
+	else{
+		Sys_Printf( "Vis: cluster %i sees %i of %i clusters, %i hidden\n", c, visible, s_numClusters, s_numClusters - visible );
+	}
 
-	return pointlist;
+	s_lastSet.swap( set );
 }
@@ -16,4 +16,11 @@
    License along with this library; if not, write to the Free Software
    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
-list<DWinding*> *BuildTrace( char* filename, vec3_t v_origin );
+#include "gtkr_vector.h"
+
+bool VisFind_Load( const char* filename );
+void VisFind_Free();
+int VisFind_ClusterForPoint( vec3_t origin );
+const float* VisFind_Points();
+int VisFind_NumPoints();
+void VisFind_Trace( int cluster, vector<unsigned int>& indexes, vector<byte>& colours );
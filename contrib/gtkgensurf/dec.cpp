@@ -17,46 +17,350 @@
    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
-#define SINGLE
-#ifdef SINGLE
-#define REAL float
-#else /* not SINGLE */
-#define REAL double
-#endif /* not SINGLE */
-
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
+#include <vector>
+#include <queue>
 #include "gensurf.h"
-#include "triangle.h"
 
+double dh, dv;
+int NVP1;
+
+#define Absolute( a )  ( ( a ) >= 0.0 ? ( a ) : -( a ) )
+
+int Bisect( NODE *, int, int, int );
+void CalcAngles( NODE *, int *, float * );
+void EdgeOnSide( int *, int *, int * );
+
+/*
+   The decimated surface is a Delaunay triangulation of the used nodes that grows one
+   node at a time. Every unused node is kept on the triangle it lies on, so adding a node
+   only redoes the triangles whose circumcircle holds it, and only the nodes that were on
+   those triangles get their error recomputed. The worst node of every triangle sits in a
+   priority queue, the largest error overall is always the next node added.
+ */
 typedef struct
 {
+	int v[3];               // counterclockwise in the triangulation plane
+	int n[3];               // triangle across the edge opposite v[k], -1 on the border
+	int nodes;              // first unused node on this triangle, linked through DECIMATE::next
+	int stamp;              // bumped when the slot is freed, older queue entries are skipped
+	int alive;
+	int worst;
 	float error;
-	int node;
-} TRITABLE;
+} DTRI;
 
-double dh, dv;
-int NVP1;
+typedef struct
+{
+	float error;
+	int tri;
+	int stamp;
+} DENTRY;
 
-#define Absolute( a )  ( ( a ) >= 0.0 ? ( a ) : -( a ) )
+struct DEntryLess
+{
+	bool operator()( const DENTRY &a, const DENTRY &b ) const { return a.error < b.error; }
+};
+
+typedef struct
+{
+	NODE *node;
+	int j0, j1, j2;
+	int used;
+	bool slivers;                   // split border slivers of new triangles
+	std::vector<int> next;
+	std::vector<DTRI> tri;
+	std::vector<int> mark;          // markStamp while the triangle is in the cavity
+	int markStamp;
+	std::vector<int> freeTris;
+	std::priority_queue<DENTRY, std::vector<DENTRY>, DEntryLess> queue;
+	std::vector<int> pending;       // border nodes that split a sliver
+	std::vector<int> cavity, edges, created, moved;
+} DECIMATE;
+
+static double Dec_Orient( DECIMATE *d, int a, int b, int c ){
+	double u1 = d->node[a].p[d->j1], v1 = d->node[a].p[d->j2];
+	double u2 = d->node[b].p[d->j1], v2 = d->node[b].p[d->j2];
+	double u3 = d->node[c].p[d->j1], v3 = d->node[c].p[d->j2];
+
+	return side( u1, v1, u2, v2, u3, v3 );
+}
+
+static bool Dec_Inside( DECIMATE *d, int t, int p ){
+	const int *v = d->tri[t].v;
+
+	return Dec_Orient( d, v[0], v[1], p ) >= 0. &&
+		   Dec_Orient( d, v[1], v[2], p ) >= 0. &&
+		   Dec_Orient( d, v[2], v[0], p ) >= 0.;
+}
+
+/*
+   > 0 if p is inside the circumcircle of triangle t
+ */
+static double Dec_InCircle( DECIMATE *d, int t, int p ){
+	const int *v = d->tri[t].v;
+	double px = d->node[p].p[d->j1], py = d->node[p].p[d->j2];
+	double adx = d->node[v[0]].p[d->j1] - px, ady = d->node[v[0]].p[d->j2] - py;
+	double bdx = d->node[v[1]].p[d->j1] - px, bdy = d->node[v[1]].p[d->j2] - py;
+	double cdx = d->node[v[2]].p[d->j1] - px, cdy = d->node[v[2]].p[d->j2] - py;
+
+	return ( adx * adx + ady * ady ) * ( bdx * cdy - cdx * bdy ) +
+		   ( bdx * bdx + bdy * bdy ) * ( cdx * ady - adx * cdy ) +
+		   ( cdx * cdx + cdy * cdy ) * ( adx * bdy - bdx * ady );
+}
+
+static int Dec_NewTri( DECIMATE *d ){
+	int t;
+
+	if ( !d->freeTris.empty() ) {
+		t = d->freeTris.back();
+		d->freeTris.pop_back();
+	}
+	else
+	{
+		t = (int)d->tri.size();
+		d->tri.push_back( DTRI() );
+		d->tri[t].stamp = 0;
+		d->mark.push_back( 0 );
+	}
+
+	d->tri[t].alive = 1;
+	d->tri[t].nodes = -1;
+	d->tri[t].worst = -1;
+	d->tri[t].error = 0;
+	d->tri[t].n[0] = d->tri[t].n[1] = d->tri[t].n[2] = -1;
+	return t;
+}
+
+static void Dec_FreeTri( DECIMATE *d, int t ){
+	d->tri[t].alive = 0;
+	d->tri[t].stamp++;
+	d->freeTris.push_back( t );
+}
+
+/*
+   Errors of the nodes on a triangle against its plane, the worst one is queued
+ */
+static void Dec_Evaluate( DECIMATE *d, int t ){
+	DTRI *tri = &d->tri[t];
+	PLANE plane;
+	int i;
+
+	tri->worst = -1;
+	tri->error = 0;
+	if ( tri->nodes < 0 ) {
+		return;
+	}
+
+	PlaneFromPoints( d->node[tri->v[0]].p, d->node[tri->v[1]].p, d->node[tri->v[2]].p, &plane );
+
+	for ( i = tri->nodes; i >= 0; i = d->next[i] )
+	{
+		NODE *node = &d->node[i];
+
+		node->tri = t;
+		node->error =
+			node->p[d->j0] - ( plane.dist -
+							   plane.normal[d->j1] * node->p[d->j1] -
+							   plane.normal[d->j2] * node->p[d->j2]  ) /
+			plane.normal[d->j0];
+		if ( Absolute( node->error ) > tri->error ) {
+			tri->error = (float)( Absolute( node->error ) );
+			tri->worst = i;
+		}
+	}
+
+	if ( tri->worst >= 0 ) {
+		DENTRY entry;
+		entry.error = tri->error;
+		entry.tri = t;
+		entry.stamp = tri->stamp;
+		d->queue.push( entry );
+	}
+}
+
+/*
+   Sliver-check along borders. Since borders are often linear, the errors along borders
+   will often be zero, so no new points will be added. This tends to produce long, thin
+   brushes. If a border triangle has an angle at the border under SLIVER_ANGLE, the border
+   edge is bisected.
+ */
+static void Dec_CheckSliver( DECIMATE *d, int t ){
+	int border, j, k0, k1;
+	float angle[3];
+
+	EdgeOnSide( d->tri[t].v, &k0, &border );
+	if ( border < 0 ) {
+		return;
+	}
+	CalcAngles( d->node, d->tri[t].v, angle );
+	k1 = ( k0 + 1 ) % 3;
+	if ( ( angle[k0] < SLIVER_ANGLE ) || ( angle[k1] < SLIVER_ANGLE ) ) {
+		j = Bisect( d->node, border, d->tri[t].v[k0], d->tri[t].v[k1] );
+		if ( j >= 0 && !d->node[j].used ) {
+			d->pending.push_back( j );
+		}
+	}
+}
+
+/*
+   Bowyer-Watson insertion of node p, which lies on triangle node[p].tri
+ */
+static void Dec_Insert( DECIMATE *d, int p ){
+	int i, k, c, t, a, b, nb, best;
+	size_t e, x, y;
+	double o, bestOrient;
+
+	d->node[p].used++;
+	d->used++;
+
+	// every triangle whose circumcircle holds p, grown from the one p lies on
+	d->markStamp++;
+	d->cavity.clear();
+	d->cavity.push_back( d->node[p].tri );
+	d->mark[d->node[p].tri] = d->markStamp;
+	for ( e = 0; e < d->cavity.size(); e++ )
+	{
+		c = d->cavity[e];
+		for ( k = 0; k < 3; k++ )
+		{
+			nb = d->tri[c].n[k];
+			if ( nb < 0 || d->mark[nb] == d->markStamp ) {
+				continue;
+			}
+			if ( Dec_InCircle( d, nb, p ) > 0. ) {
+				d->mark[nb] = d->markStamp;
+				d->cavity.push_back( nb );
+			}
+		}
+	}
+
+	// the cavity outline, p has to see every edge of it from the inside
+	// p on a border edge splits it, an inner edge p can't see (round-off) takes in the triangle behind it
+	for ( ;; )
+	{
+		d->edges.clear();
+		for ( e = 0; e < d->cavity.size(); e++ )
+		{
+			c = d->cavity[e];
+			for ( k = 0; k < 3; k++ )
+			{
+				nb = d->tri[c].n[k];
+				if ( nb >= 0 && d->mark[nb] == d->markStamp ) {
+					continue;
+				}
+				a = d->tri[c].v[( k + 1 ) % 3];
+				b = d->tri[c].v[( k + 2 ) % 3];
+				if ( Dec_Orient( d, a, b, p ) <= 0. ) {
+					if ( nb >= 0 ) {
+						d->mark[nb] = d->markStamp;
+						d->cavity.push_back( nb );
+						break;
+					}
+					continue;
+				}
+				d->edges.push_back( a );
+				d->edges.push_back( b );
+				d->edges.push_back( nb );
+			}
+			if ( k < 3 ) {
+				break;
+			}
+		}
+		if ( e == d->cavity.size() ) {
+			break;
+		}
+	}
+
+	d->moved.clear();
+	for ( e = 0; e < d->cavity.size(); e++ )
+	{
+		c = d->cavity[e];
+		for ( i = d->tri[c].nodes; i >= 0; i = d->next[i] )
+		{
+			if ( i != p ) {
+				d->moved.push_back( i );
+			}
+		}
+		Dec_FreeTri( d, c );
+	}
+
+	// a fan around p, one triangle per outline edge
+	d->created.clear();
+	for ( e = 0; e < d->edges.size(); e += 3 )
+	{
+		a = d->edges[e];
+		b = d->edges[e + 1];
+		nb = d->edges[e + 2];
+
+		t = Dec_NewTri( d );
+		d->tri[t].v[0] = a;
+		d->tri[t].v[1] = b;
+		d->tri[t].v[2] = p;
+		d->tri[t].n[2] = nb;
+		if ( nb >= 0 ) {
+			for ( k = 0; k < 3; k++ )
+			{
+				if ( d->tri[nb].v[( k + 1 ) % 3] == b && d->tri[nb].v[( k + 2 ) % 3] == a ) {
+					d->tri[nb].n[k] = t;
+				}
+			}
+		}
+		d->created.push_back( t );
+	}
+	for ( x = 0; x < d->created.size(); x++ )
+	{
+		for ( y = 0; y < d->created.size(); y++ )
+		{
+			if ( d->tri[d->created[y]].v[0] == d->tri[d->created[x]].v[1] ) {
+				d->tri[d->created[x]].n[0] = d->created[y];
+				d->tri[d->created[y]].n[1] = d->created[x];
+			}
+		}
+	}
+
+	// the nodes of the old triangles go on the new ones
+	for ( e = 0; e < d->moved.size(); e++ )
+	{
+		i = d->moved[e];
+		best = d->created[0];
+		bestOrient = -HUGE_VAL;
+		for ( x = 0; x < d->created.size(); x++ )
+		{
+			t = d->created[x];
+			if ( Dec_Inside( d, t, i ) ) {
+				best = t;
+				break;
+			}
+			// round-off, take the triangle it is least outside of
+			const int *v = d->tri[t].v;
+			o = min( Dec_Orient( d, v[0], v[1], i ), min( Dec_Orient( d, v[1], v[2], i ), Dec_Orient( d, v[2], v[0], i ) ) );
+			if ( o > bestOrient ) {
+				bestOrient = o;
+				best = t;
+			}
+		}
+		d->next[i] = d->tri[best].nodes;
+		d->tri[best].nodes = i;
+	}
+
+	for ( x = 0; x < d->created.size(); x++ )
+	{
+		Dec_Evaluate( d, d->created[x] );
+		if ( d->slivers ) {
+			Dec_CheckSliver( d, d->created[x] );
+		}
+	}
+}
 
 void MakeDecimatedMap( int *NumNodes, int *NumTris, NODE **pNode, TRI **pTri ){
-	int compare( TRITABLE *, TRITABLE * );
-	int Bisect( NODE *, int, int, int );
-	void CalcAngles( NODE *, int *, float * );
-	void EdgeOnSide( int *, int *, int * );
-	int tricall( int, NODE *, int *, TRI * *, TRI * *, const char * );
-	int CheckBorders( int *,int,NODE *,int *,TRI * * );
-
-	float biggesterror;
 	int i, j, N;
-	int j0, j1, j2;
+	int corner[4];
 	int NumNodesToSave;
-	int NumNodesUsed;
 	NODE        *Node;
 	TRI         *Tri;
-	TRITABLE    *TriTable;
+	DECIMATE d;
 
 	if ( Decimate <= 0 ) {
 		return;
@@ -85,215 +389,143 @@ void MakeDecimatedMap( int *NumNodes, int *NumTris, NODE **pNode, TRI **pTri ){
 			Node[N].fixed = xyz[i][j].fixed;
 		}
 	}
-	// Start things off with the corner values
-	Node[ 0].used           = 1;
-	Node[NV].used           = 1;
-	Node[NH * NVP1].used    = 1;
-	Node[NH * NVP1 + NV].used = 1;
-	NumNodesUsed = 4;
-	tricall( NumNodes[0], Node, NumTris, NULL, pTri, "cnzBNPY" );
-	Tri = *pTri;
 
 	// Which coordinates are we triangulating on?
 	switch ( Plane )
 	{
 	case PLANE_XZ0:
 	case PLANE_XZ1:
-		j0 = 1;
-		j1 = 0;
-		j2 = 2;
+		d.j0 = 1;
+		d.j1 = 0;
+		d.j2 = 2;
 		break;
 	case PLANE_YZ0:
 	case PLANE_YZ1:
-		j0 = 0;
-		j1 = 1;
-		j2 = 2;
+		d.j0 = 0;
+		d.j1 = 1;
+		d.j2 = 2;
 		break;
 	default:
-		j0 = 2;
-		j1 = 0;
-		j2 = 1;
+		d.j0 = 2;
+		d.j1 = 0;
+		d.j2 = 1;
+	}
+
+	d.node = Node;
+	d.used = 0;
+	d.markStamp = 0;
+	d.slivers = true;
+	d.next.resize( NumNodes[0], -1 );
+	d.tri.reserve( 2 * NumNodes[0] );
+	d.mark.reserve( 2 * NumNodes[0] );
+
+	// Start things off with the corner values, two triangles
+	corner[0] = 0;
+	corner[1] = NH * NVP1;
+	corner[2] = NH * NVP1 + NV;
+	corner[3] = NV;
+	for ( i = 0; i < 4; i++ )
+	{
+		Node[corner[i]].used = 1;
+		d.used++;
 	}
-
-	// TriTable stores the largest error in a triangle and the node where that
-	// error occurs
-	TriTable = (TRITABLE *) malloc( NH * NV * 2 * sizeof( TRITABLE ) );
-	NumNodesToSave = min( NumNodes[0], (int)( 0.01 * ( 100 - Decimate ) * ( NumNodes[0] - NumNodesUsed ) + NumNodesUsed ) );
-
-	while ( NumNodesUsed < NumNodesToSave )
+	for ( i = 0; i < 2; i++ )
 	{
-		for ( i = 0; i < NumTris[0]; i++ )
-			Tri[i].flag = 0;
-
-		// For every node that's not currently used, find what triangle it
-		// lies on, and the error at this node
-		for ( i = 0, biggesterror = 0; i < NumNodes[0]; i++ )
+		Dec_NewTri( &d );
+		d.tri[i].v[0] = corner[0];
+		d.tri[i].v[1] = corner[i + 1];
+		d.tri[i].v[2] = corner[i + 2];
+		if ( Dec_Orient( &d, d.tri[i].v[0], d.tri[i].v[1], d.tri[i].v[2] ) < 0. ) {
+			d.tri[i].v[1] = corner[i + 2];
+			d.tri[i].v[2] = corner[i + 1];
+		}
+		// the shared diagonal is corner 0 - corner 2
+		for ( j = 0; j < 3; j++ )
 		{
-			if ( Node[i].used ) {
-				continue;
-			}
-			for ( j = 0, Node[i].tri = -1; ( j < NumTris[0] ) && ( Node[i].tri == -1 ); j++ )
-			{
-				if ( side( Node[i].p[j1],          Node[i].p[j2],
-						   Node[Tri[j].v[0]].p[j1],Node[Tri[j].v[0]].p[j2],
-						   Node[Tri[j].v[1]].p[j1],Node[Tri[j].v[1]].p[j2] ) < 0. ) {
-					continue;
-				}
-				if ( side( Node[i].p[j1],          Node[i].p[j2],
-						   Node[Tri[j].v[1]].p[j1],Node[Tri[j].v[1]].p[j2],
-						   Node[Tri[j].v[2]].p[j1],Node[Tri[j].v[2]].p[j2] ) < 0. ) {
-					continue;
-				}
-				if ( side( Node[i].p[j1],          Node[i].p[j2],
-						   Node[Tri[j].v[2]].p[j1],Node[Tri[j].v[2]].p[j2],
-						   Node[Tri[j].v[0]].p[j1],Node[Tri[j].v[0]].p[j2] ) < 0. ) {
-					continue;
-				}
-				Node[i].tri = j;
-			}
-			if ( Node[i].tri < 0 ) {
-				/*
-				   ghCursorCurrent = ghCursorDefault;
-				   SetCursor(ghCursorCurrent);
-				 */
-				g_FuncTable.m_pfnMessageBox( g_pRadiantWnd,
-											 "Error: Couldn't find the triangle bounding a point.",
-											 "Decimation Error",MB_ICONEXCLAMATION, NULL );
-				return;
-			}
-			if ( !Tri[Node[i].tri].flag ) {
-				PlaneFromPoints( Node[Tri[Node[i].tri].v[0]].p,
-								 Node[Tri[Node[i].tri].v[1]].p,
-								 Node[Tri[Node[i].tri].v[2]].p,
-								 &Tri[Node[i].tri].plane );
-				Tri[Node[i].tri].flag = 1;
+			if ( d.tri[i].v[j] == corner[i == 0 ? 1 : 3] ) {
+				d.tri[i].n[j] = 1 - i;
 			}
-			Node[i].error =
-				Node[i].p[j0] - ( Tri[Node[i].tri].plane.dist -
-								  Tri[Node[i].tri].plane.normal[j1] * Node[i].p[j1] -
-								  Tri[Node[i].tri].plane.normal[j2] * Node[i].p[j2]  ) /
-				Tri[Node[i].tri].plane.normal[j0];
-			biggesterror = max( biggesterror,Absolute( Node[i].error ) );
 		}
-		if ( biggesterror == 0 ) {
-			NumNodesToSave = NumNodesUsed;
+	}
+	for ( i = NumNodes[0] - 1; i >= 0; i-- )
+	{
+		if ( Node[i].used ) {
+			continue;
 		}
-		else
+		N = Dec_Inside( &d, 0, i ) ? 0 : 1;
+		d.next[i] = d.tri[N].nodes;
+		d.tri[N].nodes = i;
+	}
+	for ( i = 0; i < 2; i++ )
+	{
+		Dec_Evaluate( &d, i );
+		Dec_CheckSliver( &d, i );
+	}
+
+	NumNodesToSave = min( NumNodes[0], (int)( 0.01 * ( 100 - Decimate ) * ( NumNodes[0] - d.used ) + d.used ) );
+
+	// Greedy: the node with the largest error goes in next, border slivers are split
+	// right away. Their nodes count against the node budget like any other, but splits
+	// already pending are finished, so the budget can be overshot by a few nodes
+	for ( ;; )
+	{
+		while ( !d.pending.empty() )
 		{
-			// For all current triangles, build a list of worst-case nodes
-			memset( TriTable,0,NH * NV * 2 * sizeof( TRITABLE ) );
-			for ( i = 0; i < NumNodes[0]; i++ )
-			{
-				if ( Node[i].used ) {
-					continue;
-				}
-				if ( Absolute( Node[i].error ) > TriTable[Node[i].tri].error ) {
-					TriTable[Node[i].tri].error = (float)( Absolute( Node[i].error ) );
-					TriTable[Node[i].tri].node  = i;
-				}
-			}
-			qsort( (void *)TriTable, (size_t)( NumTris[0] ), sizeof( TRITABLE ), ( int ( * )( const void *, const void * ) )compare );
-			for ( i = 0; i < NumTris[0] && NumNodesUsed < NumNodesToSave && TriTable[i].error > 0.5 * biggesterror; i++ )
-			{
-				if ( Node[TriTable[i].node].used ) {
-					continue;                              // shouldn't happen
-				}
-				NumNodesUsed++;
-				Node[TriTable[i].node].used++;
+			i = d.pending.back();
+			d.pending.pop_back();
+			if ( !Node[i].used ) {
+				Dec_Insert( &d, i );
 			}
-			free( Tri );
-			tricall( NumNodes[0], Node, NumTris, NULL, pTri, "cnzBNPY" );
-			Tri = *pTri;
-			// Sliver-check along borders. Since borders are often linear, the errors
-			// along borders will often be zero, so no new points will be added. This
-			// tends to produce long, thin brushes. For all border triangles, check
-			// that minimum angle isn't less than SLIVER_ANGLE. If it is, add another
-			// vertex.
-			while ( CheckBorders( &NumNodesUsed,NumNodes[0],Node,NumTris,pTri ) > 0 )
-			{
-			}
-			Tri = *pTri;
 		}
+
+		if ( d.used >= NumNodesToSave || d.queue.empty() ) {
+			break;
+		}
+
+		DENTRY entry = d.queue.top();
+		d.queue.pop();
+		if ( !d.tri[entry.tri].alive || d.tri[entry.tri].stamp != entry.stamp ) {
+			continue;
+		}
+		Dec_Insert( &d, d.tri[entry.tri].worst );
 	}
-	free( TriTable );
-	// One last time (because we're pessimistic), check border triangles
-//	CheckBorders(&NumNodesUsed,NumNodes[0],Node,NumTris,pTri);
-//	Tri = *pTri;
 
 	// Check that all fixed points are exact. If not, add them to the mix.
-	// First check to see if we have any fixed points that aren't already used.
-	for ( i = 0, N = 0; i < NumNodes[0] && !N; i++ )
+	d.slivers = false;
+	for ( i = 0; i < NumNodes[0]; i++ )
 	{
 		if ( Node[i].used ) {
 			continue;
 		}
-		if ( Node[i].fixed ) {
-			N++;
+		if ( !Node[i].fixed ) {
+			continue;
+		}
+		if ( Absolute( Node[i].error ) > 0.5 ) {
+			Dec_Insert( &d, i );
 		}
 	}
-	if ( N ) {
-		// Zero out the flag member of all triangles, indicating that
-		// the plane equation has not been found.
-		for ( i = 0; i < NumTris[0]; i++ )
-			Tri[i].flag = 0;
 
-		for ( i = 0; i < NumNodes[0]; i++ )
+	// Copy out the live triangles
+	std::vector<int> remap( d.tri.size(), -1 );
+	for ( i = 0, N = 0; i < (int)d.tri.size(); i++ )
+	{
+		if ( d.tri[i].alive ) {
+			remap[i] = N++;
+		}
+	}
+	NumTris[0] = N;
+	*pTri = (TRI *) malloc( NumTris[0] * sizeof( TRI ) );
+	Tri = *pTri;
+	memset( Tri, 0, NumTris[0] * sizeof( TRI ) );
+	for ( i = 0; i < (int)d.tri.size(); i++ )
+	{
+		if ( !d.tri[i].alive ) {
+			continue;
+		}
+		for ( j = 0; j < 3; j++ )
 		{
-			if ( Node[i].used ) {
-				continue;
-			}
-			if ( !Node[i].fixed ) {
-				continue;
-			}
-			Node[i].tri = -1;
-			for ( j = 0; j < NumTris[0] && Node[i].tri == -1; j++ )
-			{
-				if ( side( Node[i].p[j1],          Node[i].p[j2],
-						   Node[Tri[j].v[0]].p[j1],Node[Tri[j].v[0]].p[j2],
-						   Node[Tri[j].v[1]].p[j1],Node[Tri[j].v[1]].p[j2] ) < 0. ) {
-					continue;
-				}
-				if ( side( Node[i].p[j1],          Node[i].p[j2],
-						   Node[Tri[j].v[1]].p[j1],Node[Tri[j].v[1]].p[j2],
-						   Node[Tri[j].v[2]].p[j1],Node[Tri[j].v[2]].p[j2] ) < 0. ) {
-					continue;
-				}
-				if ( side( Node[i].p[j1],          Node[i].p[j2],
-						   Node[Tri[j].v[2]].p[j1],Node[Tri[j].v[2]].p[j2],
-						   Node[Tri[j].v[0]].p[j1],Node[Tri[j].v[0]].p[j2] ) < 0. ) {
-					continue;
-				}
-				Node[i].tri = j;
-			}
-			if ( Node[i].tri < 0 ) {
-				/*
-				   ghCursorCurrent = ghCursorDefault;
-				   SetCursor(ghCursorCurrent);
-				 */
-				g_FuncTable.m_pfnMessageBox( g_pRadiantWnd,
-											 "Error: Couldn't find the triangle bounding a point.",
-											 "Decimation Error",MB_ICONEXCLAMATION, NULL );
-				return;
-			}
-			if ( !Tri[Node[i].tri].flag ) {
-				PlaneFromPoints( Node[Tri[Node[i].tri].v[0]].p,
-								 Node[Tri[Node[i].tri].v[1]].p,
-								 Node[Tri[Node[i].tri].v[2]].p,
-								 &Tri[Node[i].tri].plane );
-				Tri[Node[i].tri].flag = 1;
-			}
-			Node[i].error =
-				Node[i].p[j0] - ( Tri[Node[i].tri].plane.dist -
-								  Tri[Node[i].tri].plane.normal[j1] * Node[i].p[j1] -
-								  Tri[Node[i].tri].plane.normal[j2] * Node[i].p[j2]  ) /
-				Tri[Node[i].tri].plane.normal[j0];
-			if ( Absolute( Node[i].error ) > 0.5 ) {
-				NumNodesUsed++;
-				Node[i].used++;
-				free( Tri );
-				tricall( NumNodes[0], Node, NumTris, NULL, pTri, "cnzBNPY" );
-				Tri = *pTri;
-			}
+			Tri[remap[i]].v[j] = d.tri[i].v[j];
+			Tri[remap[i]].n[j] = d.tri[i].n[j] >= 0 ? remap[d.tri[i].n[j]] : -1;
 		}
 	}
 
@@ -338,233 +570,6 @@ void MakeDecimatedMap( int *NumNodes, int *NumTris, NODE **pNode, TRI **pTri ){
 }
 /* end MakeDecimatedMap */
 
-/*****************************************************************************/
-/*                                                                           */
-/*  tricall Takes an array of nodes, spits out an array of triangles         */
-/*                                                                           */
-/*****************************************************************************/
-int tricall( int NumNodes, NODE *Node, int *NumTris, TRI **inTri, TRI **Tri, const char *Options ){
-	struct triangulateio in, out;
-	int i, N;
-	int NumUsedNodes;
-	int    *NodeTable;
-	TRI    *ptri;
-
-	/* Define input points. */
-
-	for ( i = 0,NumUsedNodes = 0; i < NumNodes; i++ )
-		if ( Node[i].used ) {
-			NumUsedNodes++;
-		}
-
-	memset( &in, 0,sizeof( in ) );
-	memset( &out,0,sizeof( out ) );
-
-	NodeTable = (int *) malloc( NumUsedNodes * sizeof( int ) );
-
-	in.numberofpoints = NumUsedNodes;
-	in.numberofpointattributes = 0;
-	in.pointlist = (REAL *) malloc( in.numberofpoints * 2 * sizeof( REAL ) );
-	for ( i = 0,N = 0; i < NumNodes; i++ )
-	{
-		if ( Node[i].used ) {
-			switch ( Plane )
-			{
-			case PLANE_XZ0:
-			case PLANE_XZ1:
-				in.pointlist[N * 2  ] = Node[i].p[0];
-				in.pointlist[N * 2 + 1] = Node[i].p[2];
-				break;
-			case PLANE_YZ0:
-			case PLANE_YZ1:
-				in.pointlist[N * 2  ] = Node[i].p[1];
-				in.pointlist[N * 2 + 1] = Node[i].p[2];
-				break;
-			default:
-				in.pointlist[N * 2  ] = Node[i].p[0];
-				in.pointlist[N * 2 + 1] = Node[i].p[1];
-			}
-			NodeTable[N] = i;
-			N++;
-		}
-	}
-	in.pointattributelist = (REAL *) NULL;
-	in.pointmarkerlist    = (int *) NULL;
-
-	if ( strstr( Options,"r" ) ) {
-		int    *TriTable;
-		TriTable = (int *) malloc( NumNodes * sizeof( int ) );
-		for ( i = 0,N = 0; i < NumNodes; i++ )
-		{
-			if ( Node[i].used ) {
-				TriTable[i] = N;
-				N++;
-			}
-		}
-		in.numberoftriangles          = NumTris[0];
-		in.numberofcorners            = 3;
-		in.numberoftriangleattributes = 0;
-		in.trianglelist               = (int *) malloc( in.numberofcorners * in.numberoftriangles * sizeof( int ) );
-		in.triangleattributelist      = (REAL *) NULL;
-		in.trianglearealist           = (REAL *) NULL;
-		ptri = *inTri;
-		for ( i = 0; i < in.numberoftriangles; i++ )
-		{
-			in.trianglelist[i * in.numberofcorners  ] = TriTable[ptri[i].v[0]];
-			in.trianglelist[i * in.numberofcorners + 1] = TriTable[ptri[i].v[1]];
-			in.trianglelist[i * in.numberofcorners + 2] = TriTable[ptri[i].v[2]];
-		}
-		free( TriTable );
-	}
-	else
-	{
-		in.numberoftriangles          = 0;
-		in.numberofcorners            = 3;
-		in.numberoftriangleattributes = 0;
-		in.trianglelist               = (int *) NULL;
-		in.triangleattributelist      = (REAL *) NULL;
-		in.trianglearealist           = (REAL *) NULL;
-	}
-
-	in.numberofsegments   = 0;
-	in.segmentlist        = (int *) NULL;
-	in.segmentmarkerlist  = (int *) NULL;
-
-	in.numberofholes      = 0;
-	in.holelist           = (REAL *) NULL;
-
-	in.numberofregions    = 0;
-	in.regionlist         = (REAL *) NULL;
-
-	in.numberofedges      = 0;
-	in.edgelist           = (int *) NULL;
-	in.edgemarkerlist     = (int *) NULL;
-	in.normlist           = (REAL *) NULL;
-
-	/* Make necessary initializations */
-	out.pointlist          = (REAL *) NULL;  /* Not needed if -N switch used. */
-	out.pointattributelist = (REAL *) NULL;  /* Not needed if -N switch used or
-	                                            number of point attributes is zero: */
-	out.pointmarkerlist    = (int *) NULL;   /* Not needed if -N or -B switch used. */
-	out.trianglelist       = (int *) NULL;   /* Not needed if -E switch used. */
-	out.triangleattributelist = (REAL *) NULL;   /* Not needed if -E switch used or
-	                                                number of triangle attributes is
-	                                                zero: */
-	out.trianglearealist   = (REAL *) NULL;
-	out.neighborlist       = (int *) NULL;   /* Needed only if -n switch used. */
-	out.segmentlist        = (int *) NULL;   /* Needed only if segments are output
-	                                            (-p or -c) and -P not used: */
-	out.segmentmarkerlist  = (int *) NULL;   /* Needed only if segments are output
-	                                            (-p or -c) and -P and -B not used: */
-	out.edgelist           = (int *) NULL;   /* Needed only if -e switch used. */
-	out.edgemarkerlist     = (int *) NULL;   /* Needed if -e used and -B not used. */
-
-	triangulate( (char *) Options, &in, &out, NULL );
-
-	NumTris[0] = out.numberoftriangles;
-	*Tri = (TRI *) malloc( NumTris[0] * sizeof( TRI ) );
-	ptri = *Tri;
-
-	for ( i = 0; i < NumTris[0]; i++ )
-	{
-		ptri[i].v[0] = NodeTable[out.trianglelist[i * out.numberofcorners  ]];
-		ptri[i].v[1] = NodeTable[out.trianglelist[i * out.numberofcorners + 1]];
-		ptri[i].v[2] = NodeTable[out.trianglelist[i * out.numberofcorners + 2]];
-		ptri[i].n[0] = out.neighborlist[i * 3  ];
-		ptri[i].n[1] = out.neighborlist[i * 3 + 1];
-		ptri[i].n[2] = out.neighborlist[i * 3 + 2];
-	}
-
-	/* Free all allocated arrays, including those allocated by Triangle. */
-	if ( in.pointlist ) {
-		free( in.pointlist );
-	}
-	if ( in.pointattributelist ) {
-		free( in.pointattributelist );
-	}
-	if ( in.pointmarkerlist ) {
-		free( in.pointmarkerlist );
-	}
-	if ( in.trianglelist ) {
-		free( in.trianglelist );
-	}
-	if ( in.triangleattributelist ) {
-		free( in.triangleattributelist );
-	}
-	if ( in.trianglearealist ) {
-		free( in.trianglearealist );
-	}
-	if ( in.neighborlist ) {
-		free( in.neighborlist );
-	}
-	if ( in.segmentlist ) {
-		free( in.segmentlist );
-	}
-	if ( in.segmentmarkerlist ) {
-		free( in.segmentmarkerlist );
-	}
-	if ( in.holelist ) {
-		free( in.holelist );
-	}
-	if ( in.regionlist ) {
-		free( in.regionlist );
-	}
-	if ( in.edgelist ) {
-		free( in.edgelist );
-	}
-	if ( in.edgemarkerlist ) {
-		free( in.edgemarkerlist );
-	}
-	if ( in.normlist ) {
-		free( in.normlist );
-	}
-	if ( out.pointlist ) {
-		free( out.pointlist );
-	}
-	if ( out.pointattributelist ) {
-		free( out.pointattributelist );
-	}
-	if ( out.pointmarkerlist ) {
-		free( out.pointmarkerlist );
-	}
-	if ( out.trianglelist ) {
-		free( out.trianglelist );
-	}
-	if ( out.triangleattributelist ) {
-		free( out.triangleattributelist );
-	}
-	if ( out.trianglearealist ) {
-		free( out.trianglearealist );
-	}
-	if ( out.neighborlist ) {
-		free( out.neighborlist );
-	}
-	if ( out.segmentlist ) {
-		free( out.segmentlist );
-	}
-	if ( out.segmentmarkerlist ) {
-		free( out.segmentmarkerlist );
-	}
-	if ( out.holelist ) {
-		free( out.holelist );
-	}
-	if ( out.regionlist ) {
-		free( out.regionlist );
-	}
-	if ( out.edgelist ) {
-		free( out.edgelist );
-	}
-	if ( out.edgemarkerlist ) {
-		free( out.edgemarkerlist );
-	}
-	if ( out.normlist ) {
-		free( out.normlist );
-	}
-
-	free( NodeTable );
-	return 0;
-}
-
 void EdgeOnSide( int *v, int *edge, int *border ){
 	int R;
 	int k0, k1, N;
@@ -744,17 +749,6 @@ int Bisect( NODE *node, int border, int j0, int j1 ){
 	}
 	return( ( ( k != j0 ) && ( k != j1 ) ) ? k : 0 );
 }
-//=================================================================
-int compare( TRITABLE *t1, TRITABLE *t2 ){
-	if ( t1->error > t2->error ) {
-		return -1;
-	}
-	if ( t1->error < t2->error ) {
-		return 1;
-	}
-	return 0;
-}
-
 void MakeBrushes( int NumTris, NODE *Node, TRI *Tri,bool surf,
 				  int offset,char *texture0, char *texture1, char *texture2 ){
 	extern double backface;
@@ -1392,37 +1386,3 @@ void MapOut( int NumNodes,int NumTris, NODE *Node, TRI *Tri ){
 	   SetCursor(ghCursorCurrent);
 	 */
 }
-//===========================================================================
-int CheckBorders( int *NumNodesUsed, int NumNodes, NODE *Node, int *NumTris, TRI **pTri ){
-	int border;
-	int i, j, k0, k1, N;
-	float angle[3];
-	TRI *Tri;
-
-	N = NumNodesUsed[0];
-	Tri = *pTri;
-	for ( i = 0; i < NumTris[0]; i++ )
-	{
-		EdgeOnSide( Tri[i].v,&k0,&border );
-		if ( border < 0 ) {
-			continue;
-		}
-		CalcAngles( Node, Tri[i].v, angle );
-		k1 = ( k0 + 1 ) % 3;
-		if ( ( angle[k0] < SLIVER_ANGLE ) || ( angle[k1] < SLIVER_ANGLE ) ) {
-			j = Bisect( Node, border, Tri[i].v[k0], Tri[i].v[k1] );
-			if ( j >= 0 ) {
-				if ( !Node[j].used ) {  // Shouldn't be used, but...
-					NumNodesUsed[0]++;
-					Node[j].used++;
-				}
-			}
-		}
-	}
-	if ( NumNodesUsed[0] > N ) {
-		free( *pTri );
-		tricall( NumNodes, Node, NumTris, NULL, pTri, "cnzBNPY" );
-		Tri = *pTri;
-	}
-	return ( NumNodesUsed[0] - N );
-}
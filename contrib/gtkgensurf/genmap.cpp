@@ -20,6 +20,7 @@
 #include <math.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <vector>
 #include "gensurf.h"
 
 double xmin,xmax,ymin,ymax,zmin,zmax;
@@ -31,6 +32,20 @@ int contents;
 int surface[3];
 LPVOID h_func_group;
 LPVOID terrainkey;  // ^Fishman - Add terrain key to func_group.
+static std::vector<LPVOID> MapUpdateGroups; // func_groups committed since BeginMapUpdate
+
+// TriangleFromPoint lookup: lists of gTri triangles in a grid of x/y cells, built on first use
+static int *TriGridStart = NULL;        // cell c has TriGridTris[TriGridStart[c]] .. [TriGridStart[c + 1] - 1]
+static int *TriGridTris  = NULL;
+static int TriGridSize;
+static double TriGridMin[2], TriGridCell[2];
+
+static void FreeTriangleGrid(){
+	free( TriGridStart );
+	free( TriGridTris );
+	TriGridStart = NULL;
+	TriGridTris  = NULL;
+}
 
 //=============================================================
 // Hydra : snap-to-grid begin
@@ -271,389 +286,492 @@ int MapPatches(){
 }
 
 //=============================================================
-void MapBrushes(){
-	char hint[128];
-	char skip[128];
-	char sidetext[64];
-	char surftext[64];
-	char surftext2[64];
-	char surft[64];
-	float Steep;
-	vec3_t PlaneNormal,SurfNormal;
-	vec3_t t[2];
-	int i, j, k;
-	int surf;
-	bool CheckAngle;
-	BRUSH brush;
-	XYZ v[8];
+// rows of a surface are worked on by a thread pool, the calling thread gets every row
+// back in order as soon as it and the rows before it are finished
+// only ROWS_AHEAD rows are handed out past the one the caller waits on, so a big surface
+// never has all of its brushes in memory at once
+#define ROWS_AHEAD 16
+
+typedef void ( *RowFunc )( int i, void *data );
+
+typedef struct
+{
+	RowFunc func;
+	void *data;
+	GAsyncQueue *finished;
+} rowPool_t;
+
+static void Row_Thread( gpointer row, gpointer user_data ){
+	rowPool_t *rp = (rowPool_t *)user_data;
+
+	rp->func( GPOINTER_TO_INT( row ) - 1, rp->data );
+	g_async_queue_push( rp->finished, row );
+}
 
-	strcpy( surftext,Texture[Game][0] );
-	strcpy( sidetext,( strlen( Texture[Game][1] ) ? Texture[Game][1] : Texture[Game][0] ) );
-	strcpy( surftext2,( strlen( Texture[Game][2] ) ? Texture[Game][2] : Texture[Game][0] ) );
+// func runs on the pool for rows first .. last - 1, done runs on the calling thread
+static void RunRows( int first, int last, RowFunc func, RowFunc done, void *data ){
+	std::vector<bool> ready;
+	GThreadPool *pool;
+	rowPool_t rp;
+	int i, next, nThreads;
 
-	// if surftext2 is identical to surftext, there's no need to
-	// check surface angle
-	if ( !g_ascii_strcasecmp( surftext,surftext2 ) ) {
-		CheckAngle = FALSE;
+	if ( first >= last ) {
+		return;
 	}
-	else
+
+#if GLIB_CHECK_VERSION( 2, 36, 0 )
+	nThreads = g_get_num_processors();
+#else
+	nThreads = 2;
+#endif
+	rp.func = func;
+	rp.data = data;
+	rp.finished = g_async_queue_new();
+	pool = ( last - first > 1 ) ? g_thread_pool_new( Row_Thread, &rp, nThreads, TRUE, NULL ) : NULL;
+	if ( !pool ) {
+		for ( i = first; i < last; i++ )
+		{
+			func( i, data );
+			if ( done ) {
+				done( i, data );
+			}
+		}
+		g_async_queue_unref( rp.finished );
+		return;
+	}
+
+	ready.assign( last - first, false );
+	next = first;
+	for ( i = first; i < last; i++ )
 	{
-		CheckAngle = TRUE;
-		Steep = (float)cos( (double)SlantAngle / 57.2957795 );
-		switch ( Plane )
+		while ( next < last && ( !done || next - i < ROWS_AHEAD ) )
 		{
-		case PLANE_XY0: PlaneNormal[0] = 0.; PlaneNormal[1] = 0.; PlaneNormal[2] = 1.; break;
-		case PLANE_XY1: PlaneNormal[0] = 0.; PlaneNormal[1] = 0.; PlaneNormal[2] = -1.; break;
-		case PLANE_XZ0: PlaneNormal[0] = 0.; PlaneNormal[1] = 1.; PlaneNormal[2] = 1.; break;
-		case PLANE_XZ1: PlaneNormal[0] = 0.; PlaneNormal[1] = -1.; PlaneNormal[2] = 1.; break;
-		case PLANE_YZ0: PlaneNormal[0] = 1.; PlaneNormal[1] = 0.; PlaneNormal[2] = 1.; break;
-		case PLANE_YZ1: PlaneNormal[0] = -1.; PlaneNormal[1] = 0.; PlaneNormal[2] = 1.; break;
+			g_thread_pool_push( pool, GINT_TO_POINTER( next + 1 ), NULL );
+			next++;
+		}
+		while ( !ready[i - first] )
+			ready[GPOINTER_TO_INT( g_async_queue_pop( rp.finished ) ) - 1 - first] = true;
+		if ( done ) {
+			done( i, data );
 		}
 	}
 
-	OpenFuncGroup();
+	g_thread_pool_free( pool, FALSE, TRUE );
+	g_async_queue_unref( rp.finished );
+}
+
+//=============================================================
+typedef struct
+{
+	char sidetext[64];
+	char surftext[64];
+	char surftext2[64];
+	float Steep;
+	vec3_t PlaneNormal;
+	bool CheckAngle;
+	std::vector< std::vector<BRUSH> > rows;
+} surfaceBrushes_t;
+
+// the two brushes of every grid square in row i, only reads xyz and the settings
+static void SurfaceBrushRow( int i, void *data ){
+	surfaceBrushes_t *sb = (surfaceBrushes_t *)data;
+	std::vector<BRUSH> &row = sb->rows[i];
+	char surft[64];
+	vec3_t SurfNormal;
+	vec3_t t[2];
+	int j;
+	int surf;
+	BRUSH brush;
+	XYZ v[8];
 
-	for ( i = 0; i < NH; i++ )
+	row.reserve( NV * 2 );
+	for ( j = 0; j < NV; j++ )
 	{
-		for ( j = 0; j < NV; j++ )
-		{
-			if ( ( i + j ) % 2 ) {
-				VectorCopy( xyz[i  ][j  ].p, v[0].p );
-				switch ( Plane )
-				{
-				case PLANE_XY1:
-				case PLANE_XZ1:
-				case PLANE_YZ1:
-					VectorCopy( xyz[i + 1][j  ].p, v[1].p );
-					VectorCopy( xyz[i + 1][j + 1].p, v[2].p );
-					break;
-				default:
-					VectorCopy( xyz[i + 1][j + 1].p, v[1].p );
-					VectorCopy( xyz[i + 1][j  ].p, v[2].p );
-				}
-			}
-			else
+		if ( ( i + j ) % 2 ) {
+			VectorCopy( xyz[i  ][j  ].p, v[0].p );
+			switch ( Plane )
 			{
-				VectorCopy( xyz[i  ][j  ].p, v[0].p );
-				switch ( Plane )
-				{
-				case PLANE_XY1:
-				case PLANE_XZ1:
-				case PLANE_YZ1:
-					VectorCopy( xyz[i + 1][j  ].p, v[1].p );
-					VectorCopy( xyz[i  ][j + 1].p, v[2].p );
-					break;
-				default:
-					VectorCopy( xyz[i  ][j + 1].p, v[1].p );
-					VectorCopy( xyz[i + 1][j  ].p, v[2].p );
-				}
+			case PLANE_XY1:
+			case PLANE_XZ1:
+			case PLANE_YZ1:
+				VectorCopy( xyz[i + 1][j  ].p, v[1].p );
+				VectorCopy( xyz[i + 1][j + 1].p, v[2].p );
+				break;
+			default:
+				VectorCopy( xyz[i + 1][j + 1].p, v[1].p );
+				VectorCopy( xyz[i + 1][j  ].p, v[2].p );
 			}
-			VectorCopy( v[0].p,v[3].p );
-			VectorCopy( v[1].p,v[4].p );
-			VectorCopy( v[2].p,v[5].p );
+		}
+		else
+		{
+			VectorCopy( xyz[i  ][j  ].p, v[0].p );
 			switch ( Plane )
 			{
-			case PLANE_XZ0:
+			case PLANE_XY1:
 			case PLANE_XZ1:
-				v[0].p[1] = backface;
-				v[1].p[1] = backface;
-				v[2].p[1] = backface;
-				break;
-			case PLANE_YZ0:
 			case PLANE_YZ1:
-				v[3].p[0] = backface;
-				v[4].p[0] = backface;
-				v[5].p[0] = backface;
+				VectorCopy( xyz[i + 1][j  ].p, v[1].p );
+				VectorCopy( xyz[i  ][j + 1].p, v[2].p );
 				break;
 			default:
-				v[3].p[2] = backface;
-				v[4].p[2] = backface;
-				v[5].p[2] = backface;
+				VectorCopy( xyz[i  ][j + 1].p, v[1].p );
+				VectorCopy( xyz[i + 1][j  ].p, v[2].p );
 			}
-
-			brush.Number   = i * NV * 2 + j * 2;
-			brush.NumFaces = 5;
-			XYZtoV( &v[0],&brush.face[0].v[0] );
-			XYZtoV( &v[3],&brush.face[0].v[1] );
-			XYZtoV( &v[4],&brush.face[0].v[2] );
-			strcpy( brush.face[0].texture,
-					( strlen( Texture[Game][1] ) ? Texture[Game][1] : Texture[Game][0] ) );
-			brush.face[0].Shift[0] = (float)TexOffset[0];
-			brush.face[0].Shift[1] = (float)TexOffset[1];
-			brush.face[0].Rotate   = 0.;
-			brush.face[0].Scale[0] = (float)TexScale[0];
-			brush.face[0].Scale[1] = (float)TexScale[1];
-			brush.face[0].Contents = contents;
-			brush.face[0].Surface  = surface[1];
-			brush.face[0].Value    = 0;
-
-			XYZtoV( &v[1],&brush.face[1].v[0] );
-			XYZtoV( &v[4],&brush.face[1].v[1] );
-			XYZtoV( &v[5],&brush.face[1].v[2] );
-			strcpy( brush.face[1].texture,
-					( strlen( Texture[Game][1] ) ? Texture[Game][1] : Texture[Game][0] ) );
-			brush.face[1].Shift[0] = (float)TexOffset[0];
-			brush.face[1].Shift[1] = (float)TexOffset[1];
-			brush.face[1].Rotate   = 0.;
-			brush.face[1].Scale[0] = (float)TexScale[0];
-			brush.face[1].Scale[1] = (float)TexScale[1];
-			brush.face[1].Contents = contents;
-			brush.face[1].Surface  = surface[1];
-			brush.face[1].Value    = 0;
-
-			XYZtoV( &v[2],&brush.face[2].v[0] );
-			XYZtoV( &v[5],&brush.face[2].v[1] );
-			XYZtoV( &v[3],&brush.face[2].v[2] );
-			strcpy( brush.face[2].texture,
-					( strlen( Texture[Game][1] ) ? Texture[Game][1] : Texture[Game][0] ) );
-			brush.face[2].Shift[0] = (float)TexOffset[0];
-			brush.face[2].Shift[1] = (float)TexOffset[1];
-			brush.face[2].Rotate   = 0.;
-			brush.face[2].Scale[0] = (float)TexScale[0];
-			brush.face[2].Scale[1] = (float)TexScale[1];
-			brush.face[2].Contents = contents;
-			brush.face[2].Surface  = surface[1];
-			brush.face[2].Value    = 0;
-
-			if ( CheckAngle && ( Plane == PLANE_XZ0 || Plane == PLANE_XZ1 ) ) {
-				XYZVectorSubtract( v[4].p,v[3].p,t[0] );
-				XYZVectorSubtract( v[5].p,v[4].p,t[1] );
+		}
+		VectorCopy( v[0].p,v[3].p );
+		VectorCopy( v[1].p,v[4].p );
+		VectorCopy( v[2].p,v[5].p );
+		switch ( Plane )
+		{
+		case PLANE_XZ0:
+		case PLANE_XZ1:
+			v[0].p[1] = backface;
+			v[1].p[1] = backface;
+			v[2].p[1] = backface;
+			break;
+		case PLANE_YZ0:
+		case PLANE_YZ1:
+			v[3].p[0] = backface;
+			v[4].p[0] = backface;
+			v[5].p[0] = backface;
+			break;
+		default:
+			v[3].p[2] = backface;
+			v[4].p[2] = backface;
+			v[5].p[2] = backface;
+		}
+
+		brush.Number   = i * NV * 2 + j * 2;
+		brush.NumFaces = 5;
+		XYZtoV( &v[0],&brush.face[0].v[0] );
+		XYZtoV( &v[3],&brush.face[0].v[1] );
+		XYZtoV( &v[4],&brush.face[0].v[2] );
+		strcpy( brush.face[0].texture,
+				( strlen( Texture[Game][1] ) ? Texture[Game][1] : Texture[Game][0] ) );
+		brush.face[0].Shift[0] = (float)TexOffset[0];
+		brush.face[0].Shift[1] = (float)TexOffset[1];
+		brush.face[0].Rotate   = 0.;
+		brush.face[0].Scale[0] = (float)TexScale[0];
+		brush.face[0].Scale[1] = (float)TexScale[1];
+		brush.face[0].Contents = contents;
+		brush.face[0].Surface  = surface[1];
+		brush.face[0].Value    = 0;
+
+		XYZtoV( &v[1],&brush.face[1].v[0] );
+		XYZtoV( &v[4],&brush.face[1].v[1] );
+		XYZtoV( &v[5],&brush.face[1].v[2] );
+		strcpy( brush.face[1].texture,
+				( strlen( Texture[Game][1] ) ? Texture[Game][1] : Texture[Game][0] ) );
+		brush.face[1].Shift[0] = (float)TexOffset[0];
+		brush.face[1].Shift[1] = (float)TexOffset[1];
+		brush.face[1].Rotate   = 0.;
+		brush.face[1].Scale[0] = (float)TexScale[0];
+		brush.face[1].Scale[1] = (float)TexScale[1];
+		brush.face[1].Contents = contents;
+		brush.face[1].Surface  = surface[1];
+		brush.face[1].Value    = 0;
+
+		XYZtoV( &v[2],&brush.face[2].v[0] );
+		XYZtoV( &v[5],&brush.face[2].v[1] );
+		XYZtoV( &v[3],&brush.face[2].v[2] );
+		strcpy( brush.face[2].texture,
+				( strlen( Texture[Game][1] ) ? Texture[Game][1] : Texture[Game][0] ) );
+		brush.face[2].Shift[0] = (float)TexOffset[0];
+		brush.face[2].Shift[1] = (float)TexOffset[1];
+		brush.face[2].Rotate   = 0.;
+		brush.face[2].Scale[0] = (float)TexScale[0];
+		brush.face[2].Scale[1] = (float)TexScale[1];
+		brush.face[2].Contents = contents;
+		brush.face[2].Surface  = surface[1];
+		brush.face[2].Value    = 0;
+
+		if ( sb->CheckAngle && ( Plane == PLANE_XZ0 || Plane == PLANE_XZ1 ) ) {
+			XYZVectorSubtract( v[4].p,v[3].p,t[0] );
+			XYZVectorSubtract( v[5].p,v[4].p,t[1] );
                 genSurfCrossProduct( t[0],t[1],SurfNormal );
-				VectorNormalize( SurfNormal,SurfNormal );
-				if ( DotProduct( SurfNormal,PlaneNormal ) < Steep ) {
-					strcpy( surft,surftext2 );
-					surf = surface[2];
-				}
-				else
-				{
-					strcpy( surft,surftext );
-					surf = surface[0];
-				}
+			VectorNormalize( SurfNormal,SurfNormal );
+			if ( DotProduct( SurfNormal,sb->PlaneNormal ) < sb->Steep ) {
+				strcpy( surft,sb->surftext2 );
+				surf = surface[2];
 			}
 			else
 			{
-				strcpy( surft,surftext );
+				strcpy( surft,sb->surftext );
 				surf = surface[0];
 			}
-
-			XYZtoV( &v[3],&brush.face[3].v[0] );
-			XYZtoV( &v[5],&brush.face[3].v[1] );
-			XYZtoV( &v[4],&brush.face[3].v[2] );
-			strcpy( brush.face[3].texture,
-					( Plane == PLANE_XZ0 || Plane == PLANE_XZ1 ? surft : sidetext ) );
-			brush.face[3].Shift[0] = (float)TexOffset[0];
-			brush.face[3].Shift[1] = (float)TexOffset[1];
-			brush.face[3].Rotate   = 0.;
-			brush.face[3].Scale[0] = (float)TexScale[0];
-			brush.face[3].Scale[1] = (float)TexScale[1];
-			brush.face[3].Contents = contents;
-			brush.face[3].Surface  = ( Plane == PLANE_XZ0 || Plane == PLANE_XZ1 ? surf : surface[1] );
-			brush.face[3].Value    = ( Plane == PLANE_XZ0 || Plane == PLANE_XZ1 ? ArghRad2 : 0 );
-
-			if ( CheckAngle && Plane != PLANE_XZ0 && Plane != PLANE_XZ1 ) {
-				XYZVectorSubtract( v[2].p,v[0].p,t[0] );
-				XYZVectorSubtract( v[1].p,v[2].p,t[1] );
+		}
+		else
+		{
+			strcpy( surft,sb->surftext );
+			surf = surface[0];
+		}
+
+		XYZtoV( &v[3],&brush.face[3].v[0] );
+		XYZtoV( &v[5],&brush.face[3].v[1] );
+		XYZtoV( &v[4],&brush.face[3].v[2] );
+		strcpy( brush.face[3].texture,
+				( Plane == PLANE_XZ0 || Plane == PLANE_XZ1 ? surft : sb->sidetext ) );
+		brush.face[3].Shift[0] = (float)TexOffset[0];
+		brush.face[3].Shift[1] = (float)TexOffset[1];
+		brush.face[3].Rotate   = 0.;
+		brush.face[3].Scale[0] = (float)TexScale[0];
+		brush.face[3].Scale[1] = (float)TexScale[1];
+		brush.face[3].Contents = contents;
+		brush.face[3].Surface  = ( Plane == PLANE_XZ0 || Plane == PLANE_XZ1 ? surf : surface[1] );
+		brush.face[3].Value    = ( Plane == PLANE_XZ0 || Plane == PLANE_XZ1 ? ArghRad2 : 0 );
+
+		if ( sb->CheckAngle && Plane != PLANE_XZ0 && Plane != PLANE_XZ1 ) {
+			XYZVectorSubtract( v[2].p,v[0].p,t[0] );
+			XYZVectorSubtract( v[1].p,v[2].p,t[1] );
                 genSurfCrossProduct( t[0],t[1],SurfNormal );
-				VectorNormalize( SurfNormal,SurfNormal );
-				if ( DotProduct( SurfNormal,PlaneNormal ) < Steep ) {
-					strcpy( surft,surftext2 );
-					surf = surface[2];
-				}
-				else
-				{
-					strcpy( surft,surftext );
-					surf = surface[0];
-				}
+			VectorNormalize( SurfNormal,SurfNormal );
+			if ( DotProduct( SurfNormal,sb->PlaneNormal ) < sb->Steep ) {
+				strcpy( surft,sb->surftext2 );
+				surf = surface[2];
 			}
 			else
 			{
-				strcpy( surft,surftext );
+				strcpy( surft,sb->surftext );
 				surf = surface[0];
 			}
-
-			XYZtoV( &v[0],&brush.face[4].v[0] );
-			XYZtoV( &v[1],&brush.face[4].v[1] );
-			XYZtoV( &v[2],&brush.face[4].v[2] );
-			strcpy( brush.face[4].texture,
-					( Plane == PLANE_XZ0 || Plane == PLANE_XZ1 ? sidetext : surft ) );
-			brush.face[4].Shift[0] = (float)TexOffset[0];
-			brush.face[4].Shift[1] = (float)TexOffset[1];
-			brush.face[4].Rotate   = 0.;
-			brush.face[4].Scale[0] = (float)TexScale[0];
-			brush.face[4].Scale[1] = (float)TexScale[1];
-			brush.face[4].Contents = contents;
-			brush.face[4].Surface  = ( Plane == PLANE_XZ0 || Plane == PLANE_XZ1 ? surface[1] : surf );
-			brush.face[4].Value    = ( Plane == PLANE_XZ0 || Plane == PLANE_XZ1 ? 0 : ArghRad2 );
-
-			MakeBrush( &brush );
-			if ( ( i + j ) % 2 ) {
-				VectorCopy( xyz[i  ][j + 1].p,v[0].p );
-				switch ( Plane )
-				{
-				case PLANE_XY1:
-				case PLANE_XZ1:
-				case PLANE_YZ1:
-					VectorCopy( xyz[i  ][j  ].p,v[1].p );
-					VectorCopy( xyz[i + 1][j + 1].p,v[2].p );
-					break;
-				default:
-					VectorCopy( xyz[i + 1][j + 1].p,v[1].p );
-					VectorCopy( xyz[i  ][j  ].p,v[2].p );
-				}
-			}
-			else
+		}
+		else
+		{
+			strcpy( surft,sb->surftext );
+			surf = surface[0];
+		}
+
+		XYZtoV( &v[0],&brush.face[4].v[0] );
+		XYZtoV( &v[1],&brush.face[4].v[1] );
+		XYZtoV( &v[2],&brush.face[4].v[2] );
+		strcpy( brush.face[4].texture,
+				( Plane == PLANE_XZ0 || Plane == PLANE_XZ1 ? sb->sidetext : surft ) );
+		brush.face[4].Shift[0] = (float)TexOffset[0];
+		brush.face[4].Shift[1] = (float)TexOffset[1];
+		brush.face[4].Rotate   = 0.;
+		brush.face[4].Scale[0] = (float)TexScale[0];
+		brush.face[4].Scale[1] = (float)TexScale[1];
+		brush.face[4].Contents = contents;
+		brush.face[4].Surface  = ( Plane == PLANE_XZ0 || Plane == PLANE_XZ1 ? surface[1] : surf );
+		brush.face[4].Value    = ( Plane == PLANE_XZ0 || Plane == PLANE_XZ1 ? 0 : ArghRad2 );
+
+		row.push_back( brush );
+		if ( ( i + j ) % 2 ) {
+			VectorCopy( xyz[i  ][j + 1].p,v[0].p );
+			switch ( Plane )
 			{
-				VectorCopy( xyz[i  ][j + 1].p,v[0].p );
-				switch ( Plane )
-				{
-				case PLANE_XY1:
-				case PLANE_XZ1:
-				case PLANE_YZ1:
-					VectorCopy( xyz[i + 1][j  ].p,v[1].p );
-					VectorCopy( xyz[i + 1][j + 1].p,v[2].p );
-					break;
-				default:
-					VectorCopy( xyz[i + 1][j + 1].p,v[1].p );
-					VectorCopy( xyz[i + 1][j  ].p,v[2].p );
-				}
+			case PLANE_XY1:
+			case PLANE_XZ1:
+			case PLANE_YZ1:
+				VectorCopy( xyz[i  ][j  ].p,v[1].p );
+				VectorCopy( xyz[i + 1][j + 1].p,v[2].p );
+				break;
+			default:
+				VectorCopy( xyz[i + 1][j + 1].p,v[1].p );
+				VectorCopy( xyz[i  ][j  ].p,v[2].p );
 			}
-			VectorCopy( v[0].p,v[3].p );
-			VectorCopy( v[1].p,v[4].p );
-			VectorCopy( v[2].p,v[5].p );
+		}
+		else
+		{
+			VectorCopy( xyz[i  ][j + 1].p,v[0].p );
 			switch ( Plane )
 			{
-			case PLANE_XZ0:
+			case PLANE_XY1:
 			case PLANE_XZ1:
-				v[0].p[1] = backface;
-				v[1].p[1] = backface;
-				v[2].p[1] = backface;
-				break;
-			case PLANE_YZ0:
 			case PLANE_YZ1:
-				v[3].p[0] = backface;
-				v[4].p[0] = backface;
-				v[5].p[0] = backface;
+				VectorCopy( xyz[i + 1][j  ].p,v[1].p );
+				VectorCopy( xyz[i + 1][j + 1].p,v[2].p );
 				break;
 			default:
-				v[3].p[2] = backface;
-				v[4].p[2] = backface;
-				v[5].p[2] = backface;
+				VectorCopy( xyz[i + 1][j + 1].p,v[1].p );
+				VectorCopy( xyz[i + 1][j  ].p,v[2].p );
 			}
-			brush.Number   = i * NV * 2 + j * 2 + 1;
-			brush.NumFaces = 5;
-			XYZtoV( &v[0],&brush.face[0].v[0] );
-			XYZtoV( &v[3],&brush.face[0].v[1] );
-			XYZtoV( &v[4],&brush.face[0].v[2] );
-			strcpy( brush.face[0].texture,
-					( strlen( Texture[Game][1] ) ? Texture[Game][1] : Texture[Game][0] ) );
-			brush.face[0].Shift[0] = (float)TexOffset[0];
-			brush.face[0].Shift[1] = (float)TexOffset[1];
-			brush.face[0].Rotate   = 0.;
-			brush.face[0].Scale[0] = (float)TexScale[0];
-			brush.face[0].Scale[1] = (float)TexScale[1];
-			brush.face[0].Contents = contents;
-			brush.face[0].Surface  = surface[1];
-			brush.face[0].Value    = 0;
-
-			XYZtoV( &v[1],&brush.face[1].v[0] );
-			XYZtoV( &v[4],&brush.face[1].v[1] );
-			XYZtoV( &v[5],&brush.face[1].v[2] );
-			strcpy( brush.face[1].texture,
-					( strlen( Texture[Game][1] ) ? Texture[Game][1] : Texture[Game][0] ) );
-			brush.face[1].Shift[0] = (float)TexOffset[0];
-			brush.face[1].Shift[1] = (float)TexOffset[1];
-			brush.face[1].Rotate   = 0.;
-			brush.face[1].Scale[0] = (float)TexScale[0];
-			brush.face[1].Scale[1] = (float)TexScale[1];
-			brush.face[1].Contents = contents;
-			brush.face[1].Surface  = surface[1];
-			brush.face[1].Value    = 0;
-
-			XYZtoV( &v[2],&brush.face[2].v[0] );
-			XYZtoV( &v[5],&brush.face[2].v[1] );
-			XYZtoV( &v[3],&brush.face[2].v[2] );
-			strcpy( brush.face[2].texture,
-					( strlen( Texture[Game][1] ) ? Texture[Game][1] : Texture[Game][0] ) );
-			brush.face[2].Shift[0] = (float)TexOffset[0];
-			brush.face[2].Shift[1] = (float)TexOffset[1];
-			brush.face[2].Rotate   = 0.;
-			brush.face[2].Scale[0] = (float)TexScale[0];
-			brush.face[2].Scale[1] = (float)TexScale[1];
-			brush.face[2].Contents = contents;
-			brush.face[2].Surface  = surface[1];
-			brush.face[2].Value    = 0;
-
-			if ( CheckAngle && ( Plane == PLANE_XZ0 || Plane == PLANE_XZ1 ) ) {
-				XYZVectorSubtract( v[4].p,v[3].p,t[0] );
-				XYZVectorSubtract( v[5].p,v[4].p,t[1] );
+		}
+		VectorCopy( v[0].p,v[3].p );
+		VectorCopy( v[1].p,v[4].p );
+		VectorCopy( v[2].p,v[5].p );
+		switch ( Plane )
+		{
+		case PLANE_XZ0:
+		case PLANE_XZ1:
+			v[0].p[1] = backface;
+			v[1].p[1] = backface;
+			v[2].p[1] = backface;
+			break;
+		case PLANE_YZ0:
+		case PLANE_YZ1:
+			v[3].p[0] = backface;
+			v[4].p[0] = backface;
+			v[5].p[0] = backface;
+			break;
+		default:
+			v[3].p[2] = backface;
+			v[4].p[2] = backface;
+			v[5].p[2] = backface;
+		}
+		brush.Number   = i * NV * 2 + j * 2 + 1;
+		brush.NumFaces = 5;
+		XYZtoV( &v[0],&brush.face[0].v[0] );
+		XYZtoV( &v[3],&brush.face[0].v[1] );
+		XYZtoV( &v[4],&brush.face[0].v[2] );
+		strcpy( brush.face[0].texture,
+				( strlen( Texture[Game][1] ) ? Texture[Game][1] : Texture[Game][0] ) );
+		brush.face[0].Shift[0] = (float)TexOffset[0];
+		brush.face[0].Shift[1] = (float)TexOffset[1];
+		brush.face[0].Rotate   = 0.;
+		brush.face[0].Scale[0] = (float)TexScale[0];
+		brush.face[0].Scale[1] = (float)TexScale[1];
+		brush.face[0].Contents = contents;
+		brush.face[0].Surface  = surface[1];
+		brush.face[0].Value    = 0;
+
+		XYZtoV( &v[1],&brush.face[1].v[0] );
+		XYZtoV( &v[4],&brush.face[1].v[1] );
+		XYZtoV( &v[5],&brush.face[1].v[2] );
+		strcpy( brush.face[1].texture,
+				( strlen( Texture[Game][1] ) ? Texture[Game][1] : Texture[Game][0] ) );
+		brush.face[1].Shift[0] = (float)TexOffset[0];
+		brush.face[1].Shift[1] = (float)TexOffset[1];
+		brush.face[1].Rotate   = 0.;
+		brush.face[1].Scale[0] = (float)TexScale[0];
+		brush.face[1].Scale[1] = (float)TexScale[1];
+		brush.face[1].Contents = contents;
+		brush.face[1].Surface  = surface[1];
+		brush.face[1].Value    = 0;
+
+		XYZtoV( &v[2],&brush.face[2].v[0] );
+		XYZtoV( &v[5],&brush.face[2].v[1] );
+		XYZtoV( &v[3],&brush.face[2].v[2] );
+		strcpy( brush.face[2].texture,
+				( strlen( Texture[Game][1] ) ? Texture[Game][1] : Texture[Game][0] ) );
+		brush.face[2].Shift[0] = (float)TexOffset[0];
+		brush.face[2].Shift[1] = (float)TexOffset[1];
+		brush.face[2].Rotate   = 0.;
+		brush.face[2].Scale[0] = (float)TexScale[0];
+		brush.face[2].Scale[1] = (float)TexScale[1];
+		brush.face[2].Contents = contents;
+		brush.face[2].Surface  = surface[1];
+		brush.face[2].Value    = 0;
+
+		if ( sb->CheckAngle && ( Plane == PLANE_XZ0 || Plane == PLANE_XZ1 ) ) {
+			XYZVectorSubtract( v[4].p,v[3].p,t[0] );
+			XYZVectorSubtract( v[5].p,v[4].p,t[1] );
                 genSurfCrossProduct( t[0],t[1],SurfNormal );
-				VectorNormalize( SurfNormal,SurfNormal );
-				if ( DotProduct( SurfNormal,PlaneNormal ) < Steep ) {
-					strcpy( surft,surftext2 );
-					surf = surface[2];
-				}
-				else
-				{
-					strcpy( surft,surftext );
-					surf = surface[0];
-				}
+			VectorNormalize( SurfNormal,SurfNormal );
+			if ( DotProduct( SurfNormal,sb->PlaneNormal ) < sb->Steep ) {
+				strcpy( surft,sb->surftext2 );
+				surf = surface[2];
 			}
 			else
 			{
-				strcpy( surft,surftext );
+				strcpy( surft,sb->surftext );
 				surf = surface[0];
 			}
-			XYZtoV( &v[3],&brush.face[3].v[0] );
-			XYZtoV( &v[5],&brush.face[3].v[1] );
-			XYZtoV( &v[4],&brush.face[3].v[2] );
-			strcpy( brush.face[3].texture,
-					( Plane == PLANE_XZ0 || Plane == PLANE_XZ1 ? surft : sidetext ) );
-			brush.face[3].Shift[0] = (float)TexOffset[0];
-			brush.face[3].Shift[1] = (float)TexOffset[1];
-			brush.face[3].Rotate   = 0.;
-			brush.face[3].Scale[0] = (float)TexScale[0];
-			brush.face[3].Scale[1] = (float)TexScale[1];
-			brush.face[3].Contents = contents;
-			brush.face[3].Surface  = ( Plane == PLANE_XZ0 || Plane == PLANE_XZ1 ? surf : surface[1] );
-			brush.face[3].Value    = ( Plane == PLANE_XZ0 || Plane == PLANE_XZ1 ? ArghRad2 : 0 );
-
-			if ( CheckAngle && Plane != PLANE_XZ0 && Plane != PLANE_XZ1 ) {
-				XYZVectorSubtract( v[2].p,v[0].p,t[0] );
-				XYZVectorSubtract( v[1].p,v[2].p,t[1] );
+		}
+		else
+		{
+			strcpy( surft,sb->surftext );
+			surf = surface[0];
+		}
+		XYZtoV( &v[3],&brush.face[3].v[0] );
+		XYZtoV( &v[5],&brush.face[3].v[1] );
+		XYZtoV( &v[4],&brush.face[3].v[2] );
+		strcpy( brush.face[3].texture,
+				( Plane == PLANE_XZ0 || Plane == PLANE_XZ1 ? surft : sb->sidetext ) );
+		brush.face[3].Shift[0] = (float)TexOffset[0];
+		brush.face[3].Shift[1] = (float)TexOffset[1];
+		brush.face[3].Rotate   = 0.;
+		brush.face[3].Scale[0] = (float)TexScale[0];
+		brush.face[3].Scale[1] = (float)TexScale[1];
+		brush.face[3].Contents = contents;
+		brush.face[3].Surface  = ( Plane == PLANE_XZ0 || Plane == PLANE_XZ1 ? surf : surface[1] );
+		brush.face[3].Value    = ( Plane == PLANE_XZ0 || Plane == PLANE_XZ1 ? ArghRad2 : 0 );
+
+		if ( sb->CheckAngle && Plane != PLANE_XZ0 && Plane != PLANE_XZ1 ) {
+			XYZVectorSubtract( v[2].p,v[0].p,t[0] );
+			XYZVectorSubtract( v[1].p,v[2].p,t[1] );
                 genSurfCrossProduct( t[0],t[1],SurfNormal );
-				VectorNormalize( SurfNormal,SurfNormal );
-				if ( DotProduct( SurfNormal,PlaneNormal ) < Steep ) {
-					strcpy( surft,surftext2 );
-					surf = surface[2];
-				}
-				else
-				{
-					strcpy( surft,surftext );
-					surf = surface[0];
-				}
+			VectorNormalize( SurfNormal,SurfNormal );
+			if ( DotProduct( SurfNormal,sb->PlaneNormal ) < sb->Steep ) {
+				strcpy( surft,sb->surftext2 );
+				surf = surface[2];
 			}
 			else
 			{
-				strcpy( surft,surftext );
+				strcpy( surft,sb->surftext );
 				surf = surface[0];
 			}
-			XYZtoV( &v[0],&brush.face[4].v[0] );
-			XYZtoV( &v[1],&brush.face[4].v[1] );
-			XYZtoV( &v[2],&brush.face[4].v[2] );
-			strcpy( brush.face[4].texture,
-					( Plane == PLANE_XZ0 || Plane == PLANE_XZ1 ? sidetext : surft ) );
-			brush.face[4].Shift[0] = (float)TexOffset[0];
-			brush.face[4].Shift[1] = (float)TexOffset[1];
-			brush.face[4].Rotate   = 0.;
-			brush.face[4].Scale[0] = (float)TexScale[0];
-			brush.face[4].Scale[1] = (float)TexScale[1];
-			brush.face[4].Contents = contents;
-			brush.face[4].Surface  = ( Plane == PLANE_XZ0 || Plane == PLANE_XZ1 ? surface[1] : surf );
-			brush.face[4].Value    = ( Plane == PLANE_XZ0 || Plane == PLANE_XZ1 ? 0 : ArghRad2 );
-
-			MakeBrush( &brush );
+		}
+		else
+		{
+			strcpy( surft,sb->surftext );
+			surf = surface[0];
+		}
+		XYZtoV( &v[0],&brush.face[4].v[0] );
+		XYZtoV( &v[1],&brush.face[4].v[1] );
+		XYZtoV( &v[2],&brush.face[4].v[2] );
+		strcpy( brush.face[4].texture,
+				( Plane == PLANE_XZ0 || Plane == PLANE_XZ1 ? sb->sidetext : surft ) );
+		brush.face[4].Shift[0] = (float)TexOffset[0];
+		brush.face[4].Shift[1] = (float)TexOffset[1];
+		brush.face[4].Rotate   = 0.;
+		brush.face[4].Scale[0] = (float)TexScale[0];
+		brush.face[4].Scale[1] = (float)TexScale[1];
+		brush.face[4].Contents = contents;
+		brush.face[4].Surface  = ( Plane == PLANE_XZ0 || Plane == PLANE_XZ1 ? surface[1] : surf );
+		brush.face[4].Value    = ( Plane == PLANE_XZ0 || Plane == PLANE_XZ1 ? 0 : ArghRad2 );
+
+		row.push_back( brush );
+	}
+}
+
+static void SurfaceBrushRowDone( int i, void *data ){
+	surfaceBrushes_t *sb = (surfaceBrushes_t *)data;
+	size_t k;
+
+	for ( k = 0; k < sb->rows[i].size(); k++ )
+		MakeBrush( &sb->rows[i][k] );
+	std::vector<BRUSH>().swap( sb->rows[i] );
+}
+
+//=============================================================
+void MapBrushes(){
+	char hint[128];
+	char skip[128];
+	int i, j, k;
+	BRUSH brush;
+	XYZ v[8];
+	surfaceBrushes_t sb;
+
+	strcpy( sb.surftext,Texture[Game][0] );
+	strcpy( sb.sidetext,( strlen( Texture[Game][1] ) ? Texture[Game][1] : Texture[Game][0] ) );
+	strcpy( sb.surftext2,( strlen( Texture[Game][2] ) ? Texture[Game][2] : Texture[Game][0] ) );
+
+	// if surftext2 is identical to surftext, there's no need to
+	// check surface angle
+	if ( !g_ascii_strcasecmp( sb.surftext,sb.surftext2 ) ) {
+		sb.CheckAngle = FALSE;
+	}
+	else
+	{
+		sb.CheckAngle = TRUE;
+		sb.Steep = (float)cos( (double)SlantAngle / 57.2957795 );
+		switch ( Plane )
+		{
+		case PLANE_XY0: sb.PlaneNormal[0] = 0.; sb.PlaneNormal[1] = 0.; sb.PlaneNormal[2] = 1.; break;
+		case PLANE_XY1: sb.PlaneNormal[0] = 0.; sb.PlaneNormal[1] = 0.; sb.PlaneNormal[2] = -1.; break;
+		case PLANE_XZ0: sb.PlaneNormal[0] = 0.; sb.PlaneNormal[1] = 1.; sb.PlaneNormal[2] = 1.; break;
+		case PLANE_XZ1: sb.PlaneNormal[0] = 0.; sb.PlaneNormal[1] = -1.; sb.PlaneNormal[2] = 1.; break;
+		case PLANE_YZ0: sb.PlaneNormal[0] = 1.; sb.PlaneNormal[1] = 0.; sb.PlaneNormal[2] = 1.; break;
+		case PLANE_YZ1: sb.PlaneNormal[0] = -1.; sb.PlaneNormal[1] = 0.; sb.PlaneNormal[2] = 1.; break;
 		}
 	}
+
+	OpenFuncGroup();
+
+	// the rows are built on the thread pool and handed to the editor in order as they come in
+	sb.rows.resize( NH );
+	RunRows( 0, NH, SurfaceBrushRow, SurfaceBrushRowDone, &sb );
 	CloseFuncGroup();
 
 	if ( AddHints || GimpHints ) {
@@ -1074,6 +1192,7 @@ void GenerateMap(){
 	   ghCursorCurrent = LoadCursor(NULL,IDC_WAIT);
 	   SetCursor(ghCursorCurrent);
 	 */
+	BeginMapUpdate();
 	if ( SingleBrushSelected ) {
 		g_FuncTable.m_pfnDeleteSelection();
 	}
@@ -1087,6 +1206,7 @@ void GenerateMap(){
 
 	if ( Decimate > 0 && ( Game != QUAKE3 || UsePatches == 0 ) ) {
 		MapOut( gNumNodes,gNumTris,gNode,gTri );
+		EndMapUpdate();
 		/*
 		   ghCursorCurrent = ghCursorDefault;
 		   SetCursor(ghCursorCurrent);
@@ -1122,6 +1242,7 @@ void GenerateMap(){
 	if ( Game != QUAKE3 || UsePatches == 0 ) {
 		MapBrushes();
 	}
+	EndMapUpdate();
 
 	/*
 	   ghCursorCurrent = ghCursorDefault;
@@ -1129,6 +1250,79 @@ void GenerateMap(){
 	 */
 }
 
+//=============================================================
+typedef struct
+{
+	int i, j;
+	int i0, i1, j0, j1;     // the nodes within range, clipped to the grid
+	double value;
+	double range, maxrange;
+	double rate;
+} fixedPoint_t;
+
+static void FixedPointRow( int ii, void *data ){
+	std::vector<fixedPoint_t> &fixedPoints = *(std::vector<fixedPoint_t> *)data;
+	double delta, dr, range;
+	size_t n;
+	int jj, k;
+
+	switch ( Plane )
+	{
+	case PLANE_XZ0:
+	case PLANE_XZ1:
+		k = 1;
+		break;
+	case PLANE_YZ0:
+	case PLANE_YZ1:
+		k = 0;
+		break;
+	default:
+		k = 2;
+	}
+
+	for ( n = 0; n < fixedPoints.size(); n++ )
+	{
+		const fixedPoint_t &fp = fixedPoints[n];
+
+		if ( fp.i == ii ) {
+			xyz[ii][fp.j].p[k] = fp.value;
+		}
+		if ( fp.range <= 0 || ii < fp.i0 || ii > fp.i1 ) {
+			continue;
+		}
+		for ( jj = fp.j0; jj <= fp.j1; jj++ )
+		{
+			if ( ii == fp.i && jj == fp.j ) {
+				continue;
+			}
+			range = pow( dh * ( fp.i - ii ), 2 ) + pow( dv * ( fp.j - jj ), 2 );
+			if ( range > fp.maxrange ) {
+				continue;
+			}
+			dr = sqrt( range / fp.maxrange );
+			if ( fp.rate < -1. ) {
+				delta = pow( ( 1. - dr ),-fp.rate + 1. );
+			}
+			else if ( fp.rate < 0. ) {
+				delta = ( 1 + fp.rate ) * 0.5 * ( cos( dr * PI ) + 1.0 ) -
+						fp.rate*pow( ( 1. - dr ),2 );
+			}
+			else if ( fp.rate == 0. ) {
+				delta = 0.5 * ( cos( dr * PI ) + 1.0 );
+			}
+			else if ( fp.rate <= 1. ) {
+				delta = ( 1. - fp.rate ) * 0.5 * ( cos( dr * PI ) + 1.0 ) +
+						fp.rate * ( 1. - pow( dr,2 ) );
+			}
+			else
+			{
+				delta = 1. - pow( dr,fp.rate + 1 );
+			}
+			xyz[ii][jj].p[k] += ( fp.value - xyz[ii][jj].p[k] ) * delta;
+		}
+	}
+}
+
 //=============================================================
 void GenerateXYZ(){
 	extern void MakeDecimatedMap( int *, int *, NODE * *, TRI * * );
@@ -1136,12 +1330,9 @@ void GenerateXYZ(){
 	double wh, wv;
 	int NHalfcycles;
 	double a,v,h,ha,va;
-	double delta, dr, rate;
-	double range, maxrange;
 	double r;
 	int i, j, k, N;
 	int i0, i1, j0, j1;
-	int ii, jj;
 
 //  FILE *f;
 //  char CSV[64];
@@ -1340,94 +1531,50 @@ void GenerateXYZ(){
 
 	if ( WaveType != WAVE_ROUGH_ONLY ) {
 		// Fixed values
+		// every fixed point sets itself and pulls the nodes within its range towards its value,
+		// in row/column order. Each row of targets replays that order on its own, so the rows
+		// can be worked on in parallel and still come out the same
+		std::vector<fixedPoint_t> fixedPoints;
+		fixedPoint_t fp;
+
 		for ( i = 0; i <= NH; i++ )
 		{
 			for ( j = 0; j <= NV; j++ )
 			{
-				if ( xyz[i][j].fixed ) {
-					switch ( Plane )
-					{
-					case PLANE_XZ0:
-					case PLANE_XZ1:
-						xyz[i][j].p[1] = xyz[i][j].fixed_value;
-						break;
-					case PLANE_YZ0:
-					case PLANE_YZ1:
-						xyz[i][j].p[0] = xyz[i][j].fixed_value;
-						break;
-					default:
-						xyz[i][j].p[2] = xyz[i][j].fixed_value;
+				if ( !xyz[i][j].fixed ) {
+					continue;
+				}
+				fp.i = i;
+				fp.j = j;
+				fp.value = xyz[i][j].fixed_value;
+				fp.range = xyz[i][j].range;
+				if ( fp.range > 0 ) {
+					fp.maxrange = pow( fp.range,2 ); // so we don't have to do sqrt's
+					fp.rate = max( -30.,min( xyz[i][j].rate,30. ) );
+					fp.i0 = i - (int)( floor( fp.range / dh - 0.5 ) + 1 );
+					fp.i1 = i + i - fp.i0;
+					fp.j0 = j - (int)( floor( fp.range / dv - 0.5 ) + 1 );
+					fp.j1 = j + j - fp.j0;
+					if ( FixBorders ) {
+						fp.i0 = max( fp.i0,1 );
+						fp.i1 = min( fp.i1,NH - 1 );
+						fp.j0 = max( fp.j0,1 );
+						fp.j1 = min( fp.j1,NV - 1 );
 					}
-
-					if ( xyz[i][j].range > 0 ) {
-						maxrange = pow( xyz[i][j].range,2 ); // so we don't have to do sqrt's
-						i0 = i - (int)( floor( xyz[i][j].range / dh - 0.5 ) + 1 );
-						i1 = i + i - i0;
-						j0 = j - (int)( floor( xyz[i][j].range / dv - 0.5 ) + 1 );
-						j1 = j + j - j0;
-						if ( FixBorders ) {
-							i0 = max( i0,1 );
-							i1 = min( i1,NH - 1 );
-							j0 = max( j0,1 );
-							j1 = min( j1,NV - 1 );
-						}
-						else
-						{
-							i0 = max( i0,0 );
-							i1 = min( i1,NH );
-							j0 = max( j0,0 );
-							j1 = min( j1,NV );
-						}
-						for ( ii = i0; ii <= i1; ii++ )
-						{
-							for ( jj = j0; jj <= j1; jj++ )
-							{
-								if ( ii == i && jj == j ) {
-									continue;
-								}
-								range = pow( dh * ( i - ii ), 2 ) + pow( dv * ( j - jj ), 2 );
-								if ( range > maxrange ) {
-									continue;
-								}
-								dr = sqrt( range / maxrange );
-								rate = max( -30.,min( xyz[i][j].rate,30. ) );
-								if ( rate < -1. ) {
-									delta = pow( ( 1. - dr ),-rate + 1. );
-								}
-								else if ( rate < 0. ) {
-									delta = ( 1 + rate ) * 0.5 * ( cos( dr * PI ) + 1.0 ) -
-											rate*pow( ( 1. - dr ),2 );
-								}
-								else if ( rate == 0. ) {
-									delta = 0.5 * ( cos( dr * PI ) + 1.0 );
-								}
-								else if ( rate <= 1. ) {
-									delta = ( 1. - rate ) * 0.5 * ( cos( dr * PI ) + 1.0 ) +
-											rate * ( 1. - pow( dr,2 ) );
-								}
-								else
-								{
-									delta = 1. - pow( dr,rate + 1 );
-								}
-								switch ( Plane )
-								{
-								case PLANE_XZ0:
-								case PLANE_XZ1:
-									xyz[ii][jj].p[1] += ( xyz[i][j].p[1] - xyz[ii][jj].p[1] ) * delta;
-									break;
-								case PLANE_YZ0:
-								case PLANE_YZ1:
-									xyz[ii][jj].p[0] += ( xyz[i][j].p[0] - xyz[ii][jj].p[0] ) * delta;
-									break;
-								default:
-									xyz[ii][jj].p[2] += ( xyz[i][j].p[2] - xyz[ii][jj].p[2] ) * delta;
-								}
-							}
-						}
+					else
+					{
+						fp.i0 = max( fp.i0,0 );
+						fp.i1 = min( fp.i1,NH );
+						fp.j0 = max( fp.j0,0 );
+						fp.j1 = min( fp.j1,NV );
 					}
 				}
+				fixedPoints.push_back( fp );
 			}
 		}
+		if ( !fixedPoints.empty() ) {
+			RunRows( 0, NH + 1, FixedPointRow, NULL, &fixedPoints );
+		}
 	}
 
 	if ( ( Roughness > 0. ) && ( WaveType != WAVE_ROUGH_ONLY ) ) {
@@ -1497,7 +1644,7 @@ void GenerateXYZ(){
 		zmin = Vll;
 		zmax = Vur;
 		xmin = xyz[0][0].p[0];
-		xmax = ymin;
+		xmax = xmin;
 		for ( i = 0; i <= NH; i++ )
 		{
 			for ( j = 0; j <= NV; j++ )
@@ -1559,6 +1706,7 @@ void GenerateXYZ(){
 		gNode = (NODE *)NULL;
 		gTri  = (TRI *)NULL;
 	}
+	FreeTriangleGrid();
 	if ( Decimate > 0 && ( Game != QUAKE3 || UsePatches == 0 ) ) {
 		MakeDecimatedMap( &gNumNodes,&gNumTris,&gNode,&gTri );
 	}
@@ -1672,6 +1820,8 @@ void GenerateXYZ(){
 		}
 	}
 	// Hydra: snap-to-grid end
+
+	InvalidatePreview();
 }
 //=============================================================
 double Nearest( double x, double dx ){
@@ -1937,20 +2087,98 @@ bool CanEdit( int i, int j ){
 	}
 	return TRUE;
 }
+/*============================================================================
+   BuildTriangleGrid
+   Sorts the gTri triangles into a square grid of x/y cells, a triangle goes in
+   every cell its bounds touch. Cell lists keep the triangles in gTri order.
+ */
+static void BuildTriangleGrid(){
+	int i, k, x, y, c;
+	int lo[2], hi[2];
+	int *fill;
+	double tmin[2], tmax[2], bmin[2], bmax[2];
+
+	TriGridSize = (int)( sqrt( (double)gNumTris ) / 2 ) + 1;
+
+	for ( i = 0; i < gNumTris; i++ )
+	{
+		for ( k = 0; k < 2; k++ )
+		{
+			tmin[k] = min( gNode[gTri[i].v[0]].p[k], min( gNode[gTri[i].v[1]].p[k], gNode[gTri[i].v[2]].p[k] ) );
+			tmax[k] = max( gNode[gTri[i].v[0]].p[k], max( gNode[gTri[i].v[1]].p[k], gNode[gTri[i].v[2]].p[k] ) );
+			bmin[k] = ( i == 0 ) ? tmin[k] : min( bmin[k], tmin[k] );
+			bmax[k] = ( i == 0 ) ? tmax[k] : max( bmax[k], tmax[k] );
+		}
+	}
+	for ( k = 0; k < 2; k++ )
+	{
+		TriGridMin[k]  = bmin[k];
+		TriGridCell[k] = ( bmax[k] - bmin[k] ) / TriGridSize;
+		if ( TriGridCell[k] <= 0. ) {
+			TriGridCell[k] = 1.;
+		}
+	}
+
+	// count, then fill
+	TriGridStart = (int *) calloc( TriGridSize * TriGridSize + 1, sizeof( int ) );
+	fill = (int *) malloc( TriGridSize * TriGridSize * sizeof( int ) );
+	for ( c = 0; c < 2; c++ )
+	{
+		for ( i = 0; i < gNumTris; i++ )
+		{
+			for ( k = 0; k < 2; k++ )
+			{
+				tmin[k] = min( gNode[gTri[i].v[0]].p[k], min( gNode[gTri[i].v[1]].p[k], gNode[gTri[i].v[2]].p[k] ) );
+				tmax[k] = max( gNode[gTri[i].v[0]].p[k], max( gNode[gTri[i].v[1]].p[k], gNode[gTri[i].v[2]].p[k] ) );
+				lo[k] = max( 0, min( TriGridSize - 1, (int)floor( ( tmin[k] - TriGridMin[k] ) / TriGridCell[k] ) ) );
+				hi[k] = max( 0, min( TriGridSize - 1, (int)floor( ( tmax[k] - TriGridMin[k] ) / TriGridCell[k] ) ) );
+			}
+			for ( y = lo[1]; y <= hi[1]; y++ )
+			{
+				for ( x = lo[0]; x <= hi[0]; x++ )
+				{
+					if ( c == 0 ) {
+						TriGridStart[y * TriGridSize + x + 1]++;
+					}
+					else{
+						TriGridTris[fill[y * TriGridSize + x]++] = i;
+					}
+				}
+			}
+		}
+		if ( c == 0 ) {
+			for ( k = 0; k < TriGridSize * TriGridSize; k++ )
+			{
+				TriGridStart[k + 1] += TriGridStart[k];
+				fill[k] = TriGridStart[k];
+			}
+			TriGridTris = (int *) malloc( max( TriGridStart[TriGridSize * TriGridSize], 1 ) * sizeof( int ) );
+		}
+	}
+	free( fill );
+}
 /*============================================================================
    TriangleFromPoint
    Determines which triangle in the gTri array bounds the input point. Doesn't
    do anything special with border points.
  */
 int TriangleFromPoint( double x, double y ){
-	int j, tri;
+	int j, k, c, tri;
 
 	if ( !gTri ) {
 		return -1;
 	}
 
-	for ( j = 0, tri = -1; j < gNumTris && tri == -1; j++ )
+	if ( !TriGridStart ) {
+		BuildTriangleGrid();
+	}
+
+	c = max( 0, min( TriGridSize - 1, (int)floor( ( y - TriGridMin[1] ) / TriGridCell[1] ) ) ) * TriGridSize +
+		max( 0, min( TriGridSize - 1, (int)floor( ( x - TriGridMin[0] ) / TriGridCell[0] ) ) );
+
+	for ( k = TriGridStart[c], tri = -1; k < TriGridStart[c + 1] && tri == -1; k++ )
 	{
+		j = TriGridTris[k];
 		if ( side( x,y,
 				   gNode[gTri[j].v[0]].p[0],gNode[gTri[j].v[0]].p[1],
 				   gNode[gTri[j].v[1]].p[0],gNode[gTri[j].v[1]].p[1] ) < 0. ) {
@@ -2009,15 +2237,23 @@ void XYZtoV( XYZ *xyz, vec3 *v ){
 
 //=============================================================
 void MakePatch( patchMesh_t *p ){
-	int ret;
+	int ret, n;
 	char shadername[64 + 9];
 
 	ret = g_FuncTable.m_pfnCreatePatchHandle();
 	// strcpy(shadername, "textures/");
 	// strcpy(shadername+9, Texture[Game][0]);
 	strcpy( shadername, Texture[Game][0] );
+	n = g_FuncTable.m_pfnSelectedBrushCount();
 	g_FuncTable.m_pfnCommitPatchHandleToMap( ret,p,shadername );
 	g_FuncTable.m_pfnReleasePatchHandles();
+
+	// the committed patch is selected, which puts it at the head of the selection
+	if ( g_FuncTable.m_pfnSelectedBrushCount() > n ) {
+		g_FuncTable.m_pfnAllocateSelectedBrushHandles();
+		g_UndoTable.m_pfnUndo_EndBrush( (brush_t *)g_FuncTable.m_pfnGetSelectedBrushHandle( 0 ) );
+		g_FuncTable.m_pfnReleaseSelectedBrushHandles();
+	}
 }
 
 //=============================================================
@@ -2071,6 +2307,7 @@ void MakeBrush( BRUSH *brush ){
 		else{
 			g_FuncTable.m_pfnCommitBrushHandle( vp );
 		}
+		g_UndoTable.m_pfnUndo_EndBrush( (brush_t *)vp );
 	}
 }
 //=============================================================
@@ -2098,7 +2335,36 @@ void OpenFuncGroup(){
 void CloseFuncGroup(){
 	if ( h_func_group ) {
 		g_FuncTable.m_pfnCommitEntityHandleToMap( h_func_group );
+		MapUpdateGroups.push_back( h_func_group );
+	}
+}
+//=============================================================
+// everything GenerateMap adds (and the selected brush it replaces) goes into one undo step,
+// the windows are redrawn once at the end
+void BeginMapUpdate(){
+	extern bool SingleBrushSelected;
+	int i, n;
+
+	MapUpdateGroups.clear();
+	g_UndoTable.m_pfnUndo_Start( "GenSurf" );
+
+	if ( SingleBrushSelected ) {
+		n = g_FuncTable.m_pfnAllocateSelectedBrushHandles();
+		for ( i = 0; i < n; i++ )
+			g_UndoTable.m_pfnUndo_AddBrush( (brush_t *)g_FuncTable.m_pfnGetSelectedBrushHandle( i ) );
+		g_FuncTable.m_pfnReleaseSelectedBrushHandles();
 	}
+}
+//=============================================================
+void EndMapUpdate(){
+	size_t k;
+
+	// MakeBrush and MakePatch have added their brushes already
+	for ( k = 0; k < MapUpdateGroups.size(); k++ )
+		g_UndoTable.m_pfnUndo_EndEntity( (entity_t *)MapUpdateGroups[k] );
+	g_UndoTable.m_pfnUndo_End();
+
+	MapUpdateGroups.clear();
 	if ( g_FuncTable.m_pfnSysUpdateWindows != NULL ) {
 		g_FuncTable.m_pfnSysUpdateWindows( W_ALL );
 	}
@@ -28,6 +28,7 @@
 #include "igl.h"
 #include "iui_gtk.h"
 #include "ientity.h"
+#include "iundo.h"
 
 #include "gendlgs.h"
 
@@ -246,7 +247,9 @@ void About( GtkWidget *parent );
 //--------------- genmap.c -----------------------------
 double AtLeast( double,double );
 bool CanEdit( int, int );
+void BeginMapUpdate();
 void CloseFuncGroup();
+void EndMapUpdate();
 bool FixedPoint( int,int );
 void GenerateMap();
 void GenerateXYZ();
@@ -278,6 +281,7 @@ void DrawGrid( RECT );
 void DrawPreview( RECT );
 void evaluate();
 void GetScaleFactor( RECT );
+void InvalidatePreview();
 void project( XYZ * );
 void Scale( RECT,XYZ,POINT * );
 void ShowPreview();
@@ -290,8 +294,9 @@ extern _QERFuncTable_1 g_FuncTable;
 extern _QERQglTable g_GLTable;
 extern _QERUIGtkTable g_UIGtkTable;
 extern _QEREntityTable g_EntityTable;
+extern _QERUndoTable g_UndoTable;
 //#define MAX_ROWS 64
-#define MAX_ROWS 128
+#define MAX_ROWS 512
 
 #define PLANE_XY0 0
 #define PLANE_XY1 1
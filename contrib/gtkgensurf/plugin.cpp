@@ -25,6 +25,7 @@ _QERFuncTable_1 g_FuncTable;
 _QERQglTable g_GLTable;
 _QERUIGtkTable g_UIGtkTable;
 _QEREntityTable g_EntityTable;
+_QERUndoTable g_UndoTable;
 bool SingleBrushSelected;
 bool g_bInitDone;
 
@@ -187,6 +188,7 @@ extern "C" CSynapseClient * SYNAPSE_DLL_EXPORT Synapse_EnumerateInterfaces( cons
 	g_SynapseClient.AddAPI( UIGTK_MAJOR, NULL, sizeof( _QERUIGtkTable ), SYN_REQUIRE, &g_UIGtkTable );
 	g_SynapseClient.AddAPI( QGL_MAJOR, NULL, sizeof( _QERQglTable ), SYN_REQUIRE, &g_GLTable );
 	g_SynapseClient.AddAPI( ENTITY_MAJOR, NULL, sizeof( _QEREntityTable ), SYN_REQUIRE, &g_EntityTable );
+	g_SynapseClient.AddAPI( UNDO_MAJOR, NULL, sizeof( _QERUndoTable ), SYN_REQUIRE, &g_UndoTable );
 
 	return &g_SynapseClient;
 }
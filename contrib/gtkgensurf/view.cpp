@@ -20,6 +20,7 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <vector>
 #include "gensurf.h"
 
 #undef ISOMETRIC
@@ -85,6 +86,128 @@ double Hhi, Hlo, Vhi, Vlo;
 
 #define SUBDIVS 6
 
+// DrawPreview's wireframe, GL_LINES over the surface nodes. It only changes with the surface,
+// turning the view just changes the matrix it is drawn with
+static std::vector<float> PreviewPoints;            // x, y, z of every node
+static std::vector<unsigned int> PreviewLines;      // pairs of nodes
+static GLuint PreviewBuffer = 0;
+static bool PreviewDirty = true;
+static bool PreviewBufferDirty = true;
+static bool PreviewDecimated;
+
+void InvalidatePreview(){
+	PreviewDirty = true;
+}
+
+static void BuildPreviewLines(){
+	int i, j, k, N;
+
+	PreviewDecimated = ( Decimate > 0 && ( Game != QUAKE3 || UsePatches == 0 ) );
+	PreviewPoints.clear();
+	PreviewLines.clear();
+
+	if ( PreviewDecimated ) {
+		PreviewPoints.reserve( gNumNodes * 3 );
+		for ( i = 0; i < gNumNodes; i++ )
+		{
+			for ( k = 0; k < 3; k++ )
+				PreviewPoints.push_back( gNode[i].p[k] );
+		}
+		PreviewLines.reserve( gNumTris * 6 );
+		for ( i = 0; i < gNumTris; i++ )
+		{
+			for ( k = 0; k < 3; k++ )
+			{
+				PreviewLines.push_back( gTri[i].v[k] );
+				PreviewLines.push_back( gTri[i].v[( k + 1 ) % 3] );
+			}
+		}
+	}
+	else
+	{
+		// xyz rather than gNode, snap-to-grid is applied after gNode is filled
+		PreviewPoints.reserve( ( NH + 1 ) * ( NV + 1 ) * 3 );
+		PreviewLines.reserve( ( NH * ( NV + 1 ) + NV * ( NH + 1 ) ) * 2 );
+		for ( i = 0, N = 0; i <= NH; i++ )
+		{
+			for ( j = 0; j <= NV; j++, N++ )
+			{
+				for ( k = 0; k < 3; k++ )
+					PreviewPoints.push_back( (float)xyz[i][j].p[k] );
+				if ( j < NV ) {
+					PreviewLines.push_back( N );
+					PreviewLines.push_back( N + 1 );
+				}
+				if ( i < NH ) {
+					PreviewLines.push_back( N );
+					PreviewLines.push_back( N + NV + 1 );
+				}
+			}
+		}
+	}
+
+	PreviewDirty = false;
+	PreviewBufferDirty = true;
+}
+
+static void DrawPreviewLines(){
+	const GLvoid *points;
+	GLfloat m[16];
+	XYZ axis[3];
+	int k;
+
+	if ( PreviewDirty || PreviewDecimated != ( Decimate > 0 && ( Game != QUAKE3 || UsePatches == 0 ) ) ) {
+		BuildPreviewLines();
+	}
+	if ( PreviewLines.empty() ) {
+		return;
+	}
+
+	points = &PreviewPoints[0];
+	if ( g_GLTable.m_pfnHasBufferObjects() ) {
+		if ( !PreviewBuffer ) {
+			g_GLTable.m_pfn_qglGenBuffersARB( 1, &PreviewBuffer );
+		}
+		g_GLTable.m_pfn_qglBindBufferARB( GL_ARRAY_BUFFER_ARB, PreviewBuffer );
+		if ( PreviewBufferDirty ) {
+			g_GLTable.m_pfn_qglBufferDataARB( GL_ARRAY_BUFFER_ARB, PreviewPoints.size() * sizeof( float ),
+											  &PreviewPoints[0], GL_STATIC_DRAW_ARB );
+			PreviewBufferDirty = false;
+		}
+		points = NULL;
+	}
+
+	// project() is linear, so it folds into one matrix with Scale()
+	for ( k = 0; k < 3; k++ )
+	{
+		VectorClear( axis[k].p );
+		axis[k].p[k] = 1.;
+		project( &axis[k] );
+		m[k * 4 + 0] = (GLfloat)( SF * axis[k].pp[0] );
+		m[k * 4 + 1] = (GLfloat)( SF * axis[k].pp[1] );
+		m[k * 4 + 2] = 0.f;
+		m[k * 4 + 3] = 0.f;
+	}
+	m[12] = (GLfloat)( X0 - SF * Hlo );
+	m[13] = (GLfloat)( Y0 - SF * Vhi );
+	m[14] = 0.f;
+	m[15] = 1.f;
+
+	g_GLTable.m_pfn_qglMatrixMode( GL_MODELVIEW );
+	g_GLTable.m_pfn_qglPushMatrix();
+	g_GLTable.m_pfn_qglMultMatrixf( m );
+
+	g_GLTable.m_pfn_qglVertexPointer( 3, GL_FLOAT, 0, points );
+	g_GLTable.m_pfn_qglEnableClientState( GL_VERTEX_ARRAY );
+	g_GLTable.m_pfn_qglDrawElements( GL_LINES, (GLsizei)PreviewLines.size(), GL_UNSIGNED_INT, &PreviewLines[0] );
+	g_GLTable.m_pfn_qglDisableClientState( GL_VERTEX_ARRAY );
+
+	if ( g_GLTable.m_pfnHasBufferObjects() ) {
+		g_GLTable.m_pfn_qglBindBufferARB( GL_ARRAY_BUFFER_ARB, 0 );
+	}
+	g_GLTable.m_pfn_qglPopMatrix();
+}
+
 
 void ShowPreview(){
 	if ( Preview ) {
@@ -509,29 +632,7 @@ void DrawPreview( RECT rc ){
 	g_GLTable.m_pfn_qglDisable( GL_LINE_STIPPLE );
 
 	if ( Decimate > 0 && ( Game != QUAKE3 || UsePatches == 0 ) ) {
-		XYZ  *vv;
-
-		vv   = (XYZ *) malloc( gNumNodes * sizeof( XYZ ) );
-		for ( i = 0; i < gNumNodes; i++ )
-		{
-			for ( j = 0; j < 3; j++ )
-				vv[i].p[j] = (double)( gNode[i].p[j] );
-			project( &vv[i] );
-		}
-
-		for ( i = 0; i < gNumTris; i++ )
-		{
-			for ( j = 0; j < 3; j++ )
-				Scale( rc,vv[gTri[i].v[j]],&pt[j] );
-
-			g_GLTable.m_pfn_qglBegin( GL_LINE_STRIP );
-			g_GLTable.m_pfn_qglVertex2f( pt[0].x, pt[0].y );
-			g_GLTable.m_pfn_qglVertex2f( pt[1].x, pt[1].y );
-			g_GLTable.m_pfn_qglVertex2f( pt[2].x, pt[2].y );
-			g_GLTable.m_pfn_qglVertex2f( pt[0].x, pt[0].y );
-			g_GLTable.m_pfn_qglEnd();
-		}
-		free( vv );
+		DrawPreviewLines();
 	}
 	else if ( Game == QUAKE3 && UsePatches != 0 ) {
 		int axis, ii, jj, k;
@@ -697,30 +798,7 @@ void DrawPreview( RECT rc ){
 	}
 	else
 	{
-		for ( i = 0; i <= NH; i++ )
-		{
-			Scale( rc,xyz[i][0],&pt[0] );
-			g_GLTable.m_pfn_qglBegin( GL_LINE_STRIP );
-			g_GLTable.m_pfn_qglVertex2f( pt[0].x, pt[0].y );
-			for ( j = 1; j <= NV; j++ )
-			{
-				Scale( rc,xyz[i][j],&pt[0] );
-				g_GLTable.m_pfn_qglVertex2f( pt[0].x, pt[0].y );
-			}
-			g_GLTable.m_pfn_qglEnd();
-		}
-		for ( j = 0; j <= NV; j++ )
-		{
-			Scale( rc,xyz[0][j],&pt[0] );
-			g_GLTable.m_pfn_qglBegin( GL_LINE_STRIP );
-			g_GLTable.m_pfn_qglVertex2f( pt[0].x, pt[0].y );
-			for ( i = 1; i <= NH; i++ )
-			{
-				Scale( rc,xyz[i][j],&pt[0] );
-				g_GLTable.m_pfn_qglVertex2f( pt[0].x, pt[0].y );
-			}
-			g_GLTable.m_pfn_qglEnd();
-		}
+		DrawPreviewLines();
 	}
 
 	if ( Game != QUAKE3 || UsePatches == 0 ) {
@@ -1208,8 +1286,9 @@ void project( XYZ *v ){
 }
 /*=======================================================================*/
 void evaluate(){
-	int i, j;
-	XYZ v[4];
+	int i, k, back;
+	double lo[3], hi[3];
+	XYZ v[8];
 
 	if ( elevation > PI ) {
 		elevation -= 2. * PI;
@@ -1225,64 +1304,50 @@ void evaluate(){
 	ct[1] = cos( roll );
 	ct[2] = cos( azimuth );
 
-	for ( i = 0; i <= NH; i++ )
-	{
-		for ( j = 0; j <= NV; j++ )
-		{
-			project( &xyz[i][j] );
-		}
-	}
-
-	Hhi = xyz[0][0].pp[0];
-	Hlo = Hhi;
-	Vhi = xyz[0][0].pp[1];
-	Vlo = Vhi;
-	for ( i = 0; i <= NH; i++ )
-	{
-		for ( j = 0; j <= NV; j++ )
-		{
-			Hlo = min( Hlo,xyz[i][j].pp[0] );
-			Hhi = max( Hhi,xyz[i][j].pp[0] );
-			Vlo = min( Vlo,xyz[i][j].pp[1] );
-			Vhi = max( Vhi,xyz[i][j].pp[1] );
-		}
-	}
-
-	// Include backface in min-max
-	VectorCopy( xyz[ 0][ 0].p,v[0].p );
-	VectorCopy( xyz[NH][ 0].p,v[1].p );
-	VectorCopy( xyz[NH][NV].p,v[2].p );
-	VectorCopy( xyz[ 0][NV].p,v[3].p );
+	// The corner nodes are the only ones drawn through their own projection
+	project( &xyz[ 0][ 0] );
+	project( &xyz[NH][ 0] );
+	project( &xyz[NH][NV] );
+	project( &xyz[ 0][NV] );
+
+	// project() is linear, so the min-max of the box around the surface and its backface
+	// holds every node, and only its 8 corners need projecting
+	lo[0] = xmin;
+	hi[0] = xmax;
+	lo[1] = ymin;
+	hi[1] = ymax;
+	lo[2] = zmin;
+	hi[2] = zmax;
 	switch ( Plane )
 	{
 	case PLANE_XZ0:
 	case PLANE_XZ1:
-		v[0].p[1] = backface;
-		v[1].p[1] = v[0].p[1];
-		v[2].p[1] = v[0].p[1];
-		v[3].p[1] = v[0].p[1];
+		back = 1;
 		break;
 	case PLANE_YZ0:
 	case PLANE_YZ1:
-		v[0].p[0] = backface;
-		v[1].p[0] = v[0].p[0];
-		v[2].p[0] = v[0].p[0];
-		v[3].p[0] = v[0].p[0];
+		back = 0;
 		break;
 	default:
-		v[0].p[2] = backface;
-		v[1].p[2] = v[0].p[2];
-		v[2].p[2] = v[0].p[2];
-		v[3].p[2] = v[0].p[2];
+		back = 2;
 	}
-	for ( i = 0; i <= 3; i++ )
+	lo[back] = min( lo[back],backface );
+	hi[back] = max( hi[back],backface );
+
+	for ( i = 0; i < 8; i++ )
 	{
+		for ( k = 0; k < 3; k++ )
+			v[i].p[k] = ( i & ( 1 << k ) ) ? hi[k] : lo[k];
 		project( &v[i] );
+		if ( i == 0 ) {
+			Hlo = Hhi = v[i].pp[0];
+			Vlo = Vhi = v[i].pp[1];
+			continue;
+		}
 		Hlo = min( Hlo,v[i].pp[0] );
 		Hhi = max( Hhi,v[i].pp[0] );
 		Vlo = min( Vlo,v[i].pp[1] );
 		Vhi = max( Vhi,v[i].pp[1] );
 	}
-
 }
 #endif
@@ -24,23 +24,25 @@
 #include <search.h>
 #endif
 #include <stdio.h>
+#include <math.h>
+
+#include <algorithm>
 
-#define LINE_BUF 1000
+#define GRID_MAX_CELLS      32          // per axis
+#define GRID_MIN_CELL       128.0f
 
 CPortals portals;
 CPortalsRender render;
 
-int compare( const void *arg1, const void *arg2 ){
+static std::vector<GLuint> s_indexes;
+static std::vector<GLuint> s_lines2D;  // outer loops of every portal, only change with the file
 
-	if ( portals.portal[*( (int *)arg1 )].dist > portals.portal[*( (int *)arg2 )].dist ) {
-		return -1;
+struct PortalBackToFront
+{
+	bool operator()( int a, int b ) const {
+		return portals.portal[a].dist > portals.portal[b].dist;
 	}
-	else if ( portals.portal[*( (int *)arg1 )].dist < portals.portal[*( (int *)arg2 )].dist ) {
-		return 1;
-	}
-
-	return 0;
-}
+};
 
 
 CBspPortal::CBspPortal(){
@@ -48,25 +50,37 @@ CBspPortal::CBspPortal(){
 }
 
 CBspPortal::~CBspPortal(){
-	delete[] point;
-	delete[] inner_point;
 }
 
-qboolean CBspPortal::Build( char *def ){
-	char *c = def;
+/*
+   parses one portal line, the points are appended to pool
+   point and inner_point are set by CPortals::Load once the pool stops growing
+ */
+qboolean CBspPortal::Build( char *def, std::vector<CBspPoint> &pool ){
+	char *c = def, *end;
+	CBspPoint *pt;
 	unsigned int n;
-	int dummy1, dummy2;
 	int i;
 
+	point_count = strtoul( c, &end, 10 );
+	if ( end == c ) {
+		return FALSE;
+	}
+	c = end;
+
 	if ( portals.hint_flags ) {
-		int res_cnt = sscanf( def, "%u %d %d %d", &point_count, &dummy1, &dummy2, (int *)&hint );
-		if ( res_cnt < 4 ) {
-			return FALSE;
+		// two clusters, then the hint flag
+		for ( i = 0; i < 3; i++ )
+		{
+			hint = (qboolean)strtol( c, &end, 10 );
+			if ( end == c ) {
+				return FALSE;
+			}
+			c = end;
 		}
 	}
 	else
 	{
-		sscanf( def, "%u", &point_count );
 		hint = FALSE;
 	}
 
@@ -74,41 +88,47 @@ qboolean CBspPortal::Build( char *def ){
 		return FALSE;
 	}
 
-	point = new CBspPoint[point_count];
-	inner_point = new CBspPoint[point_count];
+	first_point = pool.size();
+	pool.resize( first_point + 2 * point_count );
+	pt = &pool[first_point];
 
 	for ( n = 0; n < point_count; n++ )
 	{
 		for (; *c != 0 && *c != '('; c++ ) ;
 
 		if ( *c == 0 ) {
+			pool.resize( first_point );
 			return FALSE;
 		}
 
 		c++;
 
-		sscanf( c, "%f %f %f", point[n].p, point[n].p + 1, point[n].p + 2 );
+		for ( i = 0; i < 3; i++ )
+		{
+			pt[n].p[i] = (float)strtod( c, &end );
+			c = end;
+		}
 
-		center.p[0] += point[n].p[0];
-		center.p[1] += point[n].p[1];
-		center.p[2] += point[n].p[2];
+		center.p[0] += pt[n].p[0];
+		center.p[1] += pt[n].p[1];
+		center.p[2] += pt[n].p[2];
 
 		if ( n == 0 ) {
 			for ( i = 0; i < 3; i++ )
 			{
-				min[i] = point[n].p[i];
-				max[i] = point[n].p[i];
+				min[i] = pt[n].p[i];
+				max[i] = pt[n].p[i];
 			}
 		}
 		else
 		{
 			for ( i = 0; i < 3; i++ )
 			{
-				if ( min[i] > point[n].p[i] ) {
-					min[i] = point[n].p[i];
+				if ( min[i] > pt[n].p[i] ) {
+					min[i] = pt[n].p[i];
 				}
-				if ( max[i] < point[n].p[i] ) {
-					max[i] = point[n].p[i];
+				if ( max[i] < pt[n].p[i] ) {
+					max[i] = pt[n].p[i];
 				}
 			}
 		}
@@ -120,9 +140,9 @@ qboolean CBspPortal::Build( char *def ){
 
 	for ( n = 0; n < point_count; n++ )
 	{
-		inner_point[n].p[0] = ( 0.01f * center.p[0] ) + ( 0.99f * point[n].p[0] );
-		inner_point[n].p[1] = ( 0.01f * center.p[1] ) + ( 0.99f * point[n].p[1] );
-		inner_point[n].p[2] = ( 0.01f * center.p[2] ) + ( 0.99f * point[n].p[2] );
+		pt[point_count + n].p[0] = ( 0.01f * center.p[0] ) + ( 0.99f * pt[n].p[0] );
+		pt[point_count + n].p[1] = ( 0.01f * center.p[1] ) + ( 0.99f * pt[n].p[1] );
+		pt[point_count + n].p[2] = ( 0.01f * center.p[2] ) + ( 0.99f * pt[n].p[2] );
 	}
 
 	fp_color_random[0] = (float)( rand() & 0xff ) / 255.0f;
@@ -146,8 +166,24 @@ void CPortals::Purge(){
 	delete[] portal_sort;
 	portal = NULL;
 	portal_sort = NULL;
+	sort_count = 0;
 	portal_count = 0;
 
+	// the buffer object is kept, there may be no GL context here and the next load reuses it
+	delete[] points;
+	delete[] point_colors;
+	points = NULL;
+	point_colors = NULL;
+	point_total = 0;
+	buffer_dirty = TRUE;
+
+	delete[] grid_start;
+	delete[] grid_portals;
+	grid_start = NULL;
+	grid_portals = NULL;
+
+	s_lines2D.clear();
+
 	/*
 	   delete[] node;
 	   node = NULL;
@@ -155,10 +191,33 @@ void CPortals::Purge(){
 	 */
 }
 
-void CPortals::Load(){
-	char buf[LINE_BUF + 1];
+/*
+   cuts the next line out of the buffer in place
+   \return NULL at the end of the buffer
+ */
+static char *Portal_NextLine( char **cursor ){
+	char *line = *cursor, *end;
+
+	if ( *line == 0 ) {
+		return NULL;
+	}
+
+	end = strchr( line, '\n' );
+	if ( end ) {
+		*end = 0;
+		*cursor = end + 1;
+	}
+	else
+	{
+		*cursor = line + strlen( line );
+	}
 
-	memset( buf, 0, LINE_BUF + 1 );
+	return line;
+}
+
+void CPortals::Load(){
+	char *buf, *cursor, *line;
+	long size;
 
 	Purge();
 
@@ -166,7 +225,7 @@ void CPortals::Load(){
 
 	FILE *in;
 
-	in = fopen( fn, "rt" );
+	in = fopen( fn, "rb" );
 
 	if ( in == NULL ) {
 		Sys_FPrintf( SYS_ERR, "ERROR - could not open file.\n" );
@@ -174,35 +233,53 @@ void CPortals::Load(){
 		return;
 	}
 
-	if ( !fgets( buf, LINE_BUF, in ) ) {
-		fclose( in );
+	// the whole file at once, the lines are parsed straight from the buffer
+	fseek( in, 0, SEEK_END );
+	size = ftell( in );
+	fseek( in, 0, SEEK_SET );
+	if ( size < 0 ) {
+		size = 0;
+	}
+
+	buf = new char[size + 1];
+	size = fread( buf, 1, size, in );
+	buf[size] = 0;
+
+	fclose( in );
+
+	cursor = buf;
+
+	line = Portal_NextLine( &cursor );
+	if ( !line ) {
+		delete[] buf;
 
 		Sys_FPrintf( SYS_ERR, "ERROR - File ended prematurely.\n" );
 
 		return;
 	}
 
-	if ( strncmp( "PRT1", buf, 4 ) != 0 ) {
-		fclose( in );
+	if ( strncmp( "PRT1", line, 4 ) != 0 ) {
+		delete[] buf;
 
 		Sys_FPrintf( SYS_ERR, "ERROR - File header indicates wrong file type (should be \"PRT1\").\n" );
 
 		return;
 	}
 
-	if ( !fgets( buf, LINE_BUF, in ) ) {
-		fclose( in );
+	line = Portal_NextLine( &cursor );
+	if ( !line ) {
+		delete[] buf;
 
 		Sys_FPrintf( SYS_ERR, "ERROR - File ended prematurely.\n" );
 
 		return;
 	}
 
-	sscanf( buf, "%u", &node_count );
+	node_count = strtoul( line, NULL, 10 );
 /*
     if(node_count > 0xFFFF)
     {
-        fclose(in);
+        delete[] buf;
 
         node_count = 0;
 
@@ -212,8 +289,9 @@ void CPortals::Load(){
     }
  */
 
-	if ( !fgets( buf, LINE_BUF, in ) ) {
-		fclose( in );
+	line = Portal_NextLine( &cursor );
+	if ( !line ) {
+		delete[] buf;
 
 		node_count = 0;
 
@@ -222,10 +300,10 @@ void CPortals::Load(){
 		return;
 	}
 
-	sscanf( buf, "%u", &portal_count );
+	portal_count = strtoul( line, NULL, 10 );
 
 	if ( portal_count > 0xFFFF ) {
-		fclose( in );
+		delete[] buf;
 
 		portal_count = 0;
 		node_count = 0;
@@ -236,7 +314,7 @@ void CPortals::Load(){
 	}
 
 	if ( portal_count <= 0 ) {
-		fclose( in );
+		delete[] buf;
 
 		portal_count = 0;
 		node_count = 0;
@@ -250,16 +328,20 @@ void CPortals::Load(){
 	portal = new CBspPortal[portal_count];
 	portal_sort = new int[portal_count];
 
-	unsigned int n;
+	std::vector<CBspPoint> pool;
+	unsigned int n, p;
 	qboolean first = TRUE;
-	unsigned test_vals_1, test_vals_2;
+	char *end;
+
+	pool.reserve( portal_count * 16 );
 
 	hint_flags = FALSE;
 
 	for ( n = 0; n < portal_count; )
 	{
-		if ( !fgets( buf, LINE_BUF, in ) ) {
-			fclose( in );
+		line = Portal_NextLine( &cursor );
+		if ( !line ) {
+			delete[] buf;
 
 			Purge();
 
@@ -268,16 +350,24 @@ void CPortals::Load(){
 			return;
 		}
 
-		if ( !portal[n].Build( buf ) ) {
-			if ( first && sscanf( buf, "%d %d", &test_vals_1, &test_vals_2 ) == 1 ) { // skip additional counts of later data, not needed
-				// We can count on hint flags being in the file
-				hint_flags = TRUE;
-				continue;
+		if ( !portal[n].Build( line, pool ) ) {
+			// a line with a single number: skip additional counts of later data, not needed
+			if ( first ) {
+				strtol( line, &end, 10 );
+				if ( end != line ) {
+					char *second = end;
+					strtol( second, &end, 10 );
+					if ( end == second ) {
+						// We can count on hint flags being in the file
+						hint_flags = TRUE;
+						continue;
+					}
+				}
 			}
 
 			first = FALSE;
 
-			fclose( in );
+			delete[] buf;
 
 			Purge();
 
@@ -289,11 +379,152 @@ void CPortals::Load(){
 		n++;
 	}
 
-	fclose( in );
+	delete[] buf;
+
+	// one block for all the points, the portals point into it
+	point_total = pool.size();
+	points = new CBspPoint[point_total];
+	memcpy( points, &pool[0], point_total * sizeof( CBspPoint ) );
+
+	point_colors = new unsigned char[point_total * 4];
+	color_alpha = 255;
+
+	for ( n = 0; n < portal_count; n++ )
+	{
+		CBspPortal &prt = portal[n];
+
+		prt.point = points + prt.first_point;
+		prt.inner_point = prt.point + prt.point_count;
+
+		for ( p = 0; p < 2 * prt.point_count; p++ )
+		{
+			unsigned char *color = point_colors + ( prt.first_point + p ) * 4;
+			color[0] = (unsigned char)( prt.fp_color_random[0] * 255.0f );
+			color[1] = (unsigned char)( prt.fp_color_random[1] * 255.0f );
+			color[2] = (unsigned char)( prt.fp_color_random[2] * 255.0f );
+			color[3] = color_alpha;
+		}
+
+		for ( p = 0; p < prt.point_count; p++ )
+		{
+			s_lines2D.push_back( prt.first_point + p );
+			s_lines2D.push_back( prt.first_point + ( p + 1 ) % prt.point_count );
+		}
+	}
+
+	buffer_dirty = TRUE;
+	sort_count = 0;
+
+	BuildGrid();
 
 	Sys_Printf( "  %u portals read in.\n", node_count, portal_count );
 }
 
+/*
+   the cells touched by a box, clamped to the grid
+ */
+static void Grid_Range( const CPortals &prt, const float *mins, const float *maxs, int *lo, int *hi ){
+	int i;
+
+	for ( i = 0; i < 3; i++ )
+	{
+		lo[i] = (int)floor( ( mins[i] - prt.grid_origin[i] ) / prt.grid_cell );
+		hi[i] = (int)floor( ( maxs[i] - prt.grid_origin[i] ) / prt.grid_cell );
+		lo[i] = std::max( 0, std::min( lo[i], prt.grid_size[i] - 1 ) );
+		hi[i] = std::max( 0, std::min( hi[i], prt.grid_size[i] - 1 ) );
+	}
+}
+
+/*
+   every portal goes into all the cells its bounds touch
+ */
+void CPortals::BuildGrid(){
+	float mins[3], maxs[3], extent;
+	unsigned int n, *fill;
+	int i, x, y, z, lo[3], hi[3], cells;
+
+	for ( i = 0; i < 3; i++ )
+	{
+		mins[i] = portal[0].min[i];
+		maxs[i] = portal[0].max[i];
+	}
+	for ( n = 1; n < portal_count; n++ )
+	{
+		for ( i = 0; i < 3; i++ )
+		{
+			mins[i] = std::min( mins[i], portal[n].min[i] );
+			maxs[i] = std::max( maxs[i], portal[n].max[i] );
+		}
+	}
+
+	extent = 0.0f;
+	for ( i = 0; i < 3; i++ )
+		extent = std::max( extent, maxs[i] - mins[i] );
+
+	grid_cell = std::max( extent / GRID_MAX_CELLS, GRID_MIN_CELL );
+
+	cells = 1;
+	for ( i = 0; i < 3; i++ )
+	{
+		grid_origin[i] = mins[i];
+		grid_size[i] = std::min( (int)( ( maxs[i] - mins[i] ) / grid_cell ) + 1, GRID_MAX_CELLS );
+		cells *= grid_size[i];
+	}
+
+	// count, then fill
+	grid_start = new unsigned int[cells + 1];
+	memset( grid_start, 0, ( cells + 1 ) * sizeof( unsigned int ) );
+
+	for ( n = 0; n < portal_count; n++ )
+	{
+		Grid_Range( *this, portal[n].min, portal[n].max, lo, hi );
+		for ( z = lo[2]; z <= hi[2]; z++ )
+			for ( y = lo[1]; y <= hi[1]; y++ )
+				for ( x = lo[0]; x <= hi[0]; x++ )
+					grid_start[( z * grid_size[1] + y ) * grid_size[0] + x + 1]++;
+	}
+
+	for ( i = 0; i < cells; i++ )
+		grid_start[i + 1] += grid_start[i];
+
+	grid_portals = new unsigned int[grid_start[cells]];
+	fill = new unsigned int[cells];
+	memcpy( fill, grid_start, cells * sizeof( unsigned int ) );
+
+	for ( n = 0; n < portal_count; n++ )
+	{
+		Grid_Range( *this, portal[n].min, portal[n].max, lo, hi );
+		for ( z = lo[2]; z <= hi[2]; z++ )
+			for ( y = lo[1]; y <= hi[1]; y++ )
+				for ( x = lo[0]; x <= hi[0]; x++ )
+					grid_portals[fill[( z * grid_size[1] + y ) * grid_size[0] + x]++] = n;
+	}
+
+	delete[] fill;
+}
+
+/*
+   orders the portals MarkVisible found back to front from cam
+ */
+void CPortals::SortPortals( const float *cam ){
+	unsigned int n;
+	float d;
+	int i;
+
+	for ( n = 0; n < sort_count; n++ )
+	{
+		CBspPortal &prt = portal[portal_sort[n]];
+		prt.dist = 0.0f;
+		for ( i = 0; i < 3; i++ )
+		{
+			d = cam[i] - prt.center.p[i];
+			prt.dist += d * d;
+		}
+	}
+
+	std::sort( portal_sort, portal_sort + sort_count, PortalBackToFront() );
+}
+
 void CPortals::FixColors(){
 	fp_color_2d[0] = (float)GetRValue( color_2d ) / 255.0f;
 	fp_color_2d[1] = (float)GetGValue( color_2d ) / 255.0f;
@@ -318,6 +549,54 @@ CPortalsRender::CPortalsRender(){
 CPortalsRender::~CPortalsRender(){
 }
 
+/*
+   points and colors go to the buffer object once per load, and again when the alpha changes
+   without buffer objects they are drawn from memory
+ */
+static void Portals_BindArrays(){
+	const GLvoid *vertexes = portals.points;
+	const GLvoid *colors = portals.point_colors;
+
+	if ( g_QglTable.m_pfnHasBufferObjects() ) {
+		if ( !portals.buffer ) {
+			g_QglTable.m_pfn_qglGenBuffersARB( 1, &portals.buffer );
+		}
+		g_QglTable.m_pfn_qglBindBufferARB( GL_ARRAY_BUFFER_ARB, portals.buffer );
+
+		if ( portals.buffer_dirty ) {
+			size_t vertexSize = portals.point_total * sizeof( CBspPoint );
+			size_t colorSize = portals.point_total * 4;
+			unsigned char *data = new unsigned char[vertexSize + colorSize];
+
+			memcpy( data, portals.points, vertexSize );
+			memcpy( data + vertexSize, portals.point_colors, colorSize );
+			g_QglTable.m_pfn_qglBufferDataARB( GL_ARRAY_BUFFER_ARB, vertexSize + colorSize, data, GL_STATIC_DRAW_ARB );
+			delete[] data;
+
+			portals.buffer_dirty = FALSE;
+		}
+
+		vertexes = NULL;
+		colors = (const GLvoid *)( portals.point_total * sizeof( CBspPoint ) );
+	}
+
+	g_QglTable.m_pfn_qglVertexPointer( 3, GL_FLOAT, sizeof( CBspPoint ), vertexes );
+	g_QglTable.m_pfn_qglColorPointer( 4, GL_UNSIGNED_BYTE, 0, colors );
+	g_QglTable.m_pfn_qglEnableClientState( GL_VERTEX_ARRAY );
+	g_QglTable.m_pfn_qglDisableClientState( GL_COLOR_ARRAY );
+	g_QglTable.m_pfn_qglDisableClientState( GL_NORMAL_ARRAY );
+	g_QglTable.m_pfn_qglDisableClientState( GL_TEXTURE_COORD_ARRAY );
+}
+
+static void Portals_UnbindArrays(){
+	g_QglTable.m_pfn_qglDisableClientState( GL_VERTEX_ARRAY );
+	g_QglTable.m_pfn_qglDisableClientState( GL_COLOR_ARRAY );
+
+	if ( g_QglTable.m_pfnHasBufferObjects() ) {
+		g_QglTable.m_pfn_qglBindBufferARB( GL_ARRAY_BUFFER_ARB, 0 );
+	}
+}
+
 void CPortalsRender::Register(){
 	g_QglTable.m_pfnHookGL2DWindow( this );
 	g_QglTable.m_pfnHookGL3DWindow( this );
@@ -357,17 +636,11 @@ void CPortalsRender::Draw2D( VIEWTYPE vt ){
 
 	g_QglTable.m_pfn_qglColor4fv( portals.fp_color_2d );
 
-	unsigned int n, p;
-
-	for ( n = 0; n < portals.portal_count; n++ )
-	{
-		g_QglTable.m_pfn_qglBegin( GL_LINE_LOOP );
+	Portals_BindArrays();
 
-		for ( p = 0; p < portals.portal[n].point_count; p++ )
-			g_QglTable.m_pfn_qglVertex3fv( portals.portal[n].point[p].p );
+	g_QglTable.m_pfn_qglDrawElements( GL_LINES, s_lines2D.size(), GL_UNSIGNED_INT, &s_lines2D[0] );
 
-		g_QglTable.m_pfn_qglEnd();
-	}
+	Portals_UnbindArrays();
 
 	g_QglTable.m_pfn_qglPopAttrib();
 }
@@ -388,8 +661,6 @@ static void transform_point( GLdouble out[4], const GLdouble m[16],
 #undef M
 }
 
-#include <math.h>
-
 
 /*
  * Perform a 4x4 matrix multiplication  (product = a x b).
@@ -608,6 +879,112 @@ GLint UnProject( GLdouble winx,GLdouble winy,GLdouble winz,
 	return GL_TRUE;
 }
 
+/*
+   true if the box is entirely behind one of the planes
+ */
+static bool Box_Outside( const double planes[6][4], const float *mins, const float *maxs ){
+	int i;
+
+	for ( i = 0; i < 6; i++ )
+	{
+		const double *pl = planes[i];
+		double d = pl[3];
+
+		d += pl[0] * ( pl[0] >= 0.0 ? maxs[0] : mins[0] );
+		d += pl[1] * ( pl[1] >= 0.0 ? maxs[1] : mins[1] );
+		d += pl[2] * ( pl[2] >= 0.0 ? maxs[2] : mins[2] );
+
+		if ( d < 0.0 ) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/*
+   collects the portals in view, and inside the clip box when one is given, into portal_sort
+   only the grid cells in view, and in the clip box, are walked, visframe keeps a portal
+   that spans several cells from going in twice
+ */
+void CPortals::MarkVisible( const double *proj_m, const double *model_m, const float *clip_mins, const float *clip_maxs ){
+	double A[16], planes[6][4];
+	float cell_mins[3], cell_maxs[3];
+	int i, j, x, y, z, lo[3], hi[3];
+	unsigned int k;
+
+	// the frustum planes in world space, w +- x, y, z >= 0 in clip space
+	matmul( A, proj_m, model_m );
+	for ( i = 0; i < 3; i++ )
+	{
+		for ( j = 0; j < 4; j++ )
+		{
+			planes[i * 2][j] = A[j * 4 + 3] + A[j * 4 + i];
+			planes[i * 2 + 1][j] = A[j * 4 + 3] - A[j * 4 + i];
+		}
+	}
+
+	visframe++;
+	sort_count = 0;
+
+	if ( clip_mins ) {
+		Grid_Range( *this, clip_mins, clip_maxs, lo, hi );
+	}
+	else
+	{
+		for ( i = 0; i < 3; i++ )
+		{
+			lo[i] = 0;
+			hi[i] = grid_size[i] - 1;
+		}
+	}
+
+	for ( z = lo[2]; z <= hi[2]; z++ )
+	{
+		for ( y = lo[1]; y <= hi[1]; y++ )
+		{
+			for ( x = lo[0]; x <= hi[0]; x++ )
+			{
+				cell_mins[0] = grid_origin[0] + x * grid_cell;
+				cell_mins[1] = grid_origin[1] + y * grid_cell;
+				cell_mins[2] = grid_origin[2] + z * grid_cell;
+				for ( i = 0; i < 3; i++ )
+					cell_maxs[i] = cell_mins[i] + grid_cell;
+
+				if ( Box_Outside( planes, cell_mins, cell_maxs ) ) {
+					continue;
+				}
+
+				int cell = ( z * grid_size[1] + y ) * grid_size[0] + x;
+				for ( k = grid_start[cell]; k < grid_start[cell + 1]; k++ )
+				{
+					CBspPortal &prt = portal[grid_portals[k]];
+
+					if ( prt.visframe == visframe ) {
+						continue;
+					}
+
+					if ( clip_mins ) {
+						if ( prt.min[0] > clip_maxs[0] || prt.min[1] > clip_maxs[1] || prt.min[2] > clip_maxs[2] ) {
+							continue;
+						}
+						if ( prt.max[0] < clip_mins[0] || prt.max[1] < clip_mins[1] || prt.max[2] < clip_mins[2] ) {
+							continue;
+						}
+					}
+
+					if ( Box_Outside( planes, prt.min, prt.max ) ) {
+						continue;
+					}
+
+					prt.visframe = visframe;
+					portal_sort[sort_count++] = grid_portals[k];
+				}
+			}
+		}
+	}
+}
+
 void CPortalsRender::Draw3D(){
 	if ( !portals.show_3d || portals.portal_count < 1 ) {
 		return;
@@ -618,10 +995,12 @@ void CPortalsRender::Draw3D(){
 	double cam[3];
 	double proj_m[16];
 	double model_m[16];
-	float min_check[3];
-	float max_check[3];
+	float cam_f[3];
+	float clip_mins[3];
+	float clip_maxs[3];
 	float trans = ( 100.0f - portals.trans_3d ) / 100.0f;
 	int view[4];
+	int i;
 
 	g_QglTable.m_pfn_qglGetDoublev( GL_PROJECTION_MATRIX, proj_m );
 	g_QglTable.m_pfn_qglGetDoublev( GL_MODELVIEW_MATRIX, model_m );
@@ -629,18 +1008,22 @@ void CPortalsRender::Draw3D(){
 
 	UnProject( 0.5 * (double)view[2], 0.5 * (double)view[3], 0.0, model_m, proj_m, view, cam, cam + 1, cam + 2 );
 
-	min_check[0] = (float)cam[0] + ( portals.clip_range * 64.0f );
-	min_check[1] = (float)cam[1] + ( portals.clip_range * 64.0f );
-	min_check[2] = (float)cam[2] + ( portals.clip_range * 64.0f );
-	max_check[0] = (float)cam[0] - ( portals.clip_range * 64.0f );
-	max_check[1] = (float)cam[1] - ( portals.clip_range * 64.0f );
-	max_check[2] = (float)cam[2] - ( portals.clip_range * 64.0f );
+	for ( i = 0; i < 3; i++ )
+	{
+		cam_f[i] = (float)cam[i];
+		clip_mins[i] = cam_f[i] - ( portals.clip_range * 64.0f );
+		clip_maxs[i] = cam_f[i] + ( portals.clip_range * 64.0f );
+	}
+
+	portals.MarkVisible( proj_m, model_m, portals.clip ? clip_mins : NULL, clip_maxs );
 
 	g_QglTable.m_pfn_qglHint( GL_FOG_HINT, GL_NICEST );
 
 	g_QglTable.m_pfn_qglDisable( GL_CULL_FACE );
 
 	g_QglTable.m_pfn_qglDisable( GL_LINE_SMOOTH );
+
+	// the polygons go down as triangle fans, smoothing would outline their inner edges
 	g_QglTable.m_pfn_qglDisable( GL_POLYGON_SMOOTH );
 
 	g_QglTable.m_pfn_qglPolygonMode( GL_FRONT_AND_BACK, GL_FILL );
@@ -649,7 +1032,6 @@ void CPortalsRender::Draw3D(){
 
 	g_QglTable.m_pfn_qglEnable( GL_BLEND );
 	g_QglTable.m_pfn_qglBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
-	g_QglTable.m_pfn_qglEnable( GL_POLYGON_SMOOTH );
 
 	if ( portals.aa_3d ) {
 		g_QglTable.m_pfn_qglEnable( GL_LINE_SMOOTH );
@@ -689,146 +1071,78 @@ void CPortalsRender::Draw3D(){
 
 	g_QglTable.m_pfn_qglLineWidth( portals.width_3d * 0.5f );
 
-	unsigned int n, p;
+	unsigned int n, p, first;
 
 	if ( portals.polygons ) {
-		if ( portals.zbuffer != 0 ) {
-			float d;
+		// the transparency is baked into the colors
+		unsigned char alpha = (unsigned char)( std::max( 0.0f, std::min( trans, 1.0f ) ) * 255.0f );
+		if ( alpha != portals.color_alpha ) {
+			for ( n = 0; n < portals.point_total; n++ )
+				portals.point_colors[n * 4 + 3] = alpha;
+			portals.color_alpha = alpha;
+			portals.buffer_dirty = TRUE;
+		}
+	}
 
-			for ( n = 0; n < portals.portal_count; n++ )
-			{
-				d = (float)cam[0] - portals.portal[n].center.p[0];
-				portals.portal[n].dist = d * d;
+	Portals_BindArrays();
 
-				d = (float)cam[1] - portals.portal[n].center.p[1];
-				portals.portal[n].dist += d * d;
+	if ( portals.polygons ) {
+		if ( portals.zbuffer != 0 ) {
+			portals.SortPortals( cam_f );
+		}
 
-				d = (float)cam[2] - portals.portal[n].center.p[2];
-				portals.portal[n].dist += d * d;
+		s_indexes.clear();
 
-				portals.portal_sort[n] = n;
-			}
+		for ( n = 0; n < portals.sort_count; n++ )
+		{
+			const CBspPortal &prt = portals.portal[portals.portal_sort[n]];
 
-			qsort( portals.portal_sort, portals.portal_count, 4, compare );
+			if ( portals.polygons == 2 && !prt.hint ) {
+				continue;
+			}
 
-			for ( n = 0; n < portals.portal_count; n++ )
+			for ( p = 2; p < prt.point_count; p++ )
 			{
-				if ( portals.polygons == 2 && !portals.portal[portals.portal_sort[n]].hint ) {
-					continue;
-				}
-
-				if ( portals.clip ) {
-					if ( min_check[0] < portals.portal[portals.portal_sort[n]].min[0] ) {
-						continue;
-					}
-					else if ( min_check[1] < portals.portal[portals.portal_sort[n]].min[1] ) {
-						continue;
-					}
-					else if ( min_check[2] < portals.portal[portals.portal_sort[n]].min[2] ) {
-						continue;
-					}
-					else if ( max_check[0] > portals.portal[portals.portal_sort[n]].max[0] ) {
-						continue;
-					}
-					else if ( max_check[1] > portals.portal[portals.portal_sort[n]].max[1] ) {
-						continue;
-					}
-					else if ( max_check[2] > portals.portal[portals.portal_sort[n]].max[2] ) {
-						continue;
-					}
-				}
-
-				g_QglTable.m_pfn_qglColor4f( portals.portal[portals.portal_sort[n]].fp_color_random[0], portals.portal[portals.portal_sort[n]].fp_color_random[1],
-											 portals.portal[portals.portal_sort[n]].fp_color_random[2], trans );
-
-				g_QglTable.m_pfn_qglBegin( GL_POLYGON );
-
-				for ( p = 0; p < portals.portal[portals.portal_sort[n]].point_count; p++ )
-					g_QglTable.m_pfn_qglVertex3fv( portals.portal[portals.portal_sort[n]].point[p].p );
-
-				g_QglTable.m_pfn_qglEnd();
+				s_indexes.push_back( prt.first_point );
+				s_indexes.push_back( prt.first_point + p - 1 );
+				s_indexes.push_back( prt.first_point + p );
 			}
 		}
-		else
-		{
-			for ( n = 0; n < portals.portal_count; n++ )
-			{
-				if ( portals.polygons == 2 && !portals.portal[n].hint ) {
-					continue;
-				}
-
-				if ( portals.clip ) {
-					if ( min_check[0] < portals.portal[n].min[0] ) {
-						continue;
-					}
-					else if ( min_check[1] < portals.portal[n].min[1] ) {
-						continue;
-					}
-					else if ( min_check[2] < portals.portal[n].min[2] ) {
-						continue;
-					}
-					else if ( max_check[0] > portals.portal[n].max[0] ) {
-						continue;
-					}
-					else if ( max_check[1] > portals.portal[n].max[1] ) {
-						continue;
-					}
-					else if ( max_check[2] > portals.portal[n].max[2] ) {
-						continue;
-					}
-				}
-
-				g_QglTable.m_pfn_qglColor4f( portals.portal[n].fp_color_random[0], portals.portal[n].fp_color_random[1],
-											 portals.portal[n].fp_color_random[2], trans );
-
-				g_QglTable.m_pfn_qglBegin( GL_POLYGON );
-
-				for ( p = 0; p < portals.portal[n].point_count; p++ )
-					g_QglTable.m_pfn_qglVertex3fv( portals.portal[n].point[p].p );
 
-				g_QglTable.m_pfn_qglEnd();
-			}
+		if ( !s_indexes.empty() ) {
+			g_QglTable.m_pfn_qglEnableClientState( GL_COLOR_ARRAY );
+			g_QglTable.m_pfn_qglDrawElements( GL_TRIANGLES, s_indexes.size(), GL_UNSIGNED_INT, &s_indexes[0] );
+			g_QglTable.m_pfn_qglDisableClientState( GL_COLOR_ARRAY );
 		}
 	}
 
 	if ( portals.lines ) {
 		g_QglTable.m_pfn_qglColor4fv( portals.fp_color_3d );
 
-		for ( n = 0; n < portals.portal_count; n++ )
+		s_indexes.clear();
+
+		for ( n = 0; n < portals.sort_count; n++ )
 		{
-			if ( portals.lines == 2 && !portals.portal[n].hint ) {
+			const CBspPortal &prt = portals.portal[portals.portal_sort[n]];
+
+			if ( portals.lines == 2 && !prt.hint ) {
 				continue;
 			}
 
-			if ( portals.clip ) {
-				if ( min_check[0] < portals.portal[n].min[0] ) {
-					continue;
-				}
-				else if ( min_check[1] < portals.portal[n].min[1] ) {
-					continue;
-				}
-				else if ( min_check[2] < portals.portal[n].min[2] ) {
-					continue;
-				}
-				else if ( max_check[0] > portals.portal[n].max[0] ) {
-					continue;
-				}
-				else if ( max_check[1] > portals.portal[n].max[1] ) {
-					continue;
-				}
-				else if ( max_check[2] > portals.portal[n].max[2] ) {
-					continue;
-				}
+			first = prt.first_point + prt.point_count;
+			for ( p = 0; p < prt.point_count; p++ )
+			{
+				s_indexes.push_back( first + p );
+				s_indexes.push_back( first + ( p + 1 ) % prt.point_count );
 			}
+		}
 
-			g_QglTable.m_pfn_qglBegin( GL_LINE_LOOP );
-
-			for ( p = 0; p < portals.portal[n].point_count; p++ )
-				g_QglTable.m_pfn_qglVertex3fv( portals.portal[n].inner_point[p].p );
-
-			g_QglTable.m_pfn_qglEnd();
+		if ( !s_indexes.empty() ) {
+			g_QglTable.m_pfn_qglDrawElements( GL_LINES, s_indexes.size(), GL_UNSIGNED_INT, &s_indexes[0] );
 		}
 	}
 
+	Portals_UnbindArrays();
+
 	g_QglTable.m_pfn_qglPopAttrib();
 }
@@ -20,6 +20,8 @@
 #ifndef _PORTALS_H_
 #define _PORTALS_H_
 
+#include <vector>
+
 class CBspPoint {
 public:
 float p[3];
@@ -35,6 +37,7 @@ protected:
 public:
 CBspPoint center;
 unsigned point_count;
+unsigned first_point;   // outer points in CPortals::points, the inner ones follow
 CBspPoint *point;
 CBspPoint *inner_point;
 float fp_color_random[4];
@@ -42,8 +45,9 @@ float min[3];
 float max[3];
 float dist;
 qboolean hint;
+unsigned visframe;      // CPortals::visframe when the portal last passed the culling
 
-qboolean Build( char *def );
+qboolean Build( char *def, std::vector<CBspPoint> &pool );
 };
 
 class CPortals {
@@ -62,6 +66,10 @@ void Purge();
 
 void FixColors();
 
+void BuildGrid();
+void SortPortals( const float *cam );
+void MarkVisible( const double *proj_m, const double *model_m, const float *clip_mins, const float *clip_maxs );
+
 char fn[_MAX_PATH];
 
 int zbuffer;
@@ -86,12 +94,29 @@ float width_2d;      // in 8'ths
 float fp_color_2d[4];
 
 CBspPortal *portal;
-int *portal_sort;
+int *portal_sort;      // the portals MarkVisible found, back to front after SortPortals
+unsigned int sort_count;
 qboolean hint_flags;
 //	CBspNode *node;
 
 unsigned int node_count;
 unsigned int portal_count;
+
+// every portal point in one block, drawn from a buffer object when there is one
+CBspPoint *points;
+unsigned char *point_colors;    // RGBA per point, the alpha is the polygon transparency
+unsigned int point_total;
+unsigned int buffer;
+qboolean buffer_dirty;
+unsigned char color_alpha;
+
+// uniform grid over the portal bounds, grid_start[cell] .. grid_start[cell + 1] in grid_portals
+float grid_origin[3];
+float grid_cell;
+int grid_size[3];
+unsigned int *grid_start;
+unsigned int *grid_portals;
+unsigned int visframe;
 };
 
 class CPortalsRender : public IGL2DWindow, public IGL3DWindow {
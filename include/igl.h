@@ -150,6 +150,24 @@ typedef void ( APIENTRY * PFN_QGLVIEWPORT )( GLint x, GLint y, GLsizei width, GL
 
 typedef void ( WINAPI * PFN_QE_CHECKOPENGLFORERRORS )();
 
+// GL_ARB_vertex_buffer_object
+// the extension is loaded once the first GL context exists, so these go through Radiant and are
+// safe to call at any time, QERApp_HasBufferObjects tells if they do anything
+#ifndef GL_ARRAY_BUFFER_ARB
+#define GL_ARRAY_BUFFER_ARB               0x8892
+#endif
+#ifndef GL_ELEMENT_ARRAY_BUFFER_ARB
+#define GL_ELEMENT_ARRAY_BUFFER_ARB       0x8893
+#endif
+#ifndef GL_STATIC_DRAW_ARB
+#define GL_STATIC_DRAW_ARB                0x88E4
+#endif
+typedef bool ( WINAPI * PFN_QERAPP_HASBUFFEROBJECTS )();
+typedef void ( WINAPI * PFN_QGLBINDBUFFERARB )( GLenum target, GLuint buffer );
+typedef void ( WINAPI * PFN_QGLDELETEBUFFERSARB )( GLsizei n, const GLuint *buffers );
+typedef void ( WINAPI * PFN_QGLGENBUFFERSARB )( GLsizei n, GLuint *buffers );
+typedef void ( WINAPI * PFN_QGLBUFFERDATAARB )( GLenum target, ptrdiff_t size, const GLvoid *data, GLenum usage );
+
 // glu stuff
 // TTimo: NOTE: relying on glu might not be such a good idea. On many systems, the GLU lib is outdated, misversioned etc.
 typedef void ( APIENTRY * PFN_QGLUPERSPECTIVE )( GLdouble fovy, GLdouble aspect, GLdouble zNear, GLdouble zFar );
@@ -265,6 +283,13 @@ struct _QERQglTable
 	PFN_QERAPP_UNHOOKGL2DWINDOW m_pfnUnHookGL2DWindow;
 	PFN_QERAPP_HOOKGL3DWINDOW m_pfnHookGL3DWindow;
 	PFN_QERAPP_UNHOOKGL3DWINDOW m_pfnUnHookGL3DWindow;
+
+	// buffer objects
+	PFN_QERAPP_HASBUFFEROBJECTS m_pfnHasBufferObjects;
+	PFN_QGLBINDBUFFERARB m_pfn_qglBindBufferARB;
+	PFN_QGLDELETEBUFFERSARB m_pfn_qglDeleteBuffersARB;
+	PFN_QGLGENBUFFERSARB m_pfn_qglGenBuffersARB;
+	PFN_QGLBUFFERDATAARB m_pfn_qglBufferDataARB;
 };
 
 #endif
@@ -69,6 +69,9 @@ typedef struct entity_s entity_t;
 #define DRAW_RF_SEL_FILL      0x0010
 #define DRAW_RF_XY            0x0011
 #define DRAW_RF_CAM           0x0100
+// simplified mesh to draw, for models that have them, 0 is the full model
+#define DRAW_RF_LOD_MASK      0x3000
+#define DRAW_RF_LOD_SHIFT     12
 
 class IRender
 {
@@ -79,6 +82,7 @@ virtual void DecRef() = 0;   // decrements the reference counter for this object
 virtual void Draw( int state, int rflags ) const = 0; // render the object - state = the opengl state
 virtual const bool IsModelNotNull() const = 0;
 virtual const aabb_t *GetAABB() const = 0;
+virtual int GetTriangleCount( int rflags ) const { return 0; } // triangles Draw sends with these render flags, 0 if unknown
 };
 
 class ISelect
@@ -490,6 +490,14 @@ typedef const char* ( *PFN_QERAPP_READPROJECTKEY )( const char* key );
 
 typedef char* ( *PFN_GETMAPFILENAME )();
 
+/*!
+   \fn LoadTexture
+   \param name vfs path of the image, the extension is optional
+   loads the image through the image modules (or the on-disk texture cache) and creates the GL texture
+   \return NULL if the image could not be loaded
+ */
+typedef qtexture_t* ( *PFN_QERAPP_LOADTEXTURE )( const char *name );
+
 typedef bfilter_t* ( *PFN_QERPLUG_FILTERADD )( int type, int bmask, const char *str, int exclude );
 
 typedef void ( *PFN_QERPLUG_FILTERACTIVATE )( void );
@@ -629,6 +637,8 @@ struct _QERFuncTable_1
 
 	// digibob from the old _QERAppBSPFrontendTable table
 	PFN_GETMAPFILENAME m_pfnGetMapName;
+
+	PFN_QERAPP_LOADTEXTURE m_pfnLoadTexture;
 };
 
 // macros to access those faster in plugins
@@ -435,7 +435,7 @@ typedef struct {
 	bool rowDirty[( ( MAX_PATCH_WIDTH - 1 ) - 1 ) / 2];
 	bool colDirty[( ( MAX_PATCH_HEIGHT - 1 ) - 1 ) / 2];
 	bool LODUpdated;
-	void *drawLists; // pointer to std::list
+	void *drawLists; // pointer to the flat tessellation built from the LOD trees (patchTess_t in pmesh.cpp)
 } patchMesh_t;
 
 typedef struct brush_s
@@ -474,6 +474,13 @@ typedef struct brush_s
 	bool bFiltered;
 	bool bCamCulled;
 	bool bBrushDef;
+
+	// head of the list prev/next link into, kept by Brush_AddToList and Brush_SetList
+	struct brush_s *list;
+	// spatial index entry, owned by brushindex.cpp
+	void *pIndexEntry;
+	// cached camera geometry, owned by brushrender.cpp
+	void *pRenderCache;
 } brush_t;
 
 #define MAX_FLAGS   16
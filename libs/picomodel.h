@@ -122,6 +122,12 @@ struct picoSurface_s
 	picoVec3_t                  *faceNormal;
 
 	int special[ PICO_MAX_SPECIAL ];
+
+	/* PicoFindSurfaceVertexNum lookup: chains of vertex numbers by attribute hash, filled in as vertexes are added */
+	int                         *vertexHashHeads;
+	int                         *vertexHashNext;
+	int vertexHashSize, numHashedVertexes, maxHashedVertexes;
+	int vertexHashSTs, vertexHashColors;    /* st and color arrays the hashes cover */
 };
 
 
@@ -186,6 +192,9 @@ enum
 #define PM_PARAMS_SAVE \
 	const char *fileName, picoModel_t * model
 
+/* module flags */
+#define PICO_MODULE_READONLY_BUFFER 1   /* load never writes to the buffer nor needs it 0-terminated, so it can parse a file mapping */
+
 /* pico file format module structure */
 struct picoModule_s
 {
@@ -200,6 +209,7 @@ struct picoModule_s
 	picoModel_t             *( *load )( PM_PARAMS_LOAD );             /* parses model file data */
 	int ( *cansave )( PM_PARAMS_CANSAVE );                          /* checks whether module can save (returns 1 or 0 and might spit out a message) */
 	int ( *save )( PM_PARAMS_SAVE );                                /* saves a pico model in module's native model format */
+	int flags;                                                      /* PICO_MODULE_* */
 };
 
 
@@ -213,6 +223,8 @@ void                        PicoSetMallocFunc( void *( *func )( size_t ) );
 void                        PicoSetFreeFunc( void ( *func )( void* ) );
 void                        PicoSetLoadFileFunc( void ( *func )( const char*, unsigned char**, int* ) );
 void                        PicoSetFreeFileFunc( void ( *func )( void* ) );
+void                        PicoSetMapFileFunc( void ( *func )( const char*, const unsigned char**, int* ) );
+void                        PicoSetUnmapFileFunc( void ( *func )( const void* ) );
 void                        PicoSetPrintFunc( void ( *func )( int, const char* ) );
 
 const picoModule_t          **PicoModuleList( int *numModules );
@@ -24,7 +24,7 @@
 
 #define FLEN_ERROR INT_MIN
 
-static int flen;
+static PICO_THREAD_LOCAL int flen;
 
 void set_flen( int i ) { flen = i; }
 
@@ -54,6 +54,8 @@ void *( *_pico_ptr_malloc    )( size_t ) = malloc;
 void ( *_pico_ptr_free      )( void* ) = free;
 void ( *_pico_ptr_load_file )( const char*, unsigned char**, int* ) = NULL;
 void ( *_pico_ptr_free_file )( void* ) = NULL;
+void ( *_pico_ptr_map_file  )( const char*, const unsigned char**, int* ) = NULL;
+void ( *_pico_ptr_unmap_file )( const void* ) = NULL;
 void ( *_pico_ptr_print     )( int, const char* ) = NULL;
 
 typedef union
@@ -234,6 +236,32 @@ void _pico_free_file( void *buffer ){
 	_pico_ptr_free_file( buffer );
 }
 
+/* _pico_map_file:
+ * wrapper around the mapfile function pointer, the buffer is read-only
+ * and not 0-terminated; bufSize is -1 if the host can't map files
+ */
+void _pico_map_file( const char *name, const unsigned char **buffer, int *bufSize ){
+	/* sanity checks */
+	*buffer = NULL;
+	if ( name == NULL || _pico_ptr_map_file == NULL || _pico_ptr_unmap_file == NULL ) {
+		*bufSize = -1;
+		return;
+	}
+	/* BUFFER IS OWNED BY THE EXTERNAL MAPFILE FUNC */
+	_pico_ptr_map_file( name,buffer,bufSize );
+}
+
+/* _pico_unmap_file:
+ * wrapper around the file unmap function pointer
+ */
+void _pico_unmap_file( const void *buffer ){
+	/* sanity checks */
+	if ( buffer == NULL || _pico_ptr_unmap_file == NULL ) {
+		return;
+	}
+	_pico_ptr_unmap_file( buffer );
+}
+
 /* _pico_printf:
  * wrapper around the print function pointer -sea
  */
@@ -66,6 +66,17 @@ extern "C"
 #endif
 
 
+/* per-thread storage for the little file-scope state the loaders keep, */
+/* so models can be loaded on several threads at once */
+#if defined( _MSC_VER )
+	#define PICO_THREAD_LOCAL __declspec( thread )
+#elif defined( __GNUC__ )
+	#define PICO_THREAD_LOCAL __thread
+#else
+	#define PICO_THREAD_LOCAL
+#endif
+
+
 /* constants */
 #define PICO_PI 3.14159265358979323846
 
@@ -107,6 +118,8 @@ extern void                 *( *_pico_ptr_malloc )( size_t );
 extern void ( *_pico_ptr_free )( void* );
 extern void ( *_pico_ptr_load_file )( const char*, unsigned char**, int* );
 extern void ( *_pico_ptr_free_file )( void* );
+extern void ( *_pico_ptr_map_file )( const char*, const unsigned char**, int* );
+extern void ( *_pico_ptr_unmap_file )( const void* );
 extern void ( *_pico_ptr_print )( int, const char* );
 
 
@@ -123,6 +136,8 @@ void            _pico_free( void *ptr );
 /* files */
 void            _pico_load_file( const char *name, unsigned char **buffer, int *bufSize );
 void            _pico_free_file( void *buffer );
+void            _pico_map_file( const char *name, const unsigned char **buffer, int *bufSize );
+void            _pico_unmap_file( const void *buffer );
 
 /* strings */
 void			_pico_first_token(char *str);
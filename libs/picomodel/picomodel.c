@@ -132,6 +132,33 @@ void PicoSetFreeFileFunc( void ( *func )( void* ) ){
 
 
 
+/*
+   PicoSetMapFileFunc()
+   sets the ptr to the file map function, which hands out a read-only
+   buffer that is not 0-terminated (e.g. an mmap'ed file)
+ */
+
+void PicoSetMapFileFunc( void ( *func )( const char*, const unsigned char**, int* ) ){
+	if ( func != NULL ) {
+		_pico_ptr_map_file = func;
+	}
+}
+
+
+
+/*
+   PicoSetUnmapFileFunc()
+   sets the ptr to the function releasing a mapped file
+ */
+
+void PicoSetUnmapFileFunc( void ( *func )( const void* ) ){
+	if ( func != NULL ) {
+		_pico_ptr_unmap_file = func;
+	}
+}
+
+
+
 /*
    PicoSetPrintFunc()
    sets the ptr to the print function
@@ -183,6 +210,41 @@ picoModel_t *PicoModuleLoadModel( const picoModule_t* pm, const char* fileName,
 	return NULL;
 }
 
+/*
+   PicoModuleCanMapFile()
+   returns the module that reads files with the extension of fileName
+   straight from a read-only buffer, NULL if there is none
+ */
+
+static const picoModule_t *PicoModuleCanMapFile( const char *fileName ){
+	const picoModule_t  **modules;
+	const char          *ext;
+	int i;
+
+
+	/* get the extension */
+	ext = strrchr( fileName, '.' );
+	if ( ext == NULL || strpbrk( ext, "/\\" ) != NULL ) {
+		return NULL;
+	}
+	ext++;
+
+	for ( modules = PicoModuleList( NULL ); *modules != NULL; modules++ )
+	{
+		if ( !( ( *modules )->flags & PICO_MODULE_READONLY_BUFFER ) ) {
+			continue;
+		}
+		for ( i = 0; i < PICO_MAX_DEFAULT_EXTS && ( *modules )->defaultExts[ i ] != NULL; i++ )
+		{
+			if ( !_pico_stricmp( ( *modules )->defaultExts[ i ], ext ) ) {
+				return *modules;
+			}
+		}
+	}
+
+	return NULL;
+}
+
 /*
    PicoLoadModel()
    the meat and potatoes function
@@ -192,6 +254,7 @@ picoModel_t *PicoLoadModel( const char *fileName, int frameNum ){
 	const picoModule_t  **modules, *pm;
 	picoModel_t         *model;
 	picoByte_t          *buffer;
+	const picoByte_t    *mapped;
 	int bufSize;
 
 
@@ -204,6 +267,20 @@ picoModel_t *PicoLoadModel( const char *fileName, int frameNum ){
 		return NULL;
 	}
 
+	/* binary formats that never write to their buffer are parsed straight */
+	/* from a file mapping if the host can map files, so nothing is copied */
+	pm = PicoModuleCanMapFile( fileName );
+	if ( pm != NULL ) {
+		_pico_map_file( fileName, &mapped, &bufSize );
+		if ( bufSize >= 0 ) {
+			model = PicoModuleLoadModel( pm, fileName, (picoByte_t*) mapped, bufSize, frameNum );
+			_pico_unmap_file( mapped );
+			if ( model != NULL ) {
+				return model;
+			}
+		}
+	}
+
 	/* load file data (buffer is allocated by host app) */
 	_pico_load_file( fileName, &buffer, &bufSize );
 	if ( bufSize < 0 ) {
@@ -581,6 +658,8 @@ void PicoFreeSurface( picoSurface_t *surface ){
 	_pico_free( surface->smoothingGroup );
 	_pico_free( surface->index );
 	_pico_free( surface->faceNormal );
+	_pico_free( surface->vertexHashHeads );
+	_pico_free( surface->vertexHashNext );
 
 	if ( surface->name ) {
 		_pico_free( surface->name );
@@ -627,10 +706,12 @@ int PicoAdjustSurface( picoSurface_t *surface, int numVertexes, int numSTArrays,
 		numIndexes = 1;
 	}
 
-	/* additional vertexes? */
-	while ( numVertexes > surface->maxVertexes ) /* fix */
-	{
-		surface->maxVertexes += PICO_GROW_VERTEXES;
+	/* additional vertexes? grow by half again, so big models don't copy their vertexes over and over */
+	if ( numVertexes > surface->maxVertexes ) {
+		surface->maxVertexes += ( surface->maxVertexes / 2 > PICO_GROW_VERTEXES ) ? surface->maxVertexes / 2 : PICO_GROW_VERTEXES;
+		if ( surface->maxVertexes < numVertexes ) {
+			surface->maxVertexes = numVertexes;
+		}
 		if ( !_pico_realloc( (void *) &surface->xyz, surface->numVertexes * sizeof( *surface->xyz ), surface->maxVertexes * sizeof( *surface->xyz ) ) ) {
 			return 0;
 		}
@@ -686,9 +767,11 @@ int PicoAdjustSurface( picoSurface_t *surface, int numVertexes, int numSTArrays,
 	}
 
 	/* additional indexes? */
-	while ( numIndexes > surface->maxIndexes ) /* fix */
-	{
-		surface->maxIndexes += PICO_GROW_INDEXES;
+	if ( numIndexes > surface->maxIndexes ) {
+		surface->maxIndexes += ( surface->maxIndexes / 2 > PICO_GROW_INDEXES ) ? surface->maxIndexes / 2 : PICO_GROW_INDEXES;
+		if ( surface->maxIndexes < numIndexes ) {
+			surface->maxIndexes = numIndexes;
+		}
 		if ( !_pico_realloc( (void*) &surface->index, surface->numIndexes * sizeof( *surface->index ), surface->maxIndexes * sizeof( *surface->index ) ) ) {
 			return 0;
 		}
@@ -1594,66 +1677,215 @@ picoVertexCombinationHash_t *PicoAddVertexCombinationToHashTable( picoVertexComb
    ---------------------------------------------------------------------------- */
 
 /*
-   PicoFindSurfaceVertex()
-   finds a vertex matching the set parameters
-   fixme: needs non-naive algorithm
+   _pico_vertex_matches()
+   compares vertex num with the set parameters, NULL parameters match anything
  */
 
-int PicoFindSurfaceVertexNum( picoSurface_t *surface, picoVec3_t xyz, picoVec3_t normal, int numSTs, picoVec2_t *st, int numColors, picoColor_t *color, picoIndex_t smoothingGroup ){
-	int i, j;
+static int _pico_vertex_matches( picoSurface_t *surface, int num, picoVec3_t xyz, picoVec3_t normal, int numSTs, picoVec2_t *st, int numColors, picoColor_t *color, picoIndex_t smoothingGroup ){
+	int j;
 
 
-	/* dummy check */
-	if ( surface == NULL || surface->numVertexes <= 0 ) {
-		return -1;
+	/* check xyz */
+	if ( xyz != NULL && ( surface->xyz[ num ][ 0 ] != xyz[ 0 ] || surface->xyz[ num ][ 1 ] != xyz[ 1 ] || surface->xyz[ num ][ 2 ] != xyz[ 2 ] ) ) {
+		return 0;
 	}
 
-	/* walk vertex list */
-	for ( i = 0; i < surface->numVertexes; i++ )
-	{
-		/* check xyz */
-		if ( xyz != NULL && ( surface->xyz[ i ][ 0 ] != xyz[ 0 ] || surface->xyz[ i ][ 1 ] != xyz[ 1 ] || surface->xyz[ i ][ 2 ] != xyz[ 2 ] ) ) {
-			continue;
+	/* check normal */
+	if ( normal != NULL && ( surface->normal[ num ][ 0 ] != normal[ 0 ] || surface->normal[ num ][ 1 ] != normal[ 1 ] || surface->normal[ num ][ 2 ] != normal[ 2 ] ) ) {
+		return 0;
+	}
+
+	/* check smoothing group */
+	if ( surface->smoothingGroup[ num ] != smoothingGroup ) {
+		return 0;
+	}
+
+	/* check st */
+	if ( numSTs > 0 && st != NULL ) {
+		for ( j = 0; j < numSTs; j++ )
+		{
+			if ( surface->st[ j ][ num ][ 0 ] != st[ j ][ 0 ] || surface->st[ j ][ num ][ 1 ] != st[ j ][ 1 ] ) {
+				return 0;
+			}
 		}
+	}
 
-		/* check normal */
-		if ( normal != NULL && ( surface->normal[ i ][ 0 ] != normal[ 0 ] || surface->normal[ i ][ 1 ] != normal[ 1 ] || surface->normal[ i ][ 2 ] != normal[ 2 ] ) ) {
-			continue;
+	/* check color */
+	if ( numColors > 0 && color != NULL ) {
+		for ( j = 0; j < numColors; j++ )
+		{
+			if ( memcmp( surface->color[ j ][ num ], color[ j ], sizeof( picoColor_t ) ) ) {
+				return 0;
+			}
 		}
+	}
 
-		/* check normal */
-		if ( surface->smoothingGroup[ i ] != smoothingGroup ) {
-			continue;
+	/* vertex matches */
+	return 1;
+}
+
+
+/*
+   vertex hashing
+   hashes the exact bits of every attribute, so -0 is folded into 0 as the compares above treat them alike
+ */
+
+#define PICO_HASH_PRIME         16777619u
+#define PICO_MIN_VERTEX_HASH    1024
+
+static unsigned int _pico_hash_vec( unsigned int hash, const picoVec_t *v, int n ){
+	unsigned int w[ sizeof( picoVec_t ) / sizeof( unsigned int ) ];
+	picoVec_t f;
+	int i, k;
+
+
+	for ( i = 0; i < n; i++ )
+	{
+		f = v[ i ];
+		if ( f == 0 ) {
+			f = 0;
 		}
+		memcpy( w, &f, sizeof( f ) );
+		for ( k = 0; k < (int)( sizeof( w ) / sizeof( w[ 0 ] ) ); k++ )
+			hash = ( hash ^ w[ k ] ) * PICO_HASH_PRIME;
+	}
+	return hash;
+}
 
-		/* check st */
-		if ( numSTs > 0 && st != NULL ) {
-			for ( j = 0; j < numSTs; j++ )
-			{
-				if ( surface->st[ j ][ i ][ 0 ] != st[ j ][ 0 ] || surface->st[ j ][ i ][ 1 ] != st[ j ][ 1 ] ) {
-					break;
-				}
-			}
-			if ( j != numSTs ) {
-				continue;
-			}
+static unsigned int _pico_hash_color( unsigned int hash, const picoByte_t *c ){
+	int k;
+
+
+	for ( k = 0; k < 4; k++ )
+		hash = ( hash ^ c[ k ] ) * PICO_HASH_PRIME;
+	return hash;
+}
+
+static unsigned int _pico_vertex_hash( picoVec3_t xyz, picoVec3_t normal, int numSTs, picoVec2_t *st, int numColors, picoColor_t *color, picoIndex_t smoothingGroup ){
+	unsigned int hash = 2166136261u;
+	int j;
+
+
+	hash = _pico_hash_vec( hash, xyz, 3 );
+	hash = _pico_hash_vec( hash, normal, 3 );
+	hash = ( hash ^ (unsigned int) smoothingGroup ) * PICO_HASH_PRIME;
+	for ( j = 0; j < numSTs; j++ )
+		hash = _pico_hash_vec( hash, st[ j ], 2 );
+	for ( j = 0; j < numColors; j++ )
+		hash = _pico_hash_color( hash, color[ j ] );
+	return hash;
+}
+
+static unsigned int _pico_surface_vertex_hash( picoSurface_t *surface, int num ){
+	unsigned int hash = 2166136261u;
+	int j;
+
+
+	hash = _pico_hash_vec( hash, surface->xyz[ num ], 3 );
+	hash = _pico_hash_vec( hash, surface->normal[ num ], 3 );
+	hash = ( hash ^ (unsigned int) surface->smoothingGroup[ num ] ) * PICO_HASH_PRIME;
+	for ( j = 0; j < surface->vertexHashSTs; j++ )
+		hash = _pico_hash_vec( hash, surface->st[ j ][ num ], 2 );
+	for ( j = 0; j < surface->vertexHashColors; j++ )
+		hash = _pico_hash_color( hash, surface->color[ j ][ num ] );
+	return hash;
+}
+
+/*
+   _pico_update_vertex_hash()
+   hashes the vertexes added since the last lookup, starting over if the table
+   has to grow or the lookups cover other st or color arrays than before
+ */
+
+static int _pico_update_vertex_hash( picoSurface_t *surface, int numSTs, int numColors ){
+	int i, size;
+	unsigned int hash;
+
+
+	/* start over? */
+	size = surface->vertexHashSize;
+	while ( size < surface->numVertexes )
+		size = ( size > 0 ) ? size * 2 : PICO_MIN_VERTEX_HASH;
+	if ( size != surface->vertexHashSize || numSTs != surface->vertexHashSTs || numColors != surface->vertexHashColors ) {
+		_pico_free( surface->vertexHashHeads );
+		surface->vertexHashHeads = _pico_alloc( size * sizeof( *surface->vertexHashHeads ) );
+		if ( surface->vertexHashHeads == NULL ) {
+			surface->vertexHashSize = 0;
+			return 0;
 		}
+		surface->vertexHashSize = size;
+		surface->vertexHashSTs = numSTs;
+		surface->vertexHashColors = numColors;
+		surface->numHashedVertexes = 0;
+		for ( i = 0; i < size; i++ )
+			surface->vertexHashHeads[ i ] = -1;
+	}
 
-		/* check color */
-		if ( numColors > 0 && color != NULL ) {
-			for ( j = 0; j < numSTs; j++ )
-			{
-				if ( *( (int*) surface->color[ j ] ) != *( (int*) color[ j ] ) ) {
-					break;
-				}
-			}
-			if ( j != numColors ) {
-				continue;
+	/* chain links */
+	if ( surface->numVertexes > surface->maxHashedVertexes ) {
+		if ( !_pico_realloc( (void *) &surface->vertexHashNext, surface->maxHashedVertexes * sizeof( *surface->vertexHashNext ), surface->maxVertexes * sizeof( *surface->vertexHashNext ) ) ) {
+			return 0;
+		}
+		surface->maxHashedVertexes = surface->maxVertexes;
+	}
+
+	/* hash the new vertexes */
+	for ( i = surface->numHashedVertexes; i < surface->numVertexes; i++ )
+	{
+		hash = _pico_surface_vertex_hash( surface, i ) & ( surface->vertexHashSize - 1 );
+		surface->vertexHashNext[ i ] = surface->vertexHashHeads[ hash ];
+		surface->vertexHashHeads[ hash ] = i;
+	}
+	surface->numHashedVertexes = surface->numVertexes;
+
+	return 1;
+}
+
+
+/*
+   PicoFindSurfaceVertex()
+   finds a vertex matching the set parameters
+   vertexes are looked up by hash when every attribute is given, vertexes changed after
+   they were added may not be found that way, which only costs a duplicate
+ */
+
+int PicoFindSurfaceVertexNum( picoSurface_t *surface, picoVec3_t xyz, picoVec3_t normal, int numSTs, picoVec2_t *st, int numColors, picoColor_t *color, picoIndex_t smoothingGroup ){
+	int i;
+	unsigned int hash;
+
+
+	/* dummy check */
+	if ( surface == NULL || surface->numVertexes <= 0 ) {
+		return -1;
+	}
+
+	/* the st and color arrays that take part */
+	if ( numSTs < 0 || st == NULL ) {
+		numSTs = 0;
+	}
+	if ( numColors < 0 || color == NULL ) {
+		numColors = 0;
+	}
+
+	/* hashed lookup */
+	if ( xyz != NULL && normal != NULL && numSTs <= surface->numSTArrays && numColors <= surface->numColorArrays
+		 && _pico_update_vertex_hash( surface, numSTs, numColors ) ) {
+		hash = _pico_vertex_hash( xyz, normal, numSTs, st, numColors, color, smoothingGroup ) & ( surface->vertexHashSize - 1 );
+		for ( i = surface->vertexHashHeads[ hash ]; i >= 0; i = surface->vertexHashNext[ i ] )
+		{
+			if ( _pico_vertex_matches( surface, i, xyz, normal, numSTs, st, numColors, color, smoothingGroup ) ) {
+				return i;
 			}
 		}
+		return -1;
+	}
 
-		/* vertex matches */
-		return i;
+	/* walk vertex list */
+	for ( i = 0; i < surface->numVertexes; i++ )
+	{
+		if ( _pico_vertex_matches( surface, i, xyz, normal, numSTs, st, numColors, color, smoothingGroup ) ) {
+			return i;
+		}
 	}
 
 	/* nada */
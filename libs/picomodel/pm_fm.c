@@ -65,11 +65,16 @@ typedef struct index_DUP_LUT_s
 // _fm_canload()
 static int _fm_canload( PM_PARAMS_CANLOAD ){
 	fm_t fm;
-	unsigned char *bb, *bb0;
+	const unsigned char *bb;
 	int fm_file_pos;
 
-	bb0 = bb = (picoByte_t*) _pico_alloc( bufSize );
-	memcpy( bb, buffer, bufSize );
+	/* sanity check */
+	if ( (size_t) bufSize < sizeof( fm_chunk_header_t ) * 5 ) {
+		return PICO_PMV_ERROR_SIZE;
+	}
+
+	/* the chunk headers are only read, so there is no need to copy the buffer */
+	bb = (const unsigned char *) buffer;
 
 	// Header
 	fm.fm_header_hdr = (fm_chunk_header_t *) bb;
@@ -81,7 +86,6 @@ static int _fm_canload( PM_PARAMS_CANLOAD ){
 #ifdef FM_DBG
 		_pico_printf( PICO_WARNING, "FM Header Ident incorrect\n" );
 #endif
-		_pico_free( bb0 );
 		return PICO_PMV_ERROR_IDENT;
 	}
 
@@ -90,7 +94,6 @@ static int _fm_canload( PM_PARAMS_CANLOAD ){
 #ifdef FM_DBG
 		_pico_printf( PICO_WARNING, "FM Header Version incorrect\n" );
 #endif
-		_pico_free( bb0 );
 		return PICO_PMV_ERROR_VERSION;
 	}
 
@@ -104,7 +107,6 @@ static int _fm_canload( PM_PARAMS_CANLOAD ){
 #ifdef FM_DBG
 		_pico_printf( PICO_WARNING, "FM Skin Ident incorrect\n" );
 #endif
-		_pico_free( bb0 );
 		return PICO_PMV_ERROR_IDENT;
 	}
 
@@ -113,7 +115,6 @@ static int _fm_canload( PM_PARAMS_CANLOAD ){
 #ifdef FM_DBG
 		_pico_printf( PICO_WARNING, "FM Skin Version incorrect\n" );
 #endif
-		_pico_free( bb0 );
 		return PICO_PMV_ERROR_VERSION;
 	}
 
@@ -127,7 +128,6 @@ static int _fm_canload( PM_PARAMS_CANLOAD ){
 #ifdef FM_DBG
 		_pico_printf( PICO_WARNING, "FM ST Ident incorrect\n" );
 #endif
-		_pico_free( bb0 );
 		return PICO_PMV_ERROR_IDENT;
 	}
 
@@ -136,7 +136,6 @@ static int _fm_canload( PM_PARAMS_CANLOAD ){
 #ifdef FM_DBG
 		_pico_printf( PICO_WARNING, "FM ST Version incorrect\n" );
 #endif
-		_pico_free( bb0 );
 		return PICO_PMV_ERROR_VERSION;
 	}
 
@@ -150,7 +149,6 @@ static int _fm_canload( PM_PARAMS_CANLOAD ){
 #ifdef FM_DBG
 		_pico_printf( PICO_WARNING, "FM Tri Ident incorrect\n" );
 #endif
-		_pico_free( bb0 );
 		return PICO_PMV_ERROR_IDENT;
 	}
 
@@ -159,7 +157,6 @@ static int _fm_canload( PM_PARAMS_CANLOAD ){
 #ifdef FM_DBG
 		_pico_printf( PICO_WARNING, "FM Tri Version incorrect\n" );
 #endif
-		_pico_free( bb0 );
 		return PICO_PMV_ERROR_VERSION;
 	}
 
@@ -173,7 +170,6 @@ static int _fm_canload( PM_PARAMS_CANLOAD ){
 #ifdef FM_DBG
 		_pico_printf( PICO_WARNING, "FM Frame Ident incorrect\n" );
 #endif
-		_pico_free( bb0 );
 		return PICO_PMV_ERROR_IDENT;
 	}
 
@@ -182,7 +178,6 @@ static int _fm_canload( PM_PARAMS_CANLOAD ){
 #ifdef FM_DBG
 		_pico_printf( PICO_WARNING, "FM Frame Version incorrect\n" );
 #endif
-		_pico_free( bb0 );
 		return PICO_PMV_ERROR_VERSION;
 	}
 
@@ -196,21 +191,22 @@ static int _fm_canload( PM_PARAMS_CANLOAD ){
 static picoModel_t *_fm_load( PM_PARAMS_LOAD ){
 	int i, j, dups, dup_index;
 	int fm_file_pos;
-	short tot_numVerts;
 	index_LUT_t     *p_index_LUT, *p_index_LUT2, *p_index_LUT3;
 	index_DUP_LUT_t *p_index_LUT_DUPS;
 
-	fm_vert_normal_t    *vert;
+	const fm_vert_normal_t  *vert;
 
 	char skinname[FM_SKINPATHSIZE];
 	fm_t fm;
-	fm_header_t     *fm_head;
-	fm_st_t         *texCoord;
+	fm_header_t     header, *fm_head;
+	const fm_st_t   *texCoord;
+	const fm_xyz_st_t *fm_tri;
 	fm_xyz_st_t     *tri_verts;
 	fm_xyz_st_t     *triangle;
-	fm_frame_t      *frame;
+	const fm_frame_t *frame;
+	float scale[ 3 ], translate[ 3 ];
 
-	picoByte_t      *bb, bb0;
+	const picoByte_t *bb;
 	picoModel_t *picoModel;
 	picoSurface_t   *picoSurface;
 	picoShader_t    *picoShader;
@@ -222,8 +218,8 @@ static picoModel_t *_fm_load( PM_PARAMS_LOAD ){
 	// fm loading
 	_pico_printf( PICO_NORMAL, "Loading \"%s\"", fileName );
 
-	bb0 = bb = (picoByte_t*) _pico_alloc( bufSize );
-	memcpy( bb, buffer, bufSize );
+	// the buffer may be a read-only file mapping, so it is never written to
+	bb = (const picoByte_t*) buffer;
 
 
 	// Header Header
@@ -231,13 +227,11 @@ static picoModel_t *_fm_load( PM_PARAMS_LOAD ){
 	fm_file_pos = sizeof( fm_chunk_header_t ) + fm.fm_header_hdr->size;
 	if ( ( strcmp( fm.fm_header_hdr->ident, FM_HEADERCHUNKNAME ) )  ) {
 		_pico_printf( PICO_WARNING, "FM Header Ident incorrect\n" );
-		_pico_free(bb0);
 		return NULL;
 	}
 
 	if ( _pico_little_long( fm.fm_header_hdr->version ) != FM_HEADERCHUNKVER ) {
 		_pico_printf( PICO_WARNING, "FM Header Version incorrect\n" );
-		_pico_free(bb0);
 		return NULL;
 	}
 
@@ -246,13 +240,11 @@ static picoModel_t *_fm_load( PM_PARAMS_LOAD ){
 	fm_file_pos += sizeof( fm_chunk_header_t ) + fm.fm_skin_hdr->size;
 	if ( ( strcmp( fm.fm_skin_hdr->ident, FM_SKINCHUNKNAME ) ) ) {
 		_pico_printf( PICO_WARNING, "FM Skin Ident incorrect\n" );
-		_pico_free(bb0);
 		return NULL;
 	}
 
 	if ( _pico_little_long( fm.fm_skin_hdr->version ) != FM_SKINCHUNKVER ) {
 		_pico_printf( PICO_WARNING, "FM Skin Version incorrect\n" );
-		_pico_free(bb0);
 		return NULL;
 	}
 
@@ -261,13 +253,11 @@ static picoModel_t *_fm_load( PM_PARAMS_LOAD ){
 	fm_file_pos += sizeof( fm_chunk_header_t ) + fm.fm_st_hdr->size;
 	if ( ( strcmp( fm.fm_st_hdr->ident, FM_STCOORDCHUNKNAME ) ) ) {
 		_pico_printf( PICO_WARNING, "FM ST Ident incorrect\n" );
-		_pico_free(bb0);
 		return NULL;
 	}
 
 	if ( _pico_little_long( fm.fm_st_hdr->version ) != FM_STCOORDCHUNKVER ) {
 		_pico_printf( PICO_WARNING, "FM ST Version incorrect\n" );
-		_pico_free(bb0);
 		return NULL;
 	}
 
@@ -277,12 +267,10 @@ static picoModel_t *_fm_load( PM_PARAMS_LOAD ){
 	if ( ( strcmp( fm.fm_tri_hdr->ident, FM_TRISCHUNKNAME ) ) ) {
 		_pico_printf( PICO_WARNING, "FM Tri Ident incorrect\n" );
 		return NULL;
-		_pico_free(bb0);
 	}
 
 	if ( _pico_little_long( fm.fm_tri_hdr->version ) != FM_TRISCHUNKVER ) {
 		_pico_printf( PICO_WARNING, "FM Tri Version incorrect\n" );
-		_pico_free(bb0);
 		return NULL;
 	}
 
@@ -291,19 +279,19 @@ static picoModel_t *_fm_load( PM_PARAMS_LOAD ){
 	fm_file_pos += sizeof( fm_chunk_header_t );
 	if ( ( strcmp( fm.fm_frame_hdr->ident, FM_FRAMESCHUNKNAME ) ) ) {
 		_pico_printf( PICO_WARNING, "FM Frame Ident incorrect\n" );
-		_pico_free(bb0);
 		return NULL;
 	}
 
 	if ( _pico_little_long( fm.fm_frame_hdr->version ) != FM_FRAMESCHUNKVER ) {
 		_pico_printf( PICO_WARNING, "FM Frame Version incorrect\n" );
-		_pico_free(bb0);
 		return NULL;
 	}
 
 	// Header
 	fm_file_pos = sizeof( fm_chunk_header_t );
-	fm_head = fm.fm_header = (fm_header_t *) ( bb + fm_file_pos );
+	fm.fm_header = (fm_header_t *) ( bb + fm_file_pos );
+	memcpy( &header, fm.fm_header, sizeof( header ) );
+	fm_head = &header;
 	fm_file_pos += fm.fm_header_hdr->size;
 
 	// Skin
@@ -318,25 +306,12 @@ static picoModel_t *_fm_load( PM_PARAMS_LOAD ){
 
 	// Tri
 	fm_file_pos += sizeof( fm_chunk_header_t );
-	tri_verts = fm.fm_tri = (fm_xyz_st_t *) ( bb + fm_file_pos );
+	fm_tri = fm.fm_tri = (fm_xyz_st_t *) ( bb + fm_file_pos );
 	fm_file_pos += fm.fm_tri_hdr->size;
 
 	// Frame
 	fm_file_pos += sizeof( fm_chunk_header_t );
-	frame = fm.fm_frame = (fm_frame_t *) ( bb + fm_file_pos );
-
-	// do frame check
-	if ( fm_head->numFrames < 1 ) {
-		_pico_printf( PICO_ERROR, "%s has 0 frames!", fileName );
-		_pico_free(bb0);
-		return NULL;
-	}
-
-	if ( frameNum < 0 || frameNum >= fm_head->numFrames ) {
-		_pico_printf( PICO_ERROR, "Invalid or out-of-range FM frame specified" );
-		_pico_free(bb0);
-		return NULL;
-	}
+	fm.fm_frame = (fm_frame_t *) ( bb + fm_file_pos );
 
 	// swap fm
 	fm_head->skinWidth = _pico_little_long( fm_head->skinWidth );
@@ -350,30 +325,43 @@ static picoModel_t *_fm_load( PM_PARAMS_LOAD ){
 	fm_head->numGLCmds = _pico_little_long( fm_head->numGLCmds );
 	fm_head->numFrames = _pico_little_long( fm_head->numFrames );
 
+	// do frame check
+	if ( fm_head->numFrames < 1 ) {
+		_pico_printf( PICO_ERROR, "%s has 0 frames!", fileName );
+		return NULL;
+	}
+
+	if ( frameNum < 0 || frameNum >= fm_head->numFrames ) {
+		_pico_printf( PICO_ERROR, "Invalid or out-of-range FM frame specified" );
+		return NULL;
+	}
+
+	// only the requested frame is read, frames are frameSize apart
+	frame = (const fm_frame_t *) ( (const picoByte_t *) fm.fm_frame + fm_head->frameSize * frameNum );
+
 	// swap frame scale and translation
 	for ( i = 0; i < 3; i++ )
 	{
-		frame->header.scale[ i ] = _pico_little_float( frame->header.scale[ i ] );
-		frame->header.translate[ i ] = _pico_little_float( frame->header.translate[ i ] );
+		scale[ i ] = _pico_little_float( frame->header.scale[ i ] );
+		translate[ i ] = _pico_little_float( frame->header.translate[ i ] );
 	}
 
-	// swap triangles
-	triangle = tri_verts;
-	for ( i = 0; i < fm_head->numTris; i++, triangle++ )
+	// swap triangles into a copy, the dup remapping below rewrites their indexes
+	tri_verts = (fm_xyz_st_t *)_pico_alloc( sizeof( fm_xyz_st_t ) * ( fm_head->numTris > 0 ? fm_head->numTris : 1 ) );
+	if ( tri_verts == NULL ) {
+		_pico_printf( PICO_ERROR, "Unable to allocate FM triangles" );
+		return NULL;
+	}
+	for ( i = 0; i < fm_head->numTris; i++, fm_tri++ )
 	{
 		for ( j = 0; j < 3; j++ )
 		{
-			triangle->index_xyz[ j ] = _pico_little_short( triangle->index_xyz[ j ] );
-			triangle->index_st[ j ] = _pico_little_short( triangle->index_st[ j ] );
+			tri_verts[ i ].index_xyz[ j ] = _pico_little_short( fm_tri->index_xyz[ j ] );
+			tri_verts[ i ].index_st[ j ] = _pico_little_short( fm_tri->index_st[ j ] );
 		}
 	}
 
-	// swap st coords
-	for ( i = 0; i < fm_head->numST; i++ )
-	{
-		texCoord->s = _pico_little_short( texCoord[i].s );
-		texCoord->t = _pico_little_short( texCoord[i].t );
-	}
+	// st coords are swapped as they are read
 	// set Skin Name
 	strncpy( skinname, fm.fm_skin->path, FM_SKINPATHSIZE );
 
@@ -390,7 +378,7 @@ static picoModel_t *_fm_load( PM_PARAMS_LOAD ){
 	picoModel = PicoNewModel();
 	if ( picoModel == NULL ) {
 		_pico_printf( PICO_ERROR, "Unable to allocate a new model" );
-		_pico_free(bb0);
+		_pico_free( tri_verts );
 		return NULL;
 	}
 
@@ -405,18 +393,18 @@ static picoModel_t *_fm_load( PM_PARAMS_LOAD ){
 	if ( picoSurface == NULL ) {
 		_pico_printf( PICO_ERROR, "Unable to allocate a new model surface" );
 		PicoFreeModel( picoModel );
-		_pico_free(bb0);
+		_pico_free( tri_verts );
 		return NULL;
 	}
 
 
 	PicoSetSurfaceType( picoSurface, PICO_TRIANGLES );
-	PicoSetSurfaceName( picoSurface, frame->header.name );
+	PicoSetSurfaceName( picoSurface, (char*) frame->header.name );
 	picoShader = PicoNewShader( picoModel );
 	if ( picoShader == NULL ) {
 		_pico_printf( PICO_ERROR, "Unable to allocate a new model shader" );
 		PicoFreeModel( picoModel );
-		_pico_free(bb0);
+		_pico_free( tri_verts );
 		return NULL;
 	}
 
@@ -435,7 +423,6 @@ static picoModel_t *_fm_load( PM_PARAMS_LOAD ){
 	}
 
 	// Fill in Look Up Table, and allocate/fill Linked List from vert array as needed for dup STs per Vert.
-	tot_numVerts = fm_head->numXYZ;
 	dups = 0;
 	triangle = tri_verts;
 
@@ -577,13 +564,13 @@ static picoModel_t *_fm_load( PM_PARAMS_LOAD ){
 		PicoSetSurfaceIndex( picoSurface, j * 3 + 2, triangle->index_xyz[2] );
 	}
 
-	vert = (fm_vert_normal_t*) ( (picoByte_t*) ( frame->verts ) );
+	vert = frame->verts;
 	for ( i = 0; i < fm_head->numXYZ; i++, vert++ )
 	{
 		/* set vertex origin */
-		xyz[ 0 ] = vert->v[0] * frame->header.scale[0] + frame->header.translate[0];
-		xyz[ 1 ] = vert->v[1] * frame->header.scale[1] + frame->header.translate[1];
-		xyz[ 2 ] = vert->v[2] * frame->header.scale[2] + frame->header.translate[2];
+		xyz[ 0 ] = vert->v[0] * scale[0] + translate[0];
+		xyz[ 1 ] = vert->v[1] * scale[1] + translate[1];
+		xyz[ 2 ] = vert->v[2] * scale[2] + translate[2];
 		PicoSetSurfaceXYZ( picoSurface, i, xyz );
 
 		/* set normal */
@@ -593,8 +580,8 @@ static picoModel_t *_fm_load( PM_PARAMS_LOAD ){
 		PicoSetSurfaceNormal( picoSurface, i, normal );
 
 		/* set st coords */
-		st[ 0 ] =  ( ( texCoord[p_index_LUT[i].ST].s ) / ( (float)fm_head->skinWidth ) );
-		st[ 1 ] =  ( texCoord[p_index_LUT[i].ST].t / ( (float)fm_head->skinHeight ) );
+		st[ 0 ] =  ( _pico_little_short( texCoord[p_index_LUT[i].ST].s ) / ( (float)fm_head->skinWidth ) );
+		st[ 1 ] =  ( _pico_little_short( texCoord[p_index_LUT[i].ST].t ) / ( (float)fm_head->skinHeight ) );
 		PicoSetSurfaceST( picoSurface, 0, i, st );
 	}
 
@@ -603,9 +590,9 @@ static picoModel_t *_fm_load( PM_PARAMS_LOAD ){
 		{
 			j = p_index_LUT_DUPS[i].OldVert;
 			/* set vertex origin */
-			xyz[ 0 ] = frame->verts[j].v[0] * frame->header.scale[0] + frame->header.translate[0];
-			xyz[ 1 ] = frame->verts[j].v[1] * frame->header.scale[1] + frame->header.translate[1];
-			xyz[ 2 ] = frame->verts[j].v[2] * frame->header.scale[2] + frame->header.translate[2];
+			xyz[ 0 ] = frame->verts[j].v[0] * scale[0] + translate[0];
+			xyz[ 1 ] = frame->verts[j].v[1] * scale[1] + translate[1];
+			xyz[ 2 ] = frame->verts[j].v[2] * scale[2] + translate[2];
 			PicoSetSurfaceXYZ( picoSurface, i + fm_head->numXYZ, xyz );
 
 			/* set normal */
@@ -615,8 +602,8 @@ static picoModel_t *_fm_load( PM_PARAMS_LOAD ){
 			PicoSetSurfaceNormal( picoSurface, i + fm_head->numXYZ, normal );
 
 			/* set st coords */
-			st[ 0 ] =  ( ( texCoord[p_index_LUT_DUPS[i].ST].s ) / ( (float)fm_head->skinWidth ) );
-			st[ 1 ] =  ( texCoord[p_index_LUT_DUPS[i].ST].t / ( (float)fm_head->skinHeight ) );
+			st[ 0 ] =  ( _pico_little_short( texCoord[p_index_LUT_DUPS[i].ST].s ) / ( (float)fm_head->skinWidth ) );
+			st[ 1 ] =  ( _pico_little_short( texCoord[p_index_LUT_DUPS[i].ST].t ) / ( (float)fm_head->skinHeight ) );
 			PicoSetSurfaceST( picoSurface, 0, i + fm_head->numXYZ, st );
 		}
 	}
@@ -645,9 +632,9 @@ static picoModel_t *_fm_load( PM_PARAMS_LOAD ){
 	// Free malloc'ed LUTs
 	_pico_free( p_index_LUT );
 	_pico_free( p_index_LUT_DUPS );
+	_pico_free( tri_verts );
 
 	/* return the new pico model */
-	_pico_free(bb0);
 	return picoModel;
 
 }
@@ -667,5 +654,6 @@ const picoModule_t picoModuleFM =
 	_fm_canload,                /* validation routine */
 	_fm_load,                   /* load routine */
 	NULL,                       /* save validation routine */
-	NULL                        /* save routine */
+	NULL,                       /* save routine */
+	PICO_MODULE_READONLY_BUFFER /* module flags */
 };
@@ -48,7 +48,7 @@
 
 /* helper functions */
 static const char *lwo_lwIDToStr( unsigned int lwID ){
-	static char lwIDStr[5];
+	static PICO_THREAD_LOCAL char lwIDStr[5];
 
 	if ( !lwID ) {
 		return "n/a";
@@ -337,13 +337,15 @@ static picoModel_t *_md2_load( PM_PARAMS_LOAD ){
 
 	char path[ MD2_MAX_SKINNAME ];
 	char skinname[ MD2_MAX_SKINNAME ];
-	md2_t           *md2;
-	md2St_t         *texCoord;
-	md2Frame_t      *frame;
-	md2Triangle_t   *triangle;
-	md2XyzNormal_t  *vertex;
-
-	picoByte_t      *bb, *bb0;
+	md2_t           header, *md2;
+	const md2St_t   *texCoord;
+	const md2Frame_t *frame;
+	md2Triangle_t   *triangles, *triangle;
+	const md2Triangle_t *md2Triangle;
+	const md2XyzNormal_t *vertex;
+	float scale[ 3 ], translate[ 3 ];
+
+	const picoByte_t *bb;
 	picoModel_t     *picoModel;
 	picoSurface_t   *picoSurface;
 	picoShader_t    *picoShader;
@@ -355,16 +357,15 @@ static picoModel_t *_md2_load( PM_PARAMS_LOAD ){
 	// md2 loading
 	_pico_printf( PICO_NORMAL, "Loading \"%s\"", fileName );
 
-	/* set as md2 */
-	bb0 = bb = (picoByte_t*) _pico_alloc( bufSize );
-	memcpy( bb, buffer, bufSize );
-	md2 = (md2_t*) bb;
+	/* set as md2, the buffer may be a read-only file mapping so only the header is copied */
+	bb = (const picoByte_t*) buffer;
+	memcpy( &header, bb, sizeof( header ) );
+	md2 = &header;
 
 	/* check ident and version */
 	if( *((const int*) md2->magic) != *((const int*) MD2_MAGIC) || _pico_little_long( md2->version ) != MD2_VERSION ) {
 		/* not an md2 file (todo: set error) */
 		_pico_printf( PICO_ERROR, "%s is not an MD2 File!", fileName );
-		_pico_free(bb0);
 		return NULL;
 	}
 
@@ -392,44 +393,42 @@ static picoModel_t *_md2_load( PM_PARAMS_LOAD ){
 	// do frame check
 	if ( md2->numFrames < 1 ) {
 		_pico_printf( PICO_ERROR, "%s has 0 frames!", fileName );
-		_pico_free(bb0);
 		return NULL;
 	}
 
 	if ( frameNum < 0 || frameNum >= md2->numFrames ) {
 		_pico_printf( PICO_ERROR, "Invalid or out-of-range MD2 frame specified" );
-		_pico_free(bb0);
 		return NULL;
 	}
 
-	// Setup Frame
-	frame = (md2Frame_t *) ( bb + md2->ofsFrames + ( sizeof( md2Frame_t ) * frameNum ) );
+	// Setup Frame, frames are frameSize apart
+	frame = (const md2Frame_t *) ( bb + md2->ofsFrames + md2->frameSize * frameNum );
 
 	// swap frame scale and translation
 	for ( i = 0; i < 3; i++ )
 	{
-		frame->scale[ i ] = _pico_little_float( frame->scale[ i ] );
-		frame->translate[ i ] = _pico_little_float( frame->translate[ i ] );
+		scale[ i ] = _pico_little_float( frame->scale[ i ] );
+		translate[ i ] = _pico_little_float( frame->translate[ i ] );
 	}
 
-	// swap triangles
-	triangle = (md2Triangle_t *) ( (picoByte_t *) ( bb + md2->ofsTris ) );
-	for ( i = 0; i < md2->numTris; i++, triangle++ )
+	// swap triangles into a copy, the dup remapping below rewrites their indexes
+	triangles = (md2Triangle_t *)_pico_alloc( sizeof( md2Triangle_t ) * ( md2->numTris > 0 ? md2->numTris : 1 ) );
+	if ( triangles == NULL ) {
+		_pico_printf( PICO_ERROR, "Unable to allocate MD2 triangles" );
+		return NULL;
+	}
+	md2Triangle = (const md2Triangle_t *) ( bb + md2->ofsTris );
+	for ( i = 0; i < md2->numTris; i++, md2Triangle++ )
 	{
 		for ( j = 0; j < 3; j++ )
 		{
-			triangle->index_xyz[ j ] = _pico_little_short( triangle->index_xyz[ j ] );
-			triangle->index_st[ j ] = _pico_little_short( triangle->index_st[ j ] );
+			triangles[ i ].index_xyz[ j ] = _pico_little_short( md2Triangle->index_xyz[ j ] );
+			triangles[ i ].index_st[ j ] = _pico_little_short( md2Triangle->index_st[ j ] );
 		}
 	}
 
-	// swap st coords
-	texCoord = (md2St_t*) ( (picoByte_t *) ( bb + md2->ofsST ) );
-	for ( i = 0; i < md2->numST; i++, texCoord++ )
-	{
-		texCoord->s = _pico_little_short( texCoord->s );
-		texCoord->t = _pico_little_short( texCoord->t );
-	}
+	// st coords are swapped as they are read
+	texCoord = (const md2St_t*) ( bb + md2->ofsST );
 
 	// set Skin Name
 	strncpy( skinname, (const char *) ( bb + md2->ofsSkins ), MD2_MAX_SKINNAME );
@@ -463,7 +462,7 @@ static picoModel_t *_md2_load( PM_PARAMS_LOAD ){
 	picoModel = PicoNewModel();
 	if ( picoModel == NULL ) {
 		_pico_printf( PICO_ERROR, "Unable to allocate a new model" );
-		_pico_free(bb0);
+		_pico_free( triangles );
 		return NULL;
 	}
 
@@ -478,18 +477,18 @@ static picoModel_t *_md2_load( PM_PARAMS_LOAD ){
 	if ( picoSurface == NULL ) {
 		_pico_printf( PICO_ERROR, "Unable to allocate a new model surface" );
 		PicoFreeModel( picoModel );
-		_pico_free(bb0);
+		_pico_free( triangles );
 		return NULL;
 	}
 
 
 	PicoSetSurfaceType( picoSurface, PICO_TRIANGLES );
-	PicoSetSurfaceName( picoSurface, frame->name );
+	PicoSetSurfaceName( picoSurface, (char*) frame->name );
 	picoShader = PicoNewShader( picoModel );
 	if ( picoShader == NULL ) {
 		_pico_printf( PICO_ERROR, "Unable to allocate a new model shader" );
 		PicoFreeModel( picoModel );
-		_pico_free(bb0);
+		_pico_free( triangles );
 		return NULL;
 	}
 
@@ -512,7 +511,7 @@ static picoModel_t *_md2_load( PM_PARAMS_LOAD ){
 	dups = 0;
 	for ( i = 0; i < md2->numTris; i++ )
 	{
-		p_md2Triangle = (md2Triangle_t *) ( bb + md2->ofsTris + ( sizeof( md2Triangle_t ) * i ) );
+		p_md2Triangle = &triangles[ i ];
 		for ( j = 0; j < 3; j++ )
 		{
 			if ( p_index_LUT[p_md2Triangle->index_xyz[j]].ST == -1 ) { // No Main Entry
@@ -588,9 +587,8 @@ static picoModel_t *_md2_load( PM_PARAMS_LOAD ){
 	}
 
 	// Build Picomodel
-	triangle = (md2Triangle_t *) ( (picoByte_t *) ( bb + md2->ofsTris ) );
-	texCoord = (md2St_t*) ( (picoByte_t *) ( bb + md2->ofsST ) );
-	vertex = (md2XyzNormal_t*) ( (picoByte_t*) ( frame->verts ) );
+	triangle = triangles;
+	vertex = frame->verts;
 	for ( j = 0; j < md2->numTris; j++, triangle++ )
 	{
 		PicoSetSurfaceIndex( picoSurface, j * 3, triangle->index_xyz[0] );
@@ -601,9 +599,9 @@ static picoModel_t *_md2_load( PM_PARAMS_LOAD ){
 	for ( i = 0; i < md2->numXYZ; i++, vertex++ )
 	{
 		/* set vertex origin */
-		xyz[ 0 ] = vertex->v[0] * frame->scale[0] + frame->translate[0];
-		xyz[ 1 ] = vertex->v[1] * frame->scale[1] + frame->translate[1];
-		xyz[ 2 ] = vertex->v[2] * frame->scale[2] + frame->translate[2];
+		xyz[ 0 ] = vertex->v[0] * scale[0] + translate[0];
+		xyz[ 1 ] = vertex->v[1] * scale[1] + translate[1];
+		xyz[ 2 ] = vertex->v[2] * scale[2] + translate[2];
 		PicoSetSurfaceXYZ( picoSurface, i, xyz );
 
 		/* set normal */
@@ -613,8 +611,8 @@ static picoModel_t *_md2_load( PM_PARAMS_LOAD ){
 		PicoSetSurfaceNormal( picoSurface, i, normal );
 
 		/* set st coords */
-		st[ 0 ] =  ( ( texCoord[p_index_LUT[i].ST].s ) / ( (float)md2->skinWidth ) );
-		st[ 1 ] =  ( texCoord[p_index_LUT[i].ST].t / ( (float)md2->skinHeight ) );
+		st[ 0 ] =  ( _pico_little_short( texCoord[p_index_LUT[i].ST].s ) / ( (float)md2->skinWidth ) );
+		st[ 1 ] =  ( _pico_little_short( texCoord[p_index_LUT[i].ST].t ) / ( (float)md2->skinHeight ) );
 		PicoSetSurfaceST( picoSurface, 0, i, st );
 	}
 
@@ -623,9 +621,9 @@ static picoModel_t *_md2_load( PM_PARAMS_LOAD ){
 		{
 			j = p_index_LUT_DUPS[i].OldVert;
 			/* set vertex origin */
-			xyz[ 0 ] = frame->verts[j].v[0] * frame->scale[0] + frame->translate[0];
-			xyz[ 1 ] = frame->verts[j].v[1] * frame->scale[1] + frame->translate[1];
-			xyz[ 2 ] = frame->verts[j].v[2] * frame->scale[2] + frame->translate[2];
+			xyz[ 0 ] = frame->verts[j].v[0] * scale[0] + translate[0];
+			xyz[ 1 ] = frame->verts[j].v[1] * scale[1] + translate[1];
+			xyz[ 2 ] = frame->verts[j].v[2] * scale[2] + translate[2];
 			PicoSetSurfaceXYZ( picoSurface, i + md2->numXYZ, xyz );
 
 			/* set normal */
@@ -635,8 +633,8 @@ static picoModel_t *_md2_load( PM_PARAMS_LOAD ){
 			PicoSetSurfaceNormal( picoSurface, i + md2->numXYZ, normal );
 
 			/* set st coords */
-			st[ 0 ] =  ( ( texCoord[p_index_LUT_DUPS[i].ST].s ) / ( (float)md2->skinWidth ) );
-			st[ 1 ] =  ( texCoord[p_index_LUT_DUPS[i].ST].t / ( (float)md2->skinHeight ) );
+			st[ 0 ] =  ( _pico_little_short( texCoord[p_index_LUT_DUPS[i].ST].s ) / ( (float)md2->skinWidth ) );
+			st[ 1 ] =  ( _pico_little_short( texCoord[p_index_LUT_DUPS[i].ST].t ) / ( (float)md2->skinHeight ) );
 			PicoSetSurfaceST( picoSurface, 0, i + md2->numXYZ, st );
 		}
 	}
@@ -665,9 +663,9 @@ static picoModel_t *_md2_load( PM_PARAMS_LOAD ){
 	// Free malloc'ed LUTs
 	_pico_free( p_index_LUT );
 	_pico_free( p_index_LUT_DUPS );
+	_pico_free( triangles );
 
 	/* return the new pico model */
-	_pico_free(bb0);
 	return picoModel;
 
 }
@@ -687,5 +685,6 @@ const picoModule_t picoModuleMD2 =
 	_md2_canload,                   /* validation routine */
 	_md2_load,                      /* load routine */
 	NULL,                           /* save validation routine */
-	NULL                            /* save routine */
+	NULL,                           /* save routine */
+	PICO_MODULE_READONLY_BUFFER /* module flags */
 };
@@ -177,14 +177,17 @@ static int _md3_canload( PM_PARAMS_CANLOAD ){
 
 static picoModel_t *_md3_load( PM_PARAMS_LOAD ){
 	int i, j;
-	picoByte_t      *bb, *bb0;
-	md3_t           *md3;
-	md3Surface_t    *surface;
-	md3Shader_t     *shader;
-	md3TexCoord_t   *texCoord;
-	md3Frame_t      *frame;
-	md3Triangle_t   *triangle;
-	md3Vertex_t     *vertex;
+	const picoByte_t    *bb;
+	const md3_t         *md3;
+	const md3Surface_t  *surface;
+	const md3Shader_t   *shader;
+	const md3TexCoord_t *texCoord;
+	const md3Triangle_t *triangle;
+	const md3Vertex_t   *vertex;
+	int numFrames, numSurfaces, ofsSurfaces;
+	int numVerts, numTriangles, ofsTriangles, ofsShaders, ofsSt, ofsVertexes, ofsEnd;
+	short normalBits;
+	char shaderName[ 64 ];
 	double lat, lng;
 
 	picoModel_t     *picoModel;
@@ -200,103 +203,33 @@ static picoModel_t *_md3_load( PM_PARAMS_LOAD ){
 	   ------------------------------------------------- */
 
 
-	/* set as md3 */
-	bb0 = bb = (picoByte_t*) _pico_alloc( bufSize );
-	memcpy( bb, buffer, bufSize );
-	md3 = (md3_t*) bb;
+	/* the buffer may be a read-only file mapping, so it is never written to */
+	/* and only the requested frame is swapped, straight into the surfaces */
+	bb = (const picoByte_t*) buffer;
+	md3 = (const md3_t*) bb;
 
 	/* check ident and version */
-	if ( *( (int*) md3->magic ) != *( (int*) MD3_MAGIC ) || _pico_little_long( md3->version ) != MD3_VERSION ) {
+	if ( *( (const int*) md3->magic ) != *( (const int*) MD3_MAGIC ) || _pico_little_long( md3->version ) != MD3_VERSION ) {
 		/* not an md3 file (todo: set error) */
-		_pico_free(bb0);
 		return NULL;
 	}
 
 	/* swap md3; sea: swaps fixed */
-	md3->version = _pico_little_long( md3->version );
-	md3->numFrames = _pico_little_long( md3->numFrames );
-	md3->numTags = _pico_little_long( md3->numTags );
-	md3->numSurfaces = _pico_little_long( md3->numSurfaces );
-	md3->numSkins = _pico_little_long( md3->numSkins );
-	md3->ofsFrames = _pico_little_long( md3->ofsFrames );
-	md3->ofsTags = _pico_little_long( md3->ofsTags );
-	md3->ofsSurfaces = _pico_little_long( md3->ofsSurfaces );
-	md3->ofsEnd = _pico_little_long( md3->ofsEnd );
+	numFrames = _pico_little_long( md3->numFrames );
+	numSurfaces = _pico_little_long( md3->numSurfaces );
+	ofsSurfaces = _pico_little_long( md3->ofsSurfaces );
 
 	/* do frame check */
-	if ( md3->numFrames < 1 ) {
+	if ( numFrames < 1 ) {
 		_pico_printf( PICO_ERROR, "MD3 with 0 frames" );
-		_pico_free(bb0);
 		return NULL;
 	}
 
-	if ( frameNum < 0 || frameNum >= md3->numFrames ) {
+	if ( frameNum < 0 || frameNum >= numFrames ) {
 		_pico_printf( PICO_ERROR, "Invalid or out-of-range MD3 frame specified" );
-		_pico_free(bb0);
 		return NULL;
 	}
 
-	/* swap frames */
-	frame = (md3Frame_t*) ( bb + md3->ofsFrames );
-	for ( i = 0; i < md3->numFrames; i++, frame++ )
-	{
-		frame->radius = _pico_little_float( frame->radius );
-		for ( j = 0; j < 3; j++ )
-		{
-			frame->bounds[ 0 ][ j ] = _pico_little_float( frame->bounds[ 0 ][ j ] );
-			frame->bounds[ 1 ][ j ] = _pico_little_float( frame->bounds[ 1 ][ j ] );
-			frame->localOrigin[ j ] = _pico_little_float( frame->localOrigin[ j ] );
-		}
-	}
-
-	/* swap surfaces */
-	surface = (md3Surface_t*) ( bb + md3->ofsSurfaces );
-	for ( i = 0; i < md3->numSurfaces; i++ )
-	{
-		/* swap surface md3; sea: swaps fixed */
-		surface->flags = _pico_little_long( surface->flags );
-		surface->numFrames = _pico_little_long( surface->numFrames );
-		surface->numShaders = _pico_little_long( surface->numShaders );
-		surface->numTriangles = _pico_little_long( surface->numTriangles );
-		surface->ofsTriangles = _pico_little_long( surface->ofsTriangles );
-		surface->numVerts = _pico_little_long( surface->numVerts );
-		surface->ofsShaders = _pico_little_long( surface->ofsShaders );
-		surface->ofsSt = _pico_little_long( surface->ofsSt );
-		surface->ofsVertexes = _pico_little_long( surface->ofsVertexes );
-		surface->ofsEnd = _pico_little_long( surface->ofsEnd );
-
-		/* swap triangles */
-		triangle = (md3Triangle_t*) ( (picoByte_t*) surface + surface->ofsTriangles );
-		for ( j = 0; j < surface->numTriangles; j++, triangle++ )
-		{
-			/* sea: swaps fixed */
-			triangle->indexes[ 0 ] = _pico_little_long( triangle->indexes[ 0 ] );
-			triangle->indexes[ 1 ] = _pico_little_long( triangle->indexes[ 1 ] );
-			triangle->indexes[ 2 ] = _pico_little_long( triangle->indexes[ 2 ] );
-		}
-
-		/* swap st coords */
-		texCoord = (md3TexCoord_t*) ( (picoByte_t*) surface + surface->ofsSt );
-		for ( j = 0; j < surface->numVerts; j++, texCoord++ )
-		{
-			texCoord->st[ 0 ] = _pico_little_float( texCoord->st[ 0 ] );
-			texCoord->st[ 1 ] = _pico_little_float( texCoord->st[ 1 ] );
-		}
-
-		/* swap xyz/normals */
-		vertex = (md3Vertex_t*) ( (picoByte_t*) surface + surface->ofsVertexes );
-		for ( j = 0; j < ( surface->numVerts * surface->numFrames ); j++, vertex++ )
-		{
-			vertex->xyz[ 0 ] = _pico_little_short( vertex->xyz[ 0 ] );
-			vertex->xyz[ 1 ] = _pico_little_short( vertex->xyz[ 1 ] );
-			vertex->xyz[ 2 ] = _pico_little_short( vertex->xyz[ 2 ] );
-			vertex->normal   = _pico_little_short( vertex->normal );
-		}
-
-		/* get next surface */
-		surface = (md3Surface_t*) ( (picoByte_t*) surface + surface->ofsEnd );
-	}
-
 	/* -------------------------------------------------
 	   pico model creation
 	   ------------------------------------------------- */
@@ -305,28 +238,35 @@ static picoModel_t *_md3_load( PM_PARAMS_LOAD ){
 	picoModel = PicoNewModel();
 	if ( picoModel == NULL ) {
 		_pico_printf( PICO_ERROR, "Unable to allocate a new model" );
-		_pico_free(bb0);
 		return NULL;
 	}
 
 	/* do model setup */
 	PicoSetModelFrameNum( picoModel, frameNum );
-	PicoSetModelNumFrames( picoModel, md3->numFrames ); /* sea */
+	PicoSetModelNumFrames( picoModel, numFrames ); /* sea */
 	PicoSetModelName( picoModel, fileName );
 	PicoSetModelFileName( picoModel, fileName );
 
 	/* md3 surfaces become picomodel surfaces */
-	surface = (md3Surface_t*) ( bb + md3->ofsSurfaces );
+	surface = (const md3Surface_t*) ( bb + ofsSurfaces );
 
 	/* run through md3 surfaces */
-	for ( i = 0; i < md3->numSurfaces; i++ )
+	for ( i = 0; i < numSurfaces; i++ )
 	{
+		/* swap surface md3; sea: swaps fixed */
+		numVerts = _pico_little_long( surface->numVerts );
+		numTriangles = _pico_little_long( surface->numTriangles );
+		ofsTriangles = _pico_little_long( surface->ofsTriangles );
+		ofsShaders = _pico_little_long( surface->ofsShaders );
+		ofsSt = _pico_little_long( surface->ofsSt );
+		ofsVertexes = _pico_little_long( surface->ofsVertexes );
+		ofsEnd = _pico_little_long( surface->ofsEnd );
+
 		/* allocate new pico surface */
 		picoSurface = PicoNewSurface( picoModel );
 		if ( picoSurface == NULL ) {
 			_pico_printf( PICO_ERROR, "Unable to allocate a new model surface" );
 			PicoFreeModel( picoModel ); /* sea */
-			_pico_free(bb0);
 			return NULL;
 		}
 
@@ -334,7 +274,7 @@ static picoModel_t *_md3_load( PM_PARAMS_LOAD ){
 		PicoSetSurfaceType( picoSurface, PICO_TRIANGLES );
 
 		/* set surface name */
-		PicoSetSurfaceName( picoSurface, surface->name );
+		PicoSetSurfaceName( picoSurface, (char*) surface->name );
 
 		/* create new pico shader -sea */
 		picoShader = PicoNewShader( picoModel );
@@ -342,44 +282,52 @@ static picoModel_t *_md3_load( PM_PARAMS_LOAD ){
 			_pico_printf( PICO_ERROR, "Unable to allocate a new model shader" );
 			PicoFreeModel( picoModel );
 			return NULL;
-			_pico_free(bb0);
 		}
 
 		/* detox and set shader name */
-		shader = (md3Shader_t*) ( (picoByte_t*) surface + surface->ofsShaders );
-		_pico_setfext( shader->name, "" );
-		_pico_unixify( shader->name );
-		PicoSetShaderName( picoShader, shader->name );
+		shader = (const md3Shader_t*) ( (const picoByte_t*) surface + ofsShaders );
+		strncpy( shaderName, shader->name, sizeof( shaderName ) - 1 );
+		shaderName[ sizeof( shaderName ) - 1 ] = '\0';
+		_pico_setfext( shaderName, "" );
+		_pico_unixify( shaderName );
+		PicoSetShaderName( picoShader, shaderName );
 
 		/* associate current surface with newly created shader */
 		PicoSetSurfaceShader( picoSurface, picoShader );
 
+		/* size the surface once instead of growing it per vertex */
+		if ( numVerts > 0 && numTriangles > 0 ) {
+			PicoAdjustSurface( picoSurface, numVerts, 1, 1, numTriangles * 3, 0 );
+		}
+
 		/* copy indexes */
-		triangle = (md3Triangle_t *) ( (picoByte_t*) surface + surface->ofsTriangles );
+		triangle = (const md3Triangle_t *) ( (const picoByte_t*) surface + ofsTriangles );
 
-		for ( j = 0; j < surface->numTriangles; j++, triangle++ )
+		for ( j = 0; j < numTriangles; j++, triangle++ )
 		{
-			PicoSetSurfaceIndex( picoSurface, ( j * 3 + 0 ), (picoIndex_t) triangle->indexes[ 0 ] );
-			PicoSetSurfaceIndex( picoSurface, ( j * 3 + 1 ), (picoIndex_t) triangle->indexes[ 1 ] );
-			PicoSetSurfaceIndex( picoSurface, ( j * 3 + 2 ), (picoIndex_t) triangle->indexes[ 2 ] );
+			/* sea: swaps fixed */
+			PicoSetSurfaceIndex( picoSurface, ( j * 3 + 0 ), (picoIndex_t) _pico_little_long( triangle->indexes[ 0 ] ) );
+			PicoSetSurfaceIndex( picoSurface, ( j * 3 + 1 ), (picoIndex_t) _pico_little_long( triangle->indexes[ 1 ] ) );
+			PicoSetSurfaceIndex( picoSurface, ( j * 3 + 2 ), (picoIndex_t) _pico_little_long( triangle->indexes[ 2 ] ) );
 		}
 
-		/* copy vertexes */
-		texCoord = (md3TexCoord_t*) ( (picoByte_t *) surface + surface->ofsSt );
-		vertex = (md3Vertex_t*) ( (picoByte_t*) surface + surface->ofsVertexes + surface->numVerts * frameNum * sizeof( md3Vertex_t ) );
+		/* copy vertexes of the requested frame only */
+		texCoord = (const md3TexCoord_t*) ( (const picoByte_t *) surface + ofsSt );
+		vertex = (const md3Vertex_t*) ( (const picoByte_t*) surface + ofsVertexes + numVerts * frameNum * sizeof( md3Vertex_t ) );
 		_pico_set_color( color, 255, 255, 255, 255 );
 
-		for ( j = 0; j < surface->numVerts; j++, texCoord++, vertex++ )
+		for ( j = 0; j < numVerts; j++, texCoord++, vertex++ )
 		{
 			/* set vertex origin */
-			xyz[ 0 ] = MD3_SCALE * vertex->xyz[ 0 ];
-			xyz[ 1 ] = MD3_SCALE * vertex->xyz[ 1 ];
-			xyz[ 2 ] = MD3_SCALE * vertex->xyz[ 2 ];
+			xyz[ 0 ] = MD3_SCALE * _pico_little_short( vertex->xyz[ 0 ] );
+			xyz[ 1 ] = MD3_SCALE * _pico_little_short( vertex->xyz[ 1 ] );
+			xyz[ 2 ] = MD3_SCALE * _pico_little_short( vertex->xyz[ 2 ] );
 			PicoSetSurfaceXYZ( picoSurface, j, xyz );
 
 			/* decode lat/lng normal to 3 float normal */
-			lat = (float) ( ( vertex->normal >> 8 ) & 0xff );
-			lng = (float) ( vertex->normal & 0xff );
+			normalBits = _pico_little_short( vertex->normal );
+			lat = (float) ( ( normalBits >> 8 ) & 0xff );
+			lng = (float) ( normalBits & 0xff );
 			lat *= PICO_PI / 128;
 			lng *= PICO_PI / 128;
 			normal[ 0 ] = (picoVec_t) cos( lat ) * (picoVec_t) sin( lng );
@@ -388,8 +336,8 @@ static picoModel_t *_md3_load( PM_PARAMS_LOAD ){
 			PicoSetSurfaceNormal( picoSurface, j, normal );
 
 			/* set st coords */
-			st[ 0 ] = texCoord->st[ 0 ];
-			st[ 1 ] = texCoord->st[ 1 ];
+			st[ 0 ] = _pico_little_float( texCoord->st[ 0 ] );
+			st[ 1 ] = _pico_little_float( texCoord->st[ 1 ] );
 			PicoSetSurfaceST( picoSurface, 0, j, st );
 
 			/* set color */
@@ -397,11 +345,10 @@ static picoModel_t *_md3_load( PM_PARAMS_LOAD ){
 		}
 
 		/* get next surface */
-		surface = (md3Surface_t*) ( (picoByte_t*) surface + surface->ofsEnd );
+		surface = (const md3Surface_t*) ( (const picoByte_t*) surface + ofsEnd );
 	}
 
 	/* return the new pico model */
-	_pico_free(bb0);
 	return picoModel;
 }
 
@@ -420,5 +367,6 @@ const picoModule_t picoModuleMD3 =
 	_md3_canload,               /* validation routine */
 	_md3_load,                  /* load routine */
 	NULL,                       /* save validation routine */
-	NULL                        /* save routine */
+	NULL,                       /* save routine */
+	PICO_MODULE_READONLY_BUFFER /* module flags */
 };
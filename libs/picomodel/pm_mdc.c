@@ -450,16 +450,20 @@ static int _mdc_canload( PM_PARAMS_CANLOAD ){
 
 static picoModel_t *_mdc_load( PM_PARAMS_LOAD ){
 	int i, j;
-	picoByte_t          *bb, *bb0;
-	mdc_t               *mdc;
-	mdcSurface_t        *surface;
-	mdcShader_t         *shader;
-	mdcTexCoord_t       *texCoord;
-	mdcFrame_t          *frame;
-	mdcTriangle_t       *triangle;
-	mdcVertex_t         *vertex;
-	mdcXyzCompressed_t  *vertexComp = NULL;
-	short               *mdcShort, *mdcCompVert = NULL;
+	const picoByte_t            *bb;
+	const mdc_t                 *mdc;
+	const mdcSurface_t          *surface;
+	const mdcShader_t           *shader;
+	const mdcTexCoord_t         *texCoord;
+	const mdcTriangle_t         *triangle;
+	const mdcXyzCompressed_t    *vertexComp = NULL;
+	const short                 *mdcShort;
+	int numFrames, numSurfaces, ofsSurfaces;
+	int numVerts, numTriangles, numCompFrames, ofsTriangles, ofsShaders, ofsSt, ofsEnd;
+	short baseFrame, compFrame;
+	unsigned int ofsVec;
+	short normalBits;
+	char shaderName[ 64 ];
 	double lat, lng;
 
 	picoModel_t         *picoModel;
@@ -475,129 +479,33 @@ static picoModel_t *_mdc_load( PM_PARAMS_LOAD ){
 	   ------------------------------------------------- */
 
 
-	/* set as mdc */
-	bb0 = bb = (picoByte_t*) _pico_alloc( bufSize );
-	memcpy( bb, buffer, bufSize );
-	mdc = (mdc_t*) bb;
+	/* the buffer may be a read-only file mapping, so it is never written to */
+	/* and only the requested frame is swapped, straight into the surfaces */
+	bb = (const picoByte_t*) buffer;
+	mdc = (const mdc_t*) bb;
 
 	/* check ident and version */
-	if ( *( (int*) mdc->magic ) != *( (int*) MDC_MAGIC ) || _pico_little_long( mdc->version ) != MDC_VERSION ) {
+	if ( *( (const int*) mdc->magic ) != *( (const int*) MDC_MAGIC ) || _pico_little_long( mdc->version ) != MDC_VERSION ) {
 		/* not an mdc file (todo: set error) */
-		_pico_free( bb0 );
 		return NULL;
 	}
 
 	/* swap mdc */
-	mdc->version = _pico_little_long( mdc->version );
-	mdc->numFrames = _pico_little_long( mdc->numFrames );
-	mdc->numTags = _pico_little_long( mdc->numTags );
-	mdc->numSurfaces = _pico_little_long( mdc->numSurfaces );
-	mdc->numSkins = _pico_little_long( mdc->numSkins );
-	mdc->ofsFrames = _pico_little_long( mdc->ofsFrames );
-	mdc->ofsTags = _pico_little_long( mdc->ofsTags );
-	mdc->ofsTagNames = _pico_little_long( mdc->ofsTagNames );
-	mdc->ofsSurfaces = _pico_little_long( mdc->ofsSurfaces );
-	mdc->ofsEnd = _pico_little_long( mdc->ofsEnd );
+	numFrames = _pico_little_long( mdc->numFrames );
+	numSurfaces = _pico_little_long( mdc->numSurfaces );
+	ofsSurfaces = _pico_little_long( mdc->ofsSurfaces );
 
 	/* do frame check */
-	if ( mdc->numFrames < 1 ) {
+	if ( numFrames < 1 ) {
 		_pico_printf( PICO_ERROR, "MDC with 0 frames" );
-		_pico_free( bb0 );
 		return NULL;
 	}
 
-	if ( frameNum < 0 || frameNum >= mdc->numFrames ) {
+	if ( frameNum < 0 || frameNum >= numFrames ) {
 		_pico_printf( PICO_ERROR, "Invalid or out-of-range MDC frame specified" );
-		_pico_free( bb0 );
 		return NULL;
 	}
 
-	/* swap frames */
-	frame = (mdcFrame_t*) ( bb + mdc->ofsFrames );
-	for ( i = 0; i < mdc->numFrames; i++, frame++ )
-	{
-		frame->radius = _pico_little_float( frame->radius );
-		for ( j = 0; j < 3; j++ )
-		{
-			frame->bounds[ 0 ][ j ] = _pico_little_float( frame->bounds[ 0 ][ j ] );
-			frame->bounds[ 1 ][ j ] = _pico_little_float( frame->bounds[ 1 ][ j ] );
-			frame->localOrigin[ j ] = _pico_little_float( frame->localOrigin[ j ] );
-		}
-	}
-
-	/* swap surfaces */
-	surface = (mdcSurface_t*) ( bb + mdc->ofsSurfaces );
-	for ( i = 0; i < mdc->numSurfaces; i++ )
-	{
-		/* swap surface mdc */
-		surface->flags = _pico_little_long( surface->flags );
-		surface->numBaseFrames = _pico_little_long( surface->numBaseFrames );
-		surface->numCompFrames = _pico_little_long( surface->numCompFrames );
-		surface->numShaders = _pico_little_long( surface->numShaders );
-		surface->numTriangles = _pico_little_long( surface->numTriangles );
-		surface->ofsTriangles = _pico_little_long( surface->ofsTriangles );
-		surface->numVerts = _pico_little_long( surface->numVerts );
-		surface->ofsShaders = _pico_little_long( surface->ofsShaders );
-		surface->ofsSt = _pico_little_long( surface->ofsSt );
-		surface->ofsXyzNormals = _pico_little_long( surface->ofsXyzNormals );
-		surface->ofsXyzCompressed = _pico_little_long( surface->ofsXyzCompressed );
-		surface->ofsFrameBaseFrames = _pico_little_long( surface->ofsFrameBaseFrames );
-		surface->ofsFrameCompFrames = _pico_little_long( surface->ofsFrameCompFrames );
-		surface->ofsEnd = _pico_little_long( surface->ofsEnd );
-
-		/* swap triangles */
-		triangle = (mdcTriangle_t*) ( (picoByte_t*) surface + surface->ofsTriangles );
-		for ( j = 0; j < surface->numTriangles; j++, triangle++ )
-		{
-			/* sea: swaps fixed */
-			triangle->indexes[ 0 ] = _pico_little_long( triangle->indexes[ 0 ] );
-			triangle->indexes[ 1 ] = _pico_little_long( triangle->indexes[ 1 ] );
-			triangle->indexes[ 2 ] = _pico_little_long( triangle->indexes[ 2 ] );
-		}
-
-		/* swap st coords */
-		texCoord = (mdcTexCoord_t*) ( (picoByte_t*) surface + surface->ofsSt );
-		for ( j = 0; j < surface->numVerts; j++, texCoord++ )
-		{
-			texCoord->st[ 0 ] = _pico_little_float( texCoord->st[ 0 ] );
-			texCoord->st[ 1 ] = _pico_little_float( texCoord->st[ 1 ] );
-		}
-
-		/* swap xyz/normals */
-		vertex = (mdcVertex_t*) ( (picoByte_t*) surface + surface->ofsXyzNormals );
-		for ( j = 0; j < ( surface->numVerts * surface->numBaseFrames ); j++, vertex++ )
-		{
-			vertex->xyz[ 0 ] = _pico_little_short( vertex->xyz[ 0 ] );
-			vertex->xyz[ 1 ] = _pico_little_short( vertex->xyz[ 1 ] );
-			vertex->xyz[ 2 ] = _pico_little_short( vertex->xyz[ 2 ] );
-			vertex->normal   = _pico_little_short( vertex->normal );
-		}
-
-		/* swap xyz/compressed */
-		vertexComp = (mdcXyzCompressed_t*) ( (picoByte_t*) surface + surface->ofsXyzCompressed );
-		for ( j = 0; j < ( surface->numVerts * surface->numCompFrames ); j++, vertexComp++ )
-		{
-			vertexComp->ofsVec  = _pico_little_long( vertexComp->ofsVec );
-		}
-
-		/* swap base frames */
-		mdcShort = (short *) ( (picoByte_t*) surface + surface->ofsFrameBaseFrames );
-		for ( j = 0; j < mdc->numFrames; j++, mdcShort++ )
-		{
-			*mdcShort   = _pico_little_short( *mdcShort );
-		}
-
-		/* swap compressed frames */
-		mdcShort = (short *) ( (picoByte_t*) surface + surface->ofsFrameCompFrames );
-		for ( j = 0; j < mdc->numFrames; j++, mdcShort++ )
-		{
-			*mdcShort   = _pico_little_short( *mdcShort );
-		}
-
-		/* get next surface */
-		surface = (mdcSurface_t*) ( (picoByte_t*) surface + surface->ofsEnd );
-	}
-
 	/* -------------------------------------------------
 	   pico model creation
 	   ------------------------------------------------- */
@@ -606,28 +514,35 @@ static picoModel_t *_mdc_load( PM_PARAMS_LOAD ){
 	picoModel = PicoNewModel();
 	if ( picoModel == NULL ) {
 		_pico_printf( PICO_ERROR, "Unable to allocate a new model" );
-		_pico_free( bb0 );
 		return NULL;
 	}
 
 	/* do model setup */
 	PicoSetModelFrameNum( picoModel, frameNum );
-	PicoSetModelNumFrames( picoModel, mdc->numFrames ); /* sea */
+	PicoSetModelNumFrames( picoModel, numFrames ); /* sea */
 	PicoSetModelName( picoModel, fileName );
 	PicoSetModelFileName( picoModel, fileName );
 
 	/* mdc surfaces become picomodel surfaces */
-	surface = (mdcSurface_t*) ( bb + mdc->ofsSurfaces );
+	surface = (const mdcSurface_t*) ( bb + ofsSurfaces );
 
 	/* run through mdc surfaces */
-	for ( i = 0; i < mdc->numSurfaces; i++ )
+	for ( i = 0; i < numSurfaces; i++ )
 	{
+		/* swap surface mdc */
+		numVerts = _pico_little_long( surface->numVerts );
+		numTriangles = _pico_little_long( surface->numTriangles );
+		numCompFrames = _pico_little_long( surface->numCompFrames );
+		ofsTriangles = _pico_little_long( surface->ofsTriangles );
+		ofsShaders = _pico_little_long( surface->ofsShaders );
+		ofsSt = _pico_little_long( surface->ofsSt );
+		ofsEnd = _pico_little_long( surface->ofsEnd );
+
 		/* allocate new pico surface */
 		picoSurface = PicoNewSurface( picoModel );
 		if ( picoSurface == NULL ) {
 			_pico_printf( PICO_ERROR, "Unable to allocate a new model surface" );
 			PicoFreeModel( picoModel ); /* sea */
-			_pico_free( bb0 );
 			return NULL;
 		}
 
@@ -635,64 +550,74 @@ static picoModel_t *_mdc_load( PM_PARAMS_LOAD ){
 		PicoSetSurfaceType( picoSurface, PICO_TRIANGLES );
 
 		/* set surface name */
-		PicoSetSurfaceName( picoSurface, surface->name );
+		PicoSetSurfaceName( picoSurface, (char*) surface->name );
 
 		/* create new pico shader -sea */
 		picoShader = PicoNewShader( picoModel );
 		if ( picoShader == NULL ) {
 			_pico_printf( PICO_ERROR, "Unable to allocate a new model shader" );
 			PicoFreeModel( picoModel );
-			_pico_free( bb0 );
 			return NULL;
 		}
 
 		/* detox and set shader name */
-		shader = (mdcShader_t*) ( (picoByte_t*) surface + surface->ofsShaders );
-		_pico_setfext( shader->name, "" );
-		_pico_unixify( shader->name );
-		PicoSetShaderName( picoShader, shader->name );
+		shader = (const mdcShader_t*) ( (const picoByte_t*) surface + ofsShaders );
+		strncpy( shaderName, shader->name, sizeof( shaderName ) - 1 );
+		shaderName[ sizeof( shaderName ) - 1 ] = '\0';
+		_pico_setfext( shaderName, "" );
+		_pico_unixify( shaderName );
+		PicoSetShaderName( picoShader, shaderName );
 
 		/* associate current surface with newly created shader */
 		PicoSetSurfaceShader( picoSurface, picoShader );
 
+		/* size the surface once instead of growing it per vertex */
+		if ( numVerts > 0 && numTriangles > 0 ) {
+			PicoAdjustSurface( picoSurface, numVerts, 1, 1, numTriangles * 3, 0 );
+		}
+
 		/* copy indexes */
-		triangle = (mdcTriangle_t *) ( (picoByte_t*) surface + surface->ofsTriangles );
+		triangle = (const mdcTriangle_t *) ( (const picoByte_t*) surface + ofsTriangles );
 
-		for ( j = 0; j < surface->numTriangles; j++, triangle++ )
+		for ( j = 0; j < numTriangles; j++, triangle++ )
 		{
-			PicoSetSurfaceIndex( picoSurface, ( j * 3 + 0 ), (picoIndex_t) triangle->indexes[ 0 ] );
-			PicoSetSurfaceIndex( picoSurface, ( j * 3 + 1 ), (picoIndex_t) triangle->indexes[ 1 ] );
-			PicoSetSurfaceIndex( picoSurface, ( j * 3 + 2 ), (picoIndex_t) triangle->indexes[ 2 ] );
+			/* sea: swaps fixed */
+			PicoSetSurfaceIndex( picoSurface, ( j * 3 + 0 ), (picoIndex_t) _pico_little_long( triangle->indexes[ 0 ] ) );
+			PicoSetSurfaceIndex( picoSurface, ( j * 3 + 1 ), (picoIndex_t) _pico_little_long( triangle->indexes[ 1 ] ) );
+			PicoSetSurfaceIndex( picoSurface, ( j * 3 + 2 ), (picoIndex_t) _pico_little_long( triangle->indexes[ 2 ] ) );
 		}
 
-		/* copy vertexes */
-		texCoord = (mdcTexCoord_t*) ( (picoByte_t *) surface + surface->ofsSt );
-		mdcShort = (short *) ( (picoByte_t *) surface + surface->ofsXyzNormals ) + ( (int)*( (short *) ( (picoByte_t *) surface + surface->ofsFrameBaseFrames ) + frameNum ) * surface->numVerts * 4 );
-		if ( surface->numCompFrames > 0 ) {
-			mdcCompVert = (short *) ( (picoByte_t *) surface + surface->ofsFrameCompFrames ) + frameNum;
-			if ( *mdcCompVert >= 0 ) {
-				vertexComp = (mdcXyzCompressed_t *) ( (picoByte_t *) surface + surface->ofsXyzCompressed ) + ( *mdcCompVert * surface->numVerts );
+		/* copy vertexes of the requested frame only */
+		texCoord = (const mdcTexCoord_t*) ( (const picoByte_t *) surface + ofsSt );
+		baseFrame = _pico_little_short( *( (const short *) ( (const picoByte_t *) surface + _pico_little_long( surface->ofsFrameBaseFrames ) ) + frameNum ) );
+		mdcShort = (const short *) ( (const picoByte_t *) surface + _pico_little_long( surface->ofsXyzNormals ) ) + ( (int) baseFrame * numVerts * 4 );
+		compFrame = -1;
+		if ( numCompFrames > 0 ) {
+			compFrame = _pico_little_short( *( (const short *) ( (const picoByte_t *) surface + _pico_little_long( surface->ofsFrameCompFrames ) ) + frameNum ) );
+			if ( compFrame >= 0 ) {
+				vertexComp = (const mdcXyzCompressed_t *) ( (const picoByte_t *) surface + _pico_little_long( surface->ofsXyzCompressed ) ) + ( compFrame * numVerts );
 			}
 		}
 		_pico_set_color( color, 255, 255, 255, 255 );
 
-		for ( j = 0; j < surface->numVerts; j++, texCoord++, mdcShort += 4 )
+		for ( j = 0; j < numVerts; j++, texCoord++, mdcShort += 4 )
 		{
 			/* set vertex origin */
-			xyz[ 0 ] = MDC_SCALE * mdcShort[ 0 ];
-			xyz[ 1 ] = MDC_SCALE * mdcShort[ 1 ];
-			xyz[ 2 ] = MDC_SCALE * mdcShort[ 2 ];
+			xyz[ 0 ] = MDC_SCALE * _pico_little_short( mdcShort[ 0 ] );
+			xyz[ 1 ] = MDC_SCALE * _pico_little_short( mdcShort[ 1 ] );
+			xyz[ 2 ] = MDC_SCALE * _pico_little_short( mdcShort[ 2 ] );
 
 			/* add compressed ofsVec */
-			if ( surface->numCompFrames > 0 && *mdcCompVert >= 0 ) {
-				xyz[ 0 ] += ( (float) ( ( vertexComp->ofsVec ) & 255 ) - MDC_MAX_OFS ) * MDC_DIST_SCALE;
-				xyz[ 1 ] += ( (float) ( ( vertexComp->ofsVec >> 8 ) & 255 ) - MDC_MAX_OFS ) * MDC_DIST_SCALE;
-				xyz[ 2 ] += ( (float) ( ( vertexComp->ofsVec >> 16 ) & 255 ) - MDC_MAX_OFS ) * MDC_DIST_SCALE;
+			if ( compFrame >= 0 ) {
+				ofsVec = (unsigned int) _pico_little_long( (int) vertexComp->ofsVec );
+				xyz[ 0 ] += ( (float) ( ( ofsVec ) & 255 ) - MDC_MAX_OFS ) * MDC_DIST_SCALE;
+				xyz[ 1 ] += ( (float) ( ( ofsVec >> 8 ) & 255 ) - MDC_MAX_OFS ) * MDC_DIST_SCALE;
+				xyz[ 2 ] += ( (float) ( ( ofsVec >> 16 ) & 255 ) - MDC_MAX_OFS ) * MDC_DIST_SCALE;
 				PicoSetSurfaceXYZ( picoSurface, j, xyz );
 
-				normal[ 0 ] = (float) mdcNormals[ ( vertexComp->ofsVec >> 24 ) ][ 0 ];
-				normal[ 1 ] = (float) mdcNormals[ ( vertexComp->ofsVec >> 24 ) ][ 1 ];
-				normal[ 2 ] = (float) mdcNormals[ ( vertexComp->ofsVec >> 24 ) ][ 2 ];
+				normal[ 0 ] = (float) mdcNormals[ ( ofsVec >> 24 ) ][ 0 ];
+				normal[ 1 ] = (float) mdcNormals[ ( ofsVec >> 24 ) ][ 1 ];
+				normal[ 2 ] = (float) mdcNormals[ ( ofsVec >> 24 ) ][ 2 ];
 				PicoSetSurfaceNormal( picoSurface, j, normal );
 
 				vertexComp++;
@@ -702,8 +627,9 @@ static picoModel_t *_mdc_load( PM_PARAMS_LOAD ){
 				PicoSetSurfaceXYZ( picoSurface, j, xyz );
 
 				/* decode lat/lng normal to 3 float normal */
-				lat = (float) ( ( *( mdcShort + 3 ) >> 8 ) & 0xff );
-				lng = (float) ( *( mdcShort + 3 ) & 0xff );
+				normalBits = _pico_little_short( mdcShort[ 3 ] );
+				lat = (float) ( ( normalBits >> 8 ) & 0xff );
+				lng = (float) ( normalBits & 0xff );
 				lat *= PICO_PI / 128;
 				lng *= PICO_PI / 128;
 				normal[ 0 ] = (picoVec_t) cos( lat ) * (picoVec_t) sin( lng );
@@ -713,8 +639,8 @@ static picoModel_t *_mdc_load( PM_PARAMS_LOAD ){
 			}
 
 			/* set st coords */
-			st[ 0 ] = texCoord->st[ 0 ];
-			st[ 1 ] = texCoord->st[ 1 ];
+			st[ 0 ] = _pico_little_float( texCoord->st[ 0 ] );
+			st[ 1 ] = _pico_little_float( texCoord->st[ 1 ] );
 			PicoSetSurfaceST( picoSurface, 0, j, st );
 
 			/* set color */
@@ -722,11 +648,10 @@ static picoModel_t *_mdc_load( PM_PARAMS_LOAD ){
 		}
 
 		/* get next surface */
-		surface = (mdcSurface_t*) ( (picoByte_t*) surface + surface->ofsEnd );
+		surface = (const mdcSurface_t*) ( (const picoByte_t*) surface + ofsEnd );
 	}
 
 	/* return the new pico model */
-	_pico_free( bb0 );
 	return picoModel;
 }
 
@@ -745,5 +670,6 @@ const picoModule_t picoModuleMDC =
 	_mdc_canload,                   /* validation routine */
 	_mdc_load,                      /* load routine */
 	NULL,                           /* save validation routine */
-	NULL                            /* save routine */
+	NULL,                           /* save routine */
+	PICO_MODULE_READONLY_BUFFER /* module flags */
 };
@@ -341,34 +341,43 @@ static picoModel_t *_ms3d_load( PM_PARAMS_LOAD ){
 			triangle = (TMsTriangle *)( ptrToTris + ( sizeof( TMsTriangle ) * triangleIndex ) );
 
 			/* run through triangle vertices */
+			/* corners get their own surface vertex unless one with the same origin, normal and st exists, */
+			/* the file shares vertex origins between triangles with different normals and st */
 			for ( m = 0; m < 3; m++ )
 			{
 				TMsVertex   *vertex;
 				unsigned int vertexIndex;
 				picoVec2_t texCoord;
+				picoColor_t *color = &white;
+				int surfaceVertex;
 
 				/* get ptr to vertex data */
 				vertexIndex = triangle->vertexIndices[ m ];
 				vertex = (TMsVertex *)( ptrToVerts + ( sizeof( TMsVertex ) * vertexIndex ) );
 
-				/* store vertex origin */
-				PicoSetSurfaceXYZ( surface,vertexIndex,vertex->xyz );
+				/* get texture vertex coord */
+				texCoord[ 0 ] = triangle->s[ m ];
+				texCoord[ 1 ] = -triangle->t[ m ];  /* flip t */
 
-				/* store vertex color */
-				PicoSetSurfaceColor( surface,0,vertexIndex,white );
+				surfaceVertex = PicoFindSurfaceVertexNum( surface, vertex->xyz, triangle->vertexNormals[ m ], 1, &texCoord, 1, color, 0 );
+				if ( surfaceVertex < 0 ) {
+					surfaceVertex = PicoGetSurfaceNumVertexes( surface );
 
-				/* store vertex normal */
-				PicoSetSurfaceNormal( surface,vertexIndex,triangle->vertexNormals[ m ] );
+					/* store vertex origin */
+					PicoSetSurfaceXYZ( surface,surfaceVertex,vertex->xyz );
 
-				/* store current face vertex index */
-				PicoSetSurfaceIndex( surface,( k * 3 + ( 2 - m ) ),(picoIndex_t)vertexIndex );
+					/* store vertex color */
+					PicoSetSurfaceColor( surface,0,surfaceVertex,white );
 
-				/* get texture vertex coord */
-				texCoord[ 0 ] = triangle->s[ m ];
-				texCoord[ 1 ] = -triangle->t[ m ];  /* flip t */
+					/* store vertex normal */
+					PicoSetSurfaceNormal( surface,surfaceVertex,triangle->vertexNormals[ m ] );
 
-				/* store texture vertex coord */
-				PicoSetSurfaceST( surface,0,vertexIndex,texCoord );
+					/* store texture vertex coord */
+					PicoSetSurfaceST( surface,0,surfaceVertex,texCoord );
+				}
+
+				/* store current face vertex index */
+				PicoSetSurfaceIndex( surface,( k * 3 + ( 2 - m ) ),(picoIndex_t)surfaceVertex );
 			}
 		}
 		/* store material */
@@ -181,7 +181,8 @@ static TObjVertexData *SizeObjVertexData(
 	}
 	/* given vertex data ptr needs to be resized */
 	if ( reqEntries == *allocated ) {
-		newAllocated = ( *allocated + SIZE_OBJ_STEP );
+		/* grow by half again, the whole array is copied every time */
+		newAllocated = ( *allocated / 2 > SIZE_OBJ_STEP ) ? ( *allocated + *allocated / 2 ) : ( *allocated + SIZE_OBJ_STEP );
 
 		/* throw out an extended debug message */
 #ifdef DEBUG_PM_OBJ_EX
@@ -831,33 +832,44 @@ static picoModel_t *_obj_load( PM_PARAMS_LOAD ){
 			/* to our current pico surface */
 			if ( has_v ) {
 				int max = 3;
+				int vertNum[ 4 ];
 				if ( have_quad ) {
 					max = 4;
 				}
 
-				/* assign all surface information */
+				/* assign all surface information, corners that match an earlier vertex share it */
 				for ( i = 0; i < max; i++ )
 				{
-					/*if( has_v  )*/ PicoSetSurfaceXYZ( curSurface,  ( curVertex + i ), verts  [ i ] );
-					/*if( has_vt )*/ PicoSetSurfaceST( curSurface,0,( curVertex + i ), coords [ i ] );
-					/*if( has_vn )*/ PicoSetSurfaceNormal( curSurface,  ( curVertex + i ), normals[ i ] );
+					picoVec2_t *st = &coords[ i ];
+
+					if ( !has_vt ) {
+						_pico_zero_vec2( coords[ i ] );
+					}
+					if ( !has_vn ) {
+						_pico_zero_vec( normals[ i ] );
+					}
+					vertNum[ i ] = PicoFindSurfaceVertexNum( curSurface, verts[ i ], normals[ i ], 1, st, 0, NULL, 0 );
+					if ( vertNum[ i ] < 0 ) {
+						vertNum[ i ] = curVertex++;
+						/*if( has_v  )*/ PicoSetSurfaceXYZ( curSurface,  vertNum[ i ], verts  [ i ] );
+						/*if( has_vt )*/ PicoSetSurfaceST( curSurface,0,vertNum[ i ], coords [ i ] );
+						/*if( has_vn )*/ PicoSetSurfaceNormal( curSurface,  vertNum[ i ], normals[ i ] );
+					}
 				}
 				/* add our triangle (A B C) */
-				PicoSetSurfaceIndex( curSurface,( curFace * 3 + 2 ),(picoIndex_t)( curVertex + 0 ) );
-				PicoSetSurfaceIndex( curSurface,( curFace * 3 + 1 ),(picoIndex_t)( curVertex + 1 ) );
-				PicoSetSurfaceIndex( curSurface,( curFace * 3 + 0 ),(picoIndex_t)( curVertex + 2 ) );
+				PicoSetSurfaceIndex( curSurface,( curFace * 3 + 2 ),(picoIndex_t)vertNum[ 0 ] );
+				PicoSetSurfaceIndex( curSurface,( curFace * 3 + 1 ),(picoIndex_t)vertNum[ 1 ] );
+				PicoSetSurfaceIndex( curSurface,( curFace * 3 + 0 ),(picoIndex_t)vertNum[ 2 ] );
 				curFace++;
 
 				/* if we don't have a simple triangle, but a quad... */
 				if ( have_quad ) {
 					/* we have to add another triangle (2nd half of quad which is A C D) */
-					PicoSetSurfaceIndex( curSurface,( curFace * 3 + 2 ),(picoIndex_t)( curVertex + 0 ) );
-					PicoSetSurfaceIndex( curSurface,( curFace * 3 + 1 ),(picoIndex_t)( curVertex + 2 ) );
-					PicoSetSurfaceIndex( curSurface,( curFace * 3 + 0 ),(picoIndex_t)( curVertex + 3 ) );
+					PicoSetSurfaceIndex( curSurface,( curFace * 3 + 2 ),(picoIndex_t)vertNum[ 0 ] );
+					PicoSetSurfaceIndex( curSurface,( curFace * 3 + 1 ),(picoIndex_t)vertNum[ 2 ] );
+					PicoSetSurfaceIndex( curSurface,( curFace * 3 + 0 ),(picoIndex_t)vertNum[ 3 ] );
 					curFace++;
 				}
-				/* increase vertex count */
-				curVertex += max;
 			}
 
 		}
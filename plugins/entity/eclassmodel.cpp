@@ -65,6 +65,13 @@ void CEntityEclassModel::Draw( int state, int rflags ) const {
 	g_QglTable.m_pfn_qglPopMatrix();
 }
 
+int CEntityEclassModel::GetTriangleCount( int rflags ) const {
+	if ( m_model && m_model->pRender ) {
+		return m_model->pRender->GetTriangleCount( rflags );
+	}
+	return 0;
+}
+
 // ISelect
 
 bool CEntityEclassModel::TestRay( const ray_t *ray, vec_t *dist ) const {
@@ -42,6 +42,7 @@ class CEntityMiscModel : public IRender, public ISelect, public IEdit
 	void Draw( int state, int rflags ) const;
 	const bool IsModelNotNull() const { return m_model && m_model->pRender; }
 	const aabb_t *GetAABB() const { return &m_BBox; }
+	int GetTriangleCount( int rflags ) const;
 
 	// ISelect
 	bool TestRay( const ray_t *ray, vec_t *dist ) const;
@@ -108,6 +109,7 @@ class CEntityEclassModel : public IRender, public ISelect, public IEdit
 	void Draw( int state, int rflags ) const;
 	const bool IsModelNotNull() const { return m_model && m_model->pRender; }
 	const aabb_t *GetAABB() const { return &m_BBox; }
+	int GetTriangleCount( int rflags ) const;
 
 	// ISelect
 	bool TestRay( const ray_t *ray, vec_t *dist ) const;
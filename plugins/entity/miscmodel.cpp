@@ -69,6 +69,13 @@ void CEntityMiscModel::Draw( int state, int rflags ) const {
 	g_QglTable.m_pfn_qglPopMatrix();
 }
 
+int CEntityMiscModel::GetTriangleCount( int rflags ) const {
+	if ( m_model && m_model->pRender ) {
+		return m_model->pRender->GetTriangleCount( rflags );
+	}
+	return 0;
+}
+
 // ISelect
 
 bool CEntityMiscModel::TestRay( const ray_t *ray, vec_t *dist ) const {
@@ -194,12 +194,12 @@ void Patch_Parse( patchMesh_t *pPatch ){
 	int i, j;
 	char *str;
 
-	char *token = Token();
+	char *token = MapToken();
 
-	GetToken( true ); //{
+	GetMapToken( true ); //{
 
 	// parse shader name
-	GetToken( true );
+	GetMapToken( true );
 	str = new char[strlen( token ) + 10];
 	strcpy( str, "textures/" );
 	strcpy( str + 9, token );
@@ -207,17 +207,17 @@ void Patch_Parse( patchMesh_t *pPatch ){
 	pPatch->d_texture = pPatch->pShader->getTexture();
 	delete [] str;
 
-	GetToken( true ); //(
+	GetMapToken( true ); //(
 
 	// parse matrix dimensions
-	GetToken( false );
+	GetMapToken( false );
 	pPatch->width = atoi( token );
 	if ( pPatch->width > MAX_PATCH_WIDTH ) {
 		Syn_Printf( "ERROR: patch has too many planes, patch width > MAX_PATCH_WIDTH (%i > %i)\n", pPatch->width, MAX_PATCH_WIDTH );
 		pPatch->width = MAX_PATCH_WIDTH;
 		abortcode = MAP_ABORTED;
 	}
-	GetToken( false );
+	GetMapToken( false );
 	pPatch->height = atoi( token );
 	if ( pPatch->height > MAX_PATCH_HEIGHT ) {
 		Syn_Printf( "ERROR: patch has too many plane points, patch height > MAX_PATCH_HEIGHT (%i > %i)\n", pPatch->height, MAX_PATCH_HEIGHT );
@@ -226,39 +226,39 @@ void Patch_Parse( patchMesh_t *pPatch ){
 	}
 
 	// ignore contents/flags/value
-	GetToken( false );
-	GetToken( false );
-	GetToken( false );
+	GetMapToken( false );
+	GetMapToken( false );
+	GetMapToken( false );
 
-	GetToken( false ); //)
+	GetMapToken( false ); //)
 
 	// parse matrix
-	GetToken( true ); //(
+	GetMapToken( true ); //(
 	for ( i = 0; i < pPatch->width; i++ )
 	{
-		GetToken( true ); //(
+		GetMapToken( true ); //(
 		for ( j = 0; j < pPatch->height; j++ )
 		{
-			GetToken( false ); //(
+			GetMapToken( false ); //(
 
-			GetToken( false );
+			GetMapToken( false );
 			pPatch->ctrl[i][j].xyz[0] = atof( token );
-			GetToken( false );
+			GetMapToken( false );
 			pPatch->ctrl[i][j].xyz[1] = atof( token );
-			GetToken( false );
+			GetMapToken( false );
 			pPatch->ctrl[i][j].xyz[2] = atof( token );
-			GetToken( false );
+			GetMapToken( false );
 			pPatch->ctrl[i][j].st[0] = atof( token );
-			GetToken( false );
+			GetMapToken( false );
 			pPatch->ctrl[i][j].st[1] = atof( token );
 
-			GetToken( false ); //)
+			GetMapToken( false ); //)
 		}
-		GetToken( false ); //)
+		GetMapToken( false ); //)
 	}
-	GetToken( true ); //)
+	GetMapToken( true ); //)
 
-	GetToken( true ); //}
+	GetMapToken( true ); //}
 }
 
 void Face_Parse( face_t *face, bool bAlternateTexdef = false ){
@@ -266,44 +266,44 @@ void Face_Parse( face_t *face, bool bAlternateTexdef = false ){
 	char *str;
 	bool bworldcraft = false;
 
-	char *token = Token();
+	char *token = MapToken();
 
 	// parse planepts
 	str = NULL;
 	for ( i = 0; i < 3; i++ )
 	{
-		GetToken( true ); //(
+		GetMapToken( true ); //(
 		for ( j = 0; j < 3; j++ )
 		{
-			GetToken( false );
+			GetMapToken( false );
 			face->planepts[i][j] = atof( token );
 		}
-		GetToken( false ); //)
+		GetMapToken( false ); //)
 	}
 
 	if ( bAlternateTexdef ) {
 		// parse alternate texdef
-		GetToken( false ); // (
-		GetToken( false ); // (
+		GetMapToken( false ); // (
+		GetMapToken( false ); // (
 		for ( i = 0; i < 3; i++ )
 		{
-			GetToken( false );
+			GetMapToken( false );
 			face->brushprimit_texdef.coords[0][i] = atof( token );
 		}
-		GetToken( false ); // )
-		GetToken( false ); // (
+		GetMapToken( false ); // )
+		GetMapToken( false ); // (
 		for ( i = 0; i < 3; i++ )
 		{
-			GetToken( false );
+			GetMapToken( false );
 			face->brushprimit_texdef.coords[1][i] = atof( token );
 		}
-		GetToken( false ); // )
-		GetToken( false ); // )
+		GetMapToken( false ); // )
+		GetMapToken( false ); // )
 	}
 
 
 	// parse shader name
-	GetToken( false ); // shader
+	GetMapToken( false ); // shader
 
 	// if we're loading a halflife map then we don't have a relative texture name
 	// we just get <texturename>.  So we need to convert this to a relative name
@@ -421,87 +421,87 @@ void Face_Parse( face_t *face, bool bAlternateTexdef = false ){
 
 	if ( !bAlternateTexdef ) {
 		if ( g_MapVersion == MAPVERSION_HL ) { // Q1 as well ?
-			GetToken( false );
+			GetMapToken( false );
 			if ( token[0] == '[' && token[1] == '\0' ) {
 				bworldcraft = true;
 
-				GetToken( false ); // UAxis[0]
-				GetToken( false ); // UAxis[1]
-				GetToken( false ); // UAxis[2]
+				GetMapToken( false ); // UAxis[0]
+				GetMapToken( false ); // UAxis[1]
+				GetMapToken( false ); // UAxis[2]
 
-				GetToken( false ); // shift
+				GetMapToken( false ); // shift
 				face->texdef.shift[0] = atof( token );
 
-				GetToken( false ); // ]
+				GetMapToken( false ); // ]
 
-				GetToken( false ); // [
-				GetToken( false ); // VAxis[0]
-				GetToken( false ); // VAxis[1]
-				GetToken( false ); // VAxis[2]
+				GetMapToken( false ); // [
+				GetMapToken( false ); // VAxis[0]
+				GetMapToken( false ); // VAxis[1]
+				GetMapToken( false ); // VAxis[2]
 
-				GetToken( false ); // shift
+				GetMapToken( false ); // shift
 				face->texdef.shift[1] = atof( token );
 
-				GetToken( false ); // ]
+				GetMapToken( false ); // ]
 
 				// rotation is derived from the U and V axes.
 				// ZHLT ignores this setting even if present in a .map file.
-				GetToken( false );
+				GetMapToken( false );
 				face->texdef.rotate = atof( token );
 
 				// Scales
-				GetToken( false );
+				GetMapToken( false );
 				face->texdef.scale[0] = atof( token );
-				GetToken( false );
+				GetMapToken( false );
 				face->texdef.scale[1] = atof( token );
 			}
 			else
 			{
-				UnGetToken();
+				UnGetMapToken();
 			}
 		}
 
 		if ( !bworldcraft ) { // !MAPVERSION_HL
 			// parse texdef
-			GetToken( false );
+			GetMapToken( false );
 			face->texdef.shift[0] = atof( token );
-			GetToken( false );
+			GetMapToken( false );
 			face->texdef.shift[1] = atof( token );
-			GetToken( false );
+			GetMapToken( false );
 			face->texdef.rotate = atof( token );
-			GetToken( false );
+			GetMapToken( false );
 			face->texdef.scale[0] = atof( token );
-			GetToken( false );
+			GetMapToken( false );
 			face->texdef.scale[1] = atof( token );
 		}
 	}
 	// parse the optional contents/flags/value
-	if ( !bworldcraft && TokenAvailable() ) {
-		GetToken( true );
+	if ( !bworldcraft && MapTokenAvailable() ) {
+		GetMapToken( true );
 		if ( isdigit( token[0] ) ) {
 			face->texdef.contents = atoi( token );
-			GetToken( false );
+			GetMapToken( false );
 			face->texdef.flags = atoi( token );
-			GetToken( false );
+			GetMapToken( false );
 			face->texdef.value = atoi( token );
 		}
 		else
 		{
-			UnGetToken();
+			UnGetMapToken();
 		}
 	}
 }
 
 bool Primitive_Parse( brush_t *pBrush ){
-	char *token = Token();
+	char *token = MapToken();
 
-	GetToken( true );
+	GetMapToken( true );
 	if ( !strcmp( token, "patchDef2" ) ) {
 		pBrush->patchBrush = true;
 		pBrush->pPatch = Patch_Alloc();
 		pBrush->pPatch->pSymbiot = pBrush;
 		Patch_Parse( pBrush->pPatch );
-		GetToken( true ); //}
+		GetMapToken( true ); //}
 
 		// A patchdef should never be loaded from a quake2 map file
 		// so we just return false and the brush+patch gets freed
@@ -515,7 +515,7 @@ bool Primitive_Parse( brush_t *pBrush ){
 	}
 	else if ( !strcmp( token, "brushDef" ) ) {
 		pBrush->bBrushDef = true;
-		GetToken( true ); // {
+		GetMapToken( true ); // {
 		while ( 1 )
 		{
 			face_t    *f = pBrush->brush_faces;
@@ -523,17 +523,17 @@ bool Primitive_Parse( brush_t *pBrush ){
 			Face_Parse( pBrush->brush_faces, true );
 			pBrush->brush_faces->next = f;
 			// check for end of brush
-			GetToken( true );
+			GetMapToken( true );
 			if ( strcmp( token,"}" ) == 0 ) {
 				break;
 			}
-			UnGetToken();
+			UnGetMapToken();
 		}
-		GetToken( true ); // }
+		GetMapToken( true ); // }
 	}
 	else
 	{
-		UnGetToken();
+		UnGetMapToken();
 		while ( 1 )
 		{
 			face_t    *f = pBrush->brush_faces;
@@ -542,11 +542,11 @@ bool Primitive_Parse( brush_t *pBrush ){
 			pBrush->brush_faces->next = f;
 
 			// check for end of brush
-			GetToken( true );
+			GetMapToken( true );
 			if ( strcmp( token,"}" ) == 0 ) {
 				break;
 			}
-			UnGetToken();
+			UnGetMapToken();
 		}
 	}
 	return true;
@@ -557,11 +557,11 @@ void Entity_Parse( entity_t *pEntity ){
 //  CPtrArray *brushes = NULL;
 	char temptoken[1024];
 
-	char *token = Token();
+	char *token = MapToken();
 
 	while ( 1 )
 	{
-		GetToken( true ); // { or } or epair
+		GetMapToken( true ); // { or } or epair
 		if ( !strcmp( token, "}" ) ) {
 			break;
 		}
@@ -579,7 +579,7 @@ void Entity_Parse( entity_t *pEntity ){
 		else {
 
 			strcpy( temptoken, token );
-			GetToken( false );
+			GetMapToken( false );
 
 			SetKeyValue( pEntity, temptoken, token );
 
@@ -602,12 +602,14 @@ void Map_Read( IDataStream *in, CPtrArray *map ){
 	buf = new char[len + 1];
 	in->Read( buf, len );
 	buf[len] = '\0';
-	StartTokenParsing( buf );
 	abortcode = MAP_NOERROR;
+	if ( !StartMapTokenParsing( buf, len ) ) {
+		abortcode = MAP_ABORTED;
+	}
 
 	while ( abortcode == MAP_NOERROR )
 	{
-		if ( !GetToken( true ) ) { // { or NULL
+		if ( !GetMapToken( true ) ) { // { or NULL
 			break;
 		}
 		pEntity = Entity_Alloc();
@@ -616,6 +618,7 @@ void Map_Read( IDataStream *in, CPtrArray *map ){
 		map->Add( pEntity );
 	}
 
+	EndMapTokenParsing();
 	delete [] buf;
 
 	if ( abortcode != MAP_NOERROR ) {
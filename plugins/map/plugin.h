@@ -73,6 +73,14 @@ void Map_WriteHL( CPtrArray *map, IDataStream *out );
 void Map_ReadQ2( IDataStream *in, CPtrArray *map );
 void Map_WriteQ2( CPtrArray *map, IDataStream *out );
 
+// tokenize.cpp
+bool StartMapTokenParsing( const char *buf, int len );
+void EndMapTokenParsing();
+qboolean GetMapToken( qboolean crossline );
+void UnGetMapToken();
+qboolean MapTokenAvailable();
+char *MapToken();
+
 extern CSynapseServer* g_pSynapseServer;
 
 class CSynapseClientMap : public CSynapseClient
@@ -0,0 +1,316 @@
+/*
+   Copyright (C) 1999-2007 id Software, Inc. and contributors.
+   For a list of contributors, see the accompanying CONTRIBUTORS file.
+
+   This file is part of GtkRadiant.
+
+   GtkRadiant is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   GtkRadiant is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with GtkRadiant; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+//
+// splits a .map buffer into tokens on several threads
+//
+// the buffer is cut into chunks at line starts and every chunk is tokenized on its own,
+// a chunk is redone if the one before it ended inside a quoted string that runs over the cut
+// the parser then reads the tokens back in order through GetMapToken and friends,
+// which follow the core's GetToken / UnGetToken / TokenAvailable rules to the letter
+//
+
+#include "plugin.h"
+#include <vector>
+
+#define MAP_MAXTOKEN        1024
+#define MAP_CHUNK_SIZE      ( 256 * 1024 )
+
+typedef struct
+{
+	int offset;             // first character, after the opening quote for quoted tokens
+	int length;
+	int line;               // relative to the chunk until the chunks are merged
+	bool newline;           // a line break or a comment sits between this token and the previous one
+	bool available;         // TokenAvailable would be true right before this token
+} mapToken_t;
+
+typedef struct
+{
+	const char *buf;
+	int start, end;         // the chunk, start is always a line start
+	int next;               // where the tokenizer stopped, can be past end
+	int lines;
+	bool trailDecided;      // the gap after the last token already has its first non-space character (a comment)
+	bool trailAvailable;
+	const char *error;      // set if the chunk could not be tokenized
+	int errorLine;
+	std::vector<mapToken_t> tokens;
+} mapChunk_t;
+
+static const char *s_pBuffer;
+static std::vector<mapToken_t> s_tokens;
+static size_t s_nCursor;
+static bool s_bUnget;
+static bool s_bEndAvailable;    // TokenAvailable after the last token, true if a comment follows it on its line
+static int s_nLine;
+static char s_token[MAP_MAXTOKEN];
+
+/*!
+   same rules as the core GetToken: whitespace is anything <= 32, // comments run to the end of the line,
+   quoted tokens can span lines and their line breaks are not counted
+ */
+static void Chunk_Tokenize( mapChunk_t *chunk ){
+	const char *buf = chunk->buf;
+	int p = chunk->start;
+	int line = 0;
+	bool newline, lineBreak, first;
+	mapToken_t tok;
+
+	chunk->tokens.clear();
+	chunk->error = NULL;
+
+	// a chunk cut at a line start has a line break right before its first token
+	newline = lineBreak = ( p > 0 && buf[p - 1] == '\n' );
+	first = true;
+
+	while ( p < chunk->end )
+	{
+		// skip space and comments, TokenAvailable only looks up to the first non-space character
+		for ( ;; )
+		{
+			while ( p < chunk->end && (unsigned char)buf[p] <= 32 && buf[p] )
+			{
+				if ( buf[p] == '\n' ) {
+					newline = true;
+					if ( first ) {
+						lineBreak = true;
+					}
+					line++;
+				}
+				p++;
+			}
+			if ( p < chunk->end && buf[p] == '/' && buf[p + 1] == '/' ) {
+				if ( first ) {
+					tok.available = !lineBreak;
+					first = false;
+				}
+				newline = true;
+				while ( buf[p] && buf[p] != '\n' )
+					p++;
+				if ( buf[p] ) {
+					p++;
+					line++;
+				}
+				continue;
+			}
+			break;
+		}
+		if ( p >= chunk->end || !buf[p] ) {
+			break;
+		}
+		if ( first ) {
+			tok.available = !lineBreak && buf[p] != ';';
+		}
+
+		tok.line = line;
+		tok.newline = newline;
+		newline = lineBreak = false;
+
+		if ( buf[p] == '"' ) {
+			p++;
+			tok.offset = p;
+			while ( buf[p] != '"' )
+			{
+				if ( !buf[p] ) {
+					chunk->error = "EOF inside quoted token";
+					chunk->errorLine = line;
+					chunk->next = p;
+					chunk->lines = line;
+					return;
+				}
+				p++;
+			}
+			tok.length = p - tok.offset;
+			p++;
+		}
+		else
+		{
+			tok.offset = p;
+			while ( (unsigned char)buf[p] > 32 )
+				p++;
+			tok.length = p - tok.offset;
+		}
+
+		if ( tok.length >= MAP_MAXTOKEN ) {
+			chunk->error = "Token too large";
+			chunk->errorLine = line;
+			chunk->next = p;
+			chunk->lines = line;
+			return;
+		}
+
+		chunk->tokens.push_back( tok );
+		first = true;
+	}
+
+	chunk->next = p;
+	chunk->lines = line;
+	chunk->trailDecided = !first;
+	chunk->trailAvailable = tok.available;
+}
+
+static void Chunk_Thread( gpointer data, gpointer user_data ){
+	Chunk_Tokenize( (mapChunk_t *)data );
+}
+
+/*!
+   tokenize the whole buffer, buf must stay valid until EndMapTokenParsing
+   \return false if the buffer is malformed, the error has been reported already
+ */
+bool StartMapTokenParsing( const char *buf, int len ){
+	std::vector<mapChunk_t> chunks;
+	int i, nChunks, start, end, nThreads;
+	size_t t;
+
+	s_pBuffer = buf;
+	s_tokens.clear();
+	s_nCursor = 0;
+	s_bUnget = false;
+	s_nLine = 1;
+	s_token[0] = '\0';
+
+	// cut at line starts, roughly MAP_CHUNK_SIZE apart
+	nChunks = len / MAP_CHUNK_SIZE + 1;
+	chunks.resize( nChunks );
+	start = 0;
+	for ( i = 0; i < nChunks; i++ )
+	{
+		end = ( i == nChunks - 1 ) ? len : start + MAP_CHUNK_SIZE;
+		if ( end > len ) {
+			end = len;
+		}
+		while ( end < len && buf[end - 1] != '\n' )
+			end++;
+		chunks[i].buf = buf;
+		chunks[i].start = start;
+		chunks[i].end = end;
+		start = end;
+	}
+
+	if ( nChunks > 1 ) {
+#if GLIB_CHECK_VERSION( 2, 36, 0 )
+		nThreads = g_get_num_processors();
+#else
+		nThreads = 2;
+#endif
+		GThreadPool *pool = g_thread_pool_new( Chunk_Thread, NULL, nThreads, TRUE, NULL );
+		for ( i = 0; i < nChunks; i++ )
+		{
+			if ( pool ) {
+				g_thread_pool_push( pool, &chunks[i], NULL );
+			}
+			else{
+				Chunk_Tokenize( &chunks[i] );
+			}
+		}
+		if ( pool ) {
+			g_thread_pool_free( pool, FALSE, TRUE );
+		}
+	}
+	else{
+		Chunk_Tokenize( &chunks[0] );
+	}
+
+	// a quoted string ran over the cut, the next chunk started in the middle of it
+	for ( i = 1; i < nChunks && !chunks[i - 1].error; i++ )
+	{
+		if ( chunks[i - 1].next > chunks[i].start ) {
+			chunks[i].start = chunks[i - 1].next;
+			if ( chunks[i].end < chunks[i].start ) {
+				chunks[i].end = chunks[i].start;
+			}
+			Chunk_Tokenize( &chunks[i] );
+		}
+	}
+
+	// merge, making the lines absolute
+	// a gap that runs over a cut takes TokenAvailable from its part in the earlier chunk, if it was decided there
+	int base = 1;
+	bool trailDecided = false, trailAvailable = false;
+	for ( i = 0; i < nChunks; i++ )
+	{
+		for ( t = 0; t < chunks[i].tokens.size(); t++ )
+		{
+			s_tokens.push_back( chunks[i].tokens[t] );
+			s_tokens.back().line += base;
+			if ( t == 0 && trailDecided ) {
+				s_tokens.back().available = trailAvailable;
+			}
+		}
+		if ( !chunks[i].tokens.empty() || !trailDecided ) {
+			trailDecided = chunks[i].trailDecided;
+			trailAvailable = chunks[i].trailAvailable;
+		}
+		if ( chunks[i].error ) {
+			Error( "%s on line %i", chunks[i].error, chunks[i].errorLine + base );
+			return false;
+		}
+		base += chunks[i].lines;
+	}
+	s_bEndAvailable = trailDecided && trailAvailable;
+
+	return true;
+}
+
+void EndMapTokenParsing(){
+	std::vector<mapToken_t>().swap( s_tokens );
+	s_pBuffer = NULL;
+}
+
+qboolean GetMapToken( qboolean crossline ){
+	if ( s_bUnget ) {
+		s_bUnget = false;
+		return true;
+	}
+
+	if ( s_nCursor >= s_tokens.size() ) {
+		if ( !crossline ) {
+			Sys_FPrintf( SYS_WRN, "Warning: Line %i is incomplete [01]\n", s_nLine );
+		}
+		return false;
+	}
+
+	const mapToken_t &tok = s_tokens[s_nCursor++];
+	if ( !crossline && tok.newline ) {
+		Sys_FPrintf( SYS_WRN, "Warning: Line %i is incomplete [02]\n", s_nLine );
+	}
+	memcpy( s_token, s_pBuffer + tok.offset, tok.length );
+	s_token[tok.length] = '\0';
+	s_nLine = tok.line;
+
+	return true;
+}
+
+void UnGetMapToken(){
+	s_bUnget = true;
+}
+
+qboolean MapTokenAvailable(){
+	if ( s_nCursor >= s_tokens.size() ) {
+		return s_bEndAvailable;
+	}
+	return s_tokens[s_nCursor].available;
+}
+
+char *MapToken(){
+	return s_token;
+}
@@ -19,8 +19,8 @@
    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <stddef.h>
 #include "cpicomodel.h"
-#include "cpicosurface.h"
 
 CPicoModel::CPicoModel( const PicoModelKey& key )
 	: m_refcount( 1 ){
@@ -43,9 +43,8 @@ CPicoModel::CPicoModel( const char *name, const int frame )
 }
 
 void CPicoModel::load( const char *name, const int frame ){
-	CPicoSurface *surf;
-	picoSurface_t *pSurface;
-	int i;
+	m_nBuffers[0] = m_nBuffers[1] = 0;
+	m_bBuffersTried = false;
 
 	m_name = new char[strlen( name ) + 1];
 	strcpy( m_name,name );
@@ -66,32 +65,13 @@ void CPicoModel::load( const char *name, const int frame ){
 		}
 	}
 
-	if ( m_pModel ) {
-		m_children = g_ptr_array_new();
-		aabb_clear( &m_BBox );
-		for ( i = 0; i < PicoGetModelNumSurfaces( m_pModel ); i++ )
-		{
-			pSurface = PicoGetModelSurface( m_pModel,i );
-			surf = new CPicoSurface( pSurface );
-			g_ptr_array_add( m_children, surf );
-			aabb_extend_by_aabb( &m_BBox, surf->GetAABB() );
-		}
-	}
-	else
-	{
-		m_BBox.origin[0] = m_BBox.origin[1] = m_BBox.origin[2] = 0;
-		m_BBox.extents[0] = m_BBox.extents[1] = m_BBox.extents[2] = 0;
-	}
+	LoadSurfaces();
 
 	m_parents = g_ptr_array_new();
 }
 
 CPicoModel::~CPicoModel(){
-	if ( m_pModel ) {
-		for ( unsigned int i = 0; i < m_children->len; i++ )
-			( (CPicoSurface*)m_children->pdata[i] )->DecRef();
-		g_ptr_array_free( m_children, FALSE );
-	}
+	FreeSurfaces();
 	g_ptr_array_free( m_parents, FALSE );
 	delete [] m_name;
 }
@@ -110,21 +90,55 @@ void CPicoModel::RemoveParent( CPicoParent *parent ){
 }
 
 void CPicoModel::Reload( void ){
-	CPicoSurface *surf;
-	picoSurface_t *pSurface;
-	int i;
 	unsigned int j;
 
-	// Get rid of the old model
-	if ( m_pModel ) {
-		for ( j = 0; j < m_children->len; j++ ) {
-			( (CPicoSurface*)m_children->pdata[j] )->DecRef();
-			g_ptr_array_remove_index_fast( m_children, j );
-		}
-	}
+	// Get rid of the old model, along with its draw arrays and buffers
+	FreeSurfaces();
 
 	// And reload it
 	m_pModel = PicoLoadModel( m_name, m_frame );
+	LoadSurfaces();
+
+	for ( j = 0; j < m_parents->len; j++ ) {
+		( (CPicoParent*)m_parents->pdata[j] )->UpdateShaders();
+	}
+}
+
+void CPicoModel::Draw( int state, vector<IShader*> shaders, int rflags ) const {
+	if ( m_pModel && !m_drawIndexes.empty() ) {
+		const GLuint *indexes = BeginDraw();
+		for ( unsigned int i = 0; i < m_children->len; i++ )
+			( (CPicoSurface*)m_children->pdata[i] )->Draw( state, shaders[i], rflags, indexes );
+		EndDraw();
+	}
+}
+
+void CPicoModel::Draw( int state, int rflags ) const {
+	if ( m_pModel && !m_drawIndexes.empty() ) {
+		const GLuint *indexes = BeginDraw();
+		for ( unsigned int i = 0; i < m_children->len; i++ )
+			( (CPicoSurface*)m_children->pdata[i] )->Draw( state, rflags, indexes );
+		EndDraw();
+	}
+}
+
+int CPicoModel::GetTriangleCount( int rflags ) const {
+	int lod = ( rflags & DRAW_RF_LOD_MASK ) >> DRAW_RF_LOD_SHIFT;
+	if ( lod >= PICO_NUM_LODS ) {
+		lod = PICO_NUM_LODS - 1;
+	}
+	return m_nNumTriangles[lod];
+}
+
+// private
+
+void CPicoModel::LoadSurfaces(){
+	CPicoSurface *surf;
+	picoSurface_t *pSurface;
+	int i, lod;
+
+	for ( lod = 0; lod < PICO_NUM_LODS; lod++ )
+		m_nNumTriangles[lod] = 0;
 
 	if ( m_pModel ) {
 		m_children = g_ptr_array_new();
@@ -135,6 +149,9 @@ void CPicoModel::Reload( void ){
 			surf = new CPicoSurface( pSurface );
 			g_ptr_array_add( m_children, surf );
 			aabb_extend_by_aabb( &m_BBox, surf->GetAABB() );
+			surf->BuildDrawArrays( m_drawVerts, m_drawIndexes );
+			for ( lod = 0; lod < PICO_NUM_LODS; lod++ )
+				m_nNumTriangles[lod] += surf->GetNumIndexes( lod ) / 3;
 		}
 	}
 	else
@@ -142,23 +159,89 @@ void CPicoModel::Reload( void ){
 		m_BBox.origin[0] = m_BBox.origin[1] = m_BBox.origin[2] = 0;
 		m_BBox.extents[0] = m_BBox.extents[1] = m_BBox.extents[2] = 0;
 	}
-
-	for ( j = 0; j < m_parents->len; j++ ) {
-		( (CPicoParent*)m_parents->pdata[j] )->UpdateShaders();
-	}
 }
 
-void CPicoModel::Draw( int state, vector<IShader*> shaders, int rflags ) const {
+void CPicoModel::FreeSurfaces(){
 	if ( m_pModel ) {
 		for ( unsigned int i = 0; i < m_children->len; i++ )
-			( (CPicoSurface*)m_children->pdata[i] )->Draw( state, shaders[i], rflags );
+			( (CPicoSurface*)m_children->pdata[i] )->DecRef();
+		g_ptr_array_free( m_children, TRUE );
 	}
+
+	if ( m_nBuffers[0] ) {
+		g_QglTable.m_pfn_qglDeleteBuffersARB( 2, m_nBuffers );
+		m_nBuffers[0] = m_nBuffers[1] = 0;
+	}
+	m_bBuffersTried = false;
+	vector<picoDrawVert_t>().swap( m_drawVerts );
+	vector<GLuint>().swap( m_drawIndexes );
 }
 
-void CPicoModel::Draw( int state, int rflags ) const {
-	if ( m_pModel ) {
-		for ( unsigned int i = 0; i < m_children->len; i++ )
-			( (CPicoSurface*)m_children->pdata[i] )->Draw( state, rflags );
+/*!
+   points the client arrays at the model, uploading it to buffer objects the first time round
+   \return the base for the surface indexes, an offset into the index buffer when there is one
+ */
+const GLuint *CPicoModel::BeginDraw() const {
+	const char *base;
+	const GLuint *indexes;
+
+	if ( !m_bBuffersTried ) {
+		m_bBuffersTried = true;
+		if ( g_QglTable.m_pfnHasBufferObjects() ) {
+			g_QglTable.m_pfn_qglGenBuffersARB( 2, m_nBuffers );
+			g_QglTable.m_pfn_qglBindBufferARB( GL_ARRAY_BUFFER_ARB, m_nBuffers[0] );
+			g_QglTable.m_pfn_qglBufferDataARB( GL_ARRAY_BUFFER_ARB, m_drawVerts.size() * sizeof( picoDrawVert_t ), &m_drawVerts[0], GL_STATIC_DRAW_ARB );
+			g_QglTable.m_pfn_qglBindBufferARB( GL_ELEMENT_ARRAY_BUFFER_ARB, m_nBuffers[1] );
+			g_QglTable.m_pfn_qglBufferDataARB( GL_ELEMENT_ARRAY_BUFFER_ARB, m_drawIndexes.size() * sizeof( GLuint ), &m_drawIndexes[0], GL_STATIC_DRAW_ARB );
+		}
+	}
+
+	if ( m_nBuffers[0] ) {
+		g_QglTable.m_pfn_qglBindBufferARB( GL_ARRAY_BUFFER_ARB, m_nBuffers[0] );
+		g_QglTable.m_pfn_qglBindBufferARB( GL_ELEMENT_ARRAY_BUFFER_ARB, m_nBuffers[1] );
+		base = NULL;
+		indexes = NULL;
+	}
+	else
+	{
+		base = (const char *)&m_drawVerts[0];
+		indexes = &m_drawIndexes[0];
+	}
+
+	// the surfaces turn texcoords and colors on as their pass needs them
+	g_QglTable.m_pfn_qglGetIntegerv( GL_VERTEX_ARRAY, &m_nClientState[0] );
+	g_QglTable.m_pfn_qglGetIntegerv( GL_NORMAL_ARRAY, &m_nClientState[1] );
+	g_QglTable.m_pfn_qglGetIntegerv( GL_TEXTURE_COORD_ARRAY, &m_nClientState[2] );
+	g_QglTable.m_pfn_qglGetIntegerv( GL_COLOR_ARRAY, &m_nClientState[3] );
+	g_QglTable.m_pfn_qglEnableClientState( GL_VERTEX_ARRAY );
+	g_QglTable.m_pfn_qglEnableClientState( GL_NORMAL_ARRAY );
+	g_QglTable.m_pfn_qglDisableClientState( GL_TEXTURE_COORD_ARRAY );
+	g_QglTable.m_pfn_qglDisableClientState( GL_COLOR_ARRAY );
+
+	g_QglTable.m_pfn_qglVertexPointer( 3, GL_FLOAT, sizeof( picoDrawVert_t ), base + offsetof( picoDrawVert_t, xyz ) );
+	g_QglTable.m_pfn_qglNormalPointer( GL_FLOAT, sizeof( picoDrawVert_t ), base + offsetof( picoDrawVert_t, normal ) );
+	g_QglTable.m_pfn_qglTexCoordPointer( 2, GL_FLOAT, sizeof( picoDrawVert_t ), base + offsetof( picoDrawVert_t, st ) );
+	g_QglTable.m_pfn_qglColorPointer( 4, GL_UNSIGNED_BYTE, sizeof( picoDrawVert_t ), base + offsetof( picoDrawVert_t, color ) );
+
+	return indexes;
+}
+
+void CPicoModel::EndDraw() const {
+	static const GLenum arrays[4] = { GL_VERTEX_ARRAY, GL_NORMAL_ARRAY, GL_TEXTURE_COORD_ARRAY, GL_COLOR_ARRAY };
+
+	if ( m_nBuffers[0] ) {
+		g_QglTable.m_pfn_qglBindBufferARB( GL_ARRAY_BUFFER_ARB, 0 );
+		g_QglTable.m_pfn_qglBindBufferARB( GL_ELEMENT_ARRAY_BUFFER_ARB, 0 );
+	}
+
+	for ( int i = 0; i < 4; i++ )
+	{
+		if ( m_nClientState[i] ) {
+			g_QglTable.m_pfn_qglEnableClientState( arrays[i] );
+		}
+		else{
+			g_QglTable.m_pfn_qglDisableClientState( arrays[i] );
+		}
 	}
 }
 
@@ -26,6 +26,7 @@
 #include "picomodel.h"
 
 #include "gtkr_vector.h"
+#include "cpicosurface.h"
 
 class CPicoParent
 {
@@ -68,6 +69,7 @@ void Draw( int state, vector<IShader*> shaders, int rflags ) const;
 virtual void Draw( int state, int rflags ) const;
 virtual const bool IsModelNotNull() const { return true; }
 virtual const aabb_t *GetAABB() const { return &m_BBox; }
+virtual int GetTriangleCount( int rflags ) const;
 
 //ISelect
 virtual bool TestRay( const ray_t *ray, vec_t *dist ) const;
@@ -77,6 +79,10 @@ char *GetShaderNameForSurface( const unsigned int surf );
 
 private:
 void AccumulateBBox();
+void LoadSurfaces();
+void FreeSurfaces();
+const GLuint *BeginDraw() const;
+void EndDraw() const;
 
 char *m_name;
 int m_frame;
@@ -88,6 +94,15 @@ GPtrArray *m_parents;   // array of CPicoParent
 
 GPtrArray* m_shaders;
 
+// all surfaces in one set of draw arrays, shared by every entity using this model and frame
+// the buffer objects are made on the first draw, a GL context is needed for that
+vector<picoDrawVert_t> m_drawVerts;
+vector<GLuint> m_drawIndexes;
+mutable GLuint m_nBuffers[2];   // vertexes, indexes
+mutable bool m_bBuffersTried;
+mutable GLint m_nClientState[4];
+int m_nNumTriangles[PICO_NUM_LODS];
+
 bool m_bReloaded;   // managed by CModelManager
 };
 
@@ -20,6 +20,13 @@
  */
 
 #include "cpicosurface.h"
+#include <algorithm>
+#include <queue>
+
+#define PICO_LOD_MIN_TRIANGLES  32  // smaller surfaces keep their full mesh at every level
+
+// share of the triangles each level keeps
+static const float s_lodRatios[PICO_NUM_LODS] = { 1.0f, 0.5f, 0.2f };
 
 // public
 
@@ -27,6 +34,8 @@ CPicoSurface::CPicoSurface( picoSurface_t *pSurface ){
 	refCount = 1;
 
 	m_pSurface = pSurface;
+	for ( int i = 0; i < PICO_NUM_LODS; i++ )
+		m_nFirstIndex[i] = m_nNumIndexes[i] = 0;
 
 	// PicoFixSurfaceNormals( pSurface );
 
@@ -55,12 +64,12 @@ CPicoSurface::~CPicoSurface(){
 	m_shader->DecRef();
 }
 
-void CPicoSurface::Draw( int state, int rflags ){
-	Draw( state, m_shader, rflags );
+void CPicoSurface::Draw( int state, int rflags, const GLuint *indexes ){
+	Draw( state, m_shader, rflags, indexes );
 }
 
-void CPicoSurface::Draw( int state, IShader *pShader, int rflags ){
-	int j;
+void CPicoSurface::Draw( int state, IShader *pShader, int rflags, const GLuint *indexes ){
+	int lod;
 
 	if ( !( rflags & ( DRAW_RF_SEL_OUTLINE | DRAW_RF_SEL_FILL | DRAW_RF_XY ) ) ) {
 		if ( state & DRAW_GL_TEXTURE_2D ) {
@@ -83,11 +92,6 @@ void CPicoSurface::Draw( int state, IShader *pShader, int rflags ){
 				g_QglTable.m_pfn_qglAlphaFunc( nFunc, fRef );
 			}
 		}
-		else
-		{
-			//g_QglTable.m_pfn_qglColor3fv( pShader->getTexture()->color );
-/*      g_QglTable.m_pfn_qglEnableClientState(GL_COLOR_ARRAY);*/
-		}
 
 		if ( !( state & DRAW_GL_WIRE ) && ( pShader->getFlags() & QER_CULL ) ) {
 			if ( pShader->getCull() == 2 ) {
@@ -103,48 +107,23 @@ void CPicoSurface::Draw( int state, IShader *pShader, int rflags ){
 
 	switch ( PicoGetSurfaceType( m_pSurface ) )
 	{
-	case PICO_TRIANGLES:  g_QglTable.m_pfn_qglBegin( GL_TRIANGLES );
-		for ( j = 0; j < PicoGetSurfaceNumIndexes( m_pSurface ); j++ )
-		{
-            qglNormal3f_convertFloat( PicoGetSurfaceNormal( m_pSurface,PicoGetSurfaceIndex( m_pSurface,j ) ) );
-
-			if ( !( rflags & ( DRAW_RF_SEL_OUTLINE | DRAW_RF_SEL_FILL | DRAW_RF_XY ) ) ) {
-				if ( state & DRAW_GL_TEXTURE_2D ) {
-                    qglTexCoord2f_convertFloat( PicoGetSurfaceST( m_pSurface,0,PicoGetSurfaceIndex( m_pSurface,j ) ) );
-				}
-				else {
-					picoByte_t *vertexColor = PicoGetSurfaceColor( m_pSurface,0,PicoGetSurfaceIndex( m_pSurface,j ) );
-					//% g_QglTable.m_pfn_qglColor4f( vertexColor[ 0 ] / 255.f,
-					//%                              vertexColor[ 1 ] / 255.f,
-					//%                              vertexColor[ 2 ] / 255.f,
-					//%                              vertexColor[ 3 ] / 255.f );
-					g_QglTable.m_pfn_qglColor4ubv( vertexColor );
-				}
+	case PICO_TRIANGLES:
+		// the model has set up the vertex and normal arrays, texcoords and colors follow the pass
+		if ( !( rflags & ( DRAW_RF_SEL_OUTLINE | DRAW_RF_SEL_FILL | DRAW_RF_XY ) ) ) {
+			if ( state & DRAW_GL_TEXTURE_2D ) {
+				g_QglTable.m_pfn_qglEnableClientState( GL_TEXTURE_COORD_ARRAY );
 			}
-            qglVertex3f_convertFloat( PicoGetSurfaceXYZ( m_pSurface, PicoGetSurfaceIndex( m_pSurface, j ) ) );
-		}
-		g_QglTable.m_pfn_qglEnd();
-		/*g_QglTable.m_pfn_qglVertexPointer( 3, GL_FLOAT, 0, PicoGetSurfaceXYZ( m_pSurface, 0 ) );
-		   g_QglTable.m_pfn_qglNormalPointer( GL_FLOAT, 0, PicoGetSurfaceNormal( m_pSurface, 0 ) );
-		   if( !(rflags & (DRAW_RF_SEL_OUTLINE|DRAW_RF_SEL_FILL|DRAW_RF_XY)) ) {
-		   if( state & DRAW_GL_TEXTURE_2D ) {
-		    g_QglTable.m_pfn_qglTexCoordPointer( 2, GL_FLOAT, 0, PicoGetSurfaceST( m_pSurface, 0, 0 ) );
-		   } else {
-		    g_QglTable.m_pfn_qglColorPointer( 4, GL_UNSIGNED_BYTE, 0, PicoGetSurfaceColor( m_pSurface, 0, 0 ) );
-		   }
-		   }
-		   g_QglTable.m_pfn_qglDrawElements( GL_TRIANGLES, PicoGetSurfaceNumIndexes( m_pSurface ), GL_UNSIGNED_INT, PicoGetSurfaceIndexes( m_pSurface, 0 ) );*/
-
-		/*g_QglTable.m_pfn_qglColor3f( 0.f, .5f, 1.f );
-		   g_QglTable.m_pfn_qglBegin( GL_LINES );
-		   for( int i = 0; i < PicoGetSurfaceNumIndexes( m_pSurface ); i++ ) {
-		   vec3_t outerpoint;
-		   VectorMA( PicoGetSurfaceXYZ( m_pSurface, PicoGetSurfaceIndex( m_pSurface, i ) ), .3f, PicoGetSurfaceNormal( m_pSurface, PicoGetSurfaceIndex( m_pSurface, i ) ), outerpoint );
-           qglVertex3f_convertFloat( PicoGetSurfaceXYZ( m_pSurface, PicoGetSurfaceIndex( m_pSurface, i ) ) );
-           qglVertex3f_convertFloat( outerpoint );
-		   }
-		   g_QglTable.m_pfn_qglEnd();*/
-
+			else{
+				g_QglTable.m_pfn_qglEnableClientState( GL_COLOR_ARRAY );
+			}
+		}
+		lod = ( rflags & DRAW_RF_LOD_MASK ) >> DRAW_RF_LOD_SHIFT;
+		if ( lod >= PICO_NUM_LODS ) {
+			lod = PICO_NUM_LODS - 1;
+		}
+		g_QglTable.m_pfn_qglDrawElements( GL_TRIANGLES, m_nNumIndexes[lod], GL_UNSIGNED_INT, indexes + m_nFirstIndex[lod] );
+		g_QglTable.m_pfn_qglDisableClientState( GL_TEXTURE_COORD_ARRAY );
+		g_QglTable.m_pfn_qglDisableClientState( GL_COLOR_ARRAY );
 		break;
 	default:              Sys_FPrintf( SYS_ERR, "ERROR: Unsupported Pico Surface Type: %i", PicoGetSurfaceType( m_pSurface ) );
 		break;
@@ -155,10 +134,6 @@ void CPicoSurface::Draw( int state, IShader *pShader, int rflags ){
 			g_QglTable.m_pfn_qglDisable( GL_ALPHA_TEST );
 		}
 
-/*	if(!(state & DRAW_GL_TEXTURE_2D)) {
-      g_QglTable.m_pfn_qglDisableClientState(GL_COLOR_ARRAY);
-    }*/
-
 		if ( !( state & DRAW_GL_WIRE ) && ( pShader->getFlags() & QER_CULL ) ) {
 			if ( pShader->getCull() == 2 ) {
 				g_QglTable.m_pfn_qglPolygonMode( GL_FRONT, GL_LINE );
@@ -172,6 +147,333 @@ void CPicoSurface::Draw( int state, IShader *pShader, int rflags ){
 	}
 }
 
+/*
+   ==============
+   simplified meshes
+   ==============
+ */
+
+typedef struct
+{
+	float cost;
+	int a, b;
+} lodEdge_t;
+
+struct lodEdgeGreater
+{
+	bool operator()( const lodEdge_t &e1, const lodEdge_t &e2 ) const { return e1.cost > e2.cost; }
+};
+
+// welded positions are the mesh topology, corners keep their own vertex until their position is collapsed away
+typedef struct
+{
+	const picoDrawVert_t *verts;
+	vector<int> rep;            // vertex -> position
+	vector<int> repVert;        // position -> a vertex at it
+	vector<char> repAlive;
+	vector< vector<int> > repTris;
+	vector<int> cornerRep;
+	vector<int> cornerVert;
+	vector<char> triAlive;
+	std::priority_queue<lodEdge_t, vector<lodEdge_t>, lodEdgeGreater> edges;
+} lodMesh_t;
+
+static const float *Lod_Pos( const lodMesh_t &m, int r ){
+	return m.verts[m.repVert[r]].xyz;
+}
+
+static void Lod_TriNormal( const float *p0, const float *p1, const float *p2, float *n ){
+	float e1[3], e2[3];
+	for ( int i = 0; i < 3; i++ )
+	{
+		e1[i] = p1[i] - p0[i];
+		e2[i] = p2[i] - p0[i];
+	}
+	n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+	n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+	n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+}
+
+static void Lod_PushEdge( lodMesh_t &m, int a, int b ){
+	lodEdge_t e;
+	const float *pa = Lod_Pos( m, a ), *pb = Lod_Pos( m, b );
+	e.cost = ( pa[0] - pb[0] ) * ( pa[0] - pb[0] ) + ( pa[1] - pb[1] ) * ( pa[1] - pb[1] ) + ( pa[2] - pb[2] ) * ( pa[2] - pb[2] );
+	e.a = a;
+	e.b = b;
+	m.edges.push( e );
+}
+
+// a can go onto b if they still share a triangle and none of the other triangles around a turns too far
+static bool Lod_CanCollapse( const lodMesh_t &m, int a, int b ){
+	bool shared = false;
+	for ( size_t i = 0; i < m.repTris[a].size(); i++ )
+	{
+		int t = m.repTris[a][i];
+		const float *p[3], *q[3];
+		float n1[3], n2[3], d;
+		bool hasB = false;
+
+		if ( !m.triAlive[t] ) {
+			continue;
+		}
+		for ( int k = 0; k < 3; k++ )
+		{
+			int r = m.cornerRep[t * 3 + k];
+			hasB |= ( r == b );
+			p[k] = Lod_Pos( m, r );
+			q[k] = ( r == a ) ? Lod_Pos( m, b ) : p[k];
+		}
+		if ( hasB ) {
+			shared = true;
+			continue;
+		}
+		// more than 60 degrees at once adds up to flipped triangles over a few collapses
+		Lod_TriNormal( p[0], p[1], p[2], n1 );
+		Lod_TriNormal( q[0], q[1], q[2], n2 );
+		d = n1[0] * n2[0] + n1[1] * n2[1] + n1[2] * n2[2];
+		if ( d <= 0 || d * d < 0.25f * ( n1[0] * n1[0] + n1[1] * n1[1] + n1[2] * n1[2] ) * ( n2[0] * n2[0] + n2[1] * n2[1] + n2[2] * n2[2] ) ) {
+			return false;
+		}
+	}
+	return shared;
+}
+
+/*!
+   the vertex at position b a corner using vertex v moves onto
+   a triangle on the collapsing edge that uses v holds the vertex at b on the same UV island,
+   without one the vertex at b with the closest ST is taken
+ */
+static int Lod_IslandVert( const lodMesh_t &m, int v, int b ){
+	int best = m.repVert[b];
+	float bestDist = -1;
+	for ( size_t i = 0; i < m.repTris[b].size(); i++ )
+	{
+		int t = m.repTris[b][i];
+		bool hasV = false;
+
+		if ( !m.triAlive[t] ) {
+			continue;
+		}
+		for ( int k = 0; k < 3; k++ )
+			hasV |= ( m.cornerVert[t * 3 + k] == v );
+		for ( int k = 0; k < 3; k++ )
+		{
+			int w = m.cornerVert[t * 3 + k];
+			float ds, dt, dist;
+			if ( m.cornerRep[t * 3 + k] != b ) {
+				continue;
+			}
+			if ( hasV ) {
+				return w;
+			}
+			ds = m.verts[w].st[0] - m.verts[v].st[0];
+			dt = m.verts[w].st[1] - m.verts[v].st[1];
+			dist = ds * ds + dt * dt;
+			if ( bestDist < 0 || dist < bestDist ) {
+				best = w;
+				bestDist = dist;
+			}
+		}
+	}
+	return best;
+}
+
+static int Lod_Collapse( lodMesh_t &m, int a, int b ){
+	int removed = 0;
+	size_t i;
+
+	// pick the new vertexes while the triangles on the edge are still alive to pair them up
+	for ( i = 0; i < m.repTris[a].size(); i++ )
+	{
+		int t = m.repTris[a][i];
+		bool hasB = false;
+
+		if ( !m.triAlive[t] ) {
+			continue;
+		}
+		for ( int k = 0; k < 3; k++ )
+			hasB |= ( m.cornerRep[t * 3 + k] == b );
+		if ( hasB ) {
+			continue;
+		}
+		for ( int k = 0; k < 3; k++ )
+		{
+			if ( m.cornerRep[t * 3 + k] == a ) {
+				m.cornerVert[t * 3 + k] = Lod_IslandVert( m, m.cornerVert[t * 3 + k], b );
+			}
+		}
+	}
+
+	for ( i = 0; i < m.repTris[a].size(); i++ )
+	{
+		int t = m.repTris[a][i];
+		bool hasB = false;
+
+		if ( !m.triAlive[t] ) {
+			continue;
+		}
+		for ( int k = 0; k < 3; k++ )
+			hasB |= ( m.cornerRep[t * 3 + k] == b );
+		if ( hasB ) {
+			m.triAlive[t] = false;
+			removed++;
+			continue;
+		}
+		for ( int k = 0; k < 3; k++ )
+		{
+			if ( m.cornerRep[t * 3 + k] == a ) {
+				m.cornerRep[t * 3 + k] = b;
+			}
+		}
+		for ( int k = 0; k < 3; k++ )
+		{
+			if ( m.cornerRep[t * 3 + k] != b ) {
+				Lod_PushEdge( m, b, m.cornerRep[t * 3 + k] );
+			}
+		}
+		m.repTris[b].push_back( t );
+	}
+	m.repAlive[a] = false;
+	vector<int>().swap( m.repTris[a] );
+	return removed;
+}
+
+struct lodPosLess
+{
+	const picoDrawVert_t *verts;
+	bool operator()( int i, int j ) const {
+		const float *p = verts[i].xyz, *q = verts[j].xyz;
+		if ( p[0] != q[0] ) {
+			return p[0] < q[0];
+		}
+		if ( p[1] != q[1] ) {
+			return p[1] < q[1];
+		}
+		return p[2] < q[2];
+	}
+};
+
+/*!
+   edge collapse decimation, the shortest edge goes first
+   verts are the surface vertexes, src the surface triangles in local vertex numbers
+   the kept triangles are appended to out, offset by base
+ */
+static void Lod_Decimate( const picoDrawVert_t *verts, int numVerts, const int *src, int numTris, int target, int base, vector<GLuint> &out ){
+	lodMesh_t m;
+	vector<int> order( numVerts );
+	lodPosLess less;
+	int i, k, r, alive;
+
+	m.verts = verts;
+
+	// weld
+	for ( i = 0; i < numVerts; i++ )
+		order[i] = i;
+	less.verts = verts;
+	std::sort( order.begin(), order.end(), less );
+	m.rep.resize( numVerts );
+	for ( i = 0; i < numVerts; i++ )
+	{
+		if ( i == 0 || less( order[i - 1], order[i] ) ) {
+			m.repVert.push_back( order[i] );
+		}
+		m.rep[order[i]] = (int)m.repVert.size() - 1;
+	}
+	m.repAlive.assign( m.repVert.size(), 1 );
+	m.repTris.resize( m.repVert.size() );
+
+	m.cornerRep.resize( numTris * 3 );
+	m.cornerVert.resize( numTris * 3 );
+	m.triAlive.assign( numTris, 1 );
+	for ( i = 0; i < numTris; i++ )
+	{
+		for ( k = 0; k < 3; k++ )
+		{
+			m.cornerVert[i * 3 + k] = src[i * 3 + k];
+			m.cornerRep[i * 3 + k] = r = m.rep[src[i * 3 + k]];
+			m.repTris[r].push_back( i );
+		}
+		for ( k = 0; k < 3; k++ )
+			Lod_PushEdge( m, m.cornerRep[i * 3 + k], m.cornerRep[i * 3 + ( k + 1 ) % 3] );
+	}
+
+	alive = numTris;
+	while ( alive > target && !m.edges.empty() )
+	{
+		lodEdge_t e = m.edges.top();
+		m.edges.pop();
+		if ( e.a == e.b || !m.repAlive[e.a] || !m.repAlive[e.b] ) {
+			continue;
+		}
+		if ( Lod_CanCollapse( m, e.a, e.b ) ) {
+			alive -= Lod_Collapse( m, e.a, e.b );
+		}
+		else if ( Lod_CanCollapse( m, e.b, e.a ) ) {
+			alive -= Lod_Collapse( m, e.b, e.a );
+		}
+	}
+
+	for ( i = 0; i < numTris; i++ )
+	{
+		if ( m.triAlive[i] ) {
+			for ( k = 0; k < 3; k++ )
+				out.push_back( base + m.cornerVert[i * 3 + k] );
+		}
+	}
+}
+
+void CPicoSurface::BuildDrawArrays( vector<picoDrawVert_t> &verts, vector<GLuint> &indexes ){
+	picoDrawVert_t vert;
+	picoVec_t *p;
+	picoByte_t *c;
+	int i, j, base, numTris, lod;
+
+	for ( lod = 0; lod < PICO_NUM_LODS; lod++ )
+	{
+		m_nFirstIndex[lod] = (int)indexes.size();
+		m_nNumIndexes[lod] = 0;
+	}
+	if ( PicoGetSurfaceType( m_pSurface ) != PICO_TRIANGLES ) {
+		return;
+	}
+
+	base = (int)verts.size();
+	for ( i = 0; i < PicoGetSurfaceNumVertexes( m_pSurface ); i++ )
+	{
+		p = PicoGetSurfaceXYZ( m_pSurface, i );
+		for ( j = 0; j < 3; j++ )
+			vert.xyz[j] = (float)p[j];
+		p = PicoGetSurfaceNormal( m_pSurface, i );
+		for ( j = 0; j < 3; j++ )
+			vert.normal[j] = p ? (float)p[j] : 0.f;
+		p = PicoGetSurfaceST( m_pSurface, 0, i );
+		for ( j = 0; j < 2; j++ )
+			vert.st[j] = p ? (float)p[j] : 0.f;
+		c = PicoGetSurfaceColor( m_pSurface, 0, i );
+		for ( j = 0; j < 4; j++ )
+			vert.color[j] = c ? c[j] : 255;
+		verts.push_back( vert );
+	}
+
+	m_nNumIndexes[0] = PicoGetSurfaceNumIndexes( m_pSurface );
+	for ( i = 0; i < m_nNumIndexes[0]; i++ )
+		indexes.push_back( base + PicoGetSurfaceIndex( m_pSurface, i ) );
+
+	numTris = m_nNumIndexes[0] / 3;
+	for ( lod = 1; lod < PICO_NUM_LODS; lod++ )
+	{
+		if ( numTris < PICO_LOD_MIN_TRIANGLES ) {
+			m_nFirstIndex[lod] = m_nFirstIndex[0];
+			m_nNumIndexes[lod] = m_nNumIndexes[0];
+			continue;
+		}
+		m_nFirstIndex[lod] = (int)indexes.size();
+		Lod_Decimate( &verts[base], (int)verts.size() - base, PicoGetSurfaceIndexes( m_pSurface, 0 ),
+					  numTris, (int)( numTris * s_lodRatios[lod] ), base, indexes );
+		m_nNumIndexes[lod] = (int)indexes.size() - m_nFirstIndex[lod];
+	}
+}
+
 // private
 
 void CPicoSurface::AccumulateBBox(){
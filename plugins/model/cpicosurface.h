@@ -19,9 +19,25 @@
    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#ifndef _CPICOSURFACE_H_
+#define _CPICOSURFACE_H_
+
 #include "plugin.h"
 #include "picomodel.h"
 
+#include "gtkr_vector.h"
+
+#define PICO_NUM_LODS       3   // the full mesh and two simplified ones
+
+/*! one vertex of the draw arrays a CPicoModel builds for its surfaces */
+typedef struct
+{
+	float xyz[3];
+	float normal[3];
+	float st[2];
+	unsigned char color[4];
+} picoDrawVert_t;
+
 /*! Largest (potentially) selectable leaf of a Pico model */
 class CPicoSurface
 {
@@ -36,9 +52,9 @@ void DecRef() {
 	}
 }
 
-void Draw( int state, IShader *pShader, int rflags );
-//IRender
-void Draw( int state, int rflags );
+// indexes points at the first index of the surface in the bound arrays, or is the offset into the bound index buffer
+void Draw( int state, IShader *pShader, int rflags, const GLuint *indexes );
+void Draw( int state, int rflags, const GLuint *indexes );
 const aabb_t *GetAABB() const { return &m_BBox; }
 
 //ISelect
@@ -48,11 +64,20 @@ char *GetShaderName( void ){
 	return PicoGetShaderName( m_pSurface->shader );
 }
 
+// appends the surface to the model draw arrays, indexes are made relative to the whole array
+// the simplified meshes share the vertexes and follow the full index list
+void BuildDrawArrays( vector<picoDrawVert_t> &verts, vector<GLuint> &indexes );
+int GetNumIndexes( int lod ) const { return m_nNumIndexes[lod]; }
+
 private:
 int refCount;
 aabb_t m_BBox;
 picoSurface_t *m_pSurface;
 IShader* m_shader;
+int m_nFirstIndex[PICO_NUM_LODS];
+int m_nNumIndexes[PICO_NUM_LODS];
 
 void AccumulateBBox();     // accumulate local bbox.. generally created from control handles
 };
+
+#endif // _CPICOSURFACE_H_
@@ -147,6 +147,9 @@ virtual const bool IsModelNotNull() const {
 virtual const aabb_t *GetAABB() const {
 	return m_model->GetAABB();
 }
+virtual int GetTriangleCount( int rflags ) const {
+	return m_model->GetTriangleCount( rflags );
+}
 virtual bool TestRay( const ray_t *ray, vec_t *dist ) const {
 	return m_model->TestRay( ray, dist );
 }
@@ -309,6 +312,9 @@ virtual const bool IsModelNotNull() const {
 virtual const aabb_t *GetAABB() const {
 	return m_model->GetAABB();
 }
+virtual int GetTriangleCount( int rflags ) const {
+	return m_model->GetTriangleCount( rflags );
+}
 virtual bool TestRay( const ray_t *ray, vec_t *dist ) const {
 	return m_model->TestRay( ray, dist );
 }
@@ -49,7 +49,6 @@ qtexture_t *WINAPI QERApp_Texture_ForName2( const char *filename );
 IShader *WINAPI QERApp_ColorShader_ForName( const char *name );
 void WINAPI QERApp_LoadShaderFile( const char *filename );
 
-//++timo TODO: use stl::map !! (I tried having a look to CMap but it obviously sucks)
 CShaderArray g_Shaders;
 // whenever a shader gets activated / deactivated this list is updated
 // NOTE: make sure you don't add a shader that's already in
@@ -126,19 +125,63 @@ void WINAPI QERApp_SortActiveShaders(){
 	g_ActiveShaders.SortShaders();
 }
 
+CShaderArray::CShaderArray(){
+	m_pNameIndex = g_hash_table_new_full( g_str_hash, g_str_equal, g_free, NULL );
+	m_pTextureIndex = g_hash_table_new_full( g_str_hash, g_str_equal, g_free, NULL );
+	m_pShaderSet = g_hash_table_new( g_direct_hash, g_direct_equal );
+}
+
+CShaderArray::~CShaderArray(){
+	g_hash_table_destroy( m_pNameIndex );
+	g_hash_table_destroy( m_pTextureIndex );
+	g_hash_table_destroy( m_pShaderSet );
+}
+
+void CShaderArray::IndexShader( CShader *pShader ){
+	char *key;
+
+	g_hash_table_insert( m_pShaderSet, pShader, pShader );
+
+	key = g_ascii_strdown( pShader->getName(), -1 );
+	if ( g_hash_table_lookup( m_pNameIndex, key ) == NULL ) {
+		g_hash_table_insert( m_pNameIndex, key, pShader );
+	}
+	else{
+		g_free( key );
+	}
+
+	key = g_strdup( QERApp_CleanTextureName( pShader->getTextureName() ) );
+	if ( g_hash_table_lookup( m_pTextureIndex, key ) == NULL ) {
+		g_hash_table_insert( m_pTextureIndex, key, pShader );
+	}
+	else{
+		g_free( key );
+	}
+}
+
+void CShaderArray::RebuildIndex(){
+	int i;
+
+	g_hash_table_remove_all( m_pNameIndex );
+	g_hash_table_remove_all( m_pTextureIndex );
+	g_hash_table_remove_all( m_pShaderSet );
+	for ( i = 0; i < CPtrArray::GetSize(); i++ )
+		IndexShader( static_cast < CShader * >( CPtrArray::GetAt( i ) ) );
+}
+
+void CShaderArray::Add( void *lp ){
+	CPtrArray::Add( lp );
+	IndexShader( static_cast < CShader * >( lp ) );
+}
+
 // NOTE: case sensitivity
 // although we store shader names with case information, Radiant does case insensitive searches
 // (we assume there's no case conflict with the names)
 CShader *CShaderArray::Shader_ForName( const char *name ) const {
-	int i;
-	for ( i = 0; i < CPtrArray::GetSize(); i++ )
-	{
-		CShader *pShader = static_cast < CShader * >( CPtrArray::GetAt( i ) );
-		if ( stricmp( pShader->getName(), name ) == 0 ) {
-			return pShader;
-		}
-	}
-	return NULL;
+	char *key = g_ascii_strdown( name, -1 );
+	CShader *pShader = static_cast < CShader * >( g_hash_table_lookup( m_pNameIndex, key ) );
+	g_free( key );
+	return pShader;
 }
 
 void CShader::CreateDefault( const char *name ){
@@ -156,15 +199,7 @@ CShader *CShaderArray::Shader_ForTextureName( const char *name ) const {
 			name );
 	}
 #endif
-	int i;
-	for ( i = 0; i < CPtrArray::GetSize(); i++ )
-	{
-		CShader *pShader = static_cast < CShader * >( CPtrArray::GetAt( i ) );
-		if ( strcmp( name, QERApp_CleanTextureName( pShader->getTextureName() ) ) == 0 ) {
-			return pShader;
-		}
-	}
-	return NULL;
+	return static_cast < CShader * >( g_hash_table_lookup( m_pTextureIndex, name ) );
 }
 
 IShader *WINAPI QERApp_ActiveShader_ForTextureName( char *name ){
@@ -172,15 +207,11 @@ IShader *WINAPI QERApp_ActiveShader_ForTextureName( char *name ){
 }
 
 void CShaderArray::AddSingle( void *lp ){
-	int i;
-	for ( i = 0; i < CPtrArray::GetSize(); i++ )
-	{
-		if ( CPtrArray::GetAt( i ) == lp ) {
-			return;
-		}
+	if ( g_hash_table_lookup( m_pShaderSet, lp ) != NULL ) {
+		return;
 	}
-	CPtrArray::Add( lp );
-	static_cast < CShader * >( CPtrArray::GetAt( i ) )->IncRef();
+	Add( lp );
+	static_cast < CShader * >( lp )->IncRef();
 }
 
 void CShaderArray::operator =( const class CShaderArray & src ){
@@ -192,6 +223,7 @@ void CShaderArray::operator =( const class CShaderArray & src ){
 	}
 #endif
 	Copy( src );
+	RebuildIndex();
 	// now go through and IncRef
 	for ( i = 0; i < CPtrArray::GetSize(); i++ )
 		static_cast < IShader * >( CPtrArray::GetAt( i ) )->IncRef();
@@ -206,6 +238,7 @@ void CShaderArray::ReleaseAll(){
 		static_cast < IShader * >( CPtrArray::GetAt( i ) )->DecRef();
 	// get rid
 	CPtrArray::RemoveAll();
+	RebuildIndex();
 }
 
 // NOTE TTimo:
@@ -661,7 +694,6 @@ void WINAPI QERApp_LoadShaderFile( const char *filename ){
 			pShader->setShaderFileName( filename );
 			if ( pShader->Parse() ) {
 				// do we already have this shader?
-				//++timo NOTE: this may a bit slow, we may need to use a map instead of a dumb list
 				if ( g_Shaders.Shader_ForName( pShader->getName() ) != NULL ) {
 #ifdef _DEBUG
 					Sys_FPrintf( SYS_WRN, "WARNING: shader %s is already in memory, definition in %s ignored.\n",
@@ -748,8 +780,6 @@ IShader *WINAPI QERApp_Shader_ForName( const char *name ){
 qtexture_t *WINAPI QERApp_Try_Texture_ForName( const char *name ){
 	qtexture_t *q;
 //  char f1[1024], f2[1024];
-	unsigned char *pPixels = NULL;
-	int nWidth, nHeight;
 
 	// convert the texture name to the standard format we use in qtexture_t
 	const char *stdName = QERApp_CleanTextureName( name );
@@ -770,15 +800,6 @@ qtexture_t *WINAPI QERApp_Try_Texture_ForName( const char *name ){
 	}
 #endif
 
-	g_FuncTable.m_pfnLoadImage( name, &pPixels, &nWidth, &nHeight );
-
-	if ( !pPixels ) {
-		return NULL; // we failed
-	}
-	else{
-		Sys_Printf( "LOADED: %s\n", name );
-	}
-
 	// instanciate a new qtexture_t
 	// NOTE: when called by a plugin we must make sure we have set Radiant's GL context before binding the texture
 
@@ -786,11 +807,14 @@ qtexture_t *WINAPI QERApp_Try_Texture_ForName( const char *name ){
 	// need to check we are using a right GL context
 	// with GL plugins that have their own window, the GL context may be the plugin's, in which case loading textures will bug
 	//  g_QglTable.m_pfn_glwidget_make_current (g_QglTable.m_pfn_GetQeglobalsGLWidget ());
-	q = g_FuncTable.m_pfnLoadTextureRGBA( pPixels, nWidth, nHeight );
+	// the image is decoded by Radiant, or taken from its on-disk texture cache
+	q = g_FuncTable.m_pfnLoadTexture( name );
 	if ( !q ) {
-		return NULL;
+		return NULL; // we failed
+	}
+	else{
+		Sys_Printf( "LOADED: %s\n", name );
 	}
-	g_free( pPixels );
 
 	strcpy( q->name, name );
 	// only strip extension if extension there is!
@@ -865,16 +889,21 @@ IShader *WINAPI QERApp_ColorShader_ForName( const char *name ){
 }
 
 void CShaderArray::ReleaseForShaderFile( const char *name ){
-	int i;
-	// decref
-	for ( i = 0; i < CPtrArray::GetSize(); i++ )
+	int i, j;
+	// decref, and pack the remaining shaders in one pass
+	for ( i = 0, j = 0; i < CPtrArray::GetSize(); i++ )
 	{
 		IShader *pShader = static_cast < IShader * >( CPtrArray::GetAt( i ) );
 		if ( !strcmp( name, pShader->getShaderFileName() ) ) {
 			pShader->DecRef();
-			CPtrArray::RemoveAt( i );
-			i--;    // get ready for next loop
 		}
+		else{
+			m_ptrs->pdata[j++] = pShader;
+		}
+	}
+	if ( j != i ) {
+		g_ptr_array_set_size( m_ptrs, j );
+		RebuildIndex();
 	}
 }
 
@@ -146,11 +146,15 @@ void CreateColor( const char* name );
 };
 
 // the classical CPtrArray with some enhancements
+// the lookups go through hash tables kept in sync by Add, AddSingle, operator =, ReleaseAll and ReleaseForShaderFile
+// NOTE: don't change the contents through the CPtrArray methods, the index would not follow
 class CShaderArray : public CPtrArray
 {
 public:
-CShaderArray() { }
-virtual ~CShaderArray() { }
+CShaderArray();
+virtual ~CShaderArray();
+// add a shader to the end of the array
+void Add( void* );
 // look for a shader with a given name (may return NULL)
 CShader* Shader_ForName( const char * ) const;
 // look for a shader with a given texture name (may return NULL)
@@ -170,6 +174,19 @@ void SortShaders();
 void SetDisplayed( bool b );
 // set the InUse flag for all shaders stored
 void SetInUse( bool b );
+
+private:
+// index a shader that was just appended, the first one wins on a name conflict like the old linear search did
+void IndexShader( CShader * );
+// rebuild the hash tables from the array contents
+void RebuildIndex();
+
+// lowercase shader name -> CShader
+GHashTable *m_pNameIndex;
+// qtexture_t style texture name -> CShader
+GHashTable *m_pTextureIndex;
+// the set of stored shaders, for AddSingle
+GHashTable *m_pShaderSet;
 };
 
 #endif
@@ -323,6 +323,7 @@ void Face_SetColor( brush_t *b, face_t *f, float fCurveColor ){
 	f->d_color[0] = f->pShader->getTexture()->color[0] * f->d_shade;
 	f->d_color[1] = f->pShader->getTexture()->color[1] * f->d_shade;
 	f->d_color[2] = f->pShader->getTexture()->color[2] * f->d_shade;
+	BrushRender_InvalidateColors( b );
 }
 
 /*
@@ -518,8 +519,10 @@ void Face_TexdefFromTextureVectors( face_t *f, long double STfromXYZ[2][4], vec3
    Face_MakePlane
    ================
  */
-void Face_MakePlane( face_t *f ){
+// returns false if the plane points don't make a normal, doesn't print so the map loader threads can use it
+static bool Face_MakePlaneQuiet( face_t *f ){
 	int j;
+	bool bNormal;
 	vec3_t t1, t2, t3;
 
 	// convert to a vector / dist plane
@@ -531,11 +534,17 @@ void Face_MakePlane( face_t *f ){
 	}
 
 	CrossProduct( t1,t2, f->plane.normal );
-	if ( VectorCompare( f->plane.normal, vec3_origin ) ) {
-		Sys_FPrintf( SYS_WRN, "WARNING: brush plane with no normal\n" );
-	}
+	bNormal = !VectorCompare( f->plane.normal, vec3_origin );
 	VectorNormalize( f->plane.normal, f->plane.normal );
 	f->plane.dist = DotProduct( t3, f->plane.normal );
+
+	return bNormal;
+}
+
+void Face_MakePlane( face_t *f ){
+	if ( !Face_MakePlaneQuiet( f ) ) {
+		Sys_FPrintf( SYS_WRN, "WARNING: brush plane with no normal\n" );
+	}
 }
 
 /*
@@ -858,14 +867,9 @@ void DrawBrushEntityName( brush_t *b ){
 	}
 }
 
-/*
-   =================
-   Brush_MakeFaceWinding
-
-   returns the visible polygon on a face
-   =================
- */
-winding_t *Brush_MakeFaceWinding( brush_t *b, face_t *face ){
+// clips the base winding of a face by the other planes of the brush,
+// bUnused is set when the face ends up with no area
+static winding_t *Brush_ClipFaceWinding( brush_t *b, face_t *face, bool &bUnused ){
 	winding_t   *w;
 	face_t      *clip;
 	plane_t plane;
@@ -904,9 +908,25 @@ winding_t *Brush_MakeFaceWinding( brush_t *b, face_t *face ){
 	if ( w->numpoints < 3 ) {
 		free( w );
 		w = NULL;
+		bUnused = true;
 	}
 
-	if ( !w ) {
+	return w;
+}
+
+/*
+   =================
+   Brush_MakeFaceWinding
+
+   returns the visible polygon on a face
+   =================
+ */
+winding_t *Brush_MakeFaceWinding( brush_t *b, face_t *face ){
+	winding_t   *w;
+	bool bUnused = false;
+
+	w = Brush_ClipFaceWinding( b, face, bUnused );
+	if ( bUnused ) {
 		Sys_FPrintf( SYS_WRN, "unused plane\n" );
 	}
 
@@ -941,6 +961,50 @@ void Brush_SnapPlanepts( brush_t *b ){
 	}
 }
 
+/*
+   =================
+   Brush_PrebuildWindings
+
+   the part of Brush_BuildWindings that only touches the brush itself: snaps the plane points,
+   makes the planes and clips the face windings, printing nothing
+   the map loader runs it on several threads, then Brush_Build keeps the windings while g_bBuildWindingsPrebuilt is set
+   returns false and leaves no windings if a face is degenerate or unused,
+   the regular Brush_BuildWindings redoes that brush and reports it
+   =================
+ */
+bool Brush_PrebuildWindings( brush_t *b, bool bSnap ){
+	face_t  *face;
+	bool bUnused = false;
+
+	if ( bSnap ) {
+		Brush_SnapPlanepts( b );
+	}
+
+	for ( face = b->brush_faces ; face ; face = face->next )
+	{
+		// also catches NaN plane points, Winding_BaseForPlane would Error on them
+		if ( !Face_MakePlaneQuiet( face ) || !( fabs( face->plane.normal[0] ) + fabs( face->plane.normal[1] ) + fabs( face->plane.normal[2] ) > 0.5 ) ) {
+			return false;
+		}
+	}
+
+	for ( face = b->brush_faces ; face ; face = face->next )
+	{
+		free( face->face_winding );
+		face->face_winding = Brush_ClipFaceWinding( b, face, bUnused );
+		if ( !face->face_winding ) {
+			for ( face = b->brush_faces ; face ; face = face->next )
+			{
+				free( face->face_winding );
+				face->face_winding = NULL;
+			}
+			return false;
+		}
+	}
+
+	return true;
+}
+
 /*
 ** Brush_Build
 **
@@ -982,6 +1046,7 @@ void Brush_Build( brush_t *b, bool bSnap, bool bMarkMap, bool bConvert, bool bFi
 		const aabb_t *aabb = b->owner->model.pRender->GetAABB();
 		VectorAdd( aabb->origin, aabb->extents, b->maxs );
 		VectorSubtract( aabb->origin, aabb->extents, b->mins );
+		BrushIndex_Link( b );
 	}
 
 	//Patch_BuildPoints (b); // does nothing but set b->patchBrush true if the texdef contains SURF_PATCH !
@@ -2013,6 +2078,9 @@ void Brush_Free( brush_t *b, bool bRemoveNode ){
 		Entity_UnlinkBrush( b );
 	}
 
+	BrushIndex_Unlink( b );
+	BrushRender_Invalidate( b );
+
 	free( b );
 }
 
@@ -2439,6 +2507,12 @@ void    Brush_AddToList( brush_t *b, brush_t *blist ){
 	blist->next->prev = b;
 	blist->next = b;
 	b->prev = blist;
+	b->list = blist;
+
+	// clones copy their bounds without building windings
+	if ( !b->pIndexEntry ) {
+		BrushIndex_Link( b );
+	}
 
 	// TTimo messaging
 	DispatchRadiantMsg( RADIANT_SELECTION );
@@ -2455,6 +2529,20 @@ void    Brush_RemoveFromList( brush_t *b ){
 	b->next->prev = b->prev;
 	b->prev->next = b->next;
 	b->next = b->prev = NULL;
+	b->list = NULL;
+}
+
+/*
+   ================
+   Brush_SetList
+
+   points the brushes of a list back at it, after the whole list was spliced
+   over in one go
+   ================
+ */
+void Brush_SetList( brush_t *blist ){
+	for ( brush_t *b = blist->next; b != blist; b = b->next )
+		b->list = blist;
 }
 
 /*
@@ -2812,6 +2900,7 @@ void Brush_SideSelect( brush_t *b, vec3_t origin, vec3_t dir
 }
 
 bool g_bBuildWindingsNoTexBuild = false;
+bool g_bBuildWindingsPrebuilt = false;
 
 void Brush_SetBuildWindingsNoTexBuild( bool bBuild ){
 	g_bBuildWindingsNoTexBuild = bBuild;
@@ -2826,14 +2915,22 @@ void Brush_BuildWindings( brush_t *b, bool bSnap ){
 	face_t    *face;
 	vec_t v;
 
-	if ( bSnap ) {
+	// the map loader clipped the windings on its threads already, see Brush_PrebuildWindings
+	bool bPrebuilt = g_bBuildWindingsPrebuilt && b->brush_faces && b->brush_faces->face_winding;
+
+	if ( bSnap && !bPrebuilt ) {
 		Brush_SnapPlanepts( b );
 	}
 
+	// the windings are about to change under the cached camera geometry
+	BrushRender_Invalidate( b );
+
 	// clear the mins/maxs bounds
     ClearBounds( b->mins, b->maxs );
 
-	Brush_MakeFacePlanes( b );
+	if ( !bPrebuilt ) {
+		Brush_MakeFacePlanes( b );
+	}
 
 	face = b->brush_faces;
 
@@ -2842,8 +2939,14 @@ void Brush_BuildWindings( brush_t *b, bool bSnap ){
 	for ( ; face ; face = face->next )
 	{
 		int i, j;
-		free( face->face_winding );
-		w = face->face_winding = Brush_MakeFaceWinding( b, face );
+		if ( bPrebuilt ) {
+			w = face->face_winding;
+		}
+		else
+		{
+			free( face->face_winding );
+			w = face->face_winding = Brush_MakeFaceWinding( b, face );
+		}
 
 		if ( !g_bBuildWindingsNoTexBuild || !face->d_texture ) {
 #ifdef _DEBUG
@@ -2928,6 +3031,8 @@ void Brush_BuildWindings( brush_t *b, bool bSnap ){
 				EmitTextureCoordinates( w->points[i], face->d_texture, face );
 		}
 	}
+
+	BrushIndex_Link( b );
 }
 
 /*
@@ -3413,7 +3518,9 @@ void Brush_DrawXY( brush_t *b, int nViewType ){
 			qglPushAttrib( GL_CURRENT_BIT ); // save brush colour
             qglColor3f_convertFloat( b->owner->eclass->color );
 			if ( g_PrefsDlg.m_nEntityShowState != ENTITY_BOX ) {
+				Profiler_Push( PROF_MODELS );
 				b->owner->model.pRender->Draw( DRAW_GL_WIRE, DRAW_RF_XY );
+				Profiler_Pop();
 			}
 			aabb_draw( b->owner->model.pRender->GetAABB(), DRAW_GL_WIRE );
 			qglPopAttrib();
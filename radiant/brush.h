@@ -24,11 +24,13 @@
 
 // some usefull flags to control the behaviour of Brush_Build
 extern bool g_bBuildWindingsNoTexBuild;
+extern bool g_bBuildWindingsPrebuilt;
 
 void        Brush_AddToList( brush_t *b, brush_t *lst );
 void        Brush_Build( brush_t *b, bool bSnap = true, bool bMarkMap = true, bool bConvert = false, bool bFilterTest = true );
 void    Brush_SetBuildWindingsNoTexBuild( bool bBuild );
 void        Brush_BuildWindings( brush_t *b, bool bSnap = true );
+bool        Brush_PrebuildWindings( brush_t *b, bool bSnap = true );
 brush_t*    Brush_Clone( brush_t *b );
 brush_t*    Brush_FullClone( brush_t *b );
 brush_t*    Brush_Create( vec3_t mins, vec3_t maxs, texdef_t *texdef );
@@ -47,6 +49,7 @@ bool        Brush_MoveVertex( brush_t *b, vec3_t vertex, vec3_t delta, vec3_t en
 void        Brush_ResetFaceOriginals( brush_t *b );
 face_t*     Brush_Ray( vec3_t origin, vec3_t dir, brush_t *b, vec_t *dist, int nFlags = 0 );
 void        Brush_RemoveFromList( brush_t *b );
+void        Brush_SetList( brush_t *blist );
 // bCaulk means the faces created during the operation will be caulked, this is used in conjunction with g_PrefsDlg.m_bClipCaulk
 void        Brush_SplitBrushByFace( brush_t *in, face_t *f, brush_t **front, brush_t **back, qboolean bCaulk = false );
 void        Brush_SelectFaceForDragging( brush_t *b, face_t *f, qboolean shear );
@@ -68,6 +71,7 @@ float       SetShadeForPlane( plane_t *p );
 face_t* Face_Alloc( void );
 void        Face_Free( face_t *f );
 face_t* Face_Clone( face_t *f );
+int         Face_MemorySize( face_t *f );
 void    Face_SetShader( face_t *face, const char *name );
 /*!
    faster version if you know the IShader already
@@ -75,6 +79,7 @@ void    Face_SetShader( face_t *face, const char *name );
  */
 void    Face_SetShader( face_t *face, IShader *shader );
 void    Face_MakePlane( face_t *f );
+void Face_SetColor( brush_t *b, face_t *f, float fCurveColor );
 void        Face_Draw( face_t *face );
 void Face_TextureVectors( face_t * f, float STfromXYZ[2][4] );
 void        SetFaceTexdef( face_t *f, texdef_t *texdef, brushprimit_texdef_t *brushprimit_texdef, bool bFitScale = false, IPluginTexdef* pPlugTexdef = NULL );
@@ -87,4 +92,30 @@ brush_t *Brush_Alloc();
 const char* Brush_Name( brush_t *b );
 
 //eclass_t* HasModel(brush_t *b);
+
+/*!
+   spatial index over brush bounds, see brushindex.cpp
+   a query marks the candidate brushes, BrushIndex_QueryBox also returns them,
+   callers walking a list skip the brushes BrushIndex_IsMarked rejects
+ */
+void BrushIndex_Link( brush_t *b );
+void BrushIndex_Unlink( brush_t *b );
+void BrushIndex_MarkBox( const vec3_t mins, const vec3_t maxs );
+void BrushIndex_QueryBox( const vec3_t mins, const vec3_t maxs, CPtrArray &brushes );
+void BrushIndex_MarkRay( const vec3_t origin, const vec3_t dir );
+bool BrushIndex_IsMarked( const brush_t *b );
+void BrushIndex_Benchmark();
+
+/*!
+   batched camera renderer for world brushes, see brushrender.cpp
+ */
+void BrushRender_Invalidate( brush_t *b );
+void BrushRender_InvalidateColors( brush_t *b );
+void BrushRender_InvalidateAll();
+void BrushRender_Begin( int nGLState, int nDrawMode );
+bool BrushRender_Queue( brush_t *b );
+void BrushRender_Flush();
+void BrushRender_BeginLines( int nViewType );
+bool BrushRender_QueueLines( brush_t *b, int nViewType, const float color[3] );
+void BrushRender_FlushLines( int nViewType );
 void aabb_draw( const aabb_t *aabb, int mode );
@@ -0,0 +1,510 @@
+/*
+   Copyright (C) 1999-2007 id Software, Inc. and contributors.
+   For a list of contributors, see the accompanying CONTRIBUTORS file.
+
+   This file is part of GtkRadiant.
+
+   GtkRadiant is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   GtkRadiant is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with GtkRadiant; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/*
+   brush spatial index
+
+   a loose octree over the bounds of every built brush. each node's bounds are
+   doubled, so a brush lives in the deepest node whose cell contains its center
+   and whose half size is at least the brush's largest half extent; a brush can
+   never straddle a node and nothing is ever split or duplicated.
+
+   queries stamp the entries they touch, BrushIndex_IsMarked lets the callers
+   that walk a short list (the selection) skip the per-brush work for everything
+   else. BrushIndex_QueryBox also hands back the brushes it stamps, so the views
+   only visit those; the index holds every built brush, including the ones on
+   the region, undo and clipboard lists, so callers check brush_t::list.
+ */
+
+#include "stdafx.h"
+#include <vector>
+
+#define BRUSHINDEX_MAX_DEPTH    10
+#define BRUSHINDEX_PADDING      1.0
+
+typedef struct brushIndexEntry_s
+{
+	brush_t *brush;
+	vec3_t mins, maxs;
+	int node;           // node holding this entry
+	int slot;           // position in that node's entry list
+	unsigned int stamp;
+} brushIndexEntry_t;
+
+typedef struct brushIndexNode_s
+{
+	vec3_t center;
+	vec_t half;
+	int depth;
+	int children[8];
+	int count;          // entries in this node and below
+	std::vector<brushIndexEntry_t*> entries;
+} brushIndexNode_t;
+
+static std::vector<brushIndexNode_t> g_IndexNodes;
+static unsigned int g_nIndexStamp = 1;
+
+static int BrushIndex_AllocNode( const vec3_t center, vec_t half, int depth ){
+	brushIndexNode_t node;
+
+	VectorCopy( center, node.center );
+	node.half = half;
+	node.depth = depth;
+	for ( int i = 0; i < 8; i++ )
+		node.children[i] = -1;
+	node.count = 0;
+	g_IndexNodes.push_back( node );
+	return (int)g_IndexNodes.size() - 1;
+}
+
+static void BrushIndex_Init(){
+	vec3_t center;
+
+	if ( !g_IndexNodes.empty() ) {
+		return;
+	}
+
+	center[0] = center[1] = center[2] = ( g_MinWorldCoord + g_MaxWorldCoord ) * 0.5;
+	BrushIndex_AllocNode( center, ( g_MaxWorldCoord - g_MinWorldCoord ) * 0.5, 0 );
+}
+
+/*
+   ================
+   BrushIndex_Insert
+
+   walks down from the root as long as the entry fits in a child's loose cell
+   ================
+ */
+static void BrushIndex_Insert( brushIndexEntry_t *entry ){
+	vec3_t center;
+	vec_t extent;
+	int i, n;
+
+	extent = 0;
+	for ( i = 0; i < 3; i++ )
+	{
+		center[i] = ( entry->mins[i] + entry->maxs[i] ) * 0.5;
+		extent = MAX( extent, ( entry->maxs[i] - entry->mins[i] ) * 0.5 );
+	}
+
+	n = 0;
+	while ( g_IndexNodes[n].depth < BRUSHINDEX_MAX_DEPTH )
+	{
+		vec_t childHalf = g_IndexNodes[n].half * 0.5;
+		int child = 0;
+
+		// outside the root cell, or too big for a child
+		if ( extent > childHalf ) {
+			break;
+		}
+		for ( i = 0; i < 3; i++ )
+		{
+			if ( fabs( center[i] - g_IndexNodes[n].center[i] ) > g_IndexNodes[n].half ) {
+				break;
+			}
+			if ( center[i] >= g_IndexNodes[n].center[i] ) {
+				child |= 1 << i;
+			}
+		}
+		if ( i < 3 ) {
+			break;
+		}
+
+		if ( g_IndexNodes[n].children[child] < 0 ) {
+			vec3_t childCenter;
+			for ( i = 0; i < 3; i++ )
+				childCenter[i] = g_IndexNodes[n].center[i] + ( ( child & ( 1 << i ) ) ? childHalf : -childHalf );
+			// AllocNode may move the node array
+			int c = BrushIndex_AllocNode( childCenter, childHalf, g_IndexNodes[n].depth + 1 );
+			g_IndexNodes[n].children[child] = c;
+		}
+		g_IndexNodes[n].count++;
+		n = g_IndexNodes[n].children[child];
+	}
+
+	g_IndexNodes[n].count++;
+	entry->node = n;
+	entry->slot = (int)g_IndexNodes[n].entries.size();
+	g_IndexNodes[n].entries.push_back( entry );
+}
+
+static void BrushIndex_Remove( brushIndexEntry_t *entry ){
+	brushIndexNode_t *node = &g_IndexNodes[entry->node];
+	brushIndexEntry_t *last = node->entries.back();
+	vec3_t center;
+	int i, n;
+
+	last->slot = entry->slot;
+	node->entries[entry->slot] = last;
+	node->entries.pop_back();
+
+	// fix up the counts along the path from the root
+	for ( i = 0; i < 3; i++ )
+		center[i] = ( entry->mins[i] + entry->maxs[i] ) * 0.5;
+	n = 0;
+	while ( n != entry->node )
+	{
+		int child = 0;
+		g_IndexNodes[n].count--;
+		for ( i = 0; i < 3; i++ )
+			if ( center[i] >= g_IndexNodes[n].center[i] ) {
+				child |= 1 << i;
+			}
+		n = g_IndexNodes[n].children[child];
+	}
+	g_IndexNodes[n].count--;
+}
+
+/*
+   ================
+   BrushIndex_Link
+
+   (re)inserts a brush after its bounds were rebuilt
+   brushes without valid bounds are dropped from the index, which makes
+   BrushIndex_IsMarked accept them unconditionally
+   ================
+ */
+void BrushIndex_Link( brush_t *b ){
+	brushIndexEntry_t *entry = (brushIndexEntry_t*)b->pIndexEntry;
+	vec3_t mins, maxs;
+	int i;
+
+	for ( i = 0; i < 3; i++ )
+	{
+		if ( b->mins[i] > b->maxs[i] ) {
+			BrushIndex_Unlink( b );
+			return;
+		}
+		mins[i] = b->mins[i] - BRUSHINDEX_PADDING;
+		maxs[i] = b->maxs[i] + BRUSHINDEX_PADDING;
+	}
+
+	if ( entry ) {
+		if ( VectorCompare( mins, entry->mins ) && VectorCompare( maxs, entry->maxs ) ) {
+			return;
+		}
+		BrushIndex_Remove( entry );
+	}
+	else
+	{
+		BrushIndex_Init();
+		entry = (brushIndexEntry_t*)qmalloc( sizeof( brushIndexEntry_t ) );
+		entry->brush = b;
+		b->pIndexEntry = entry;
+	}
+
+	VectorCopy( mins, entry->mins );
+	VectorCopy( maxs, entry->maxs );
+	BrushIndex_Insert( entry );
+}
+
+void BrushIndex_Unlink( brush_t *b ){
+	brushIndexEntry_t *entry = (brushIndexEntry_t*)b->pIndexEntry;
+
+	if ( !entry ) {
+		return;
+	}
+	BrushIndex_Remove( entry );
+	free( entry );
+	b->pIndexEntry = NULL;
+}
+
+bool BrushIndex_IsMarked( const brush_t *b ){
+	const brushIndexEntry_t *entry = (const brushIndexEntry_t*)b->pIndexEntry;
+	return !entry || entry->stamp == g_nIndexStamp;
+}
+
+static bool BrushIndex_BoxesTouch( const vec3_t mins1, const vec3_t maxs1, const vec3_t mins2, const vec3_t maxs2 ){
+	for ( int i = 0; i < 3; i++ )
+	{
+		if ( mins1[i] > maxs2[i] || maxs1[i] < mins2[i] ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static void BrushIndex_MarkBox_r( int n, const vec3_t mins, const vec3_t maxs, CPtrArray *brushes ){
+	brushIndexNode_t *node = &g_IndexNodes[n];
+	vec3_t looseMins, looseMaxs;
+	size_t i;
+
+	if ( !node->count ) {
+		return;
+	}
+
+	// the root also holds everything outside the world cell
+	if ( n ) {
+		for ( i = 0; i < 3; i++ )
+		{
+			looseMins[i] = node->center[i] - node->half * 2;
+			looseMaxs[i] = node->center[i] + node->half * 2;
+		}
+		if ( !BrushIndex_BoxesTouch( looseMins, looseMaxs, mins, maxs ) ) {
+			return;
+		}
+	}
+
+	for ( i = 0; i < node->entries.size(); i++ )
+	{
+		brushIndexEntry_t *entry = node->entries[i];
+		if ( BrushIndex_BoxesTouch( entry->mins, entry->maxs, mins, maxs ) ) {
+			entry->stamp = g_nIndexStamp;
+			if ( brushes ) {
+				brushes->Add( entry->brush );
+			}
+		}
+	}
+
+	for ( i = 0; i < 8; i++ )
+	{
+		if ( node->children[i] >= 0 ) {
+			BrushIndex_MarkBox_r( node->children[i], mins, maxs, brushes );
+		}
+	}
+}
+
+/*
+   ================
+   BrushIndex_MarkBox
+
+   marks every indexed brush whose bounds touch the box
+   ================
+ */
+void BrushIndex_MarkBox( const vec3_t mins, const vec3_t maxs ){
+	g_nIndexStamp++;
+	if ( !g_IndexNodes.empty() ) {
+		BrushIndex_MarkBox_r( 0, mins, maxs, NULL );
+	}
+}
+
+/*
+   ================
+   BrushIndex_QueryBox
+
+   marks like BrushIndex_MarkBox and fills brushes with the marked brushes, in
+   index order. brushes without valid bounds aren't indexed and never show up
+   ================
+ */
+void BrushIndex_QueryBox( const vec3_t mins, const vec3_t maxs, CPtrArray &brushes ){
+	g_nIndexStamp++;
+	brushes.RemoveAll();
+	if ( !g_IndexNodes.empty() ) {
+		BrushIndex_MarkBox_r( 0, mins, maxs, &brushes );
+	}
+}
+
+/*
+   slab test of an infinite line against a box; Brush_Ray callers don't all
+   reject hits behind the origin, so neither does the index
+ */
+static bool BrushIndex_LineTouches( const vec3_t mins, const vec3_t maxs, const vec3_t origin, const vec3_t dir ){
+	vec_t enter = -1e30, leave = 1e30;
+
+	for ( int i = 0; i < 3; i++ )
+	{
+		if ( dir[i] == 0 ) {
+			if ( origin[i] < mins[i] || origin[i] > maxs[i] ) {
+				return false;
+			}
+			continue;
+		}
+
+		vec_t t1 = ( mins[i] - origin[i] ) / dir[i];
+		vec_t t2 = ( maxs[i] - origin[i] ) / dir[i];
+		if ( t1 > t2 ) {
+			vec_t t = t1; t1 = t2; t2 = t;
+		}
+		enter = MAX( enter, t1 );
+		leave = MIN( leave, t2 );
+		if ( enter > leave ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static void BrushIndex_MarkRay_r( int n, const vec3_t origin, const vec3_t dir ){
+	brushIndexNode_t *node = &g_IndexNodes[n];
+	vec3_t looseMins, looseMaxs;
+	size_t i;
+
+	if ( !node->count ) {
+		return;
+	}
+
+	if ( n ) {
+		for ( i = 0; i < 3; i++ )
+		{
+			looseMins[i] = node->center[i] - node->half * 2;
+			looseMaxs[i] = node->center[i] + node->half * 2;
+		}
+		if ( !BrushIndex_LineTouches( looseMins, looseMaxs, origin, dir ) ) {
+			return;
+		}
+	}
+
+	for ( i = 0; i < node->entries.size(); i++ )
+	{
+		brushIndexEntry_t *entry = node->entries[i];
+		if ( BrushIndex_LineTouches( entry->mins, entry->maxs, origin, dir ) ) {
+			entry->stamp = g_nIndexStamp;
+		}
+	}
+
+	for ( i = 0; i < 8; i++ )
+	{
+		if ( node->children[i] >= 0 ) {
+			BrushIndex_MarkRay_r( node->children[i], origin, dir );
+		}
+	}
+}
+
+/*
+   ================
+   BrushIndex_MarkRay
+
+   marks every indexed brush whose bounds the line through origin along dir touches
+   ================
+ */
+void BrushIndex_MarkRay( const vec3_t origin, const vec3_t dir ){
+	g_nIndexStamp++;
+	if ( !g_IndexNodes.empty() ) {
+		BrushIndex_MarkRay_r( 0, origin, dir );
+	}
+}
+
+/*
+   ================
+   BrushIndex_Benchmark
+
+   times a sweep of camera style box queries and selection rays over the
+   active brushes, first testing every brush and then through the index
+   ================
+ */
+#define BRUSHINDEX_BENCH_STEPS  64
+
+void BrushIndex_Benchmark(){
+	CPtrArray candidates;
+	brush_t *b;
+	vec3_t worldMins, worldMaxs, mins, maxs, origin, dir;
+	double start, linearBox, indexedBox, linearRay, indexedRay;
+	int i, j, brushes, linearHits, indexedHits;
+
+	brushes = 0;
+	ClearBounds( worldMins, worldMaxs );
+	for ( b = active_brushes.next; b != &active_brushes; b = b->next )
+	{
+		AddPointToBounds( b->mins, worldMins, worldMaxs );
+		AddPointToBounds( b->maxs, worldMins, worldMaxs );
+		brushes++;
+	}
+	if ( !brushes ) {
+		Sys_Printf( "Brush index benchmark: no brushes loaded\n" );
+		return;
+	}
+
+	// boxes an eighth of the map wide, swept corner to corner
+	linearHits = indexedHits = 0;
+	start = Sys_DoubleTime();
+	for ( i = 0; i < BRUSHINDEX_BENCH_STEPS; i++ )
+	{
+		for ( j = 0; j < 3; j++ )
+		{
+			vec_t size = ( worldMaxs[j] - worldMins[j] ) / 8;
+			mins[j] = worldMins[j] + ( worldMaxs[j] - worldMins[j] - size ) * i / ( BRUSHINDEX_BENCH_STEPS - 1 );
+			maxs[j] = mins[j] + size;
+		}
+		for ( b = active_brushes.next; b != &active_brushes; b = b->next )
+			if ( BrushIndex_BoxesTouch( b->mins, b->maxs, mins, maxs ) ) {
+				linearHits++;
+			}
+	}
+	linearBox = Sys_DoubleTime() - start;
+
+	start = Sys_DoubleTime();
+	for ( i = 0; i < BRUSHINDEX_BENCH_STEPS; i++ )
+	{
+		for ( j = 0; j < 3; j++ )
+		{
+			vec_t size = ( worldMaxs[j] - worldMins[j] ) / 8;
+			mins[j] = worldMins[j] + ( worldMaxs[j] - worldMins[j] - size ) * i / ( BRUSHINDEX_BENCH_STEPS - 1 );
+			maxs[j] = mins[j] + size;
+		}
+		BrushIndex_QueryBox( mins, maxs, candidates );
+		for ( j = 0; j < candidates.GetSize(); j++ )
+		{
+			b = (brush_t*)candidates.GetAt( j );
+			if ( b->list == &active_brushes && BrushIndex_BoxesTouch( b->mins, b->maxs, mins, maxs ) ) {
+				indexedHits++;
+			}
+		}
+	}
+	indexedBox = Sys_DoubleTime() - start;
+
+	if ( linearHits != indexedHits ) {
+		Sys_FPrintf( SYS_WRN, "WARNING: brush index box query mismatch (%d vs %d)\n", linearHits, indexedHits );
+	}
+
+	// rays from above down through a grid over the map, like clicking in the top view
+	linearHits = indexedHits = 0;
+	VectorSet( dir, 0, 0, -1 );
+	start = Sys_DoubleTime();
+	for ( i = 0; i < BRUSHINDEX_BENCH_STEPS; i++ )
+	{
+		origin[0] = worldMins[0] + ( worldMaxs[0] - worldMins[0] ) * i / ( BRUSHINDEX_BENCH_STEPS - 1 );
+		origin[1] = worldMins[1] + ( worldMaxs[1] - worldMins[1] ) * ( ( i * 7 ) % BRUSHINDEX_BENCH_STEPS ) / ( BRUSHINDEX_BENCH_STEPS - 1 );
+		origin[2] = worldMaxs[2] + 64;
+		for ( b = active_brushes.next; b != &active_brushes; b = b->next )
+		{
+			vec_t dist;
+			if ( Brush_Ray( origin, dir, b, &dist, 0 ) ) {
+				linearHits++;
+			}
+		}
+	}
+	linearRay = Sys_DoubleTime() - start;
+
+	start = Sys_DoubleTime();
+	for ( i = 0; i < BRUSHINDEX_BENCH_STEPS; i++ )
+	{
+		origin[0] = worldMins[0] + ( worldMaxs[0] - worldMins[0] ) * i / ( BRUSHINDEX_BENCH_STEPS - 1 );
+		origin[1] = worldMins[1] + ( worldMaxs[1] - worldMins[1] ) * ( ( i * 7 ) % BRUSHINDEX_BENCH_STEPS ) / ( BRUSHINDEX_BENCH_STEPS - 1 );
+		origin[2] = worldMaxs[2] + 64;
+		BrushIndex_MarkRay( origin, dir );
+		for ( b = active_brushes.next; b != &active_brushes; b = b->next )
+		{
+			vec_t dist;
+			if ( BrushIndex_IsMarked( b ) && Brush_Ray( origin, dir, b, &dist, 0 ) ) {
+				indexedHits++;
+			}
+		}
+	}
+	indexedRay = Sys_DoubleTime() - start;
+
+	if ( linearHits != indexedHits ) {
+		Sys_FPrintf( SYS_WRN, "WARNING: brush index ray query mismatch (%d vs %d)\n", linearHits, indexedHits );
+	}
+
+	Sys_Printf( "Brush index benchmark: %d brushes, %d index nodes, %d queries each\n", brushes, (int)g_IndexNodes.size(), BRUSHINDEX_BENCH_STEPS );
+	Sys_Printf( "  box queries: %.3f ms linear, %.3f ms indexed\n", linearBox * 1000, indexedBox * 1000 );
+	Sys_Printf( "  ray picks:   %.3f ms linear, %.3f ms indexed\n", linearRay * 1000, indexedRay * 1000 );
+}
@@ -0,0 +1,855 @@
+/*
+   Copyright (C) 1999-2007 id Software, Inc. and contributors.
+   For a list of contributors, see the accompanying CONTRIBUTORS file.
+
+   This file is part of GtkRadiant.
+
+   GtkRadiant is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   GtkRadiant is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with GtkRadiant; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/*
+   retained mode renderer for world brushes in the camera and 2D views
+
+   every brush keeps its triangulated face windings in a cache that is only
+   thrown away when Brush_BuildWindings runs on it. the camera keeps a store of
+   vertex arrays, one per texture (kept in a VBO when the driver has
+   GL_ARB_vertex_buffer_object), and the first time a brush is queued its faces
+   are appended to the arrays of their textures. the arrays don't depend on what
+   the camera sees: each pass only collects the ranges of the queued brushes and
+   draws them, and only the ranges appended since the last frame are uploaded.
+   a rebuilt brush leaves its old ranges behind as dead vertices, an array is
+   emptied and filled again from the queued brushes once most of it is dead
+
+   faces are emitted as triangles, so this is only used for filled passes;
+   wireframe passes and everything that isn't a plain brush (entities, models,
+   lights, patches) still go through CamWnd::Cam_DrawBrush
+
+   the 2D views work the same way with lines: each cache also keeps the outline
+   segments of the faces that show in each view axis, and every view type keeps
+   one colored line array a brush is appended to the first time it's queued
+   there. a pass only draws the ranges of the queued brushes, so panning and
+   zooming upload nothing, a rebuilt or recolored brush leaves its old range dead
+ */
+
+#include "stdafx.h"
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#define Q2_SURF_TRANS33   0x00000010
+#define Q2_SURF_TRANS66   0x00000020
+
+// face is hidden by one of the exclude filters
+#define FACE_EXCLUDE_CAULK      0x0001
+#define FACE_EXCLUDE_BOTCLIP    0x0002
+#define FACE_EXCLUDE_CLIP       0x0004
+
+// xyz st rgba normal
+#define RENDER_VERTEX_FLOATS    12
+
+// don't bother emptying arrays with fewer dead vertices than this
+#define RENDER_COMPACT_VERTS    4096
+
+typedef struct brushRenderFace_s
+{
+	face_t *face;
+	int firstVert;
+	int numVerts;
+	int exclude;
+	bool bTrans;
+	float transVal;
+
+	// where the face sits in the camera store
+	int bucket;
+	int bucketVert;
+	unsigned int bucketGeneration;
+} brushRenderFace_t;
+
+// triangulated windings of one brush, xyz st per vertex
+typedef struct brushRenderCache_s
+{
+	int numFaces;
+	brushRenderFace_t *faces;
+	int numVerts;
+	float *verts;
+
+	// camera store the faces were added to, 0 if they are not in the current one
+	unsigned int storeGeneration;
+
+	// outline segments for each VIEWTYPE, built on first use
+	float *lines[3];
+	int numLineVerts[3];
+
+	// where the outlines sit in the line store of each VIEWTYPE
+	int lineFirst[3];
+	unsigned int lineGeneration[3];
+	byte lineRGBA[3][4];
+} brushRenderCache_t;
+
+// the faces of one texture, in the vertex layout the camera draws
+typedef struct renderBucket_s
+{
+	qtexture_t *texture;    // NULL draws untextured
+	bool bTrans;
+	unsigned int generation;    // changes when the array is emptied
+	std::vector<float> verts;
+	int numDead;            // vertices of faces that were rebuilt or recolored since
+	GLuint vbo;
+	size_t vboFloats;
+	size_t dirtyFirst, dirtyEnd;    // floats that aren't in the vbo yet
+} renderBucket_t;
+
+typedef struct renderStore_s
+{
+	bool bValid;
+	unsigned int generation;
+	int glState;            // without DRAW_GL_BLEND, both textured passes share the store
+	int drawMode;
+	bool bGLLighting;
+	std::vector<renderBucket_t> buckets;
+	std::map<std::pair<qtexture_t*, bool>, int> bucketIndex;
+} renderStore_t;
+
+typedef struct renderDraw_s
+{
+	int bucket;
+	int firstVert;
+	int numVerts;
+} renderDraw_t;
+
+typedef struct lineVertex_s
+{
+	float xyz[3];
+	byte rgba[4];
+} lineVertex_t;
+
+// the outlines of one VIEWTYPE
+typedef struct lineStore_s
+{
+	unsigned int generation;    // changes when the array is emptied
+	std::vector<lineVertex_t> verts;
+	int numDead;
+	GLuint vbo;
+	size_t vboVerts;
+	size_t dirtyFirst, dirtyEnd;
+} lineStore_t;
+
+static unsigned int g_nRenderSerial;
+
+static renderStore_t g_RenderStore;
+
+// ranges queued since BrushRender_Begin, in queue order
+static std::vector<renderDraw_t> g_RenderDraws;
+static int g_nRenderGLState;
+static int g_nRenderExclude;
+
+static lineStore_t g_LineStores[3];
+
+// ranges queued since BrushRender_BeginLines, in queue order
+static std::vector<renderDraw_t> g_LineDraws;
+
+// marks the outlines of a brush dead in the line stores they were added to
+static void BrushRender_ReleaseLines( brushRenderCache_t *cache ){
+	for ( int i = 0; i < 3; i++ )
+	{
+		if ( cache->lines[i] && cache->lineGeneration[i] == g_LineStores[i].generation ) {
+			g_LineStores[i].numDead += cache->numLineVerts[i];
+		}
+		cache->lineGeneration[i] = 0;
+	}
+}
+
+// marks the faces of a brush dead in the arrays they were added to
+static void BrushRender_ReleaseFaces( brushRenderCache_t *cache ){
+	if ( !g_RenderStore.bValid || cache->storeGeneration != g_RenderStore.generation ) {
+		return;
+	}
+	for ( int i = 0; i < cache->numFaces; i++ )
+	{
+		brushRenderFace_t *rf = &cache->faces[i];
+		if ( rf->bucket >= 0 && g_RenderStore.buckets[rf->bucket].generation == rf->bucketGeneration ) {
+			g_RenderStore.buckets[rf->bucket].numDead += rf->numVerts;
+		}
+	}
+	cache->storeGeneration = 0;
+}
+
+/*
+   ================
+   BrushRender_Invalidate
+
+   drops the cached geometry of a brush, called when its windings are rebuilt
+   ================
+ */
+void BrushRender_Invalidate( brush_t *b ){
+	brushRenderCache_t *cache = (brushRenderCache_t*)b->pRenderCache;
+
+	if ( !cache ) {
+		return;
+	}
+	BrushRender_ReleaseFaces( cache );
+	BrushRender_ReleaseLines( cache );
+	for ( int i = 0; i < 3; i++ )
+		free( cache->lines[i] );
+	free( cache->faces );
+	free( cache->verts );
+	free( cache );
+	b->pRenderCache = NULL;
+}
+
+/*
+   ================
+   BrushRender_InvalidateColors
+
+   the store bakes the face colors in, called when the color of a face changes,
+   the brush is added again the next time it's queued
+   ================
+ */
+void BrushRender_InvalidateColors( brush_t *b ){
+	brushRenderCache_t *cache = (brushRenderCache_t*)b->pRenderCache;
+
+	if ( cache ) {
+		BrushRender_ReleaseFaces( cache );
+	}
+}
+
+/*
+   ================
+   BrushRender_InvalidateAll
+
+   empties the camera store, called when the shaders are reloaded and the faces
+   point to new textures
+   ================
+ */
+void BrushRender_InvalidateAll(){
+	size_t i;
+
+	for ( i = 0; i < g_RenderStore.buckets.size(); i++ )
+	{
+		if ( g_RenderStore.buckets[i].vbo && qglDeleteBuffersARB ) {
+			qglDeleteBuffersARB( 1, &g_RenderStore.buckets[i].vbo );
+		}
+	}
+	g_RenderStore.buckets.clear();
+	g_RenderStore.bucketIndex.clear();
+	g_RenderStore.bValid = false;
+	g_RenderStore.generation = 0;
+}
+
+static brushRenderCache_t *BrushRender_BuildCache( brush_t *b ){
+	brushRenderCache_t *cache;
+	face_t *face;
+	winding_t *w;
+	int numFaces, numVerts;
+
+	numFaces = numVerts = 0;
+	for ( face = b->brush_faces; face; face = face->next )
+	{
+		w = face->face_winding;
+		if ( !w || w->numpoints < 3 ) {
+			continue;
+		}
+		numFaces++;
+		numVerts += ( w->numpoints - 2 ) * 3;
+	}
+
+	cache = (brushRenderCache_t*)qmalloc( sizeof( brushRenderCache_t ) );
+	cache->faces = (brushRenderFace_t*)qmalloc( sizeof( brushRenderFace_t ) * ( numFaces ? numFaces : 1 ) );
+	cache->verts = (float*)qmalloc( sizeof( float ) * 5 * ( numVerts ? numVerts : 1 ) );
+
+	for ( face = b->brush_faces; face; face = face->next )
+	{
+		const char *name;
+		brushRenderFace_t *rf;
+		float *out;
+		int i, j, k;
+
+		w = face->face_winding;
+		if ( !w || w->numpoints < 3 ) {
+			continue;
+		}
+
+		rf = &cache->faces[cache->numFaces++];
+		rf->face = face;
+		rf->firstVert = cache->numVerts;
+		rf->numVerts = ( w->numpoints - 2 ) * 3;
+		rf->bucket = -1;
+
+		// same rules as Brush_Draw
+		rf->bTrans = ( face->pShader->getFlags() & QER_TRANS ) != 0;
+		rf->transVal = face->pShader->getTrans();
+		if ( !rf->bTrans ) {
+			if ( face->texdef.flags & Q2_SURF_TRANS33 ) {
+				rf->bTrans = true;
+				rf->transVal = 0.33f;
+			}
+			else if ( face->texdef.flags & Q2_SURF_TRANS66 ) {
+				rf->bTrans = true;
+				rf->transVal = 0.66f;
+			}
+		}
+
+		name = face->texdef.GetName();
+		rf->exclude = 0;
+		if ( strstr( name, "caulk" ) ) {
+			rf->exclude |= FACE_EXCLUDE_CAULK;
+		}
+		if ( strstr( name, "botclip" ) || strstr( name, "clipmonster" ) ) {
+			rf->exclude |= FACE_EXCLUDE_BOTCLIP;
+		}
+		if ( strstr( name, "clip" ) ) {
+			rf->exclude |= FACE_EXCLUDE_CLIP;
+		}
+
+		// fan out the winding
+		out = cache->verts + cache->numVerts * 5;
+		for ( i = 1; i < w->numpoints - 1; i++ )
+		{
+			const int fan[3] = { 0, i, i + 1 };
+			for ( j = 0; j < 3; j++ )
+			{
+				for ( k = 0; k < 5; k++ )
+					*out++ = (float)w->points[fan[j]][k];
+			}
+		}
+		cache->numVerts += rf->numVerts;
+	}
+
+	b->pRenderCache = cache;
+	return cache;
+}
+
+static void BrushRender_FaceColor( const brushRenderFace_t *rf, int nGLState, float color[4] ){
+	face_t *face = rf->face;
+
+	if ( ( nGLState & DRAW_GL_LIGHTING ) && !g_PrefsDlg.m_bGLLighting ) {
+		if ( nGLState & DRAW_GL_TEXTURE_2D ) {
+			color[0] = color[1] = color[2] = face->d_shade;
+		}
+		else
+		{
+			VectorCopy( face->d_color, color );
+		}
+	}
+	else if ( nGLState & DRAW_GL_TEXTURE_2D ) {
+		color[0] = color[1] = color[2] = 0.8f;
+	}
+	else
+	{
+		VectorCopy( face->pShader->getTexture()->color, color );
+	}
+	color[3] = rf->transVal;
+}
+
+// appends a face to the array of its texture
+static void BrushRender_AddFace( brushRenderCache_t *cache, brushRenderFace_t *rf ){
+	bool bTextured = ( g_RenderStore.glState & DRAW_GL_TEXTURE_2D )
+					 && ( g_RenderStore.drawMode == cd_texture || g_RenderStore.drawMode == cd_light );
+	qtexture_t *texture = NULL;
+	renderBucket_t *bucket;
+	const float *in;
+	float *out;
+	float color[4];
+	size_t first;
+	int i;
+
+	if ( bTextured && rf->face->d_texture->name[0] != '(' ) {
+		texture = rf->face->d_texture;
+	}
+
+	std::map<std::pair<qtexture_t*, bool>, int>::iterator it = g_RenderStore.bucketIndex.find( std::make_pair( texture, rf->bTrans ) );
+	if ( it == g_RenderStore.bucketIndex.end() ) {
+		renderBucket_t empty;
+		empty.texture = texture;
+		empty.bTrans = rf->bTrans;
+		empty.generation = ++g_nRenderSerial;
+		empty.numDead = 0;
+		empty.vbo = 0;
+		empty.vboFloats = 0;
+		empty.dirtyFirst = empty.dirtyEnd = 0;
+		it = g_RenderStore.bucketIndex.insert( std::make_pair( std::make_pair( texture, rf->bTrans ), (int)g_RenderStore.buckets.size() ) ).first;
+		g_RenderStore.buckets.push_back( empty );
+	}
+	bucket = &g_RenderStore.buckets[it->second];
+
+	BrushRender_FaceColor( rf, g_RenderStore.glState, color );
+
+	first = bucket->verts.size();
+	if ( bucket->dirtyEnd == bucket->dirtyFirst ) {
+		bucket->dirtyFirst = first;
+	}
+	bucket->verts.resize( first + (size_t)rf->numVerts * RENDER_VERTEX_FLOATS );
+	bucket->dirtyEnd = bucket->verts.size();
+
+	in = cache->verts + rf->firstVert * 5;
+	out = &bucket->verts[first];
+	for ( i = 0; i < rf->numVerts; i++, in += 5, out += RENDER_VERTEX_FLOATS )
+	{
+		out[0] = in[0];
+		out[1] = in[1];
+		out[2] = in[2];
+		out[3] = in[3];
+		out[4] = in[4];
+		out[5] = color[0];
+		out[6] = color[1];
+		out[7] = color[2];
+		out[8] = color[3];
+		out[9] = (float)rf->face->plane.normal[0];
+		out[10] = (float)rf->face->plane.normal[1];
+		out[11] = (float)rf->face->plane.normal[2];
+	}
+
+	rf->bucket = it->second;
+	rf->bucketVert = (int)( first / RENDER_VERTEX_FLOATS );
+	rf->bucketGeneration = bucket->generation;
+}
+
+/*
+   ================
+   BrushRender_Begin / BrushRender_Queue
+
+   BrushRender_Queue returns false for brushes the batched path doesn't handle,
+   the caller draws those itself
+   ================
+ */
+void BrushRender_Begin( int nGLState, int nDrawMode ){
+	int glState = nGLState & ~DRAW_GL_BLEND;
+	size_t i;
+
+	if ( g_RenderStore.bValid && ( g_RenderStore.glState != glState || g_RenderStore.drawMode != nDrawMode
+								   || g_RenderStore.bGLLighting != g_PrefsDlg.m_bGLLighting ) ) {
+		BrushRender_InvalidateAll();
+	}
+	if ( !g_RenderStore.bValid ) {
+		g_RenderStore.bValid = true;
+		g_RenderStore.generation = ++g_nRenderSerial;
+		g_RenderStore.glState = glState;
+		g_RenderStore.drawMode = nDrawMode;
+		g_RenderStore.bGLLighting = g_PrefsDlg.m_bGLLighting;
+	}
+
+	// empty the arrays that are mostly dead, their live faces are added again when queued
+	for ( i = 0; i < g_RenderStore.buckets.size(); i++ )
+	{
+		renderBucket_t *bucket = &g_RenderStore.buckets[i];
+		int numLive = (int)( bucket->verts.size() / RENDER_VERTEX_FLOATS ) - bucket->numDead;
+
+		if ( bucket->numDead >= RENDER_COMPACT_VERTS && bucket->numDead > numLive ) {
+			bucket->verts.clear();
+			bucket->numDead = 0;
+			bucket->generation = ++g_nRenderSerial;
+			bucket->dirtyFirst = bucket->dirtyEnd = 0;
+		}
+	}
+
+	g_nRenderGLState = nGLState;
+	g_nRenderExclude = 0;
+	if ( g_qeglobals.d_savedinfo.exclude & EXCLUDE_CAULK ) {
+		g_nRenderExclude |= FACE_EXCLUDE_CAULK;
+	}
+	if ( g_qeglobals.d_savedinfo.exclude & EXCLUDE_BOTCLIP ) {
+		g_nRenderExclude |= FACE_EXCLUDE_BOTCLIP;
+	}
+	if ( g_qeglobals.d_savedinfo.exclude & EXCLUDE_CLIP ) {
+		g_nRenderExclude |= FACE_EXCLUDE_CLIP;
+	}
+	g_RenderDraws.clear();
+}
+
+bool BrushRender_Queue( brush_t *b ){
+	brushRenderCache_t *cache;
+	bool bBlend = ( g_nRenderGLState & DRAW_GL_BLEND ) != 0;
+	int i;
+
+	if ( b->owner->eclass->fixedsize || b->patchBrush ) {
+		return false;
+	}
+
+	cache = (brushRenderCache_t*)b->pRenderCache;
+	if ( !cache ) {
+		cache = BrushRender_BuildCache( b );
+	}
+	if ( cache->storeGeneration != g_RenderStore.generation ) {
+		for ( i = 0; i < cache->numFaces; i++ )
+			cache->faces[i].bucket = -1;
+		cache->storeGeneration = g_RenderStore.generation;
+	}
+
+	for ( i = 0; i < cache->numFaces; i++ )
+	{
+		brushRenderFace_t *rf = &cache->faces[i];
+
+		if ( rf->bucket < 0 || g_RenderStore.buckets[rf->bucket].generation != rf->bucketGeneration ) {
+			BrushRender_AddFace( cache, rf );
+		}
+		if ( rf->bTrans != bBlend || ( rf->exclude & g_nRenderExclude ) ) {
+			continue;
+		}
+
+		if ( !g_RenderDraws.empty() ) {
+			renderDraw_t *last = &g_RenderDraws.back();
+			if ( last->bucket == rf->bucket && last->firstVert + last->numVerts == rf->bucketVert ) {
+				last->numVerts += rf->numVerts;
+				continue;
+			}
+		}
+		renderDraw_t draw;
+		draw.bucket = rf->bucket;
+		draw.firstVert = rf->bucketVert;
+		draw.numVerts = rf->numVerts;
+		g_RenderDraws.push_back( draw );
+	}
+	return true;
+}
+
+static bool BrushRender_DrawBefore( const renderDraw_t &a, const renderDraw_t &b ){
+	return a.bucket < b.bucket;
+}
+
+// sends the vertices appended since the last upload
+static void BrushRender_UploadBucket( renderBucket_t *bucket ){
+	size_t size = bucket->verts.size();
+
+	if ( !bucket->vbo ) {
+		qglGenBuffersARB( 1, &bucket->vbo );
+	}
+	qglBindBufferARB( GL_ARRAY_BUFFER_ARB, bucket->vbo );
+	if ( size > bucket->vboFloats ) {
+		// grow along with the array so appending doesn't reallocate every frame
+		bucket->vboFloats = bucket->verts.capacity();
+		qglBufferDataARB( GL_ARRAY_BUFFER_ARB, bucket->vboFloats * sizeof( float ), NULL, GL_DYNAMIC_DRAW_ARB );
+		qglBufferSubDataARB( GL_ARRAY_BUFFER_ARB, 0, size * sizeof( float ), &bucket->verts[0] );
+	}
+	else if ( bucket->dirtyEnd > bucket->dirtyFirst ) {
+		qglBufferSubDataARB( GL_ARRAY_BUFFER_ARB, bucket->dirtyFirst * sizeof( float ),
+							 ( bucket->dirtyEnd - bucket->dirtyFirst ) * sizeof( float ), &bucket->verts[bucket->dirtyFirst] );
+	}
+	bucket->dirtyFirst = bucket->dirtyEnd = 0;
+}
+
+/*
+   ================
+   BrushRender_Flush
+
+   draws the brushes queued since BrushRender_Begin or the last flush, the
+   caller flushes before drawing a brush itself so the list order is kept
+   ================
+ */
+void BrushRender_Flush(){
+	bool bTextured, bLighting, bVBO;
+	int current;
+	size_t i;
+
+	if ( g_RenderDraws.empty() ) {
+		return;
+	}
+
+	// blended faces keep the queue order, opaque ones only need the texture changes kept down
+	if ( !( g_nRenderGLState & DRAW_GL_BLEND ) ) {
+		std::stable_sort( g_RenderDraws.begin(), g_RenderDraws.end(), BrushRender_DrawBefore );
+	}
+
+	bTextured = ( g_nRenderGLState & DRAW_GL_TEXTURE_2D ) != 0;
+	bLighting = ( g_nRenderGLState & DRAW_GL_LIGHTING ) && g_PrefsDlg.m_bGLLighting;
+	bVBO = qglGenBuffersARB && qglBufferSubDataARB;
+
+	qglEnable( GL_CULL_FACE );
+	qglShadeModel( GL_FLAT );
+
+	qglPushClientAttrib( GL_CLIENT_VERTEX_ARRAY_BIT );
+	qglEnableClientState( GL_VERTEX_ARRAY );
+	qglEnableClientState( GL_COLOR_ARRAY );
+	if ( bTextured ) {
+		qglEnableClientState( GL_TEXTURE_COORD_ARRAY );
+	}
+	else{
+		qglDisableClientState( GL_TEXTURE_COORD_ARRAY );
+	}
+	if ( bLighting ) {
+		qglEnableClientState( GL_NORMAL_ARRAY );
+	}
+	else{
+		qglDisableClientState( GL_NORMAL_ARRAY );
+	}
+
+	current = -1;
+	for ( i = 0; i < g_RenderDraws.size(); i++ )
+	{
+		const renderDraw_t *draw = &g_RenderDraws[i];
+		GLsizei numVerts = draw->numVerts;
+
+		// ranges of neighbouring brushes often follow each other in the array
+		while ( i + 1 < g_RenderDraws.size() && g_RenderDraws[i + 1].bucket == draw->bucket
+				&& g_RenderDraws[i + 1].firstVert == draw->firstVert + numVerts )
+		{
+			numVerts += g_RenderDraws[++i].numVerts;
+		}
+
+		if ( draw->bucket != current ) {
+			renderBucket_t *bucket = &g_RenderStore.buckets[draw->bucket];
+			const float *base;
+
+			current = draw->bucket;
+			if ( bVBO ) {
+				BrushRender_UploadBucket( bucket );
+				base = NULL;
+			}
+			else{
+				base = &bucket->verts[0];
+			}
+
+			qglVertexPointer( 3, GL_FLOAT, RENDER_VERTEX_FLOATS * sizeof( float ), base );
+			qglColorPointer( 4, GL_FLOAT, RENDER_VERTEX_FLOATS * sizeof( float ), base + 5 );
+			if ( bTextured ) {
+				qglTexCoordPointer( 2, GL_FLOAT, RENDER_VERTEX_FLOATS * sizeof( float ), base + 3 );
+				if ( bucket->texture ) {
+					qglEnable( GL_TEXTURE_2D );
+					qglBindTexture( GL_TEXTURE_2D, bucket->texture->texture_number );
+				}
+				else{
+					qglDisable( GL_TEXTURE_2D );
+				}
+			}
+			if ( bLighting ) {
+				qglNormalPointer( GL_FLOAT, RENDER_VERTEX_FLOATS * sizeof( float ), base + 9 );
+			}
+		}
+		qglDrawArrays( GL_TRIANGLES, draw->firstVert, numVerts );
+	}
+
+	if ( bTextured ) {
+		qglEnable( GL_TEXTURE_2D );
+	}
+	if ( bVBO ) {
+		qglBindBufferARB( GL_ARRAY_BUFFER_ARB, 0 );
+	}
+	qglPopClientAttrib();
+
+	// the color array leaves the current color undefined
+	qglColor4f( 1, 1, 1, 1 );
+
+	g_RenderDraws.clear();
+}
+
+/*
+   ================
+   BrushRender_BuildLines
+
+   outlines of the faces that point towards the viewer of a 2D view,
+   the same faces Brush_DrawXY draws
+   ================
+ */
+static void BrushRender_BuildLines( brushRenderCache_t *cache, int nViewType ){
+	float *out;
+	int i, j, numLineVerts;
+
+	numLineVerts = 0;
+	for ( i = 0; i < cache->numFaces; i++ )
+		numLineVerts += cache->faces[i].face->face_winding->numpoints * 2;
+
+	cache->lines[nViewType] = out = (float*)qmalloc( sizeof( float ) * 3 * ( numLineVerts ? numLineVerts : 1 ) );
+	cache->numLineVerts[nViewType] = 0;
+
+	for ( i = 0; i < cache->numFaces; i++ )
+	{
+		face_t *face = cache->faces[i].face;
+		winding_t *w = face->face_winding;
+
+		if ( nViewType == XY ) {
+			if ( face->plane.normal[2] <= 0 ) {
+				continue;
+			}
+		}
+		else if ( nViewType == XZ ) {
+			if ( face->plane.normal[1] >= 0 ) { // stop axes being mirrored
+				continue;
+			}
+		}
+		else if ( face->plane.normal[0] <= 0 ) {
+			continue;
+		}
+
+		for ( j = 0; j < w->numpoints; j++ )
+		{
+			const vec_t *p1 = w->points[j];
+			const vec_t *p2 = w->points[( j + 1 ) % w->numpoints];
+			*out++ = (float)p1[0];
+			*out++ = (float)p1[1];
+			*out++ = (float)p1[2];
+			*out++ = (float)p2[0];
+			*out++ = (float)p2[1];
+			*out++ = (float)p2[2];
+		}
+		cache->numLineVerts[nViewType] += w->numpoints * 2;
+	}
+}
+
+// appends the outlines of a brush to the line store of a view type
+static void BrushRender_AddLines( brushRenderCache_t *cache, int nViewType, const byte rgba[4] ){
+	lineStore_t *store = &g_LineStores[nViewType];
+	const float *in = cache->lines[nViewType];
+	size_t first = store->verts.size();
+	lineVertex_t *out;
+
+	if ( store->dirtyEnd == store->dirtyFirst ) {
+		store->dirtyFirst = first;
+	}
+	store->verts.resize( first + cache->numLineVerts[nViewType] );
+	store->dirtyEnd = store->verts.size();
+
+	out = cache->numLineVerts[nViewType] ? &store->verts[first] : NULL;
+	for ( int i = 0; i < cache->numLineVerts[nViewType]; i++, in += 3, out++ )
+	{
+		VectorCopy( in, out->xyz );
+		memcpy( out->rgba, rgba, sizeof( out->rgba ) );
+	}
+
+	cache->lineFirst[nViewType] = (int)first;
+	cache->lineGeneration[nViewType] = store->generation;
+	memcpy( cache->lineRGBA[nViewType], rgba, sizeof( cache->lineRGBA[nViewType] ) );
+}
+
+/*
+   ================
+   BrushRender_BeginLines / BrushRender_QueueLines
+
+   BrushRender_QueueLines returns false for brushes Brush_DrawXY has to draw,
+   entities, patches and the key brush of brush entities (it carries the name)
+   ================
+ */
+void BrushRender_BeginLines( int nViewType ){
+	lineStore_t *store = &g_LineStores[nViewType];
+	int numLive = (int)store->verts.size() - store->numDead;
+
+	// empty the array once it's mostly dead, the queued brushes are added again
+	if ( !store->generation || ( store->numDead >= RENDER_COMPACT_VERTS && store->numDead > numLive ) ) {
+		store->verts.clear();
+		store->numDead = 0;
+		store->generation = ++g_nRenderSerial;
+		store->dirtyFirst = store->dirtyEnd = 0;
+	}
+	g_LineDraws.clear();
+}
+
+bool BrushRender_QueueLines( brush_t *b, int nViewType, const float color[3] ){
+	lineStore_t *store = &g_LineStores[nViewType];
+	brushRenderCache_t *cache;
+	byte rgba[4];
+
+	if ( b->owner->eclass->fixedsize || b->patchBrush ) {
+		return false;
+	}
+	if ( b->owner != world_entity && b == b->owner->brushes.onext ) {
+		return false;
+	}
+
+	cache = (brushRenderCache_t*)b->pRenderCache;
+	if ( !cache ) {
+		cache = BrushRender_BuildCache( b );
+	}
+	if ( !cache->lines[nViewType] ) {
+		BrushRender_BuildLines( cache, nViewType );
+	}
+
+	for ( int i = 0; i < 3; i++ )
+		rgba[i] = (byte)( MAX( 0.0f, MIN( 1.0f, color[i] ) ) * 255.0f + 0.5f );
+	rgba[3] = 255;
+
+	if ( cache->lineGeneration[nViewType] != store->generation ) {
+		BrushRender_AddLines( cache, nViewType, rgba );
+	}
+	else if ( memcmp( cache->lineRGBA[nViewType], rgba, sizeof( rgba ) ) ) {
+		// the color is baked in, the old range is left dead
+		store->numDead += cache->numLineVerts[nViewType];
+		BrushRender_AddLines( cache, nViewType, rgba );
+	}
+
+	if ( !cache->numLineVerts[nViewType] ) {
+		return true;
+	}
+	if ( !g_LineDraws.empty() ) {
+		renderDraw_t *last = &g_LineDraws.back();
+		if ( last->firstVert + last->numVerts == cache->lineFirst[nViewType] ) {
+			last->numVerts += cache->numLineVerts[nViewType];
+			return true;
+		}
+	}
+	renderDraw_t draw;
+	draw.bucket = nViewType;
+	draw.firstVert = cache->lineFirst[nViewType];
+	draw.numVerts = cache->numLineVerts[nViewType];
+	g_LineDraws.push_back( draw );
+	return true;
+}
+
+/*
+   ================
+   BrushRender_FlushLines
+
+   draws the brushes queued since BrushRender_BeginLines, only the outlines
+   appended since the last pass are uploaded
+   ================
+ */
+void BrushRender_FlushLines( int nViewType ){
+	lineStore_t *store = &g_LineStores[nViewType];
+	bool bVBO = qglGenBuffersARB && qglBufferSubDataARB;
+	const byte *base;
+	size_t i;
+
+	if ( g_LineDraws.empty() ) {
+		return;
+	}
+
+	qglPushClientAttrib( GL_CLIENT_VERTEX_ARRAY_BIT );
+	if ( bVBO ) {
+		size_t size = store->verts.size();
+
+		if ( !store->vbo ) {
+			qglGenBuffersARB( 1, &store->vbo );
+		}
+		qglBindBufferARB( GL_ARRAY_BUFFER_ARB, store->vbo );
+		if ( size > store->vboVerts ) {
+			store->vboVerts = store->verts.capacity();
+			qglBufferDataARB( GL_ARRAY_BUFFER_ARB, store->vboVerts * sizeof( lineVertex_t ), NULL, GL_DYNAMIC_DRAW_ARB );
+			qglBufferSubDataARB( GL_ARRAY_BUFFER_ARB, 0, size * sizeof( lineVertex_t ), &store->verts[0] );
+		}
+		else if ( store->dirtyEnd > store->dirtyFirst ) {
+			qglBufferSubDataARB( GL_ARRAY_BUFFER_ARB, store->dirtyFirst * sizeof( lineVertex_t ),
+								 ( store->dirtyEnd - store->dirtyFirst ) * sizeof( lineVertex_t ), &store->verts[store->dirtyFirst] );
+		}
+		store->dirtyFirst = store->dirtyEnd = 0;
+		base = NULL;
+	}
+	else{
+		base = (const byte*)&store->verts[0];
+	}
+
+	qglEnableClientState( GL_VERTEX_ARRAY );
+	qglVertexPointer( 3, GL_FLOAT, sizeof( lineVertex_t ), base );
+	qglEnableClientState( GL_COLOR_ARRAY );
+	qglColorPointer( 4, GL_UNSIGNED_BYTE, sizeof( lineVertex_t ), base + offsetof( lineVertex_t, rgba ) );
+	qglDisableClientState( GL_TEXTURE_COORD_ARRAY );
+	qglDisableClientState( GL_NORMAL_ARRAY );
+
+	for ( i = 0; i < g_LineDraws.size(); i++ )
+		qglDrawArrays( GL_LINES, g_LineDraws[i].firstVert, g_LineDraws[i].numVerts );
+
+	if ( bVBO ) {
+		qglBindBufferARB( GL_ARRAY_BUFFER_ARB, 0 );
+	}
+	qglPopClientAttrib();
+
+	g_LineDraws.clear();
+}
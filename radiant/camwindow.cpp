@@ -1030,9 +1030,56 @@ extern void Brush_DrawModel( brush_t *b, bool bTextured = false );
 extern void DrawModelOrigin( brush_t *b );
 extern void DrawModelBBox( brush_t *b );
 
+/*!
+   picks the model detail from its size on screen, selected models always get the full mesh
+   \return DRAW_RF_LOD_* render flags, -1 if the model is small enough to be drawn as a box
+ */
+int CamWnd::Cam_ModelLOD( brush_t *b ){
+	const aabb_t *aabb;
+	vec3_t dir;
+	vec_t radius, dist, size;
+	int lod;
+
+	if ( !g_PrefsDlg.m_bModelLOD || IsBrushSelected( b ) ) {
+		lod = DRAW_RF_NONE;
+	}
+	else
+	{
+		aabb = b->owner->model.pRender->GetAABB();
+		radius = VectorLength( aabb->extents );
+		VectorSubtract( aabb->origin, m_Camera.origin, dir );
+		dist = VectorLength( dir );
+
+		// width of the bounding sphere in pixels
+		size = ( dist > radius ) ? radius * m_Camera.width / ( tan( xfovRad / 2 ) * dist ) : m_Camera.width;
+
+		if ( size < g_PrefsDlg.m_nModelImpostorSize ) {
+			lod = -1;
+		}
+		else if ( size < g_PrefsDlg.m_nModelLODSize / 2 ) {
+			lod = 2 << DRAW_RF_LOD_SHIFT;
+		}
+		else if ( size < g_PrefsDlg.m_nModelLODSize ) {
+			lod = 1 << DRAW_RF_LOD_SHIFT;
+		}
+		else{
+			lod = DRAW_RF_NONE;
+		}
+	}
+
+	// textured models go through the opaque and the blended pass, only the first one counts
+	if ( Profiler_Active() && !( m_Camera.draw_glstate & DRAW_GL_BLEND ) ) {
+		int full = b->owner->model.pRender->GetTriangleCount( DRAW_RF_NONE );
+		Profiler_CountModel( lod < 0 ? -1 : lod >> DRAW_RF_LOD_SHIFT, full, lod < 0 ? 0 : b->owner->model.pRender->GetTriangleCount( lod ) );
+	}
+
+	return lod;
+}
+
 void CamWnd::Cam_DrawBrush( brush_t *b, int mode ){
 	int nGLState = m_Camera.draw_glstate;
 	int nModelMode = g_PrefsDlg.m_nEntityShowState;
+	int nLOD;
 
 	GLfloat material[4], identity[4];
 	VectorSet( identity, 0.8f, 0.8f, 0.8f );
@@ -1060,6 +1107,7 @@ void CamWnd::Cam_DrawBrush( brush_t *b, int mode ){
 	// models
 	else if ( b->owner->eclass->fixedsize && b->owner->model.pRender
 			  && !( !IsBrushSelected( b ) && ( nModelMode & ENTITY_SELECTED_ONLY ) ) ) {
+		Profiler_Push( PROF_MODELS );
 		switch ( mode )
 		{
 		case DRAW_TEXTURED:
@@ -1084,7 +1132,22 @@ void CamWnd::Cam_DrawBrush( brush_t *b, int mode ){
 				// If the model is NULL or invalid, draw a box instead
 				bool isModelValid = b->owner->model.pRender->IsModelNotNull();
 				if ( isModelValid ) {
-					b->owner->model.pRender->Draw( nGLState, DRAW_RF_CAM );
+					nLOD = Cam_ModelLOD( b );
+					if ( nLOD < 0 ) {
+						// too small to make out, a solid box in the entity color stands in for it
+						qglDisable( GL_CULL_FACE );
+						if ( nGLState & DRAW_GL_TEXTURE_2D ) {
+							qglDisable( GL_TEXTURE_2D );
+						}
+						qglColor4fv( material );
+						aabb_draw( b->owner->model.pRender->GetAABB(), DRAW_GL_FLAT );
+						if ( nGLState & DRAW_GL_TEXTURE_2D ) {
+							qglEnable( GL_TEXTURE_2D );
+						}
+					}
+					else{
+						b->owner->model.pRender->Draw( nGLState, DRAW_RF_CAM | nLOD );
+					}
 				}
 				else {
 					qglColor4fv( material );
@@ -1099,7 +1162,13 @@ void CamWnd::Cam_DrawBrush( brush_t *b, int mode ){
 
 			// model view mode "wireframe" or "selected wire"
 			if ( nModelMode & ENTITY_WIREFRAME ) {
-				b->owner->model.pRender->Draw( nGLState, DRAW_RF_CAM );
+				nLOD = Cam_ModelLOD( b );
+				if ( nLOD < 0 ) {
+					aabb_draw( b->owner->model.pRender->GetAABB(), DRAW_GL_WIRE );
+				}
+				else{
+					b->owner->model.pRender->Draw( nGLState, DRAW_RF_CAM | nLOD );
+				}
 			}
 
 			// model view mode "skinned and boxed"
@@ -1115,6 +1184,7 @@ void CamWnd::Cam_DrawBrush( brush_t *b, int mode ){
               DrawModelOrigin(b);
  */
 		}
+		Profiler_Pop();
 	}
 
 	// patches
@@ -1198,14 +1268,45 @@ void CamWnd::Cam_DrawBrushes( int mode ){
 	brush_t *b;
 	brush_t *pList = ( g_bClipMode && g_pSplitList ) ? g_pSplitList : &selected_brushes;
 
-	for ( b = active_brushes.next; b != &active_brushes; b = b->next )
-		if ( !b->bFiltered && !b->bCamCulled ) {
+	// filled textured passes batch the world brushes, see brushrender.cpp
+	// the windings would show their triangulation in wireframe, so that stays immediate
+	bool bBatch = mode == DRAW_TEXTURED && g_PrefsDlg.m_bBatchedCamRender
+				  && ( m_Camera.draw_glstate & DRAW_GL_FILL );
+
+	Profiler_Push( PROF_BRUSHES );
+	if ( bBatch ) {
+		BrushRender_Begin( m_Camera.draw_glstate, m_Camera.draw_mode );
+	}
+
+	// the queued brushes are flushed before each brush drawn here, so they keep their order
+	for ( int i = 0; i < m_VisibleBrushes.GetSize(); i++ )
+	{
+		b = (brush_t*)m_VisibleBrushes.GetAt( i );
+		if ( !b->bFiltered ) {
+			if ( bBatch ) {
+				if ( BrushRender_Queue( b ) ) {
+					continue;
+				}
+				BrushRender_Flush();
+			}
 			Cam_DrawBrush( b, mode );
 		}
+	}
 	for ( b = pList->next; b != pList; b = b->next )
 		if ( !b->bFiltered && !b->bCamCulled ) {
+			if ( bBatch ) {
+				if ( BrushRender_Queue( b ) ) {
+					continue;
+				}
+				BrushRender_Flush();
+			}
 			Cam_DrawBrush( b, mode );
 		}
+
+	if ( bBatch ) {
+		BrushRender_Flush();
+	}
+	Profiler_Pop();
 }
 
 void CamWnd::Cam_DrawStuff(){
@@ -1223,11 +1324,27 @@ void CamWnd::Cam_DrawStuff(){
         distance = (double) g_PrefsDlg.m_nRenderDistance;
     }
 
-	for ( b = active_brushes.next; b != &active_brushes; b = b->next )
-        b->bCamCulled = CullBrush( b, distance );
+    // only brushes the index finds within the cull distance need the full test,
+    // the visible active brushes are kept for Cam_DrawBrushes
+    Profiler_Push( PROF_CULL );
+    vec3_t cullMins, cullMaxs;
+    for ( int i = 0; i < 3; i++ ) {
+        cullMins[i] = m_Camera.origin[i] - distance;
+        cullMaxs[i] = m_Camera.origin[i] + distance;
+    }
+    BrushIndex_QueryBox( cullMins, cullMaxs, m_CullCandidates );
+
+    m_VisibleBrushes.RemoveAll();
+    for ( int i = 0; i < m_CullCandidates.GetSize(); i++ ) {
+        b = (brush_t*)m_CullCandidates.GetAt( i );
+        if ( b->list == &active_brushes && !CullBrush( b, distance ) ) {
+            m_VisibleBrushes.Add( b );
+        }
+    }
 
 	for ( b = selected_brushes.next; b != &selected_brushes; b = b->next )
-        b->bCamCulled = CullBrush( b, distance );
+        b->bCamCulled = !BrushIndex_IsMarked( b ) || CullBrush( b, distance );
+    Profiler_Pop();
 
 	switch ( m_Camera.draw_mode )
 	{
@@ -1450,6 +1567,10 @@ void CamWnd::Cam_Draw(){
 		return; // not valid yet
 
 	}
+	Profiler_BeginFrame( PROF_VIEW_CAMERA );
+	if ( g_bPatchLODPending ) {
+		Patch_LODMatchAll();
+	}
 	if ( m_Camera.timing ) {
 		start = Sys_DoubleTime();
 	}
@@ -1556,7 +1677,9 @@ void CamWnd::Cam_Draw(){
 		qglEnable( GL_LIGHT0 );
 	}
 
+	Profiler_Push( PROF_CULL );
 	InitCull();
+	Profiler_Pop();
 
 	//
 	// draw stuff
@@ -1575,6 +1698,7 @@ void CamWnd::Cam_Draw(){
 
 	brush_t* pList = ( g_bClipMode && g_pSplitList ) ? g_pSplitList : &selected_brushes;
 
+	Profiler_Push( PROF_BRUSHES );
 	if ( g_qeglobals.d_savedinfo.iSelectedOutlinesStyle & OUTLINE_BSEL ) {
 		qglColor4f( g_qeglobals.d_savedinfo.colors[COLOR_SELBRUSHES3D][0], g_qeglobals.d_savedinfo.colors[COLOR_SELBRUSHES3D][1], g_qeglobals.d_savedinfo.colors[COLOR_SELBRUSHES3D][2], 0.3f );
 		qglEnable( GL_BLEND );
@@ -1681,6 +1805,7 @@ void CamWnd::Cam_Draw(){
         }
         qglDisable( GL_POLYGON_OFFSET_LINE );
     }
+	Profiler_Pop();
 
     qglDisable( GL_DEPTH_TEST );
 
@@ -1817,6 +1942,8 @@ void CamWnd::Cam_Draw(){
 	}
 #endif
 
+	Profiler_DrawOverlay( PROF_VIEW_CAMERA, m_Camera.width, m_Camera.height );
+
 	// bind back to the default texture so that we don't have problems
 	// elsewhere using/modifying texture maps between contexts
 	qglBindTexture( GL_TEXTURE_2D, 0 );
@@ -1828,9 +1955,7 @@ void CamWnd::Cam_Draw(){
 		end = Sys_DoubleTime();
 		Sys_Printf( "Camera: %i ms\n", (int)( 1000 * ( end - start ) ) );
 	}
-
-	for ( brush = active_brushes.next ; brush != &active_brushes ; brush = brush->next )
-		brush->bCamCulled = false;
+	Profiler_EndFrame( PROF_VIEW_CAMERA );
 
 	for ( brush = pList->next ; brush != pList ; brush = brush->next )
 		brush->bCamCulled = false;
@@ -1852,8 +1977,6 @@ void CamWnd::OnExpose(){
 			}
 		}
 
-		Patch_LODMatchAll(); // spog
-
 		Cam_Draw();
 		QE_CheckOpenGLForErrors();
 
@@ -1867,15 +1990,35 @@ void CamWnd::BenchMark(){
 		Error( "glXMakeCurrent failed in Benchmark" );
 	}
 
+	// time the same spin with both brush renderers, so software contexts
+	// (Mesa llvmpipe) can be compared against hardware ones
+	const char *renderer = (const char*)qglGetString( GL_RENDERER );
+	bool bSaveBatched = g_PrefsDlg.m_bBatchedCamRender;
+	vec_t fSaveYaw = m_Camera.angles[YAW];
+	double dTime[2];
+
+	Sys_Printf( "Camera benchmark on %s\n", renderer ? renderer : "unknown renderer" );
+
 	qglDrawBuffer( GL_FRONT );
-	double dStart = Sys_DoubleTime();
-	for ( int i = 0 ; i < 100 ; i++ )
+	for ( int pass = 0 ; pass < 2 ; pass++ )
 	{
-		m_Camera.angles[YAW] = i * 4;
-		Cam_Draw();
+		g_PrefsDlg.m_bBatchedCamRender = ( pass == 1 );
+		qglFinish();
+		double dStart = Sys_DoubleTime();
+		for ( int i = 0 ; i < 100 ; i++ )
+		{
+			m_Camera.angles[YAW] = i * 4;
+			Cam_Draw();
+		}
+		qglFinish();
+		dTime[pass] = Sys_DoubleTime() - dStart;
 	}
 	SwapBuffers();
 	qglDrawBuffer( GL_BACK );
-	double dEnd = Sys_DoubleTime();
-	Sys_Printf( "%5.2f seconds\n", dEnd - dStart );
+
+	g_PrefsDlg.m_bBatchedCamRender = bSaveBatched;
+	m_Camera.angles[YAW] = fSaveYaw;
+
+	Sys_Printf( "  immediate: %5.2f seconds\n", dTime[0] );
+	Sys_Printf( "  batched:   %5.2f seconds%s\n", dTime[1], qglGenBuffersARB ? "" : " (no VBO support, client arrays)" );
 }
@@ -121,9 +121,13 @@ void Cam_Draw();
 void Cam_DrawStuff();
 void Cam_DrawBrushes( int mode );
 void Cam_DrawBrush( brush_t *b, int mode );
+int Cam_ModelLOD( brush_t *b );
 
 brush_t* m_TransBrushes[MAX_MAP_BRUSHES];
 int m_nNumTransBrushes;
+// active brushes that passed the cull of the current frame
+CPtrArray m_VisibleBrushes;
+CPtrArray m_CullCandidates;
 camera_t m_Camera;
 int m_nCambuttonstate;
 int m_ptButtonX;
@@ -471,6 +471,8 @@ void Drag_Begin( int x, int y, int buttons,
 			if ( t.brush->brush_faces->texdef.GetName()[0] == '(' ) {
 				if ( t.brush->owner->eclass->nShowFlags & ECLASS_LIGHT ) {
 					Str strBuff;
+					// the color of a texture still loading is the placeholder grey
+					Texture_FlushUploads();
 					qtexture_t* pTex = g_qeglobals.d_texturewin.pShader->getTexture();
 					if ( pTex ) {
 						vec3_t vColor;
@@ -81,3 +81,32 @@ void Draw3DPluginEntities(){
 	for ( int i = 0; i < l_GL3DWindows.GetSize(); i++ )
 		static_cast<IGL3DWindow*>( l_GL3DWindows.GetAt( i ) )->Draw3D();
 }
+
+// buffer objects for the plugins, qglGenBuffersARB and friends are only set once a context exists
+bool WINAPI QERApp_HasBufferObjects(){
+	return qglGenBuffersARB != NULL;
+}
+
+void WINAPI QERApp_BindBufferARB( GLenum target, GLuint buffer ){
+	if ( qglBindBufferARB ) {
+		qglBindBufferARB( target, buffer );
+	}
+}
+
+void WINAPI QERApp_DeleteBuffersARB( GLsizei n, const GLuint *buffers ){
+	if ( qglDeleteBuffersARB ) {
+		qglDeleteBuffersARB( n, buffers );
+	}
+}
+
+void WINAPI QERApp_GenBuffersARB( GLsizei n, GLuint *buffers ){
+	if ( qglGenBuffersARB ) {
+		qglGenBuffersARB( n, buffers );
+	}
+}
+
+void WINAPI QERApp_BufferDataARB( GLenum target, ptrdiff_t size, const GLvoid *data, GLenum usage ){
+	if ( qglBufferDataARB ) {
+		qglBufferDataARB( target, size, data, usage );
+	}
+}
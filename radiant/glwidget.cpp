@@ -328,6 +328,8 @@ void gtk_glwidget_print_string( const char *s ){
 			   "you should have called gtk_glwidget_create_font() first" );
 	}
 
+	Profiler_Push( PROF_TEXT );
+
 	layout = pango_layout_new( ft2_context );
 	pango_layout_set_width( layout, -1 ); // -1 no wrapping.  All text on one line.
 	pango_layout_set_text( layout, s, -1 ); // -1 null-terminated string.
@@ -382,6 +384,8 @@ void gtk_glwidget_print_string( const char *s ){
 	}
 
 	g_object_unref( G_OBJECT( layout ) );
+
+	Profiler_Pop();
 }
 
 void gtk_glwidget_print_char( char s ){
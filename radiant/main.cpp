@@ -498,6 +498,13 @@ int mainRadiant( int argc, char* argv[] ) {
 	textdomain( GETTEXT_PACKAGE );
 //  gtk_disable_setlocale();
 
+#if !GLIB_CHECK_VERSION( 2, 32, 0 )
+	// the texture loader uses a glib thread pool
+	if ( !g_thread_supported() ) {
+		g_thread_init( NULL );
+	}
+#endif
+
 	gtk_init( &argc, &argv );
 	gtk_gl_init( &argc, &argv );
 	gdk_gl_init( &argc, &argv );
@@ -516,6 +523,12 @@ int mainRadiant( int argc, char* argv[] ) {
 				g_bBuildList = true;
 				argv[i] = NULL;
 			}
+			// --benchmark <script> <csv>, see profiler.cpp
+			else if ( strcmp( param, "benchmark" ) == 0 && i + 2 < argc ) {
+				Profiler_SetBenchmark( argv[i + 1], argv[i + 2] );
+				argv[i] = argv[i + 1] = argv[i + 2] = NULL;
+				i += 2;
+			}
 		}
 	}
 
@@ -909,6 +922,8 @@ int mainRadiant( int argc, char* argv[] ) {
 	//++timo: temporary debug
 	g_pParentWnd->DoWatchBSP();
 
+	Profiler_StartBenchmark();
+
 	gtk_main();
 
 	// close the log file if any
@@ -921,9 +936,9 @@ int mainRadiant( int argc, char* argv[] ) {
 	// NOTE TTimo not sure what this _exit(0) call is worth
 	//   restricting it to linux build
 #ifdef __linux__
-	_exit( 0 );
+	_exit( Profiler_ExitCode() );
 #endif
-	return 0;
+	return Profiler_ExitCode();
 }
 
 
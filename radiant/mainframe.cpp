@@ -374,6 +374,9 @@ int g_nKeyCount = sizeof( g_Keys ) / sizeof( SKeyInfo );
 
 void WINAPI Sys_UpdateWindows( int nBits ){
 	g_nUpdateBits |= nBits;
+	if ( nBits & ( W_XY | W_XY_OVERLAY | W_CAMERA | W_CAMERA_IFON ) ) {
+		g_bPatchLODPending = true;
+	}
 }
 
 // =============================================================================
@@ -607,6 +610,9 @@ gint HandleCommand( GtkWidget *widget, gpointer data ){
 		  case ID_TEXTUREWINDOW_SCALEUP: g_pParentWnd->OnTexturewindowScaleup(); break;
 		  case ID_TEXTUREWINDOW_SCALEDOWN: g_pParentWnd->OnTexturewindowScaledown(); break;
 		  case ID_MISC_BENCHMARK: g_pParentWnd->OnMiscBenchmark(); break;
+		  case ID_MISC_BRUSHINDEXBENCHMARK: g_pParentWnd->OnMiscBrushIndexBenchmark(); break;
+		  case ID_MISC_TIMEXYVIEWS: g_pParentWnd->OnMiscTimeXYViews(); break;
+		  case ID_MISC_PROFILEROVERLAY: g_pParentWnd->OnMiscProfilerOverlay(); break;
           case ID_COLOR_SET_UPGRADIANT: g_pParentWnd->OnColorSetUpgRadiant(); break;
           case ID_COLOR_SETORIGINAL: g_pParentWnd->OnColorSetoriginal(); break;
           case ID_COLOR_SETQER: g_pParentWnd->OnColorSetqer(); break;
@@ -1594,6 +1600,10 @@ void MainFrame::create_main_menu( GtkWidget *window, GtkWidget *vbox ){
 	}
 
 	create_menu_item_with_mnemonic( menu, _( "_Benchmark" ), G_CALLBACK( HandleCommand ), ID_MISC_BENCHMARK );
+	create_menu_item_with_mnemonic( menu, _( "Brush _Index Benchmark" ), G_CALLBACK( HandleCommand ), ID_MISC_BRUSHINDEXBENCHMARK );
+	create_menu_item_with_mnemonic( menu, _( "Time 2D View Draws" ), G_CALLBACK( HandleCommand ), ID_MISC_TIMEXYVIEWS );
+	item = create_check_menu_item_with_mnemonic( menu, _( "_Profiler Overlay" ), G_CALLBACK( HandleCommand ), ID_MISC_PROFILEROVERLAY, FALSE );
+	g_object_set_data( G_OBJECT( window ), "menu_misc_profileroverlay", item );
 	menu_in_menu = create_menu_in_menu_with_mnemonic( menu, _( "Colors" ) );
 	menu_3 = create_menu_in_menu_with_mnemonic( menu_in_menu, _( "Themes" ) );
     create_menu_item_with_mnemonic( menu_3, _( "upgRadiant" ), G_CALLBACK( HandleCommand ), ID_COLOR_SET_UPGRADIANT );
@@ -3477,6 +3487,7 @@ void MainFrame::OnSleep(){
 
 		Sys_Iconify( m_pWidget );
 		Select_Deselect();
+		Texture_FlushUploads();
 		QERApp_FreeShaders();
 		g_bScreenUpdates = false;
 
@@ -3513,6 +3524,7 @@ void MainFrame::OnSleep(){
 		Sys_Printf( "Reloading shaders..." );
 		// reload the shader scripts and textures
 		QERApp_ReloadShaders();
+		BrushRender_InvalidateAll();
 		// current shader
 		// NOTE: we are kinda making it loop on itself, it will update the pShader and scroll the texture window
 		Texture_SetTexture( &g_qeglobals.d_texturewin.texdef, &g_qeglobals.d_texturewin.brushprimit_texdef, false, NULL, false );
@@ -3771,6 +3783,7 @@ void MainFrame::OnDestroy(){
 	Sys_Printf( "Done.\n" );
 
 	Sys_Printf( "FreeShaders..." );
+	Texture_FlushUploads();
 	QERApp_FreeShaders();
 	Sys_Printf( "Done.\n" );
 }
@@ -4292,6 +4305,12 @@ void MainFrame::UpdateWindows( int nBits ){
 	bean_count++;
 #endif
 
+	// match the patch LODs once for all the views redrawn by this update,
+	// rather than once in every view's draw
+	if ( nBits & ( W_XY | W_XY_OVERLAY | W_CAMERA | W_CAMERA_IFON ) ) {
+		Patch_LODMatchAll(); // spog
+	}
+
     if ( nBits & ( W_XY | W_XY_OVERLAY ) ) {
 		if ( m_pXYWnd ) {
 			m_pXYWnd->RedrawWindow();
@@ -4396,6 +4415,9 @@ void MainFrame::RoutineProcessing(){
             m_pCamWnd->Cam_MouseControl( delta );
 		}
 
+		// upload the textures the loader threads have finished
+		Texture_DrainUploads();
+
 		if ( g_nUpdateBits ) {
 			int nBits = g_nUpdateBits; // this is done to keep this routine from being
 			g_nUpdateBits = 0;        // re-entered due to the paint process.. only
@@ -6338,7 +6360,9 @@ void MainFrame::OnTexturesLoad(){
 
 void MainFrame::OnTexturesReloadshaders(){
 	Sys_BeginWait();
+	Texture_FlushUploads();
 	QERApp_ReloadShaders();
+	BrushRender_InvalidateAll();
 	// current shader
 	// NOTE: we are kinda making it loop on itself, it will update the pShader and scroll the texture window
 	Texture_SetTexture( &g_qeglobals.d_texturewin.texdef, &g_qeglobals.d_texturewin.brushprimit_texdef, false, NULL, false );
@@ -6513,6 +6537,37 @@ void MainFrame::OnMiscBenchmark(){
 	m_pCamWnd->BenchMark();
 }
 
+void MainFrame::OnMiscBrushIndexBenchmark(){
+	Sys_BeginWait();
+	BrushIndex_Benchmark();
+	Sys_EndWait();
+}
+
+// toggles the per view draw time output of the 2D views
+void MainFrame::OnMiscTimeXYViews(){
+	XYWnd *views[] = { m_pXYWnd, m_pXZWnd, m_pYZWnd };
+	bool bTiming = !( m_pXYWnd && m_pXYWnd->GetTiming() );
+
+	for ( int i = 0; i < 3; i++ )
+	{
+		if ( views[i] ) {
+			views[i]->SetTiming( bTiming );
+		}
+	}
+	Sys_Printf( "2D view timing %s\n", bTiming ? "on" : "off" );
+	Sys_UpdateWindows( W_XY );
+}
+
+// per section frame times drawn over the camera and the 2D views, see profiler.cpp
+void MainFrame::OnMiscProfilerOverlay(){
+	g_bProfilerOverlay = !g_bProfilerOverlay;
+	GtkWidget *item = GTK_WIDGET( g_object_get_data( G_OBJECT( m_pWidget ), "menu_misc_profileroverlay" ) );
+	g_bIgnoreCommands++;
+	gtk_check_menu_item_set_active( GTK_CHECK_MENU_ITEM( item ), g_bProfilerOverlay ? TRUE : FALSE );
+	g_bIgnoreCommands--;
+	Sys_UpdateWindows( W_XY | W_CAMERA );
+}
+
 void MainFrame::OnColorSetUpgRadiant(){
     g_qeglobals.d_savedinfo.colors[COLOR_TEXTUREBACK][0] = 0.25f;
     g_qeglobals.d_savedinfo.colors[COLOR_TEXTUREBACK][1] = 0.25f;
@@ -306,6 +306,9 @@ struct SKeyInfo
 #define ID_SELECTION_CREATEENTITY       40039
 #define ID_SELECTION_EDITENTITY         40040
 #define ID_MISC_BENCHMARK               40041
+#define ID_MISC_BRUSHINDEXBENCHMARK     40042
+#define ID_MISC_TIMEXYVIEWS             40035
+#define ID_MISC_PROFILEROVERLAY         40036
 #define ID_REGION_OFF                   40043
 #define ID_REGION_SETXY                 40044
 #define ID_REGION_SETBRUSH              40045
@@ -694,6 +697,9 @@ void OnViewSide();
 void OnTexturesShowinuse();
 void OnTexturesInspector();
 void OnMiscBenchmark();
+void OnMiscBrushIndexBenchmark();
+void OnMiscTimeXYViews();
+void OnMiscProfilerOverlay();
 void OnMiscFindbrush();
 void OnMiscGamma();
 void OnMiscNextleakspot();
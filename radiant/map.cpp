@@ -265,6 +265,78 @@ void Map_FreeEntities( CPtrArray *ents ){
 	ents->RemoveAll();
 }
 
+// wall clock time of the load phases, printed by Map_LoadFile
+static double s_fParseTime, s_fShaderTime, s_fWindingTime, s_fBuildTime;
+static int s_nWindingThreads;
+
+// below this many brushes the thread pool is not worth starting
+#define PREBUILD_MIN_BRUSHES    256
+#define PREBUILD_CHUNK          64
+
+typedef struct
+{
+	GPtrArray *brushes;
+	guint first, last;
+} prebuildChunk_t;
+
+static void Map_PrebuildThread( gpointer data, gpointer user_data ){
+	prebuildChunk_t *chunk = (prebuildChunk_t *)data;
+	guint i;
+
+	for ( i = chunk->first; i < chunk->last; i++ )
+		Brush_PrebuildWindings( (brush_t *)g_ptr_array_index( chunk->brushes, i ) );
+}
+
+/*!
+   clip the face windings of the parsed brushes on a few threads,
+   the brushes are not linked into any list yet so nothing else can see them
+   \return the number of threads used
+ */
+static int Map_PrebuildWindings( GPtrArray *brushes ){
+	GThreadPool *pool = NULL;
+	prebuildChunk_t *chunks;
+	guint i, nChunks;
+	int nThreads = 1;
+
+	if ( brushes->len >= PREBUILD_MIN_BRUSHES ) {
+#if GLIB_CHECK_VERSION( 2, 36, 0 )
+		nThreads = g_get_num_processors();
+#else
+		nThreads = 2;
+#endif
+		if ( nThreads > 1 ) {
+			pool = g_thread_pool_new( Map_PrebuildThread, NULL, nThreads, TRUE, NULL );
+		}
+	}
+
+	nChunks = ( brushes->len + PREBUILD_CHUNK - 1 ) / PREBUILD_CHUNK;
+	chunks = new prebuildChunk_t[nChunks];
+	for ( i = 0; i < nChunks; i++ )
+	{
+		chunks[i].brushes = brushes;
+		chunks[i].first = i * PREBUILD_CHUNK;
+		chunks[i].last = chunks[i].first + PREBUILD_CHUNK;
+		if ( chunks[i].last > brushes->len ) {
+			chunks[i].last = brushes->len;
+		}
+		if ( pool ) {
+			g_thread_pool_push( pool, &chunks[i], NULL );
+		}
+		else{
+			Map_PrebuildThread( &chunks[i], NULL );
+		}
+	}
+	if ( pool ) {
+		g_thread_pool_free( pool, FALSE, TRUE );
+	}
+	else{
+		nThreads = 1;
+	}
+	delete [] chunks;
+
+	return nThreads;
+}
+
 /*!\todo Possibly make the import Undo-friendly by calling Undo_End for new brushes and ents */
 void Map_ImportEntities( CPtrArray *ents, bool bAddSelected = false ){
 	int num_ents, num_brushes;
@@ -325,7 +397,12 @@ void Map_ImportEntities( CPtrArray *ents, bool bAddSelected = false ){
 		}
 	}
 
-	// process the entities into the world geometry
+	double start, finish;
+	GPtrArray *build_brushes = g_ptr_array_new();
+	GHashTable *shaders = g_hash_table_new( g_str_hash, g_str_equal );
+
+	// link the brushes and resolve the shaders, every shader name is only looked up once
+	start = Sys_DoubleTime();
 	num_ents = ents->GetSize();
 	for ( i = 0; i < num_ents; i++ )
 	{
@@ -351,19 +428,54 @@ void Map_ImportEntities( CPtrArray *ents, bool bAddSelected = false ){
 		e->eclass = Eclass_ForName( ValueForKey( e, "classname" ),
 									( e->brushes.onext != &e->brushes ) );
 
-		// go through all parsed brushes and build stuff
 		for ( b = e->brushes.onext; b != &e->brushes; b = b->onext )
 		{
 			for ( f = b->brush_faces; f != NULL; f = f->next )
 			{
-				f->pShader = QERApp_Shader_ForName( f->texdef.GetName() );
+				// the key belongs to the face, which outlives the table
+				// "(r g b)" color shaders are not shared, every face gets its own
+				const char *name = f->texdef.GetName();
+				IShader *pShader = (IShader *)g_hash_table_lookup( shaders, name );
+				if ( !pShader ) {
+					pShader = QERApp_Shader_ForName( name );
+					if ( name[0] != '(' ) {
+						g_hash_table_insert( shaders, (gpointer)name, pShader );
+					}
+				}
+				f->pShader = pShader;
 				f->d_texture = f->pShader->getTexture();
 			}
+			if ( !b->patchBrush ) {
+				g_ptr_array_add( build_brushes, b );
+			}
+		}
+	}
+	g_hash_table_destroy( shaders );
+	finish = Sys_DoubleTime();
+	s_fShaderTime = finish - start;
+
+	// clip the windings on the worker threads, Brush_Build below picks them up
+	start = finish;
+	s_nWindingThreads = Map_PrebuildWindings( build_brushes );
+	g_ptr_array_free( build_brushes, TRUE );
+	finish = Sys_DoubleTime();
+	s_fWindingTime = finish - start;
+
+	// process the entities into the world geometry
+	start = finish;
+	for ( i = 0; i < num_ents; i++ )
+	{
+		e = (entity_t*)ents->GetAt( i );
 
+		// go through all parsed brushes and build stuff
+		g_bBuildWindingsPrebuilt = true;
+		for ( b = e->brushes.onext; b != &e->brushes; b = b->onext )
+		{
 			// when brushes are in final state, build the planes and windings
 			// NOTE: also converts BP brushes if g_qeglobals.bNeedConvert is true
 			Brush_Build( b );
 		}
+		g_bBuildWindingsPrebuilt = false;
 
 //#define TERRAIN_HACK
 #undef TERRAIN_HACK
@@ -514,6 +626,7 @@ void Map_ImportEntities( CPtrArray *ents, bool bAddSelected = false ){
 		}
 	}
 	g_ptr_array_free( new_ents, FALSE );
+	s_fBuildTime = Sys_DoubleTime() - start;
 
 	ents->RemoveAll();
 
@@ -522,8 +635,10 @@ void Map_ImportEntities( CPtrArray *ents, bool bAddSelected = false ){
 
 void Map_Import( IDataStream *in, const char *type, bool bAddSelected ){
 	CPtrArray ents;
+	double start = Sys_DoubleTime();
 
 	g_pParentWnd->GetSynapseClient().ImportMap( in, &ents, type );
+	s_fParseTime = Sys_DoubleTime() - start;
 	Map_ImportEntities( &ents, bAddSelected );
 }
 
@@ -533,9 +648,10 @@ void Map_Import( IDataStream *in, const char *type, bool bAddSelected ){
    ================
  */
 void Map_LoadFile( const char *filename ) {
-	clock_t start, finish;
-	double elapsed_time;
-	start = clock();
+	double start, elapsed_time;
+	start = Sys_DoubleTime();
+	s_fParseTime = s_fShaderTime = s_fWindingTime = s_fBuildTime = 0;
+	s_nWindingThreads = 0;
 
     // NAB622: Add the map to the recently used list here so it can't be missed
     MRU_AddFile( filename );
@@ -604,8 +720,7 @@ void Map_LoadFile( const char *filename ) {
         g_bIgnoreCommands--;
         return;
 	}
-	finish = clock();
-	elapsed_time = (double)( finish - start ) / CLOCKS_PER_SEC;
+	elapsed_time = Sys_DoubleTime() - start;
 
 	Sys_Printf( "--- LoadMapFile ---\n" );
 	Sys_Printf( "%s\n", filename );
@@ -613,6 +728,8 @@ void Map_LoadFile( const char *filename ) {
 	Sys_Printf( "%5i brushes\n",  g_qeglobals.d_parsed_brushes );
 	Sys_Printf( "%5i entities\n", g_qeglobals.d_num_entities );
 	Sys_Printf( "%5.2f second(s) load time\n", elapsed_time );
+	Sys_Printf( "      %5.2f parse, %5.2f shaders, %5.2f windings (%i thread(s)), %5.2f build\n",
+				s_fParseTime, s_fShaderTime, s_fWindingTime, s_nWindingThreads, s_fBuildTime );
 
 	Sys_EndWait();
 
@@ -1098,6 +1215,8 @@ void Map_RegionSelectedBrushes( void ){
 
 	// clear selected_brushes
 	selected_brushes.next = selected_brushes.prev = &selected_brushes;
+	Brush_SetList( &filtered_brushes );
+	Brush_SetList( &active_brushes );
 
 	Sys_UpdateWindows( W_ALL );
 }
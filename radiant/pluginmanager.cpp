@@ -1633,6 +1633,7 @@ void CPlugInManager::CommitEntityHandleToMap( void* vpEntity ){
 				active_brushes.next->prev = b;
 				b->prev = &active_brushes;
 				active_brushes.next = b;
+				b->list = &active_brushes;
 			}
 
 			// handle worldspawn entities
@@ -2089,6 +2090,7 @@ bool CSynapseClientRadiant::RequestAPI( APIDescriptor_t *pAPI ){
 		pTable->m_pfnGetFileTypeRegistry = &GetFileTypeRegistry;
 		pTable->m_pfnReadProjectKey = &QERApp_ReadProjectKey;
 		pTable->m_pfnGetMapName = &QERApp_GetMapName;
+		pTable->m_pfnLoadTexture = &QERApp_LoadTexture;
 		pTable->m_pfnFilterAdd = &FilterCreate;
 		pTable->m_pfnFiltersActivate = &FiltersActivate;
 
@@ -2226,6 +2228,11 @@ bool CSynapseClientRadiant::RequestAPI( APIDescriptor_t *pAPI ){
 		pQglTable->m_pfnUnHookGL2DWindow = QERApp_UnHookGL2DWindow;
 		pQglTable->m_pfnHookGL3DWindow = QERApp_HookGL3DWindow;
 		pQglTable->m_pfnUnHookGL3DWindow = QERApp_UnHookGL3DWindow;
+		pQglTable->m_pfnHasBufferObjects = QERApp_HasBufferObjects;
+		pQglTable->m_pfn_qglBindBufferARB = QERApp_BindBufferARB;
+		pQglTable->m_pfn_qglDeleteBuffersARB = QERApp_DeleteBuffersARB;
+		pQglTable->m_pfn_qglGenBuffersARB = QERApp_GenBuffersARB;
+		pQglTable->m_pfn_qglBufferDataARB = QERApp_BufferDataARB;
 
 		return true;
 	}
@@ -30,6 +30,8 @@
 #include "gtkmisc.h"
 
 #include "gtkr_list.h"
+#include "gtkr_vector.h"
+#include <algorithm>
 
 #include "iglInterpolate.h"
 
@@ -2243,15 +2245,131 @@ int Patch_DegenCurve( vec3_t &start, vec3_t &mid, vec3_t &end ){
 	else{ return 0; }
 }
 
+/*
+   patch edge lookup
+
+   Patch_FindLODMatches used to test every patch in the map for every edge curve of
+   every dirty patch, the mid points of all edge curves are now put in a sorted table
+   of cells so only the patches with an edge curve at the same point are tested
+   the table lives for one Patch_LODMatchAll, the control points don't move in it
+ */
+#define PATCH_EDGE_CELL     8.0
+
+typedef struct
+{
+	int cell[3];
+	int order;          // position in active then selected brushes, matches are tried in list order
+	brush_t *pb;
+} patchEdge_t;
+
+static bool PatchEdge_Less( const patchEdge_t &a, const patchEdge_t &b ){
+	for ( int i = 0; i < 3; i++ )
+	{
+		if ( a.cell[i] != b.cell[i] ) {
+			return a.cell[i] < b.cell[i];
+		}
+	}
+	return a.order < b.order;
+}
+
+static vector<patchEdge_t> s_patchEdges;
+static bool s_bPatchEdges = false;
+
+static void PatchEdge_Cell( const vec_t v, int &cell ){
+	cell = (int)floor( v / PATCH_EDGE_CELL );
+}
+
+static void PatchEdge_Add( brush_t *pb, int order, drawVert_t &vMid ){
+	patchEdge_t edge;
+	for ( int i = 0; i < 3; i++ )
+		PatchEdge_Cell( vMid.xyz[i], edge.cell[i] );
+	edge.order = order;
+	edge.pb = pb;
+	s_patchEdges.push_back( edge );
+}
+
+static void Patch_BuildEdgeTable(){
+	brush_t *pb, *brushlist;
+	patchMesh_t *p;
+	int i, row, col, order = 0;
+
+	s_patchEdges.clear();
+
+	brushlist = &active_brushes;
+	for ( i = 0; i < 2; i++ )
+	{
+		for ( pb = brushlist->next; pb != brushlist; pb = pb->next, order++ )
+		{
+			if ( !pb->patchBrush ) {
+				continue;
+			}
+			p = pb->pPatch;
+			for ( col = 1; col < p->width; col += 2 )
+				for ( row = 0; row < p->height; row += p->height - 1 )
+					PatchEdge_Add( pb, order, p->ctrl[col][row] );
+			for ( row = 1; row < p->height; row += 2 )
+				for ( col = 0; col < p->width; col += p->width - 1 )
+					PatchEdge_Add( pb, order, p->ctrl[col][row] );
+		}
+		brushlist = &selected_brushes;
+	}
+
+	std::sort( s_patchEdges.begin(), s_patchEdges.end(), PatchEdge_Less );
+	s_bPatchEdges = true;
+}
+
+static void Patch_FreeEdgeTable(){
+	vector<patchEdge_t>().swap( s_patchEdges );
+	s_bPatchEdges = false;
+}
+
+static bool PatchEdge_OrderLess( const patchEdge_t &a, const patchEdge_t &b ){
+	return a.order < b.order;
+}
+
+// the patches with an edge curve mid point within EQUAL_EPSILON of v, in list order
+static void Patch_EdgeCandidates( vec3_t v, vector<brush_t*> &candidates ){
+	vector<patchEdge_t> found;
+	int lo[3], hi[3], c[3], i;
+	patchEdge_t key;
+
+	for ( i = 0; i < 3; i++ )
+	{
+		PatchEdge_Cell( v[i] - EQUAL_EPSILON, lo[i] );
+		PatchEdge_Cell( v[i] + EQUAL_EPSILON, hi[i] );
+	}
+
+	for ( c[0] = lo[0]; c[0] <= hi[0]; c[0]++ )
+		for ( c[1] = lo[1]; c[1] <= hi[1]; c[1]++ )
+			for ( c[2] = lo[2]; c[2] <= hi[2]; c[2]++ )
+			{
+				VectorCopy( c, key.cell );
+				key.order = -1;
+				vector<patchEdge_t>::iterator it = std::lower_bound( s_patchEdges.begin(), s_patchEdges.end(), key, PatchEdge_Less );
+				for ( ; it != s_patchEdges.end() && it->cell[0] == c[0] && it->cell[1] == c[1] && it->cell[2] == c[2]; it++ )
+					found.push_back( *it );
+			}
+
+	std::sort( found.begin(), found.end(), PatchEdge_OrderLess );
+	candidates.clear();
+	for ( i = 0; i < (int)found.size(); i++ )
+	{
+		if ( i == 0 || found[i].order != found[i - 1].order ) {
+			candidates.push_back( found[i].pb );
+		}
+	}
+}
+
+static BTreeList_t *Patch_MatchLODEdges( patchMesh_t *patch, brush_t *pb, BTreeList_t *pBTList, drawVert_t &pMid, drawVert_t &pLeft, drawVert_t &pRight );
+
 // take a pointer to the last item added to the list, and a pointer to a patch (this patch is the owner of the three drawverts)
 // take the addresses of three drawVerts, and compare them with the edges of all patches that touch the patch
 // if they match an edge, add the tree roots for that section of the matched patch to the list, and recurse for the opposite edge of that patch section. Also, set the matched patch Dirty, so that its drawlists will be rebuilt
 // return a pointer to the last item added
 BTreeList_t *Patch_FindLODMatches( patchMesh_t *patch, BTreeList_t *pBTList, drawVert_t &pMid, drawVert_t &pLeft, drawVert_t &pRight ){
 	brush_t *pb, *brushlist;
-	int row, col, i; //, pos;
+	int i;
 	vec3_t vTemp, v1, v2; //, vClear;
-	bool bAlreadyAdded;
 
 	//Sys_Printf("Patch_FindLODMatches: called\n");
 
@@ -2278,108 +2396,123 @@ BTreeList_t *Patch_FindLODMatches( patchMesh_t *patch, BTreeList_t *pBTList, dra
 		return pBTList;
 	}
 
+	if ( s_bPatchEdges ) {
+		vector<brush_t*> candidates;
+		Patch_EdgeCandidates( pMid.xyz, candidates );
+		for ( i = 0; i < (int)candidates.size(); i++ )
+			pBTList = Patch_MatchLODEdges( patch, candidates[i], pBTList, pMid, pLeft, pRight );
+		return pBTList;
+	}
+
 	brushlist = &active_brushes;
 	for ( i = 0; i < 2; i++ )
 	{
 		for ( pb = brushlist->next; pb != brushlist; pb = pb->next )
+			pBTList = Patch_MatchLODEdges( patch, pb, pBTList, pMid, pLeft, pRight );
+		brushlist = &selected_brushes;
+	}
+	return pBTList;
+}
+
+// match the edge curves of pb's patch against the test curve
+static BTreeList_t *Patch_MatchLODEdges( patchMesh_t *patch, brush_t *pb, BTreeList_t *pBTList, drawVert_t &pMid, drawVert_t &pLeft, drawVert_t &pRight ){
+	int row, col;
+	bool bAlreadyAdded;
+
+	if ( !pb->patchBrush || pb->pPatch == patch ) {
+		return pBTList;
+	}
+
+	// ignore this patch if its AABB does not touch the subject patch
+	if ( !TouchingAABBs( patch->pSymbiot->maxs, patch->pSymbiot->mins, pb->maxs, pb->mins ) ) {
+		return pBTList;
+	}
+
+	// all columns of curves
+	for ( col = 1; col < pb->pPatch->width; col += 2 )
+	{
+		if ( pb->pPatch->colDirty[( col - 1 ) / 2] ) {
+			continue;
+		}
+
+		bAlreadyAdded = false;
+
+		// top and bottom curves of this column
+		for ( row = 0; row < pb->pPatch->height; row += pb->pPatch->height - 1 )
 		{
-			if ( !pb->patchBrush || pb->pPatch == patch ) {
+			if ( bAlreadyAdded ) {
 				continue;
 			}
-
-			// ignore this patch if its AABB does not touch the subject patch
-			if ( !TouchingAABBs( patch->pSymbiot->maxs, patch->pSymbiot->mins, pb->maxs, pb->mins ) ) {
+			//if (!BTree_IsInList(pBTList, pb->pPatch->rowLOD[(((col-1)/2)*patch->height)+row]))
+			//  continue;
+			// ignore this curve if it shares no mid ctrl point with the test curve
+			if ( !VectorCompare( pb->pPatch->ctrl[col][row].xyz, pMid.xyz ) ) {
 				continue;
 			}
-
-			// all columns of curves
-			for ( col = 1; col < pb->pPatch->width; col += 2 )
-			{
-				if ( pb->pPatch->colDirty[( col - 1 ) / 2] ) {
-					continue;
-				}
-
-				bAlreadyAdded = false;
-
-				// top and bottom curves of this column
-				for ( row = 0; row < pb->pPatch->height; row += pb->pPatch->height - 1 )
-				{
-					if ( bAlreadyAdded ) {
-						continue;
-					}
-					//if (!BTree_IsInList(pBTList, pb->pPatch->rowLOD[(((col-1)/2)*patch->height)+row]))
-					//  continue;
-					// ignore this curve if it shares no mid ctrl point with the test curve
-					if ( !VectorCompare( pb->pPatch->ctrl[col][row].xyz, pMid.xyz ) ) {
-						continue;
-					}
-					// ignore this curve if it is degenerate
-					if ( VectorCompare( pb->pPatch->ctrl[col][row].xyz, pb->pPatch->ctrl[col - 1][row].xyz ) || VectorCompare( pb->pPatch->ctrl[col][row].xyz, pb->pPatch->ctrl[col + 1][row].xyz ) ) {
-						continue;
-					}
-					// if curve matches the test curve directly
-					if ( VectorCompare( pb->pPatch->ctrl[col - 1][row].xyz, pLeft.xyz ) && VectorCompare( pb->pPatch->ctrl[col + 1][row].xyz, pRight.xyz ) ) {
-						// add a blank link as separator
-						pBTList = BTree_AddLinkToList( pBTList );
-						// add this entire column, if top, top-to-bottom, else bottom to top
-						pBTList = Patch_CreateBTListForRows( pBTList, pb->pPatch, row, col );
-						// continue checking from last curve added to list
-						pBTList = Patch_FindLODMatches( pb->pPatch, pBTList, pBTList->pBT->info, pBTList->vLeft, pBTList->vRight );
-						// set flag
-						pb->pPatch->LODUpdated = true;
-						bAlreadyAdded = true;
-					}
-					// if curve matches test curve but flipped
-					else if ( VectorCompare( pb->pPatch->ctrl[col - 1][row].xyz, pRight.xyz ) && VectorCompare( pb->pPatch->ctrl[col + 1][row].xyz, pLeft.xyz ) ) {
-						pBTList = BTree_AddLinkToList( pBTList, true ); // flip
-						pBTList = Patch_CreateBTListForRows( pBTList, pb->pPatch, row, col );
-						pBTList = Patch_FindLODMatches( pb->pPatch, pBTList, pBTList->pBT->info, pBTList->vLeft, pBTList->vRight );
-						pb->pPatch->LODUpdated = true;
-						bAlreadyAdded = true;
-					}
-				}
+			// ignore this curve if it is degenerate
+			if ( VectorCompare( pb->pPatch->ctrl[col][row].xyz, pb->pPatch->ctrl[col - 1][row].xyz ) || VectorCompare( pb->pPatch->ctrl[col][row].xyz, pb->pPatch->ctrl[col + 1][row].xyz ) ) {
+				continue;
+			}
+			// if curve matches the test curve directly
+			if ( VectorCompare( pb->pPatch->ctrl[col - 1][row].xyz, pLeft.xyz ) && VectorCompare( pb->pPatch->ctrl[col + 1][row].xyz, pRight.xyz ) ) {
+				// add a blank link as separator
+				pBTList = BTree_AddLinkToList( pBTList );
+				// add this entire column, if top, top-to-bottom, else bottom to top
+				pBTList = Patch_CreateBTListForRows( pBTList, pb->pPatch, row, col );
+				// continue checking from last curve added to list
+				pBTList = Patch_FindLODMatches( pb->pPatch, pBTList, pBTList->pBT->info, pBTList->vLeft, pBTList->vRight );
+				// set flag
+				pb->pPatch->LODUpdated = true;
+				bAlreadyAdded = true;
 			}
+			// if curve matches test curve but flipped
+			else if ( VectorCompare( pb->pPatch->ctrl[col - 1][row].xyz, pRight.xyz ) && VectorCompare( pb->pPatch->ctrl[col + 1][row].xyz, pLeft.xyz ) ) {
+				pBTList = BTree_AddLinkToList( pBTList, true ); // flip
+				pBTList = Patch_CreateBTListForRows( pBTList, pb->pPatch, row, col );
+				pBTList = Patch_FindLODMatches( pb->pPatch, pBTList, pBTList->pBT->info, pBTList->vLeft, pBTList->vRight );
+				pb->pPatch->LODUpdated = true;
+				bAlreadyAdded = true;
+			}
+		}
+	}
 
-			// all rows of curves
-			for ( row = 1; row < pb->pPatch->height; row += 2 )
-			{
-				if ( pb->pPatch->rowDirty[( row - 1 ) / 2] ) {
-					continue;
-				}
+	// all rows of curves
+	for ( row = 1; row < pb->pPatch->height; row += 2 )
+	{
+		if ( pb->pPatch->rowDirty[( row - 1 ) / 2] ) {
+			continue;
+		}
 
-				bAlreadyAdded = false;
+		bAlreadyAdded = false;
 
-				for ( col = 0; col < pb->pPatch->width; col += pb->pPatch->width - 1 )
-				{
-					if ( bAlreadyAdded ) {
-						continue;
-					}
-					//if (BTree_IsInList(pBTList, pb->pPatch->colLOD[(((row-1)/2)*patch->width)+col]))
-					//  continue;
-					if ( !VectorCompare( pb->pPatch->ctrl[col][row].xyz, pMid.xyz ) ) {
-						continue;
-					}
-					if ( VectorCompare( pb->pPatch->ctrl[col][row].xyz, pb->pPatch->ctrl[col][row - 1].xyz ) || VectorCompare( pb->pPatch->ctrl[col][row].xyz, pb->pPatch->ctrl[col][row + 1].xyz ) ) {
-						continue;
-					}
-					if ( VectorCompare( pb->pPatch->ctrl[col][row - 1].xyz, pLeft.xyz ) && VectorCompare( pb->pPatch->ctrl[col][row + 1].xyz, pRight.xyz ) ) {
-						pBTList = BTree_AddLinkToList( pBTList );
-						pBTList = Patch_CreateBTListForCols( pBTList, pb->pPatch, row, col );
-						pBTList = Patch_FindLODMatches( pb->pPatch, pBTList, pBTList->pBT->info, pBTList->vLeft, pBTList->vRight );
-						pb->pPatch->LODUpdated = true;
-						bAlreadyAdded = true;
-					}
-					else if ( VectorCompare( pb->pPatch->ctrl[col][row - 1].xyz, pRight.xyz ) && VectorCompare( pb->pPatch->ctrl[col][row + 1].xyz, pLeft.xyz ) ) {
-						pBTList = BTree_AddLinkToList( pBTList, true ); // flip
-						pBTList = Patch_CreateBTListForCols( pBTList, pb->pPatch, row, col );
-						pBTList = Patch_FindLODMatches( pb->pPatch, pBTList, pBTList->pBT->info, pBTList->vLeft, pBTList->vRight );
-						pb->pPatch->LODUpdated = true;
-						bAlreadyAdded = true;
-					}
-				}
+		for ( col = 0; col < pb->pPatch->width; col += pb->pPatch->width - 1 )
+		{
+			if ( bAlreadyAdded ) {
+				continue;
+			}
+			//if (BTree_IsInList(pBTList, pb->pPatch->colLOD[(((row-1)/2)*patch->width)+col]))
+			//  continue;
+			if ( !VectorCompare( pb->pPatch->ctrl[col][row].xyz, pMid.xyz ) ) {
+				continue;
+			}
+			if ( VectorCompare( pb->pPatch->ctrl[col][row].xyz, pb->pPatch->ctrl[col][row - 1].xyz ) || VectorCompare( pb->pPatch->ctrl[col][row].xyz, pb->pPatch->ctrl[col][row + 1].xyz ) ) {
+				continue;
+			}
+			if ( VectorCompare( pb->pPatch->ctrl[col][row - 1].xyz, pLeft.xyz ) && VectorCompare( pb->pPatch->ctrl[col][row + 1].xyz, pRight.xyz ) ) {
+				pBTList = BTree_AddLinkToList( pBTList );
+				pBTList = Patch_CreateBTListForCols( pBTList, pb->pPatch, row, col );
+				pBTList = Patch_FindLODMatches( pb->pPatch, pBTList, pBTList->pBT->info, pBTList->vLeft, pBTList->vRight );
+				pb->pPatch->LODUpdated = true;
+				bAlreadyAdded = true;
+			}
+			else if ( VectorCompare( pb->pPatch->ctrl[col][row - 1].xyz, pRight.xyz ) && VectorCompare( pb->pPatch->ctrl[col][row + 1].xyz, pLeft.xyz ) ) {
+				pBTList = BTree_AddLinkToList( pBTList, true ); // flip
+				pBTList = Patch_CreateBTListForCols( pBTList, pb->pPatch, row, col );
+				pBTList = Patch_FindLODMatches( pb->pPatch, pBTList, pBTList->pBT->info, pBTList->vLeft, pBTList->vRight );
+				pb->pPatch->LODUpdated = true;
+				bAlreadyAdded = true;
 			}
 		}
-		brushlist = &selected_brushes;
 	}
 	return pBTList;
 }
@@ -2817,9 +2950,20 @@ void Patch_ClearLODFlags( patchMesh_t *p ){
 
 // reset the lodDirty flags owned by all patches in the map
 // create new LOD trees for all dirty patches, matched with all other patches in the map
+static void Patch_PrebuildTess( vector<patchMesh_t*> &patches );
+static void Patch_InvalidateTess( patchMesh_t *patch );
+
+// set by Sys_UpdateWindows, the patches may have changed since the last match
+// views drawn outside MainFrame::UpdateWindows (exposes, resizes) match first
+bool g_bPatchLODPending = false;
+
 void Patch_LODMatchAll(){
 	brush_t *pb, *brushlist;
 	int i;
+	vector<patchMesh_t*> dirty, updated;
+
+	g_bPatchLODPending = false;
+	Profiler_Push( PROF_PATCHLOD );
 
 	// create LOD tree roots and LOD tree lists for all patches that are dirty
 
@@ -2838,13 +2982,21 @@ void Patch_LODMatchAll(){
 			if ( !pb->pPatch->bDirty ) {
 				continue;
 			}
-
-			Patch_CalcCVNormals( pb->pPatch );
-			Patch_CreateLODTrees( pb->pPatch );
+			dirty.push_back( pb->pPatch );
 		}
 		brushlist = &selected_brushes;
 	}
 
+	if ( !dirty.empty() ) {
+		Patch_BuildEdgeTable();
+		for ( i = 0; i < (int)dirty.size(); i++ )
+		{
+			Patch_CalcCVNormals( dirty[i] );
+			Patch_CreateLODTrees( dirty[i] );
+		}
+		Patch_FreeEdgeTable();
+	}
+
 	brushlist = &active_brushes;
 	for ( i = 0; i < 2; i++ )
 	{
@@ -2856,6 +3008,7 @@ void Patch_LODMatchAll(){
 
 			if ( pb->pPatch->LODUpdated ) {
 				Patch_GenerateLODNormals( pb->pPatch );
+				updated.push_back( pb->pPatch );
 			}
 
 			Patch_ClearLODFlags( pb->pPatch );
@@ -2863,6 +3016,9 @@ void Patch_LODMatchAll(){
 		brushlist = &selected_brushes;
 	}
 
+	Patch_PrebuildTess( updated );
+
+	Profiler_Pop();
 }
 
 void Vertex_TransformTexture( drawVert_t *pVert, float fx, float fy, transformtype xform ){
@@ -2896,6 +3052,8 @@ void BTree_TransformTexture( BTNode_t *pBT, float fx, float fy, transformtype xf
 void Patch_TransformLODTexture( patchMesh_t *p, float fx, float fy, transformtype xform ){
 	int col, row;
 
+	Patch_InvalidateTess( p );
+
 	for ( col = 1; col < p->width; col += 2 )
 		for ( row = 0; row < p->height; row++ )
 			BTree_TransformTexture( p->rowLOD[( ( ( col - 1 ) / 2 ) * p->height ) + row], fx, fy, xform );
@@ -2905,7 +3063,11 @@ void Patch_TransformLODTexture( patchMesh_t *p, float fx, float fy, transformtyp
 			BTree_TransformTexture( p->colLOD[( ( ( row - 1 ) / 2 ) * p->width ) + col], fx, fy, xform );
 }
 
-void Patch_AddBTreeToDrawListInOrder( list<drawVert_t> *drawList, BTNode_t *pBT ){
+// the tessellation is collected in one vector per row of vertices, then packed into a patchTess_t
+typedef vector<drawVert_t> drawList_t;
+typedef vector<drawList_t*> drawLists_t;
+
+void Patch_AddBTreeToDrawListInOrder( drawList_t *drawList, BTNode_t *pBT ){
 	if ( pBT != NULL ) { //traverse InOrder
 		Patch_AddBTreeToDrawListInOrder( drawList, pBT->left );
 		if ( pBT->left != NULL && pBT->right != NULL ) {
@@ -2915,7 +3077,7 @@ void Patch_AddBTreeToDrawListInOrder( list<drawVert_t> *drawList, BTNode_t *pBT
 	}
 }
 
-void Patch_InterpolateListFromRowBT( list<drawVert_t> *drawList, BTNode_t *rowBT, BTNode_t *rowBTLeft, drawVert_t *vCurve[], float u, float n, float v ){
+void Patch_InterpolateListFromRowBT( drawList_t *drawList, BTNode_t *rowBT, BTNode_t *rowBTLeft, drawVert_t *vCurve[], float u, float n, float v ){
 	if ( rowBT != NULL ) {
 		Patch_InterpolateListFromRowBT( drawList, rowBT->left, rowBTLeft->left, vCurve, u - n, n * 0.5f, v );
 		if ( rowBT->left != NULL && rowBT->right != NULL ) {
@@ -2939,7 +3101,7 @@ void Patch_InterpolateListFromRowBT( list<drawVert_t> *drawList, BTNode_t *rowBT
 	}
 }
 
-void Patch_TraverseColBTInOrder( list<list<drawVert_t>*>::iterator& iter, BTNode_t *colBTLeft, BTNode_t *colBT, BTNode_t *colBTRight, BTNode_t *rowBT, BTNode_t *rowBTLeft, float v, float n ){
+void Patch_TraverseColBTInOrder( drawLists_t::iterator& iter, BTNode_t *colBTLeft, BTNode_t *colBT, BTNode_t *colBTRight, BTNode_t *rowBT, BTNode_t *rowBTLeft, float v, float n ){
 	if ( colBT != NULL ) {
 		//traverse subtree In Order
 		Patch_TraverseColBTInOrder( iter, colBTLeft->left, colBT->left, colBTRight->left, rowBT, rowBTLeft, v - n, n * 0.5f );
@@ -2958,12 +3120,12 @@ void Patch_TraverseColBTInOrder( list<list<drawVert_t>*>::iterator& iter, BTNode
 }
 
 
-void Patch_StartDrawLists( list<list<drawVert_t>*> *drawLists, BTNode_t *colBT ){
+void Patch_StartDrawLists( drawLists_t *drawLists, BTNode_t *colBT ){
 	if ( colBT != NULL ) {
 		//traverse subtree In Order
 		Patch_StartDrawLists( drawLists, colBT->left );
 		if ( colBT->left != NULL && colBT->right != NULL ) {
-			list<drawVert_t> *newList = new list<drawVert_t>;
+			drawList_t *newList = new drawList_t;
 			drawLists->push_back( newList ); // add empty list to back
 			drawLists->back()->push_back( colBT->vMid );
 		}
@@ -2971,30 +3133,65 @@ void Patch_StartDrawLists( list<list<drawVert_t>*> *drawLists, BTNode_t *colBT )
 	}
 }
 
-typedef list<drawVert_t> drawList_t;
-typedef list<list<drawVert_t>*> drawLists_t;
-
-void Patch_CreateDrawLists( patchMesh_t *patch ){
-	int col, row, colpos, rowpos;
+/*
+   flat patch tessellation, what patchMesh_t::drawLists points to
 
-	drawLists_t *drawLists = new drawLists_t;
+   the rows of vertices are stored back to back, each pair of neighbouring rows is
+   drawn as one quad strip through the index array, the strip stops at the end of
+   the shorter row like the old list walk did
+   camera and 2D views draw from the same tessellation, it is only rebuilt when the
+   LOD trees change
+ */
+typedef struct
+{
+	float xyz[3];
+	float st[2];
+	float normal[3];
+} tessVert_t;
 
+typedef struct
+{
+	int numRows;
+	int *rowStart;          // numRows + 1 offsets into verts
+	drawVert_t *verts;      // full precision, for Patch_Ray
+	tessVert_t *drawVerts;
+	unsigned int *indexes;
+	int *stripStart;        // numRows offsets into indexes, strip i runs to stripStart[i + 1]
+	bool bPrebuilt;         // built by Patch_LODMatchAll for the LOD update that is still pending
+} patchTess_t;
+
+static void Patch_FreeTess( patchTess_t *tess ){
+	if ( tess ) {
+		delete [] tess->rowStart;
+		delete [] tess->verts;
+		delete [] tess->drawVerts;
+		delete [] tess->indexes;
+		delete [] tess->stripStart;
+		delete tess;
+	}
+}
+
+// builds the tessellation from the LOD trees, doesn't touch anything but the patch so it can run on a worker thread
+static patchTess_t *Patch_BuildTess( patchMesh_t *patch ){
+	int col, row, colpos, rowpos;
+	int i, j, n, numVerts, numIndexes;
+	drawLists_t drawLists;
 	drawLists_t::iterator iter1, iter2;
+	patchTess_t *tess;
 
 	for ( row = 0; row < patch->height; row += 2 )
 	{
-		colpos = ( row / 2 ) * patch->width;
 		drawList_t *newList = new drawList_t;
-		drawLists->push_back( newList ); // add a new empty list to back
-		drawLists->back()->push_back( patch->ctrl[0][row] ); // fill list at back
+		drawLists.push_back( newList ); // add a new empty list to back
+		drawLists.back()->push_back( patch->ctrl[0][row] ); // fill list at back
 
 		if ( row + 1 == patch->height ) {
 			continue;
 		}
-		Patch_StartDrawLists( drawLists, patch->colLOD[colpos] );
+		Patch_StartDrawLists( &drawLists, patch->colLOD[( row / 2 ) * patch->width] );
 	}
 
-	iter1 = drawLists->begin();
+	iter1 = drawLists.begin();
 	for ( row = 0; row < patch->height; row += 2 )
 	{
 		iter2 = iter1;
@@ -3017,93 +3214,179 @@ void Patch_CreateDrawLists( patchMesh_t *patch ){
 		}
 	}
 
-	patch->drawLists = drawLists;
+	// pack
+	tess = new patchTess_t;
+	tess->numRows = (int)drawLists.size();
+	tess->rowStart = new int[tess->numRows + 1];
+	numVerts = numIndexes = 0;
+	for ( i = 0; i < tess->numRows; i++ )
+	{
+		tess->rowStart[i] = numVerts;
+		numVerts += (int)drawLists[i]->size();
+		if ( i + 1 < tess->numRows ) {
+			n = (int)drawLists[i]->size();
+			if ( n > (int)drawLists[i + 1]->size() ) {
+				n = (int)drawLists[i + 1]->size();
+			}
+			numIndexes += 2 * n;
+		}
+	}
+	tess->rowStart[tess->numRows] = numVerts;
+
+	tess->verts = new drawVert_t[numVerts + 1];
+	tess->drawVerts = new tessVert_t[numVerts + 1];
+	for ( i = 0; i < tess->numRows; i++ )
+	{
+		for ( j = 0; j < (int)drawLists[i]->size(); j++ )
+		{
+			drawVert_t *v = &tess->verts[tess->rowStart[i] + j];
+			tessVert_t *d = &tess->drawVerts[tess->rowStart[i] + j];
+			*v = ( *drawLists[i] )[j];
+			VectorCopy( v->xyz, d->xyz );
+			d->st[0] = v->st[0];
+			d->st[1] = v->st[1];
+			VectorCopy( v->normal, d->normal );
+		}
+		delete drawLists[i];
+	}
+
+	tess->indexes = new unsigned int[numIndexes + 1];
+	tess->stripStart = new int[tess->numRows + 1];
+	numIndexes = 0;
+	for ( i = 0; i + 1 < tess->numRows; i++ )
+	{
+		tess->stripStart[i] = numIndexes;
+		n = tess->rowStart[i + 1] - tess->rowStart[i];
+		if ( n > tess->rowStart[i + 2] - tess->rowStart[i + 1] ) {
+			n = tess->rowStart[i + 2] - tess->rowStart[i + 1];
+		}
+		for ( j = 0; j < n; j++ )
+		{
+			tess->indexes[numIndexes++] = tess->rowStart[i] + j;
+			tess->indexes[numIndexes++] = tess->rowStart[i + 1] + j;
+		}
+	}
+	if ( tess->numRows > 0 ) {
+		tess->stripStart[tess->numRows - 1] = numIndexes;
+	}
+	tess->bPrebuilt = false;
+
+	return tess;
 }
 
+void Patch_CreateDrawLists( patchMesh_t *patch ){
+	patch->drawLists = Patch_BuildTess( patch );
+}
 
 void Patch_DeleteDrawLists( patchMesh_t *patch ){
-	drawLists_t *drawLists;
-	drawLists_t::iterator iter;
+	Patch_FreeTess( (patchTess_t *)patch->drawLists );
+	patch->drawLists = NULL;
+}
 
-	if ( patch->drawLists == NULL ) {
-		return;
+// the LOD trees changed after the tessellation was built ahead of the draw
+static void Patch_InvalidateTess( patchMesh_t *patch ){
+	if ( patch->drawLists ) {
+		( (patchTess_t *)patch->drawLists )->bPrebuilt = false;
 	}
+}
 
-	drawLists = (drawLists_t *)patch->drawLists;
-
-	for ( iter = drawLists->begin(); iter != drawLists->end(); iter++ )
-	{
-		delete ( *iter );
+// true once, for the draw that consumes a tessellation built by Patch_PrebuildTess
+// a patch made dirty again since then has moved its control points, it is rebuilt
+static bool Patch_TakePrebuiltTess( patchMesh_t *patch ){
+	patchTess_t *tess = (patchTess_t *)patch->drawLists;
+	if ( tess && tess->bPrebuilt ) {
+		tess->bPrebuilt = false;
+		return !patch->bDirty;
 	}
-
-	delete drawLists;
-	patch->drawLists = NULL;
+	return false;
 }
 
+typedef struct
+{
+	patchMesh_t *patch;
+	patchTess_t *tess;
+} tessJob_t;
 
-void Patch_DrawLODPatchMesh( patchMesh_t *patch ){
-	drawLists_t *drawLists;
+static void Patch_BuildTessThread( gpointer data, gpointer user_data ){
+	tessJob_t *job = (tessJob_t *)data;
+	job->tess = Patch_BuildTess( job->patch );
+}
 
-	drawLists_t::iterator iterLists, iterListsNext;
-	drawList_t::iterator iterList, iterListNext;
+#define PATCH_TESS_THREAD_MIN   8   // fewer patches than this are built right here
 
-	//int nGLState = g_pParentWnd->GetCamera()->Camera()->draw_glstate;
+// build the tessellations of the patches whose LOD changed ahead of the draw, the views
+// then only have to upload them
+static void Patch_PrebuildTess( vector<patchMesh_t*> &patches ){
+	vector<tessJob_t> jobs( patches.size() );
+	GThreadPool *pool = NULL;
+	int i, nThreads;
 
-	if ( patch->drawLists == NULL ) {
+	if ( patches.empty() ) {
 		return;
 	}
 
-	drawLists = (drawLists_t *)patch->drawLists;
+	for ( i = 0; i < (int)patches.size(); i++ )
+	{
+		jobs[i].patch = patches[i];
+		jobs[i].tess = NULL;
+	}
 
-	iterListsNext = drawLists->begin();
-	iterListsNext++;
-	for ( iterLists = drawLists->begin(); iterLists != drawLists->end() && iterListsNext != drawLists->end(); iterLists++, iterListsNext++ )
+	if ( (int)patches.size() >= PATCH_TESS_THREAD_MIN ) {
+#if GLIB_CHECK_VERSION( 2, 36, 0 )
+		nThreads = g_get_num_processors();
+#else
+		nThreads = 2;
+#endif
+		pool = g_thread_pool_new( Patch_BuildTessThread, NULL, nThreads, TRUE, NULL );
+	}
+
+	for ( i = 0; i < (int)jobs.size(); i++ )
 	{
-		// traverse two drawlists at once to draw a strip
-		//if (nGLState & DRAW_GL_LINE)
-		qglBegin( GL_QUAD_STRIP );
-		//else
-		//  qglBegin(GL_TRIANGLE_STRIP);
-		for ( iterList = ( *iterLists )->begin(), iterListNext = ( *iterListsNext )->begin(); iterList != ( *iterLists )->end() && iterListNext != ( *iterListsNext )->end(); iterList++, iterListNext++ )
-		{
-			//if (g_PrefsDlg.m_bGLLighting)
-            qglNormal3f_convertFloat( ( *iterList ).normal );
-			//else if (bShade && !g_PrefsDlg.m_bDisplayLists)
-			//	qglColor3f((*iterList).lightmap[0], (*iterList).lightmap[0], (*iterList).lightmap[0]);
+		if ( pool ) {
+			g_thread_pool_push( pool, &jobs[i], NULL );
+		}
+		else{
+			Patch_BuildTessThread( &jobs[i], NULL );
+		}
+	}
+	if ( pool ) {
+		g_thread_pool_free( pool, FALSE, TRUE );
+	}
 
-            qglTexCoord2f_convertFloat( ( *iterList ).st );
-            qglVertex3f_convertFloat( ( *iterList ).xyz );
+	for ( i = 0; i < (int)jobs.size(); i++ )
+	{
+		Patch_DeleteDrawLists( jobs[i].patch );
+		jobs[i].tess->bPrebuilt = true;
+		jobs[i].patch->drawLists = jobs[i].tess;
+	}
+}
 
-			//if (g_PrefsDlg.m_bGLLighting)
-            qglNormal3f_convertFloat( ( *iterListNext ).normal );
-			//else if (bShade && !g_PrefsDlg.m_bDisplayLists)
-			//	qglColor3f((*iterListNext).lightmap[0], (*iterListNext).lightmap[0], (*iterListNext).lightmap[0]);
+void Patch_DrawLODPatchMesh( patchMesh_t *patch ){
+	patchTess_t *tess = (patchTess_t *)patch->drawLists;
+	int i;
 
-            qglTexCoord2f_convertFloat( ( *iterListNext ).st );
-            qglVertex3f_convertFloat( ( *iterListNext ).xyz );
-		}
-		qglEnd();
+	if ( tess == NULL || tess->numRows < 2 ) {
+		return;
 	}
-/*
-   #ifdef _DEBUG
-   vec3_t vNormal;
-   for (iterLists=drawLists->begin(); iterLists != drawLists->end(); iterLists++)
-   {
-        qglBegin (GL_LINES); // draw normals
-        //qglColor3f(1,1,1);
-        for (iterList=(*iterLists)->begin(); iterList != (*iterLists)->end(); iterList++)
-        {
-            VectorAdd((*iterList).xyz, (*iterList).normal, vNormal);
-            qglVertex3f_convertFloat ((*iterList).xyz);
-            qglVertex3f_convertFloat (vNormal);
-        }
-        qglEnd ();
-   }
 
-    Patch_DrawNormals(patch);
+	// the views keep the vertex arrays enabled for the whole frame, leave them as they were
+	qglPushClientAttrib( GL_CLIENT_VERTEX_ARRAY_BIT );
+	qglEnableClientState( GL_VERTEX_ARRAY );
+	qglVertexPointer( 3, GL_FLOAT, sizeof( tessVert_t ), tess->drawVerts->xyz );
+	qglEnableClientState( GL_TEXTURE_COORD_ARRAY );
+	qglTexCoordPointer( 2, GL_FLOAT, sizeof( tessVert_t ), tess->drawVerts->st );
+	qglEnableClientState( GL_NORMAL_ARRAY );
+	qglNormalPointer( GL_FLOAT, sizeof( tessVert_t ), tess->drawVerts->normal );
 
-   #endif
- */
+	for ( i = 0; i + 1 < tess->numRows; i++ )
+	{
+		// traverse two rows at once to draw a strip
+		if ( tess->stripStart[i + 1] > tess->stripStart[i] ) {
+			qglDrawElements( GL_QUAD_STRIP, tess->stripStart[i + 1] - tess->stripStart[i], GL_UNSIGNED_INT, tess->indexes + tess->stripStart[i] );
+		}
+	}
+
+	qglPopClientAttrib();
 }
 
 /*
@@ -3264,10 +3547,9 @@ int Triangle_Ray( vec_t orig[3], vec_t dir[3], bool bCullBack,
 }
 
 bool Patch_Ray( patchMesh_t *patch, vec3_t origin, vec3_t dir, double *t, double *u, double *v ){
-	drawLists_t *drawLists;
-
-	drawLists_t::iterator iterLists, iterListsNext;
-	drawList_t::iterator i1, i2, i3, i4;
+	patchTess_t *tess;
+	drawVert_t *i1, *i2, *i3, *i4;
+	int row, j, n;
 
 //  vec3_t tris[2][3];
 	bool bIntersect = false;
@@ -3277,26 +3559,25 @@ bool Patch_Ray( patchMesh_t *patch, vec3_t origin, vec3_t dir, double *t, double
 		return false;
 	}
 
-	drawLists = (drawLists_t *)patch->drawLists;
+	tess = (patchTess_t *)patch->drawLists;
 
-	iterListsNext = drawLists->begin();
-	iterListsNext++;
-	for ( iterLists = drawLists->begin(); iterLists != drawLists->end() && iterListsNext != drawLists->end(); iterLists++, iterListsNext++ )
+	for ( row = 0; row + 1 < tess->numRows; row++ )
 	{
-		// traverse two drawlists at once with two iterators each to triangulate
-		i1 = i3 = ( *iterLists )->begin();
-		i2 = i4 = ( *iterListsNext )->begin();
-		i3++;
-		i4++;
-		while ( i3 != ( *iterLists )->end() && i4 != ( *iterListsNext )->end() )
+		// traverse two rows at once to triangulate
+		i1 = tess->verts + tess->rowStart[row];
+		i2 = tess->verts + tess->rowStart[row + 1];
+		n = ( tess->stripStart[row + 1] - tess->stripStart[row] ) / 2;
+		for ( j = 0; j + 1 < n; j++ )
 		{
-			if ( Triangle_Ray( origin, dir, false, ( *i1 ).xyz, ( *i2 ).xyz, ( *i3 ).xyz, t, u, v ) ) {
+			i3 = i1 + 1;
+			i4 = i2 + 1;
+			if ( Triangle_Ray( origin, dir, false, i1->xyz, i2->xyz, i3->xyz, t, u, v ) ) {
 				bIntersect = true;
 				if ( *t < tBest ) {
 					tBest = *t;
 				}
 			}
-			if ( Triangle_Ray( origin, dir, false, ( *i3 ).xyz, ( *i4 ).xyz, ( *i2 ).xyz, t, u, v ) ) {
+			if ( Triangle_Ray( origin, dir, false, i3->xyz, i4->xyz, i2->xyz, t, u, v ) ) {
 				bIntersect = true;
 				if ( *t < tBest ) {
 					tBest = *t;
@@ -3304,8 +3585,6 @@ bool Patch_Ray( patchMesh_t *patch, vec3_t origin, vec3_t dir, double *t, double
 			}
 			i1++;
 			i2++;
-			i3++;
-			i4++;
 		}
 	}
 	if ( bIntersect ) {
@@ -3327,6 +3606,12 @@ bool Patch_Ray( patchMesh_t *patch, vec3_t origin, vec3_t dir, double *t, double
    =================
  */
 void DrawPatchMesh( patchMesh_t *pm ){
+	// the LODs are matched by MainFrame::UpdateWindows or at the start of the view's draw,
+	// a patch made dirty without a Sys_UpdateWindows may still have no LOD trees
+	if ( pm->bDirty && !pm->rowLOD[0] && !pm->colLOD[0] ) {
+		Patch_LODMatchAll();
+	}
+
 	if ( g_PrefsDlg.m_bDisplayLists ) {
 		if ( pm->bDirty || pm->nListID <= 0 || pm->LODUpdated ) {
 			if ( pm->nListID <= 0 ) {
@@ -3336,8 +3621,12 @@ void DrawPatchMesh( patchMesh_t *pm ){
 				qglNewList( pm->nListID, GL_COMPILE_AND_EXECUTE );
 			}
 
-			Patch_DeleteDrawLists( pm );
-			Patch_CreateDrawLists( pm );
+			if ( !Patch_TakePrebuiltTess( pm ) ) {
+				Profiler_Push( PROF_PATCHLOD );
+				Patch_DeleteDrawLists( pm );
+				Patch_CreateDrawLists( pm );
+				Profiler_Pop();
+			}
 
 			Patch_DrawLODPatchMesh( pm );
 
@@ -3356,8 +3645,12 @@ void DrawPatchMesh( patchMesh_t *pm ){
 	else
 	{
 		if ( pm->bDirty || pm->LODUpdated ) {
-			Patch_DeleteDrawLists( pm );
-			Patch_CreateDrawLists( pm );
+			if ( !Patch_TakePrebuiltTess( pm ) ) {
+				Profiler_Push( PROF_PATCHLOD );
+				Patch_DeleteDrawLists( pm );
+				Patch_CreateDrawLists( pm );
+				Profiler_Pop();
+			}
 			pm->bDirty = false;
 			pm->LODUpdated = false;
 		}
@@ -132,6 +132,12 @@
 #define HIDEEMPTYDIRS_KEY       "HideEmptyDirs"
 #define SHADERTEST_KEY          "ShaderTest"
 #define GLLIGHTING_KEY          "UseGLLighting"
+#define BATCHEDCAMRENDER_KEY    "BatchedCameraRender"
+#define ASYNCTEXTURELOAD_KEY    "AsyncTextureLoad"
+#define TEXTURECACHE_KEY        "TextureCache"
+#define MODELLOD_KEY            "ModelLOD"
+#define MODELLODSIZE_KEY        "ModelLODSize"
+#define MODELIMPOSTORSIZE_KEY   "ModelImpostorSize"
 #define LOADSHADERS_KEY         "LoadShaders"
 #define SHOWTEXDIRLIST_KEY		"ShowTextureDirectoryList"
 #define NOSTIPPLE_KEY           "NoStipple"
@@ -717,6 +723,12 @@ PrefsDlg::PrefsDlg (){
 	m_bShowShaders = TRUE;
 	m_bHideEmptyDirs = FALSE;
 	m_bGLLighting = FALSE;
+	m_bBatchedCamRender = TRUE;
+	m_bAsyncTextureLoad = TRUE;
+	m_bTextureCache = TRUE;
+	m_bModelLOD = TRUE;
+	m_nModelLODSize = 160;
+	m_nModelImpostorSize = 8;
 	m_nShader = 0;
     m_nUndoLevels = 512;
 	m_bTexturesShaderlistOnly = FALSE;
@@ -2247,6 +2259,70 @@ void PrefsDlg::BuildDialog(){
 	AddDialogData( check, &m_bCamXYUpdate, DLG_CHECK_BOOL );
 */
 
+    // Batched brush rendering
+    check = gtk_check_button_new_with_label( _( "Batch brush faces by texture in the camera view\n(uncheck to draw them one polygon at a time)" ) );
+    gtk_box_pack_start( GTK_BOX( vbox ), check, FALSE, FALSE, 0 );
+    gtk_widget_show( check );
+    AddDialogData( check, &m_bBatchedCamRender, DLG_CHECK_BOOL );
+
+    // Background texture loading
+    check = gtk_check_button_new_with_label( _( "Process and upload textures in the background\n(uncheck to load each texture completely before continuing)" ) );
+    gtk_box_pack_start( GTK_BOX( vbox ), check, FALSE, FALSE, 0 );
+    gtk_widget_show( check );
+    AddDialogData( check, &m_bAsyncTextureLoad, DLG_CHECK_BOOL );
+
+    // On-disk texture cache
+    check = gtk_check_button_new_with_label( _( "Keep processed textures in a cache on disk\n(in the texcache folder next to the preferences)" ) );
+    gtk_box_pack_start( GTK_BOX( vbox ), check, FALSE, FALSE, 0 );
+    gtk_widget_show( check );
+    AddDialogData( check, &m_bTextureCache, DLG_CHECK_BOOL );
+
+    // Model detail
+    check = gtk_check_button_new_with_label( _( "Draw simplified models when they are small in the camera view" ) );
+    gtk_box_pack_start( GTK_BOX( vbox ), check, FALSE, FALSE, 0 );
+    gtk_widget_show( check );
+    AddDialogData( check, &m_bModelLOD, DLG_CHECK_BOOL );
+
+    table = gtk_table_new( 2, 2, FALSE );
+    gtk_box_pack_start( GTK_BOX( vbox ), table, FALSE, FALSE, 0 );
+    gtk_table_set_row_spacings( GTK_TABLE( table ), 5 );
+    gtk_table_set_col_spacings( GTK_TABLE( table ), 5 );
+    gtk_widget_show( table );
+
+    label = gtk_label_new( _( "Simplify models below (pixels):" ) );
+    gtk_table_attach( GTK_TABLE( table ), label, 0, 1, 0, 1,
+                      (GtkAttachOptions) ( GTK_FILL ),
+                      (GtkAttachOptions) ( 0 ), 0, 0 );
+    gtk_misc_set_alignment( GTK_MISC( label ), 0.0, 0.5 );
+    gtk_widget_show( label );
+
+    spin = gtk_spin_button_new( GTK_ADJUSTMENT( gtk_adjustment_new( 160, 0, 4096, 8, 64, 0 ) ), 1, 0 );
+    gtk_widget_set_tooltip_text( spin, _( "Models smaller than this on screen are drawn with about half of their triangles,\nand with a fifth of them below half this size" ) );
+    gtk_spin_button_set_numeric( GTK_SPIN_BUTTON( spin ), TRUE );
+    gtk_entry_set_alignment( GTK_ENTRY( spin ), 1.0 ); //right
+    gtk_table_attach( GTK_TABLE( table ), spin, 1, 2, 0, 1,
+                      (GtkAttachOptions) ( GTK_FILL ),
+                      (GtkAttachOptions) ( 0 ), 0, 0 );
+    gtk_widget_show( spin );
+    AddDialogData( spin, &m_nModelLODSize, DLG_SPIN_INT );
+
+    label = gtk_label_new( _( "Draw models as boxes below (pixels):" ) );
+    gtk_table_attach( GTK_TABLE( table ), label, 0, 1, 1, 2,
+                      (GtkAttachOptions) ( GTK_FILL ),
+                      (GtkAttachOptions) ( 0 ), 0, 0 );
+    gtk_misc_set_alignment( GTK_MISC( label ), 0.0, 0.5 );
+    gtk_widget_show( label );
+
+    spin = gtk_spin_button_new( GTK_ADJUSTMENT( gtk_adjustment_new( 8, 0, 256, 1, 8, 0 ) ), 1, 0 );
+    gtk_widget_set_tooltip_text( spin, _( "Models smaller than this on screen are drawn as a box in their entity color" ) );
+    gtk_spin_button_set_numeric( GTK_SPIN_BUTTON( spin ), TRUE );
+    gtk_entry_set_alignment( GTK_ENTRY( spin ), 1.0 ); //right
+    gtk_table_attach( GTK_TABLE( table ), spin, 1, 2, 1, 2,
+                      (GtkAttachOptions) ( GTK_FILL ),
+                      (GtkAttachOptions) ( 0 ), 0, 0 );
+    gtk_widget_show( spin );
+    AddDialogData( spin, &m_nModelImpostorSize, DLG_SPIN_INT );
+
 #ifdef ATIHACK_812
     // ATI bugs
     check = gtk_check_button_new_with_label( _( "Enable workaround for ATI and Intel cards with buggy drivers\n(Disappearing polygons)" ) );
@@ -3610,6 +3686,12 @@ void PrefsDlg::LoadPrefs(){
 	mLocalPrefs.GetPref( SHOWSHADERS_KEY,        &m_bShowShaders,                TRUE );
 	mLocalPrefs.GetPref( HIDEEMPTYDIRS_KEY,      &m_bHideEmptyDirs,              FALSE );
 	mLocalPrefs.GetPref( GLLIGHTING_KEY,         &m_bGLLighting,                 FALSE );
+	mLocalPrefs.GetPref( BATCHEDCAMRENDER_KEY,   &m_bBatchedCamRender,           TRUE );
+	mLocalPrefs.GetPref( ASYNCTEXTURELOAD_KEY,   &m_bAsyncTextureLoad,           TRUE );
+	mLocalPrefs.GetPref( TEXTURECACHE_KEY,       &m_bTextureCache,               TRUE );
+	mLocalPrefs.GetPref( MODELLOD_KEY,           &m_bModelLOD,                   TRUE );
+	mLocalPrefs.GetPref( MODELLODSIZE_KEY,       &m_nModelLODSize,               160 );
+	mLocalPrefs.GetPref( MODELIMPOSTORSIZE_KEY,  &m_nModelImpostorSize,          8 );
     mLocalPrefs.GetPref( NOSTIPPLE_KEY,          &m_bNoStipple,                  FALSE );
     mLocalPrefs.GetPref( XRAYSELECTION_KEY,      &m_bXraySelection,              TRUE );
     mLocalPrefs.GetPref( UNDOLEVELS_KEY,         &m_nUndoLevels,                 512 );
@@ -677,6 +677,12 @@ bool m_bSwitchClip;
 bool m_bSelectWholeEntities;
 int m_nTextureQuality;
 bool m_bGLLighting;
+bool m_bBatchedCamRender;
+bool m_bAsyncTextureLoad;
+bool m_bTextureCache;
+bool m_bModelLOD;
+int m_nModelLODSize;
+int m_nModelImpostorSize;
 bool m_bTexturesShaderlistOnly;
 int m_nSubdivisions;
 float m_fDefTextureScale;
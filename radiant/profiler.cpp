@@ -0,0 +1,430 @@
+/*
+   Copyright (C) 1999-2007 id Software, Inc. and contributors.
+   For a list of contributors, see the accompanying CONTRIBUTORS file.
+
+   This file is part of GtkRadiant.
+
+   GtkRadiant is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   GtkRadiant is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with GtkRadiant; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/*
+   frame time profiler
+
+   the camera and the 2D views bracket their draws with Profiler_BeginFrame and
+   Profiler_EndFrame, the parts of a draw are bracketed with Profiler_Push and
+   Profiler_Pop. sections nest, time is only charged to the innermost one, so a
+   model drawn from the brush loop counts as model time and not brush time.
+   work done between two draws (Patch_LODMatchAll from UpdateWindows) is charged
+   to the next frame of whatever view draws first.
+
+   the camera also counts the models it draws, how many went to a simplified mesh
+   or a box, and the triangles that saved (Profiler_CountModel).
+
+   nothing is timed unless the overlay is on or a benchmark is running.
+
+   the benchmark is started from the command line:
+     radiant --benchmark <script> <csv> [map]
+   the script has one camera key per line, "x y z pitch yaw [frames]", the camera
+   moves from the previous key to this one over frames draws (30 by default).
+   every step redraws the camera and the 2D views, following the camera, and
+   writes one CSV row per view. radiant quits when it is done.
+ */
+
+#include "stdafx.h"
+#include <vector>
+
+#define PROF_HISTORY        64
+#define PROF_MAX_DEPTH      16
+#define PROF_DEFAULT_FRAMES 30
+
+typedef struct
+{
+	double total;
+	double section[PROF_NUMSECTIONS];
+	int models, modelsLOD, modelsBoxed;
+	int modelTris, modelTrisSaved;
+} profFrame_t;
+
+typedef struct
+{
+	vec3_t origin;
+	vec_t pitch, yaw;
+	int frames;
+} benchKey_t;
+
+static const char *s_sectionNames[PROF_NUMSECTIONS] = { "cull", "brushes", "models", "patch LOD", "text" };
+static const char *s_sectionColumns[PROF_NUMSECTIONS] = { "cull_ms", "brushes_ms", "models_ms", "patch_lod_ms", "text_ms" };
+static const char *s_viewNames[PROF_NUMVIEWS] = { "camera", "YZ", "XZ", "XY" };
+
+bool g_bProfilerOverlay = false;
+
+static bool s_bBenchmarking = false;
+static char *s_pBenchScript = NULL;
+static char *s_pBenchCSV = NULL;
+static int s_nBenchExitCode = 0;
+
+static profFrame_t s_history[PROF_NUMVIEWS][PROF_HISTORY];
+static int s_nFrames[PROF_NUMVIEWS];
+
+static int s_nView = -1;            // view being drawn, -1 between draws
+static double s_fFrameStart;
+static profFrame_t s_current;
+static profFrame_t s_pending;       // charged between draws
+
+static int s_stack[PROF_MAX_DEPTH];
+static int s_nDepth;
+static double s_fMark;
+
+bool Profiler_Active(){
+	return g_bProfilerOverlay || s_bBenchmarking;
+}
+
+static void Profiler_Charge( double now ){
+	if ( s_nDepth > 0 && s_nDepth <= PROF_MAX_DEPTH ) {
+		profFrame_t *frame = ( s_nView >= 0 ) ? &s_current : &s_pending;
+		frame->section[s_stack[s_nDepth - 1]] += now - s_fMark;
+	}
+	s_fMark = now;
+}
+
+void Profiler_Push( int section ){
+	if ( !Profiler_Active() ) {
+		return;
+	}
+	Profiler_Charge( Sys_DoubleTime() );
+	if ( s_nDepth < PROF_MAX_DEPTH ) {
+		s_stack[s_nDepth] = section;
+	}
+	s_nDepth++;
+}
+
+void Profiler_Pop(){
+	if ( !Profiler_Active() || s_nDepth == 0 ) {
+		return;
+	}
+	Profiler_Charge( Sys_DoubleTime() );
+	s_nDepth--;
+}
+
+void Profiler_BeginFrame( int view ){
+	if ( !Profiler_Active() ) {
+		return;
+	}
+	s_current = s_pending;
+	memset( &s_pending, 0, sizeof( s_pending ) );
+	for ( int i = 0; i < PROF_NUMSECTIONS; i++ )
+		s_current.total += s_current.section[i];
+	s_nView = view;
+	s_nDepth = 0;
+	s_fFrameStart = s_fMark = Sys_DoubleTime();
+}
+
+void Profiler_EndFrame( int view ){
+	if ( !Profiler_Active() || s_nView != view ) {
+		return;
+	}
+	s_current.total += Sys_DoubleTime() - s_fFrameStart;
+	s_history[view][s_nFrames[view] % PROF_HISTORY] = s_current;
+	s_nFrames[view]++;
+	s_nView = -1;
+	s_nDepth = 0;
+}
+
+// fullTris is what the model has at full detail, drawnTris what was sent, lod is -1 for a box
+void Profiler_CountModel( int lod, int fullTris, int drawnTris ){
+	if ( !Profiler_Active() || s_nView < 0 ) {
+		return;
+	}
+	s_current.models++;
+	if ( lod < 0 ) {
+		s_current.modelsBoxed++;
+	}
+	else if ( lod > 0 ) {
+		s_current.modelsLOD++;
+	}
+	s_current.modelTris += drawnTris;
+	s_current.modelTrisSaved += fullTris - drawnTris;
+}
+
+static const profFrame_t *Profiler_LastFrame( int view ){
+	if ( s_nFrames[view] == 0 ) {
+		return NULL;
+	}
+	return &s_history[view][( s_nFrames[view] - 1 ) % PROF_HISTORY];
+}
+
+static double Profiler_Other( const profFrame_t *frame ){
+	double other = frame->total;
+	for ( int i = 0; i < PROF_NUMSECTIONS; i++ )
+		other -= frame->section[i];
+	return other > 0 ? other : 0;
+}
+
+void Profiler_DrawOverlay( int view, int width, int height ){
+	const profFrame_t *last;
+	profFrame_t avg;
+	char line[128];
+	int i, j, n, y, lineHeight;
+
+	if ( !g_bProfilerOverlay || ( last = Profiler_LastFrame( view ) ) == NULL ) {
+		return;
+	}
+
+	n = s_nFrames[view] < PROF_HISTORY ? s_nFrames[view] : PROF_HISTORY;
+	memset( &avg, 0, sizeof( avg ) );
+	for ( i = 0; i < n; i++ )
+	{
+		avg.total += s_history[view][i].total / n;
+		for ( j = 0; j < PROF_NUMSECTIONS; j++ )
+			avg.section[j] += s_history[view][i].section[j] / n;
+	}
+
+	qglMatrixMode( GL_PROJECTION );
+	qglPushMatrix();
+	qglLoadIdentity();
+	qglOrtho( 0, width, 0, height, -100, 100 );
+	qglMatrixMode( GL_MODELVIEW );
+	qglPushMatrix();
+	qglLoadIdentity();
+	qglPushAttrib( GL_ENABLE_BIT | GL_CURRENT_BIT );
+	qglDisable( GL_DEPTH_TEST );
+	qglDisable( GL_TEXTURE_2D );
+	qglDisable( GL_LIGHTING );
+
+	qglColor3fv( g_qeglobals.d_savedinfo.colors[COLOR_VIEWNAME] );
+	lineHeight = gtk_glwidget_font_ascent() + gtk_glwidget_font_descent() + 2;
+	y = height - 8 - lineHeight;
+
+	sprintf( line, "%s: %.2f ms  (avg %.2f over %d frames)", s_viewNames[view], 1000 * last->total, 1000 * avg.total, n );
+	qglRasterPos2i( 8, y );
+	gtk_glwidget_print_string( line );
+	y -= lineHeight;
+
+	for ( i = 0; i < PROF_NUMSECTIONS; i++, y -= lineHeight )
+	{
+		sprintf( line, "  %-10s %7.2f  %7.2f", s_sectionNames[i], 1000 * last->section[i], 1000 * avg.section[i] );
+		qglRasterPos2i( 8, y );
+		gtk_glwidget_print_string( line );
+	}
+	sprintf( line, "  %-10s %7.2f  %7.2f", "other", 1000 * Profiler_Other( last ), 1000 * Profiler_Other( &avg ) );
+	qglRasterPos2i( 8, y );
+	gtk_glwidget_print_string( line );
+
+	if ( last->models ) {
+		y -= lineHeight;
+		sprintf( line, "  models %d (%d simplified, %d boxed)  %d tris, %d saved", last->models, last->modelsLOD, last->modelsBoxed, last->modelTris, last->modelTrisSaved );
+		qglRasterPos2i( 8, y );
+		gtk_glwidget_print_string( line );
+	}
+
+	qglPopAttrib();
+	qglMatrixMode( GL_PROJECTION );
+	qglPopMatrix();
+	qglMatrixMode( GL_MODELVIEW );
+	qglPopMatrix();
+}
+
+/*
+   ==============
+   benchmark
+   ==============
+ */
+
+void Profiler_SetBenchmark( const char *script, const char *csv ){
+	g_free( s_pBenchScript );
+	g_free( s_pBenchCSV );
+	s_pBenchScript = g_strdup( script );
+	s_pBenchCSV = g_strdup( csv );
+}
+
+static bool Profiler_LoadScript( const char *filename, std::vector<benchKey_t> &keys ){
+	char line[1024];
+	FILE *f;
+	int n = 0;
+
+	f = fopen( filename, "r" );
+	if ( !f ) {
+		Sys_FPrintf( SYS_ERR, "ERROR: can't open benchmark script %s\n", filename );
+		return false;
+	}
+
+	while ( fgets( line, sizeof( line ), f ) )
+	{
+		benchKey_t key;
+		double x, y, z, pitch, yaw;
+		int args;
+
+		n++;
+		if ( line[0] == '#' || ( line[0] == '/' && line[1] == '/' ) ) {
+			continue;
+		}
+		key.frames = PROF_DEFAULT_FRAMES;
+		args = sscanf( line, "%lf %lf %lf %lf %lf %d", &x, &y, &z, &pitch, &yaw, &key.frames );
+		if ( args <= 0 ) {
+			continue;
+		}
+		if ( args < 5 || key.frames < 1 ) {
+			Sys_FPrintf( SYS_ERR, "ERROR: %s line %d: expected x y z pitch yaw [frames]\n", filename, n );
+			fclose( f );
+			return false;
+		}
+		VectorSet( key.origin, x, y, z );
+		key.pitch = pitch;
+		key.yaw = yaw;
+		keys.push_back( key );
+	}
+	fclose( f );
+
+	if ( keys.empty() ) {
+		Sys_FPrintf( SYS_ERR, "ERROR: benchmark script %s has no camera keys\n", filename );
+		return false;
+	}
+	return true;
+}
+
+// drawn is the view's frame count before the expose, a view that didn't draw gets no row
+static bool Profiler_WriteRow( FILE *f, int step, int view, int drawn, double sum[PROF_NUMVIEWS], double worst[PROF_NUMVIEWS] ){
+	const profFrame_t *frame = Profiler_LastFrame( view );
+	if ( !frame || s_nFrames[view] == drawn ) {
+		return false;
+	}
+
+	fprintf( f, "%d,%s,%.3f", step, s_viewNames[view], 1000 * frame->total );
+	for ( int i = 0; i < PROF_NUMSECTIONS; i++ )
+		fprintf( f, ",%.3f", 1000 * frame->section[i] );
+	fprintf( f, ",%.3f,%d,%d\n", 1000 * Profiler_Other( frame ), frame->modelTris, frame->modelTrisSaved );
+
+	sum[view] += frame->total;
+	if ( frame->total > worst[view] ) {
+		worst[view] = frame->total;
+	}
+	return true;
+}
+
+// draws the camera and the 2D views at every step of the script, one CSV row per view and step
+static bool Profiler_RunBenchmark(){
+	std::vector<benchKey_t> keys;
+	CamWnd *cam = g_pParentWnd->GetCamWnd();
+	XYWnd *views[3] = { g_pParentWnd->GetYZWnd(), g_pParentWnd->GetXZWnd(), g_pParentWnd->GetXYWnd() };
+	double sum[PROF_NUMVIEWS], worst[PROF_NUMVIEWS];
+	int counts[PROF_NUMVIEWS];
+	int i, k, step, view, drawn;
+	FILE *f;
+
+	if ( !cam ) {
+		Sys_FPrintf( SYS_ERR, "ERROR: benchmark needs the camera view\n" );
+		return false;
+	}
+	if ( !Profiler_LoadScript( s_pBenchScript, keys ) ) {
+		return false;
+	}
+	f = fopen( s_pBenchCSV, "w" );
+	if ( !f ) {
+		Sys_FPrintf( SYS_ERR, "ERROR: can't write benchmark results to %s\n", s_pBenchCSV );
+		return false;
+	}
+
+	const char *renderer = (const char*)qglGetString( GL_RENDERER );
+	Sys_Printf( "Running benchmark %s on %s\n", s_pBenchScript, renderer ? renderer : "unknown renderer" );
+
+	fprintf( f, "step,view,total_ms" );
+	for ( i = 0; i < PROF_NUMSECTIONS; i++ )
+		fprintf( f, ",%s", s_sectionColumns[i] );
+	fprintf( f, ",other_ms,model_tris,model_tris_saved\n" );
+
+	memset( sum, 0, sizeof( sum ) );
+	memset( worst, 0, sizeof( worst ) );
+	memset( counts, 0, sizeof( counts ) );
+	memset( s_nFrames, 0, sizeof( s_nFrames ) );
+
+	// the benchmark runs inside a timeout, so the idle upload drain never gets a chance:
+	// without this every texture still pending would be timed as its placeholder
+	Texture_FlushUploads();
+	Patch_LODMatchAll();
+	s_bBenchmarking = true;
+
+	step = 0;
+	for ( k = 0; k < (int)keys.size(); k++ )
+	{
+		// the first key is a single step, every other one is reached over its frames
+		int frames = ( k == 0 ) ? 1 : keys[k].frames;
+		for ( i = 1; i <= frames; i++, step++ )
+		{
+			camera_t *camera = cam->Camera();
+			float t = (float)i / frames;
+			const benchKey_t &from = keys[k == 0 ? 0 : k - 1];
+
+			for ( int j = 0; j < 3; j++ )
+				camera->origin[j] = from.origin[j] + t * ( keys[k].origin[j] - from.origin[j] );
+			camera->angles[PITCH] = from.pitch + t * ( keys[k].pitch - from.pitch );
+			camera->angles[YAW] = from.yaw + t * ( keys[k].yaw - from.yaw );
+
+			Patch_LODMatchAll();
+
+			drawn = s_nFrames[PROF_VIEW_CAMERA];
+			static_cast<GLWindow*>( cam )->OnExpose();
+			if ( Profiler_WriteRow( f, step, PROF_VIEW_CAMERA, drawn, sum, worst ) ) {
+				counts[PROF_VIEW_CAMERA]++;
+			}
+
+			for ( view = 0; view < 3; view++ )
+			{
+				if ( !views[view] ) {
+					continue;
+				}
+				int type = PROF_VIEW_2D + views[view]->GetViewType();
+				views[view]->SetOrigin( camera->origin );
+				drawn = s_nFrames[type];
+				static_cast<GLWindow*>( views[view] )->OnExpose();
+				if ( Profiler_WriteRow( f, step, type, drawn, sum, worst ) ) {
+					counts[type]++;
+				}
+			}
+		}
+	}
+
+	s_bBenchmarking = false;
+	fclose( f );
+
+	for ( view = 0; view < PROF_NUMVIEWS; view++ )
+	{
+		if ( counts[view] ) {
+			Sys_Printf( "  %-6s %5d frames  avg %7.2f ms  worst %7.2f ms\n", s_viewNames[view], counts[view],
+						1000 * sum[view] / counts[view], 1000 * worst[view] );
+		}
+	}
+	Sys_Printf( "Benchmark results written to %s\n", s_pBenchCSV );
+	return true;
+}
+
+static gint Profiler_BenchmarkTimeout( gpointer data ){
+	if ( !Profiler_RunBenchmark() ) {
+		s_nBenchExitCode = 1;
+	}
+	gtk_main_quit();
+	return FALSE;
+}
+
+// called right before gtk_main, the views have to be mapped before anything is drawn
+void Profiler_StartBenchmark(){
+	if ( s_pBenchScript ) {
+		g_timeout_add( 1000, Profiler_BenchmarkTimeout, NULL );
+	}
+}
+
+// nonzero when a benchmark run failed, so scripted runs can tell from the exit status
+int Profiler_ExitCode(){
+	return s_nBenchExitCode;
+}
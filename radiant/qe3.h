@@ -353,6 +353,23 @@ qboolean QE_SingleBrush( bool bQuiet = false );
 // sys stuff
 void Sys_MarkMapModified( void );
 
+// profiler.cpp
+// per frame timings of the camera and the 2D views, see profiler.cpp
+enum { PROF_CULL, PROF_BRUSHES, PROF_MODELS, PROF_PATCHLOD, PROF_TEXT, PROF_NUMSECTIONS };
+// the 2D views are PROF_VIEW_2D + their VIEWTYPE
+enum { PROF_VIEW_CAMERA, PROF_VIEW_2D, PROF_NUMVIEWS = PROF_VIEW_2D + 3 };
+extern bool g_bProfilerOverlay;
+bool Profiler_Active();
+void Profiler_BeginFrame( int view );
+void Profiler_EndFrame( int view );
+void Profiler_Push( int section );
+void Profiler_Pop();
+void Profiler_CountModel( int lod, int fullTris, int drawnTris );
+void Profiler_DrawOverlay( int view, int width, int height );
+void Profiler_SetBenchmark( const char *script, const char *csv );
+void Profiler_StartBenchmark();
+int Profiler_ExitCode();
+
 #if 0 // no longer used
 
 // QE Win32 function declarations
@@ -478,6 +495,7 @@ extern vec3_t g_vBendOrigin;
 const char* Patch_GetKeyValue( patchMesh_t *p, const char *pKey );
 void Patch_SetEpair( patchMesh_t *p, const char *pKey, const char *pValue );
 void Patch_LODMatchAll();
+extern bool g_bPatchLODPending;
 void Patch_CalcBounds( patchMesh_t *p, vec3_t& vMin, vec3_t& vMax );
 
 
@@ -636,6 +654,11 @@ void WINAPI QERApp_HookGL3DWindow( IGL3DWindow* pGLW );
 void WINAPI QERApp_UnHookGL3DWindow( IGL3DWindow* pGLW );
 void Draw2DPluginEntities( VIEWTYPE vt );
 void Draw3DPluginEntities();
+bool WINAPI QERApp_HasBufferObjects();
+void WINAPI QERApp_BindBufferARB( GLenum target, GLuint buffer );
+void WINAPI QERApp_DeleteBuffersARB( GLsizei n, const GLuint *buffers );
+void WINAPI QERApp_GenBuffersARB( GLsizei n, GLuint *buffers );
+void WINAPI QERApp_BufferDataARB( GLenum target, ptrdiff_t size, const GLvoid *data, GLenum usage );
 
 //
 // IShaders interface
@@ -688,6 +711,9 @@ extern qboolean g_bShowAllShaders;
 
 extern CPtrArray g_lstSkinCache;
 qtexture_t *QERApp_LoadTextureRGBA( unsigned char* pPixels, int nWidth, int nHeight );
+qtexture_t *QERApp_LoadTexture( const char *name );
+void Texture_DrainUploads();
+void Texture_FlushUploads();
 
 // This needs to be visible globally so the texture window can be correctly redrawn
 void checkTextureWindowBoundaries();
@@ -489,6 +489,12 @@ void ( APIENTRY * qglMultiTexCoord4ivARB )( GLenum target, const GLint *v );
 void ( APIENTRY * qglMultiTexCoord4sARB )( GLenum target, GLshort s );
 void ( APIENTRY * qglMultiTexCoord4svARB )( GLenum target, const GLshort *v );
 
+void ( APIENTRY * qglBindBufferARB )( GLenum target, GLuint buffer );
+void ( APIENTRY * qglDeleteBuffersARB )( GLsizei n, const GLuint *buffers );
+void ( APIENTRY * qglGenBuffersARB )( GLsizei n, GLuint *buffers );
+void ( APIENTRY * qglBufferDataARB )( GLenum target, ptrdiff_t size, const GLvoid *data, GLenum usage );
+void ( APIENTRY * qglBufferSubDataARB )( GLenum target, ptrdiff_t offset, ptrdiff_t size, const GLvoid *data );
+
 // glu stuff
 void ( APIENTRY * qgluPerspective )( GLdouble fovy, GLdouble aspect, GLdouble zNear, GLdouble zFar );
 
@@ -905,6 +911,11 @@ void QGL_Shutdown(){
 	qglMultiTexCoord4ivARB = NULL;
 	qglMultiTexCoord4sARB = NULL;
 	qglMultiTexCoord4svARB = NULL;
+	qglBindBufferARB = NULL;
+	qglDeleteBuffersARB = NULL;
+	qglGenBuffersARB = NULL;
+	qglBufferDataARB = NULL;
+	qglBufferSubDataARB = NULL;
 
 #ifdef _WIN32
 	qwglCopyContext              = NULL;
@@ -1590,6 +1601,11 @@ int QGL_Init( const char *dllname, const char* gluname ){
 	qglMultiTexCoord4ivARB = NULL;
 	qglMultiTexCoord4sARB = NULL;
 	qglMultiTexCoord4svARB = NULL;
+	qglBindBufferARB = NULL;
+	qglDeleteBuffersARB = NULL;
+	qglGenBuffersARB = NULL;
+	qglBufferDataARB = NULL;
+	qglBufferSubDataARB = NULL;
 
 #ifdef _WIN32
 	qwglCopyContext              = safe_dlsym( g_hGLDLL, "wglCopyContext" );
@@ -1753,4 +1769,12 @@ void QGL_InitExtensions(){
 		qglMultiTexCoord4sARB = Sys_GLGetExtension( "glMultiTexCoord4sARB" );
 		qglMultiTexCoord4svARB = Sys_GLGetExtension( "glMultiTexCoord4svARB" );
 	}
+
+	if ( GL_ExtensionSupported( "GL_ARB_vertex_buffer_object" ) ) {
+		qglBindBufferARB = Sys_GLGetExtension( "glBindBufferARB" );
+		qglDeleteBuffersARB = Sys_GLGetExtension( "glDeleteBuffersARB" );
+		qglGenBuffersARB = Sys_GLGetExtension( "glGenBuffersARB" );
+		qglBufferDataARB = Sys_GLGetExtension( "glBufferDataARB" );
+		qglBufferSubDataARB = Sys_GLGetExtension( "glBufferSubDataARB" );
+	}
 }
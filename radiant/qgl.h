@@ -28,6 +28,7 @@
 
 #define ATIHACK_812
 
+#include <stddef.h>
 #include <GL/gl.h>
 
 #if defined( __linux__ ) || defined( __FreeBSD__ ) || defined( __APPLE__ )
@@ -76,6 +77,12 @@
 #define GL_MAX_TEXTURE_UNITS_ARB          0x84E2
 #endif
 
+#ifndef GL_ARB_vertex_buffer_object
+#define GL_ARRAY_BUFFER_ARB               0x8892
+#define GL_STATIC_DRAW_ARB                0x88E4
+#define GL_DYNAMIC_DRAW_ARB               0x88E8
+#endif
+
 #ifndef GL_VERSION_1_3
 // this is hacky, I'd recommend people having GL 1.3 headers instead
 #define GL_COMPRESSED_RGBA 0x84EE
@@ -481,6 +488,13 @@ extern void ( APIENTRY * qglMultiTexCoord4ivARB )( GLenum target, const GLint *v
 extern void ( APIENTRY * qglMultiTexCoord4sARB )( GLenum target, GLshort s );
 extern void ( APIENTRY * qglMultiTexCoord4svARB )( GLenum target, const GLshort *v );
 
+// GL_ARB_vertex_buffer_object, NULL when not supported
+extern void ( APIENTRY * qglBindBufferARB )( GLenum target, GLuint buffer );
+extern void ( APIENTRY * qglDeleteBuffersARB )( GLsizei n, const GLuint *buffers );
+extern void ( APIENTRY * qglGenBuffersARB )( GLsizei n, GLuint *buffers );
+extern void ( APIENTRY * qglBufferDataARB )( GLenum target, ptrdiff_t size, const GLvoid *data, GLenum usage );
+extern void ( APIENTRY * qglBufferSubDataARB )( GLenum target, ptrdiff_t offset, ptrdiff_t size, const GLvoid *data );
+
 
 
 #ifdef _WIN32
@@ -47,6 +47,9 @@ trace_t Test_Ray( vec3_t origin, vec3_t dir, int flags ){
 	memset( &t, 0, sizeof( t ) );
 	t.dist = DIST_START;
 
+	// only brushes whose bounds the ray crosses can be hit
+	BrushIndex_MarkRay( origin, dir );
+
 	if ( flags & SF_CYCLE ) {
         CPtrArray array;
 		brush_t *pToSelect = ( selected_brushes.next != &selected_brushes ) ? selected_brushes.next : NULL;
@@ -58,7 +61,7 @@ trace_t Test_Ray( vec3_t origin, vec3_t dir, int flags ){
 			//if ( (flags & SF_ENTITIES_FIRST) && brush->owner == world_entity)
 			//  continue;
 
-			if ( brush->bFiltered ) {
+			if ( brush->bFiltered || !BrushIndex_IsMarked( brush ) ) {
 				continue;
 			}
 
@@ -113,7 +116,7 @@ trace_t Test_Ray( vec3_t origin, vec3_t dir, int flags ){
 				continue;
 			}
 
-			if ( brush->bFiltered ) {
+			if ( brush->bFiltered || !BrushIndex_IsMarked( brush ) ) {
 				continue;
 			}
 
@@ -147,7 +150,7 @@ trace_t Test_Ray( vec3_t origin, vec3_t dir, int flags ){
 			continue;
 		}
 
-		if ( brush->bFiltered ) {
+		if ( brush->bFiltered || !BrushIndex_IsMarked( brush ) ) {
 			continue;
 		}
 
@@ -464,6 +467,8 @@ void Select_Deselect( bool bDeselectFaces ){
 
 	UpdateWorkzone_ForBrush( b );
 
+	for ( b = selected_brushes.next; b != &selected_brushes; b = b->next )
+		b->list = &active_brushes;
 	selected_brushes.next->prev = &active_brushes;
 	selected_brushes.prev->next = active_brushes.next;
 	active_brushes.next->prev = selected_brushes.prev;
@@ -1296,6 +1301,13 @@ void Select_RealCompleteTall( vec3_t mins, vec3_t maxs ){
 
 	g_qeglobals.d_select_mode = sel_brush;
 
+	vec3_t boxMins, boxMaxs;
+	VectorCopy( mins, boxMins );
+	VectorCopy( maxs, boxMaxs );
+	boxMins[3 - nDim1 - nDim2] = g_MinWorldCoord;
+	boxMaxs[3 - nDim1 - nDim2] = g_MaxWorldCoord;
+	BrushIndex_MarkBox( boxMins, boxMaxs );
+
 	for ( b = active_brushes.next ; b != &active_brushes ; b = next )
 	{
 		next = b->next;
@@ -1304,6 +1316,10 @@ void Select_RealCompleteTall( vec3_t mins, vec3_t maxs ){
 			continue;
 		}
 
+		if ( !BrushIndex_IsMarked( b ) ) {
+			continue;
+		}
+
 		if ( ( b->maxs[nDim1] > maxs[nDim1] || b->mins[nDim1] < mins[nDim1] )
 			 || ( b->maxs[nDim2] > maxs[nDim2] || b->mins[nDim2] < mins[nDim2] ) ) {
 			continue;
@@ -1354,6 +1370,13 @@ void Select_PartialTall( void ){
 	int nDim1 = ( g_pParentWnd->ActiveXY()->GetViewType() == YZ ) ? 1 : 0;
 	int nDim2 = ( g_pParentWnd->ActiveXY()->GetViewType() == XY ) ? 1 : 2;
 
+	vec3_t boxMins, boxMaxs;
+	VectorCopy( mins, boxMins );
+	VectorCopy( maxs, boxMaxs );
+	boxMins[3 - nDim1 - nDim2] = g_MinWorldCoord;
+	boxMaxs[3 - nDim1 - nDim2] = g_MaxWorldCoord;
+	BrushIndex_MarkBox( boxMins, boxMaxs );
+
 	for ( b = active_brushes.next ; b != &active_brushes ; b = next )
 	{
 		next = b->next;
@@ -1362,6 +1385,10 @@ void Select_PartialTall( void ){
 			continue;
 		}
 
+		if ( !BrushIndex_IsMarked( b ) ) {
+			continue;
+		}
+
 		if ( ( b->mins[nDim1] > maxs[nDim1] || b->maxs[nDim1] < mins[nDim1] )
 			 || ( b->mins[nDim2] > maxs[nDim2] || b->maxs[nDim2] < mins[nDim2] ) ) {
 			continue;
@@ -1389,6 +1416,14 @@ void Select_Touching( void ){
 	VectorCopy( selected_brushes.next->mins, mins );
 	VectorCopy( selected_brushes.next->maxs, maxs );
 
+	vec3_t boxMins, boxMaxs;
+	for ( i = 0 ; i < 3 ; i++ )
+	{
+		boxMins[i] = mins[i] - 1;
+		boxMaxs[i] = maxs[i] + 1;
+	}
+	BrushIndex_MarkBox( boxMins, boxMaxs );
+
 	for ( b = active_brushes.next ; b != &active_brushes ; b = next )
 	{
 		next = b->next;
@@ -1397,6 +1432,10 @@ void Select_Touching( void ){
 			continue;
 		}
 
+		if ( !BrushIndex_IsMarked( b ) ) {
+			continue;
+		}
+
 		for ( i = 0 ; i < 3 ; i++ )
 			if ( b->mins[i] > maxs[i] + 1 || b->maxs[i] < mins[i] - 1 ) {
 				break;
@@ -1430,6 +1469,8 @@ void Select_Inside( void ){
 	VectorCopy( selected_brushes.next->maxs, maxs );
 	Select_Delete();
 
+	BrushIndex_MarkBox( mins, maxs );
+
 	for ( b = active_brushes.next ; b != &active_brushes ; b = next )
 	{
 		next = b->next;
@@ -1438,6 +1479,10 @@ void Select_Inside( void ){
 			continue;
 		}
 
+		if ( !BrushIndex_IsMarked( b ) ) {
+			continue;
+		}
+
 		for ( i = 0 ; i < 3 ; i++ )
 			if ( b->maxs[i] > maxs[i] || b->mins[i] < mins[i] ) {
 				break;
@@ -2144,6 +2189,8 @@ void Select_Invert( void ){
 		selected_brushes.next = &selected_brushes;
 		selected_brushes.prev = &selected_brushes;
 	}
+	Brush_SetList( &active_brushes );
+	Brush_SetList( &selected_brushes );
 
 	// now check if any hidden brush is selected
 	for ( b = selected_brushes.next; b != &selected_brushes; )
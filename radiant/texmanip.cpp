@@ -32,9 +32,6 @@
 #include "stdafx.h"
 #include "str.h"
 
-static byte *row1 = NULL, *row2 = NULL;
-static int rowsize = 0;
-
 void R_ResampleTextureLerpLine( byte *in, byte *out, int inwidth, int outwidth, int bytesperpixel ){
 	int j, xi, oldx = 0, f, fstep, endx, lerp;
 #define LERPBYTE( i ) out[i] = (byte) ( ( ( ( row2[i] - row1[i] ) * lerp ) >> 16 ) + row1[i] )
@@ -100,18 +97,9 @@ void R_ResampleTextureLerpLine( byte *in, byte *out, int inwidth, int outwidth,
    ================
  */
 void R_ResampleTexture( void *indata, int inwidth, int inheight, void *outdata,  int outwidth, int outheight, int bytesperpixel ){
-	if ( rowsize < outwidth * bytesperpixel ) {
-		if ( row1 ) {
-			free( row1 );
-		}
-		if ( row2 ) {
-			free( row2 );
-		}
-
-		rowsize = outwidth * bytesperpixel;
-		row1 = (byte *)malloc( rowsize );
-		row2 = (byte *)malloc( rowsize );
-	}
+	// the row buffers are per call so textures can be resampled on the loader threads
+	byte *row1 = (byte *)malloc( outwidth * bytesperpixel );
+	byte *row2 = (byte *)malloc( outwidth * bytesperpixel );
 
 	if ( bytesperpixel == 4 ) {
 		int i, j, yi, oldy, f, fstep, lerp, endy = ( inheight - 1 ), inwidth4 = inwidth * 4, outwidth4 = outwidth * 4;
@@ -298,6 +286,9 @@ void R_ResampleTexture( void *indata, int inwidth, int inheight, void *outdata,
 	else{
 		Sys_Printf( "R_ResampleTexture: unsupported bytesperpixel %i\n", bytesperpixel );
 	}
+
+	free( row1 );
+	free( row2 );
 }
 
 // in can be the same as out
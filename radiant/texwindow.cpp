@@ -34,15 +34,22 @@
 
 #if defined( __linux__ ) || defined( __FreeBSD__ ) || defined( __APPLE__ )
 #include <dirent.h>
+#include <unistd.h>
+#endif
+#ifdef _WIN32
+#include <io.h>
 #endif
 #include <gtk/gtk.h>
 #include <assert.h>
 #include <sys/stat.h>
+#include <glib/gstdio.h>
 #include "stdafx.h"
 #include "texwindow.h"
 #include "str.h"
 #include "missing.h"
 #include "texmanip.h"
+#include <vector>
+#include <algorithm>
 
 #define TYP_MIPTEX  68
 
@@ -322,31 +329,104 @@ void ResampleGamma( float fGamma ){
 }
 
 /*!
-   this function does the actual processing of raw RGBA data into a GL texture
-   it will also generate the mipmaps
-   it looks like pPixels nWidth nHeight are the only relevant parameters
+   background texture loading
+   QERApp_LoadTextureRGBA hands the gamma correction, power-of-two resampling and the mip chain
+   to a pool of worker threads, the qtexture_t gets a 1x1 placeholder until the levels are ready
+   the GL uploads are done on the main thread by Texture_DrainUploads, a few milliseconds per idle tick
+   NOTE: the image itself is still decoded by the caller, the image plugins and the VFS are not reentrant
  */
-qtexture_t *QERApp_LoadTextureRGBA( unsigned char* pPixels, int nWidth, int nHeight ){
-	static float fGamma = -1;
-	float total[3];
-	byte  *outpixels = NULL;
-	int i, j, resampled, width2, height2, width3, height3;
-	int max_tex_size = 0, mip = 0;
-	int nCount = nWidth * nHeight;
+#define MAX_TEXTURE_MIPS    16
+#define TEXTURE_UPLOAD_TIME 0.008
 
-	if ( fGamma != g_qeglobals.d_savedinfo.fGamma ) {
-		fGamma = g_qeglobals.d_savedinfo.fGamma;
-		ResampleGamma( fGamma );
-	}
+typedef struct
+{
+	qtexture_t  *q;
+	byte        *pixels;        // source RGBA, owned by the job
+	int width, height;
+	int max_tex_size;
+	float gamma;
+	byte gammatable[256];
+	char        *cacheFile;     // written by the loader thread once the mips are built, NULL if not caching
+	char cacheName[128];        // vfs path of the image, stored in the cache header
+	int quality;
+
+	// filled in by Texture_BuildMips
+	byte        *mips;
+	int numMips;
+	int mipWidth[MAX_TEXTURE_MIPS], mipHeight[MAX_TEXTURE_MIPS];
+	int mipOffset[MAX_TEXTURE_MIPS];
+	vec3_t color;
+} textureJob_t;
+
+static GThreadPool *s_pTexturePool = NULL;
+static GAsyncQueue *s_pTextureDone = NULL;
+static int s_nTexturesPending = 0;
 
-	qglGetIntegerv( GL_MAX_TEXTURE_SIZE, &max_tex_size );
-	if ( !max_tex_size ) {
-		max_tex_size = 1024;
+/*!
+   on-disk texture cache
+   <prefs dir>/texcache/<key>.tex holds the finished mip chain of an image, gamma corrected and resampled
+   the key hashes the vfs path with the size and time of a loose image file, or with the contents of one in a pak,
+   so edited or replaced images miss
+   the path is stored in the header as well and doubles as a collision check
+   the header records the settings the mips were built with, a gamma or texture quality change misses too
+   hits touch their file, and the least recently used entries are dropped once the cache outgrows TEXCACHE_MAX_SIZE
+ */
+#define TEXCACHE_IDENT      ( ( 'H' << 24 ) + ( 'C' << 16 ) + ( 'X' << 8 ) + 'T' )
+#define TEXCACHE_VERSION    1
+#define TEXCACHE_MAX_SIZE   ( 512 << 20 )
+
+typedef struct
+{
+	int ident;
+	int version;
+	char name[128];
+	int width, height;
+	float gamma;
+	int quality;
+	int max_tex_size;
+	float color[3];
+	int numMips;
+	int mipWidth[MAX_TEXTURE_MIPS], mipHeight[MAX_TEXTURE_MIPS];
+} textureCacheHeader_t;
+
+/*!
+   lay the levels out back to back, starting from a width x height base level
+   \return the size of the whole chain in bytes
+ */
+static int Texture_SetMipLayout( textureJob_t *job, int width, int height ){
+	int size = 0;
+
+	job->numMips = 0;
+	for ( ;; )
+	{
+		job->mipWidth[job->numMips] = width;
+		job->mipHeight[job->numMips] = height;
+		job->mipOffset[job->numMips] = size;
+		job->numMips++;
+		size += width * height * 4;
+		if ( ( width == 1 && height == 1 ) || job->numMips == MAX_TEXTURE_MIPS ) {
+			break;
+		}
+		if ( width > 1 ) {
+			width >>= 1;
+		}
+		if ( height > 1 ) {
+			height >>= 1;
+		}
 	}
 
-	qtexture_t *q = (qtexture_t*)g_malloc( sizeof( *q ) );
-	q->width = nWidth;
-	q->height = nHeight;
+	return size;
+}
+
+/*!
+   gamma correct the source pixels and build the complete mip chain in one block
+   runs on the worker threads, must not touch GL or anything global
+ */
+static void Texture_BuildMips( textureJob_t *job ){
+	float total[3];
+	byte *outpixels;
+	int i, j, width2, height2, width3, height3;
+	int nCount = job->width * job->height;
 
 	total[0] = total[1] = total[2] = 0.0f;
 
@@ -355,29 +435,23 @@ qtexture_t *QERApp_LoadTextureRGBA( unsigned char* pPixels, int nWidth, int nHei
 	{
 		for ( j = 0; j < 3; j++ )
 		{
-			total[j] += ( pPixels + i )[j];
-			byte b = ( pPixels + i )[j];
-			( pPixels + i )[j] = g_gammatable[b];
+			total[j] += ( job->pixels + i )[j];
+			byte b = ( job->pixels + i )[j];
+			( job->pixels + i )[j] = job->gammatable[b];
 		}
 	}
 
-	q->color[0] = total[0] / ( nCount * 255 );
-	q->color[1] = total[1] / ( nCount * 255 );
-	q->color[2] = total[2] / ( nCount * 255 );
-
-	qglGenTextures( 1, &q->texture_number );
-
-	qglBindTexture( GL_TEXTURE_2D, q->texture_number );
-
-	SetTexParameters();
+	job->color[0] = total[0] / ( nCount * 255 );
+	job->color[1] = total[1] / ( nCount * 255 );
+	job->color[2] = total[2] / ( nCount * 255 );
 
-	width2 = 1; while ( width2 < nWidth ) width2 <<= 1;
-	height2 = 1; while ( height2 < nHeight ) height2 <<= 1;
+	width2 = 1; while ( width2 < job->width ) width2 <<= 1;
+	height2 = 1; while ( height2 < job->height ) height2 <<= 1;
 
 	width3 = width2;
 	height3 = height2;
-	while ( width3 > max_tex_size ) width3 >>= 1;
-	while ( height3 > max_tex_size ) height3 >>= 1;
+	while ( width3 > job->max_tex_size ) width3 >>= 1;
+	while ( height3 > job->max_tex_size ) height3 >>= 1;
 	if ( width3 < 1 ) {
 		width3 = 1;
 	}
@@ -385,14 +459,14 @@ qtexture_t *QERApp_LoadTextureRGBA( unsigned char* pPixels, int nWidth, int nHei
 		height3 = 1;
 	}
 
-	if ( !( width2 == nWidth && height2 == nHeight ) ) {
-		resampled = 1;
+	if ( !( width2 == job->width && height2 == job->height ) ) {
 		outpixels = (byte *)malloc( width2 * height2 * 4 );
-		R_ResampleTexture( pPixels, nWidth, nHeight, outpixels, width2, height2, 4 );
+		R_ResampleTexture( job->pixels, job->width, job->height, outpixels, width2, height2, 4 );
+		free( job->pixels );
+		job->pixels = outpixels;
 	}
 	else {
-		resampled = 0;
-		outpixels = pPixels;
+		outpixels = job->pixels;
 	}
 
 	while ( width2 > width3 || height2 > height3 )
@@ -407,29 +481,554 @@ qtexture_t *QERApp_LoadTextureRGBA( unsigned char* pPixels, int nWidth, int nHei
 		}
 	}
 
-	qglTexImage2D( GL_TEXTURE_2D, mip++, g_qeglobals.texture_components, width2, height2, 0, GL_RGBA, GL_UNSIGNED_BYTE, outpixels );
-	while ( width2 > 1 || height2 > 1 )
+	job->mips = (byte *)malloc( Texture_SetMipLayout( job, width2, height2 ) );
+	memcpy( job->mips, outpixels, width2 * height2 * 4 );
+	for ( i = 1; i < job->numMips; i++ )
 	{
-		GL_MipReduce( outpixels, outpixels, width2, height2, 1, 1 );
+		GL_MipReduce( job->mips + job->mipOffset[i - 1], job->mips + job->mipOffset[i],
+					  job->mipWidth[i - 1], job->mipHeight[i - 1], 1, 1 );
+	}
 
-		if ( width2 > 1 ) {
-			width2 >>= 1;
+	free( job->pixels );
+	job->pixels = NULL;
+}
+
+/*!
+   save the mip chain of a finished job, runs on the worker threads
+   the file is written under a unique temporary name and renamed, so a partial file is never picked up
+   and two writers of the same entry don't share one
+ */
+static void Texture_WriteCache( textureJob_t *job ){
+	textureCacheHeader_t header;
+	char *tmpFile;
+	FILE *f;
+	int i, fd;
+	bool ok;
+
+	memset( &header, 0, sizeof( header ) );
+	header.ident = TEXCACHE_IDENT;
+	header.version = TEXCACHE_VERSION;
+	strncpy( header.name, job->cacheName, sizeof( header.name ) - 1 );
+	header.width = job->width;
+	header.height = job->height;
+	header.gamma = job->gamma;
+	header.quality = job->quality;
+	header.max_tex_size = job->max_tex_size;
+	VectorCopy( job->color, header.color );
+	header.numMips = job->numMips;
+	for ( i = 0; i < job->numMips; i++ )
+	{
+		header.mipWidth[i] = job->mipWidth[i];
+		header.mipHeight[i] = job->mipHeight[i];
+	}
+
+	tmpFile = g_strdup_printf( "%s.XXXXXX", job->cacheFile );
+	fd = g_mkstemp( tmpFile );
+	if ( fd == -1 ) {
+		g_free( tmpFile );
+		return;
+	}
+	f = fdopen( fd, "wb" );
+	if ( !f ) {
+		close( fd );
+		remove( tmpFile );
+		g_free( tmpFile );
+		return;
+	}
+	ok = fwrite( &header, sizeof( header ), 1, f ) == 1;
+	ok = ok && fwrite( job->mips, job->mipOffset[job->numMips - 1] + job->mipWidth[job->numMips - 1] * job->mipHeight[job->numMips - 1] * 4, 1, f ) == 1;
+	ok = ( fclose( f ) == 0 ) && ok;
+
+	remove( job->cacheFile );
+	if ( !ok || rename( tmpFile, job->cacheFile ) != 0 ) {
+		remove( tmpFile );
+	}
+	g_free( tmpFile );
+}
+
+/*!
+   fill a job from the cache file
+   \return false if there is no usable entry for it
+ */
+static bool Texture_ReadCache( textureJob_t *job ){
+	textureCacheHeader_t header;
+	FILE *f;
+	int i, size;
+	long len;
+	bool ok;
+
+	f = fopen( job->cacheFile, "rb" );
+	if ( !f ) {
+		return false;
+	}
+	fseek( f, 0, SEEK_END );
+	len = ftell( f );
+	fseek( f, 0, SEEK_SET );
+
+	if ( fread( &header, sizeof( header ), 1, f ) != 1
+		 || header.ident != TEXCACHE_IDENT || header.version != TEXCACHE_VERSION
+		 || header.gamma != job->gamma || header.quality != job->quality
+		 || header.max_tex_size != job->max_tex_size
+		 || header.numMips < 1 || header.numMips > MAX_TEXTURE_MIPS
+		 || header.mipWidth[0] < 1 || header.mipWidth[0] > job->max_tex_size
+		 || header.mipHeight[0] < 1 || header.mipHeight[0] > job->max_tex_size
+		 || strncmp( header.name, job->cacheName, sizeof( header.name ) - 1 ) ) {
+		fclose( f );
+		return false;
+	}
+
+	// the mips have to be all that follows the header, a damaged file can't ask for more memory than it holds
+	size = Texture_SetMipLayout( job, header.mipWidth[0], header.mipHeight[0] );
+	if ( len != (long)sizeof( header ) + size ) {
+		fclose( f );
+		return false;
+	}
+	for ( i = 0; i < job->numMips; i++ )
+	{
+		if ( i >= header.numMips || header.mipWidth[i] != job->mipWidth[i] || header.mipHeight[i] != job->mipHeight[i] ) {
+			fclose( f );
+			return false;
 		}
-		if ( height2 > 1 ) {
-			height2 >>= 1;
+	}
+
+	job->mips = (byte *)malloc( size );
+	ok = fread( job->mips, size, 1, f ) == 1;
+	fclose( f );
+	if ( !ok ) {
+		free( job->mips );
+		job->mips = NULL;
+		return false;
+	}
+
+	job->width = header.width;
+	job->height = header.height;
+	VectorCopy( header.color, job->color );
+
+	// mark it as recently used for Texture_PruneCache
+	g_utime( job->cacheFile, NULL );
+	return true;
+}
+
+typedef struct
+{
+	time_t time;
+	long long size;
+	char *file;
+} texCacheEntry_t;
+
+static bool Texture_CacheEntryOlder( const texCacheEntry_t &a, const texCacheEntry_t &b ){
+	return a.time < b.time;
+}
+
+/*!
+   drop the least recently used entries until the cache is back under three quarters of TEXCACHE_MAX_SIZE
+   temporary files an interrupted writer left behind go as well
+ */
+static void Texture_PruneCache( const char *path ){
+	std::vector<texCacheEntry_t> entries;
+	texCacheEntry_t entry;
+	struct stat st;
+	const gchar *name;
+	long long total = 0;
+	size_t i;
+	GDir *dir;
+
+	dir = g_dir_open( path, 0, NULL );
+	if ( !dir ) {
+		return;
+	}
+	while ( ( name = g_dir_read_name( dir ) ) != NULL )
+	{
+		entry.file = g_strdup_printf( "%s/%s", path, name );
+		if ( stat( entry.file, &st ) != 0 ) {
+			g_free( entry.file );
+			continue;
+		}
+		i = strlen( name );
+		if ( i < 4 || strcmp( name + i - 4, ".tex" ) ) {
+			// an hour is long enough for a writer that is still going
+			if ( time( NULL ) - st.st_mtime > 3600 ) {
+				remove( entry.file );
+			}
+			g_free( entry.file );
+			continue;
+		}
+		entry.time = st.st_mtime;
+		entry.size = st.st_size;
+		entries.push_back( entry );
+		total += entry.size;
+	}
+	g_dir_close( dir );
+
+	if ( total > TEXCACHE_MAX_SIZE ) {
+		std::sort( entries.begin(), entries.end(), Texture_CacheEntryOlder );
+		for ( i = 0; i < entries.size() && total > TEXCACHE_MAX_SIZE / 4 * 3; i++ )
+		{
+			if ( remove( entries[i].file ) == 0 ) {
+				total -= entries[i].size;
+			}
+		}
+		Sys_Printf( "Texture cache: dropped %d old entries\n", (int)i );
+	}
+
+	for ( i = 0; i < entries.size(); i++ )
+		g_free( entries[i].file );
+}
+
+static void Texture_LoaderThread( gpointer data, gpointer user_data ){
+	textureJob_t *job = (textureJob_t *)data;
+
+	Texture_BuildMips( job );
+	if ( job->cacheFile ) {
+		Texture_WriteCache( job );
+	}
+	g_async_queue_push( s_pTextureDone, job );
+}
+
+/*!
+   upload a finished job into its qtexture_t, main thread only
+ */
+static void Texture_UploadJob( textureJob_t *job ){
+	int i;
+
+	VectorCopy( job->color, job->q->color );
+
+	qglBindTexture( GL_TEXTURE_2D, job->q->texture_number );
+	SetTexParameters();
+	for ( i = 0; i < job->numMips; i++ )
+	{
+		qglTexImage2D( GL_TEXTURE_2D, i, g_qeglobals.texture_components, job->mipWidth[i], job->mipHeight[i], 0, GL_RGBA, GL_UNSIGNED_BYTE, job->mips + job->mipOffset[i] );
+	}
+	qglBindTexture( GL_TEXTURE_2D, 0 );
+
+	free( job->mips );
+	g_free( job->cacheFile );
+	delete job;
+}
+
+static bool Texture_StartLoaderThreads(){
+	int nThreads;
+
+	if ( s_pTexturePool ) {
+		return true;
+	}
+
+#if GLIB_CHECK_VERSION( 2, 36, 0 )
+	nThreads = g_get_num_processors() - 1;
+#else
+	nThreads = 2;
+#endif
+	if ( nThreads < 1 ) {
+		nThreads = 1;
+	}
+
+	s_pTextureDone = g_async_queue_new();
+	s_pTexturePool = g_thread_pool_new( Texture_LoaderThread, NULL, nThreads, FALSE, NULL );
+	if ( !s_pTexturePool ) {
+		Sys_Printf( "WARNING: failed to start the texture loader threads, loading synchronously\n" );
+		g_async_queue_unref( s_pTextureDone );
+		s_pTextureDone = NULL;
+		return false;
+	}
+
+	Sys_Printf( "Texture loader: %d threads\n", nThreads );
+	return true;
+}
+
+/*!
+   faces baked the placeholder grey into d_color, give them the color of the uploaded textures
+ */
+static void Texture_RefreshFaceColors( std::vector<qtexture_t*> &uploaded ){
+	brush_t *b, *list;
+	face_t *f;
+	int i;
+
+	if ( uploaded.empty() ) {
+		return;
+	}
+	std::sort( uploaded.begin(), uploaded.end() );
+
+	for ( i = 0; i < 2; i++ )
+	{
+		list = i ? &selected_brushes : &active_brushes;
+		for ( b = list->next; b != NULL && b != list; b = b->next )
+		{
+			if ( b->patchBrush ) {
+				continue;
+			}
+			for ( f = b->brush_faces; f; f = f->next )
+			{
+				if ( f->pShader && std::binary_search( uploaded.begin(), uploaded.end(), f->pShader->getTexture() ) ) {
+					Face_SetColor( b, f, 1.0 );
+				}
+			}
+		}
+	}
+	uploaded.clear();
+}
+
+/*!
+   upload the textures the loader threads have finished with, stops after TEXTURE_UPLOAD_TIME
+   called from MainFrame::RoutineProcessing
+ */
+void Texture_DrainUploads(){
+	std::vector<qtexture_t*> uploaded;
+	textureJob_t *job;
+	double start;
+	int nUploaded = 0;
+
+	if ( !s_nTexturesPending ) {
+		return;
+	}
+
+	start = Sys_DoubleTime();
+	while ( s_nTexturesPending && ( job = (textureJob_t *)g_async_queue_try_pop( s_pTextureDone ) ) != NULL )
+	{
+		if ( !nUploaded ) {
+			gtk_glwidget_make_current( g_qeglobals_gui.d_glBase );
+		}
+		uploaded.push_back( job->q );
+		Texture_UploadJob( job );
+		s_nTexturesPending--;
+		nUploaded++;
+
+		if ( Sys_DoubleTime() - start > TEXTURE_UPLOAD_TIME ) {
+			break;
 		}
+	}
+
+	if ( nUploaded ) {
+		Texture_RefreshFaceColors( uploaded );
+		Sys_UpdateWindows( W_TEXTURE | W_CAMERA );
+	}
+}
+
+/*!
+   wait for every queued texture and upload it
+   must be called before the qtexture_t list is freed (shader reload, sleep, shutdown)
+ */
+void Texture_FlushUploads(){
+	std::vector<qtexture_t*> uploaded;
+	textureJob_t *job;
+
+	if ( !s_nTexturesPending ) {
+		return;
+	}
+
+	gtk_glwidget_make_current( g_qeglobals_gui.d_glBase );
+	while ( s_nTexturesPending )
+	{
+		job = (textureJob_t *)g_async_queue_pop( s_pTextureDone );
+		uploaded.push_back( job->q );
+		Texture_UploadJob( job );
+		s_nTexturesPending--;
+	}
+	Texture_RefreshFaceColors( uploaded );
+}
 
-		qglTexImage2D( GL_TEXTURE_2D, mip++, g_qeglobals.texture_components, width2, height2, 0, GL_RGBA, GL_UNSIGNED_BYTE, outpixels );
+/*!
+   allocate the qtexture_t and its GL texture, and a job carrying the current gamma settings
+ */
+static textureJob_t *Texture_NewJob( int nWidth, int nHeight ){
+	static float fGamma = -1;
+	static int max_tex_size = 0;
+
+	if ( fGamma != g_qeglobals.d_savedinfo.fGamma ) {
+		fGamma = g_qeglobals.d_savedinfo.fGamma;
+		ResampleGamma( fGamma );
+	}
+
+	if ( !max_tex_size ) {
+		qglGetIntegerv( GL_MAX_TEXTURE_SIZE, &max_tex_size );
+		if ( !max_tex_size ) {
+			max_tex_size = 1024;
+		}
 	}
 
+	qtexture_t *q = (qtexture_t*)g_malloc( sizeof( *q ) );
+	q->width = nWidth;
+	q->height = nHeight;
+
+	qglGenTextures( 1, &q->texture_number );
+
+	textureJob_t *job = new textureJob_t;
+	memset( job, 0, sizeof( *job ) );
+	job->q = q;
+	job->width = nWidth;
+	job->height = nHeight;
+	job->max_tex_size = max_tex_size;
+	job->gamma = fGamma;
+	job->quality = g_PrefsDlg.m_nTextureQuality;
+	memcpy( job->gammatable, g_gammatable, sizeof( job->gammatable ) );
+
+	return job;
+}
+
+/*!
+   upload the job right away, or give the qtexture_t a placeholder and hand the job to the loader threads
+   jobs that already have their mips (cache hits) skip the threads and wait in the upload queue
+ */
+static qtexture_t *Texture_QueueJob( textureJob_t *job ){
+	qtexture_t *q = job->q;
+
+	if ( !g_PrefsDlg.m_bAsyncTextureLoad || !Texture_StartLoaderThreads() ) {
+		if ( !job->mips ) {
+			Texture_BuildMips( job );
+			if ( job->cacheFile ) {
+				Texture_WriteCache( job );
+			}
+		}
+		Texture_UploadJob( job );
+		return q;
+	}
+
+	// grey placeholder until the loader threads are done with it
+	byte placeholder[4] = { 128, 128, 128, 255 };
+	q->color[0] = q->color[1] = q->color[2] = 0.5f;
+	qglBindTexture( GL_TEXTURE_2D, q->texture_number );
+	SetTexParameters();
+	qglTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, placeholder );
 	qglBindTexture( GL_TEXTURE_2D, 0 );
-	if ( resampled ) {
-		free( outpixels );
+
+	s_nTexturesPending++;
+	if ( job->mips ) {
+		g_async_queue_push( s_pTextureDone, job );
+	}
+	else {
+		g_thread_pool_push( s_pTexturePool, job, NULL );
 	}
 
 	return q;
 }
 
+/*!
+   this function does the actual processing of raw RGBA data into a GL texture
+   it will also generate the mipmaps
+   it looks like pPixels nWidth nHeight are the only relevant parameters
+   NOTE: pPixels still belongs to the caller
+ */
+qtexture_t *QERApp_LoadTextureRGBA( unsigned char* pPixels, int nWidth, int nHeight ){
+	textureJob_t *job = Texture_NewJob( nWidth, nHeight );
+
+	job->pixels = (byte *)malloc( nWidth * nHeight * 4 );
+	memcpy( job->pixels, pPixels, nWidth * nHeight * 4 );
+
+	return Texture_QueueJob( job );
+}
+
+/*!
+   load an image by vfs name and create its qtexture_t, going through the on-disk texture cache
+   a hit on a loose image file doesn't read it at all, one in a pak has to be read so its contents can be hashed
+   \return NULL if the image could not be found or decoded
+ */
+qtexture_t *QERApp_LoadTexture( const char *name ){
+	static bool bCacheDir = false;
+	Str fullname;
+	char key[17];
+	unsigned char *pPixels = NULL;
+	byte *buffer = NULL;
+	int i, len, nWidth, nHeight;
+	unsigned long long hash;
+	const char *ext;
+	char *path;
+	struct stat st;
+	bool found = false;
+
+	if ( !g_PrefsDlg.m_bTextureCache ) {
+		g_ImageManager.LoadImage( name, &pPixels, &nWidth, &nHeight );
+		if ( !pPixels ) {
+			return NULL;
+		}
+		qtexture_t *q = QERApp_LoadTextureRGBA( pPixels, nWidth, nHeight );
+		g_free( pPixels );
+		return q;
+	}
+
+	// find the file the image modules are going to pick
+	i = strlen( name );
+	if ( i > 5 && name[i - 4] == '.' ) {
+		fullname = name;
+		found = vfsGetFileCount( fullname.GetBuffer(), 0 ) > 0;
+	}
+	else
+	{
+		g_ImageManager.BeginExtensionsScan();
+		while ( !found && ( ext = g_ImageManager.GetNextExtension() ) != NULL )
+		{
+			fullname.Format( "%s.%s", name, ext );
+			found = vfsGetFileCount( fullname.GetBuffer(), 0 ) > 0;
+		}
+	}
+	if ( !found ) {
+		return NULL;
+	}
+
+	// 64 bit FNV-1a over the lowercase path, then the size and time of a loose file
+	// the search directories come before the paks, the same loose file the image modules are going to load
+	hash = 14695981039346656037ULL;
+	for ( i = 0; fullname.GetBuffer()[i]; i++ )
+	{
+		hash = ( hash ^ (byte)tolower( fullname.GetBuffer()[i] ) ) * 1099511628211ULL;
+	}
+	path = vfsGetFullPath( fullname.GetBuffer(), 0, 0 );
+	if ( path && stat( path, &st ) == 0 ) {
+		unsigned long long stamp[2] = { (unsigned long long)st.st_size, (unsigned long long)st.st_mtime };
+		for ( i = 0; i < (int)sizeof( stamp ); i++ )
+		{
+			hash = ( hash ^ ( (byte *)stamp )[i] ) * 1099511628211ULL;
+		}
+	}
+	else
+	{
+		// a file in a pak has no time of its own, hash its contents
+		len = vfsLoadFile( fullname.GetBuffer(), (void **)&buffer, 0 );
+		if ( len <= 0 ) {
+			return NULL;
+		}
+		for ( i = 0; i < len; i++ )
+		{
+			hash = ( hash ^ buffer[i] ) * 1099511628211ULL;
+		}
+		vfsFreeFile( buffer );
+	}
+	sprintf( key, "%016llx", hash );
+
+	Str cachePath;
+	cachePath.Format( "%stexcache", g_PrefsDlg.m_rc_path->str );
+	if ( !bCacheDir ) {
+		Q_mkdir( cachePath.GetBuffer(), 0775 );
+		Texture_PruneCache( cachePath.GetBuffer() );
+		bCacheDir = true;
+	}
+
+	textureJob_t *job = Texture_NewJob( 0, 0 );
+	job->cacheFile = g_strdup_printf( "%s/%s.tex", cachePath.GetBuffer(), key );
+	strncpy( job->cacheName, fullname.GetBuffer(), sizeof( job->cacheName ) - 1 );
+
+	if ( Texture_ReadCache( job ) ) {
+		job->q->width = job->width;
+		job->q->height = job->height;
+		return Texture_QueueJob( job );
+	}
+
+	g_ImageManager.LoadImage( fullname.GetBuffer(), &pPixels, &nWidth, &nHeight );
+	if ( !pPixels ) {
+		qglDeleteTextures( 1, &job->q->texture_number );
+		g_free( job->q );
+		g_free( job->cacheFile );
+		delete job;
+		return NULL;
+	}
+
+	job->q->width = job->width = nWidth;
+	job->q->height = job->height = nHeight;
+	job->pixels = (byte *)malloc( nWidth * nHeight * 4 );
+	memcpy( job->pixels, pPixels, nWidth * nHeight * 4 );
+	g_free( pPixels );
+
+	return Texture_QueueJob( job );
+}
+
 /*
    ==================
    DumpUnreferencedShaders
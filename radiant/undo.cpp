@@ -19,7 +19,6 @@
    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
-
 /*
 
    QERadiant Undo/Redo
@@ -33,20 +32,48 @@
    undo/redo on the world_entity is special, only the epair changes are remembered
    and the world entity never gets deleted.
 
+   plain brushes added to the undo get an undoBrush_t record of their faces, copied
+   without windings, instead of a full clone. when the operation ends, the records of
+   brushes that are still in the map are kept and undone in place by swapping the face
+   lists, whatever the operation did to the planes and the texture alignment. records of
+   deleted brushes are turned into brushes for the brushlist, those get their windings
+   when they are put back. patches and entity brushes are cloned as before.
+   undo clones keep the numberId of their brush so the records can find it again after
+   a later operation got undone.
+
    FIXME: maybe reset the Undo system at map load
          maybe also reset the entityId at map load
  */
 
 #include "stdafx.h"
 
+// consecutive in place edits of the same brushes by the same operation closer than this are merged into one undo
+#define UNDO_COALESCE_TIME  1.0
+
+typedef struct undoBrush_s
+{
+	int numberId;               //numberId of the brush
+	int ownerId;                //entityId of the owner entity when the record was taken
+	int undoId;                 //undo ID the brush had before the operation
+	bool bBrushDef;
+	bool hiddenBrush;
+	face_t *faces;              //the faces to put back, copied without windings
+	struct undoBrush_s *next;
+} undoBrush_t;
+
 typedef struct undo_s
 {
 	double time;                //time operation was performed
+	double endtime;             //time operation was finished
 	int id;                     //every undo has an unique id
 	int done;                   //true when undo is build
     const char *operation;      //name of the operation
 	brush_t brushlist;          //deleted brushes
 	entity_t entitylist;        //deleted entities
+	undoBrush_t *records;       //brushes changed in place
+	undoBrush_t *pending;       //records taken since the start, sorted out by Undo_End
+	GHashTable *brushIds;       //numberIds of the brushes in brushlist and the records
+	GHashTable *entityIds;      //entityIds of the entities in entitylist
 	struct undo_s *prev, *next; //next and prev undo in list
 } undo_t;
 
@@ -70,6 +97,273 @@ int Undo_MemorySize( void ){
 	return g_undoMemorySize;
 }
 
+/*
+   =============
+   Undo_RecordMemorySize
+   =============
+ */
+static int Undo_RecordMemorySize( undoBrush_t *r ){
+	int size = sizeof( undoBrush_t );
+	face_t *f;
+
+	for ( f = r->faces; f; f = f->next )
+		size += Face_MemorySize( f );
+	return size;
+}
+
+static void Undo_FreeFaces( face_t *f ){
+	face_t *next;
+
+	for ( ; f; f = next )
+	{
+		next = f->next;
+		Face_Free( f );
+	}
+}
+
+static int Undo_FreeRecordList( undoBrush_t *r ){
+	undoBrush_t *next;
+	int size = 0;
+
+	for ( ; r; r = next )
+	{
+		next = r->next;
+		size += Undo_RecordMemorySize( r );
+		Undo_FreeFaces( r->faces );
+		free( r );
+	}
+	return size;
+}
+
+/*
+   =============
+   Undo_FreeRecords
+
+   frees the brush records and the lookup tables of an undo, returns the memory they used
+   =============
+ */
+static int Undo_FreeRecords( undo_t *undo ){
+	int size;
+
+	size = Undo_FreeRecordList( undo->records );
+	size += Undo_FreeRecordList( undo->pending );
+	undo->records = undo->pending = NULL;
+	if ( undo->brushIds ) {
+		g_hash_table_destroy( undo->brushIds );
+		undo->brushIds = NULL;
+	}
+	if ( undo->entityIds ) {
+		g_hash_table_destroy( undo->entityIds );
+		undo->entityIds = NULL;
+	}
+	return size;
+}
+
+/*
+   =============
+   Undo_BrushIndex
+
+   numberId -> brush for the brushes in the map
+   =============
+ */
+static GHashTable *Undo_BrushIndex( void ){
+	GHashTable *index = g_hash_table_new( g_direct_hash, g_direct_equal );
+	brush_t *pBrush;
+
+	for ( pBrush = active_brushes.next; pBrush != NULL && pBrush != &active_brushes; pBrush = pBrush->next )
+		g_hash_table_insert( index, GINT_TO_POINTER( pBrush->numberId ), pBrush );
+	for ( pBrush = selected_brushes.next; pBrush != NULL && pBrush != &selected_brushes; pBrush = pBrush->next )
+		g_hash_table_insert( index, GINT_TO_POINTER( pBrush->numberId ), pBrush );
+	return index;
+}
+
+static bool Undo_HasOriginalFaces( brush_t *b ){
+	face_t *f;
+
+	for ( f = b->brush_faces; f; f = f->next )
+	{
+		if ( f->original ) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+   =============
+   Undo_CanRecord
+
+   true for the brushes whose state is all in their faces
+   =============
+ */
+static bool Undo_CanRecord( brush_t *pBrush ){
+	return !pBrush->patchBrush && !pBrush->epairs && !pBrush->owner->eclass->fixedsize
+		   && !Undo_HasOriginalFaces( pBrush );
+}
+
+/*
+   =============
+   Undo_RecordToClone
+
+   makes a brush for the brushlist out of a record, the record is freed
+   the brush has no windings and no owner until Undo_Undo puts it back
+   =============
+ */
+static void Undo_RecordToClone( undo_t *undo, undoBrush_t *r ){
+	brush_t *pClone = Brush_Alloc();
+
+	pClone->numberId = r->numberId;
+	pClone->ownerId = r->ownerId;
+	pClone->undoId = r->undoId;
+	pClone->bBrushDef = r->bBrushDef;
+	pClone->hiddenBrush = r->hiddenBrush;
+	pClone->brush_faces = r->faces;
+	Brush_AddToList( pClone, &undo->brushlist );
+	g_hash_table_insert( undo->brushIds, GINT_TO_POINTER( r->numberId ), pClone );
+
+	g_undoMemorySize -= Undo_RecordMemorySize( r );
+	g_undoMemorySize += Brush_MemorySize( pClone );
+	free( r );
+}
+
+/*
+   =============
+   Undo_SortRecords
+
+   keeps the records of the brushes the operation changed in place, and turns the
+   others (deleted brushes, brushes that changed owner) into brushlist clones
+   =============
+ */
+static void Undo_SortRecords( undo_t *undo ){
+	GHashTable *index;
+	undoBrush_t *r, *next;
+	brush_t *pBrush;
+
+	if ( !undo->pending ) {
+		return;
+	}
+	index = Undo_BrushIndex();
+	for ( r = undo->pending; r; r = next )
+	{
+		next = r->next;
+		pBrush = (brush_t *) g_hash_table_lookup( index, GINT_TO_POINTER( r->numberId ) );
+		// only brushes the operation tagged as its own are restored from the undo
+		if ( pBrush && pBrush->undoId == undo->id && Undo_CanRecord( pBrush )
+			 && pBrush->owner->entityId == r->ownerId
+			 && !( undo->entityIds && g_hash_table_lookup( undo->entityIds, GINT_TO_POINTER( r->ownerId ) ) )
+			 && pBrush->bBrushDef == r->bBrushDef && pBrush->hiddenBrush == r->hiddenBrush ) {
+			// the brush stays in place, give it back the undo ID it had
+			pBrush->undoId = r->undoId;
+			r->next = undo->records;
+			undo->records = r;
+		}
+		else
+		{
+			Undo_RecordToClone( undo, r );
+		}
+	}
+	undo->pending = NULL;
+	g_hash_table_destroy( index );
+}
+
+/*
+   =============
+   Undo_ApplyRecords
+
+   swaps the faces of the brushes with the ones recorded, and moves the records, now
+   holding the faces the brushes had, to the other list
+   fromSize gets the memory the records used in from, toSize what they use in to,
+   records that lost their brush are freed
+   =============
+ */
+static void Undo_ApplyRecords( undo_t *from, undo_t *to, int *fromSize, int *toSize ){
+	GHashTable *index;
+	undoBrush_t *r, *next;
+	brush_t *pBrush;
+	face_t *f, *faces;
+
+	*fromSize = *toSize = 0;
+	if ( !from->records ) {
+		return;
+	}
+	index = Undo_BrushIndex();
+	for ( r = from->records; r; r = next )
+	{
+		next = r->next;
+		*fromSize += Undo_RecordMemorySize( r );
+		pBrush = (brush_t *) g_hash_table_lookup( index, GINT_TO_POINTER( r->numberId ) );
+		if ( !pBrush || !Undo_CanRecord( pBrush ) ) {
+			Sys_FPrintf( SYS_WRN, "WARNING: lost track of brush %i in undo\n", r->numberId );
+			Undo_FreeFaces( r->faces );
+			free( r );
+			continue;
+		}
+
+		faces = pBrush->brush_faces;
+		pBrush->brush_faces = r->faces;
+		r->faces = faces;
+		for ( f = r->faces; f; f = f->next )
+		{
+			free( f->face_winding );
+			f->face_winding = NULL;
+		}
+		Brush_Build( pBrush, false );
+		Select_Brush( pBrush );
+
+		*toSize += Undo_RecordMemorySize( r );
+		r->next = to->records;
+		to->records = r;
+	}
+	from->records = NULL;
+	g_hash_table_destroy( index );
+}
+
+/*
+   =============
+   Undo_CoalesceRecords
+
+   merges the last undo into the one before it if both only changed the same brushes in
+   place, the older records already hold the state to go back to
+   =============
+ */
+static void Undo_CoalesceRecords( void ){
+	undo_t *undo = g_lastundo, *prev = g_lastundo->prev;
+	undoBrush_t *r, *pr;
+
+	if ( !prev || !prev->done || !undo->records || !prev->records ) {
+		return;
+	}
+	if ( strcmp( undo->operation, prev->operation ) || undo->time - prev->endtime > UNDO_COALESCE_TIME ) {
+		return;
+	}
+	if ( undo->brushlist.next != &undo->brushlist || undo->entitylist.next != &undo->entitylist
+		 || prev->brushlist.next != &prev->brushlist || prev->entitylist.next != &prev->entitylist ) {
+		return;
+	}
+	for ( r = undo->records, pr = prev->records; r && pr; r = r->next, pr = pr->next )
+	{
+		if ( r->numberId != pr->numberId ) {
+			return;
+		}
+	}
+	if ( r || pr ) {
+		return;
+	}
+
+	prev->endtime = undo->endtime;
+
+	g_undoMemorySize -= Undo_FreeRecords( undo );
+	g_undoMemorySize -= sizeof( undo_t );
+	prev->next = NULL;
+	g_lastundo = prev;
+	free( undo );
+	g_undoSize--;
+	g_undoId--;
+	if ( g_undoId <= 0 ) {
+		g_undoId = 2 * g_undoMaxSize;
+	}
+}
+
 /*
    =============
    Undo_ClearRedo
@@ -93,6 +387,7 @@ void Undo_ClearRedo( void ){
 			pNextEntity = pEntity->next;
 			Entity_Free( pEntity );
 		}
+		Undo_FreeRecords( redo );
 		free( redo );
 	}
 	g_redolist = NULL;
@@ -128,6 +423,7 @@ void Undo_Clear( void ){
 			g_undoMemorySize -= Entity_MemorySize( pEntity );
 			Entity_Free( pEntity );
 		}
+		g_undoMemorySize -= Undo_FreeRecords( undo );
 		g_undoMemorySize -= sizeof( undo_t );
 		free( undo );
 	}
@@ -209,6 +505,7 @@ void Undo_FreeFirstUndo( void ){
 		g_undoMemorySize -= Entity_MemorySize( pEntity );
 		Entity_Free( pEntity );
 	}
+	g_undoMemorySize -= Undo_FreeRecords( undo );
 	g_undoMemorySize -= sizeof( undo_t );
 	free( undo );
 	g_undoSize--;
@@ -295,35 +592,82 @@ void Undo_GeneralStart( const char *operation ){
    =============
  */
 int Undo_BrushInUndo( undo_t *undo, brush_t *brush ){
-/*	brush_t *b;
-
-    for (b = undo->brushlist.next; b != &undo->brushlist; b = b->next)
-    {
-    // Arnout: NOTE - can't do a pointer compare as the brushes get cloned into the undo brushlist, and not just referenced from it
-    // For entities we have a unique ID, for brushes we have numberID - but brush full clone increases that anyway so it's useless right now.
-        if (b == brush) return true;
-    }*/
-	// Arnout: function is pointless right now, see above explanation
-	return false;
+	// Arnout: NOTE - can't do a pointer compare as the brushes get cloned into the undo brushlist, and not just referenced from it
+	// the clones keep the numberId of their brush though
+	return undo->brushIds && g_hash_table_lookup( undo->brushIds, GINT_TO_POINTER( brush->numberId ) ) != NULL;
 }
 
 /*
    =============
-   Undo_EntityInUndo
+   Undo_AddBrushClone
    =============
  */
-int Undo_EntityInUndo( undo_t *undo, entity_t *ent ){
-	entity_t *e;
+static void Undo_AddBrushClone( brush_t *pBrush ){
+	//clone the brush
+	brush_t* pClone = Brush_FullClone( pBrush );
+	//keep the brush number, the move records look brushes up by it
+	pClone->numberId = pBrush->numberId;
+	//save the ID of the owner entity
+	pClone->ownerId = pBrush->owner->entityId;
+	//save the old undo ID for previous undos
+	pClone->undoId = pBrush->undoId;
+	Brush_AddToList( pClone, &g_lastundo->brushlist );
+	if ( !g_lastundo->brushIds ) {
+		g_lastundo->brushIds = g_hash_table_new( g_direct_hash, g_direct_equal );
+	}
+	g_hash_table_insert( g_lastundo->brushIds, GINT_TO_POINTER( pBrush->numberId ), pClone );
+	//
+	g_undoMemorySize += Brush_MemorySize( pClone );
+}
+
+/*
+   =============
+   Undo_AddBrushRecord
+
+   records the faces of a plain brush, everything else gets a full clone
+   =============
+ */
+static void Undo_AddBrushRecord( brush_t *pBrush ){
+	undoBrush_t *r;
+	face_t *f, *nf, **last;
 
-	for ( e = undo->entitylist.next; e != &undo->entitylist; e = e->next )
+	if ( !Undo_CanRecord( pBrush ) ) {
+		Undo_AddBrushClone( pBrush );
+		return;
+	}
+
+	r = (undoBrush_t *) malloc( sizeof( undoBrush_t ) );
+	r->numberId = pBrush->numberId;
+	r->ownerId = pBrush->owner->entityId;
+	r->undoId = pBrush->undoId;
+	r->bBrushDef = pBrush->bBrushDef;
+	r->hiddenBrush = pBrush->hiddenBrush;
+	r->faces = NULL;
+	last = &r->faces;
+	for ( f = pBrush->brush_faces; f; f = f->next )
 	{
-		// Arnout: NOTE - can't do a pointer compare as the entities get cloned into the undo entitylist, and not just referenced from it
-		//if (e == ent) return true;
-		if ( e->entityId == ent->entityId ) {
-			return true;
-		}
+		nf = Face_Clone( f );
+		*last = nf;
+		last = &nf->next;
 	}
-	return false;
+	r->next = g_lastundo->pending;
+	g_lastundo->pending = r;
+	if ( !g_lastundo->brushIds ) {
+		g_lastundo->brushIds = g_hash_table_new( g_direct_hash, g_direct_equal );
+	}
+	g_hash_table_insert( g_lastundo->brushIds, GINT_TO_POINTER( pBrush->numberId ), r );
+	//
+	g_undoMemorySize += Undo_RecordMemorySize( r );
+}
+
+/*
+   =============
+   Undo_EntityInUndo
+   =============
+ */
+int Undo_EntityInUndo( undo_t *undo, entity_t *ent ){
+	// Arnout: NOTE - can't do a pointer compare as the entities get cloned into the undo entitylist, and not just referenced from it
+	return undo->entityIds && g_hash_table_lookup( undo->entityIds, GINT_TO_POINTER( ent->entityId ) ) != NULL;
 }
 
 /*
@@ -369,15 +713,7 @@ void Undo_AddBrush( brush_t *pBrush ){
 	if ( Undo_BrushInUndo( g_lastundo, pBrush ) ) {
 		return;
 	}
-	//clone the brush
-	brush_t* pClone = Brush_FullClone( pBrush );
-	//save the ID of the owner entity
-	pClone->ownerId = pBrush->owner->entityId;
-	//save the old undo ID for previous undos
-	pClone->undoId = pBrush->undoId;
-	Brush_AddToList( pClone, &g_lastundo->brushlist );
-	//
-	g_undoMemorySize += Brush_MemorySize( pClone );
+	Undo_AddBrushRecord( pBrush );
 }
 
 /*
@@ -423,15 +759,7 @@ void Undo_AddBrushList( brush_t *brushlist ){
 		if ( pBrush->owner->eclass->fixedsize == 1 ) {
 			Undo_AddEntity( pBrush->owner );
 		}
-		// clone the brush
-		brush_t* pClone = Brush_FullClone( pBrush );
-		// save the ID of the owner entity
-		pClone->ownerId = pBrush->owner->entityId;
-		// save the old undo ID from previous undos
-		pClone->undoId = pBrush->undoId;
-		Brush_AddToList( pClone, &g_lastundo->brushlist );
-		// track memory size used by undo
-		g_undoMemorySize += Brush_MemorySize( pClone );
+		Undo_AddBrushRecord( pBrush );
 	}
 }
 
@@ -527,6 +855,10 @@ void Undo_AddEntity( entity_t *entity ){
 	pClone->entityId = entity->entityId;
 	//
 	Entity_AddToList( pClone, &g_lastundo->entitylist );
+	if ( !g_lastundo->entityIds ) {
+		g_lastundo->entityIds = g_hash_table_new( g_direct_hash, g_direct_equal );
+	}
+	g_hash_table_insert( g_lastundo->entityIds, GINT_TO_POINTER( entity->entityId ), pClone );
 	//
 	g_undoMemorySize += Entity_MemorySize( pClone );
 }
@@ -591,6 +923,10 @@ void Undo_End( void ){
 		return;
 	}
 	g_lastundo->done = true;
+	g_lastundo->endtime = Sys_DoubleTime();
+
+	Undo_SortRecords( g_lastundo );
+	Undo_CoalesceRecords();
 
 	//undo memory size is bound to a max
 	while ( g_undoMemorySize > g_undoMaxMemorySize )
@@ -620,6 +956,7 @@ void Undo_Undo( qboolean bSilent ){
 	undo_t *undo, *redo;
 	brush_t *pBrush, *pNextBrush;
 	entity_t *pEntity, *pNextEntity, *pUndoEntity;
+	int nFromSize, nToSize;
 
 	if ( !g_lastundo ) {
 		Sys_Printf( "Nothing left to undo.\n" );
@@ -686,6 +1023,9 @@ void Undo_Undo( qboolean bSilent ){
 
 	// deselect current sutff
 	Select_Deselect();
+	// put the brushes that were changed in place back
+	Undo_ApplyRecords( undo, redo, &nFromSize, &nToSize );
+	g_undoMemorySize -= nFromSize;
 	// move "created" brushes to the redo
 	for ( pBrush = active_brushes.next; pBrush != NULL && pBrush != &active_brushes; pBrush = pNextBrush )
 	{
@@ -764,6 +1104,10 @@ void Undo_Undo( qboolean bSilent ){
 		}
 		//build the brush
 		//Brush_Build(pBrush);
+		//brushes made from a record have no windings yet
+		if ( pBrush->brush_faces && !pBrush->brush_faces->face_winding ) {
+			Brush_Build( pBrush, false );
+		}
 		Select_Brush( pBrush );
 		pBrush->redoId = redo->id;
 	}
@@ -771,6 +1115,7 @@ void Undo_Undo( qboolean bSilent ){
 		Sys_Printf( "%s undone.\n", undo->operation );
 	}
 	// free the undo
+	g_undoMemorySize -= Undo_FreeRecords( undo );
 	g_undoMemorySize -= sizeof( undo_t );
 	free( undo );
 	g_undoSize--;
@@ -798,6 +1143,7 @@ void Undo_Redo( void ){
 	undo_t *redo;
 	brush_t *pBrush, *pNextBrush;
 	entity_t *pEntity, *pNextEntity, *pRedoEntity;
+	int nFromSize, nToSize;
 
 	if ( !g_lastredo ) {
 		Sys_Printf( "Nothing left to redo.\n" );
@@ -824,6 +1170,9 @@ void Undo_Redo( void ){
 	Undo_GeneralStart( redo->operation );
 	// remove current selection
 	Select_Deselect();
+	// redo the changes made in place
+	Undo_ApplyRecords( redo, g_lastundo, &nFromSize, &nToSize );
+	g_undoMemorySize += nToSize;
 	// move "created" brushes back to the last undo
 	for ( pBrush = active_brushes.next; pBrush != NULL && pBrush != &active_brushes; pBrush = pNextBrush )
 	{
@@ -904,6 +1253,7 @@ void Undo_Redo( void ){
 	//
 	g_redoId--;
 	// free the undo
+	Undo_FreeRecords( redo );
 	free( redo );
 	//
 	g_bScreenUpdates = true;
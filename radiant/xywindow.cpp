@@ -653,6 +653,8 @@ XYWnd::XYWnd ()
 	m_bActive = false;
 	//m_bTiming = true;
 	m_bTiming = false;
+	m_nTimingCount = 0;
+	m_dTimingTotal = 0;
 	m_bRButtonDown = false;
 	m_nUpdateBits = W_XY;
 	g_bPathMode = false;
@@ -3095,8 +3097,6 @@ void XYWnd::PaintSizeInfo( int nDim1, int nDim2, vec3_t vMinBounds, vec3_t vMaxB
    ==============
  */
 
-long g_lCount = 0;
-long g_lTotal = 0;
 extern void DrawBrushEntityName( brush_t *b );
 
 //#define DBG_SCENEDUMP
@@ -3129,8 +3129,11 @@ void XYWnd::XY_Draw(){
 		return; // not valid yet
 
 	}
-	Patch_LODMatchAll(); // spog
 
+	Profiler_BeginFrame( PROF_VIEW_2D + m_nViewType );
+	if ( g_bPatchLODPending ) {
+		Patch_LODMatchAll();
+	}
 	if ( m_bTiming ) {
 		start = Sys_DoubleTime();
 	}
@@ -3221,9 +3224,28 @@ void XYWnd::XY_Draw(){
 		start2 = Sys_DoubleTime();
 	}
 
-	for ( brush = active_brushes.next ; brush != &active_brushes ; brush = brush->next )
+	// the view spans the whole world along the axis it looks down
+	vec3_t viewMins, viewMaxs;
+	viewMins[nDim1] = mins[0];
+	viewMaxs[nDim1] = maxs[0];
+	viewMins[nDim2] = mins[1];
+	viewMaxs[nDim2] = maxs[1];
+	viewMins[3 - nDim1 - nDim2] = g_MinWorldCoord;
+	viewMaxs[3 - nDim1 - nDim2] = g_MaxWorldCoord;
+	Profiler_Push( PROF_CULL );
+	BrushIndex_QueryBox( viewMins, viewMaxs, m_ViewBrushes );
+	Profiler_Pop();
+
+	// plain brushes go into the line array of this view type, see brushrender.cpp
+	Profiler_Push( PROF_BRUSHES );
+	BrushRender_BeginLines( m_nViewType );
+
+	for ( i = 0; i < m_ViewBrushes.GetSize(); i++ )
 	{
-		if ( brush->bFiltered ) {
+		float color[3];
+
+		brush = (brush_t*)m_ViewBrushes.GetAt( i );
+		if ( brush->list != &active_brushes || brush->bFiltered ) {
 			continue;
 		}
 
@@ -3238,15 +3260,15 @@ void XYWnd::XY_Draw(){
 		drawn++;
 
 		if ( brush->owner != e && brush->owner ) {
-            qglColor3f_convertFloat( brush->owner->eclass->color );
-        }
+			VectorCopy( brush->owner->eclass->color, color );
+		}
 		else if ( brush->brush_faces->texdef.contents & CONTENTS_DETAIL )
 		{
-            qglColor3fv( g_qeglobals.d_savedinfo.colors[COLOR_DETAIL] );
+			VectorCopy( g_qeglobals.d_savedinfo.colors[COLOR_DETAIL], color );
 		}
 		else
 		{
-            qglColor3fv( g_qeglobals.d_savedinfo.colors[COLOR_BRUSHES] );
+			VectorCopy( g_qeglobals.d_savedinfo.colors[COLOR_BRUSHES], color );
 		}
 
 #ifdef DBG_SCENEDUMP
@@ -3256,9 +3278,17 @@ void XYWnd::XY_Draw(){
 		}
 #endif
 
+		if ( BrushRender_QueueLines( brush, m_nViewType, color ) ) {
+			continue;
+		}
+
+		qglColor3fv( color );
 		Brush_DrawXY( brush, m_nViewType );
 	}
 
+	BrushRender_FlushLines( m_nViewType );
+	Profiler_Pop();
+
 	if ( m_bTiming ) {
 		end2 = Sys_DoubleTime();
 	}
@@ -3302,10 +3332,12 @@ void XYWnd::XY_Draw(){
 
 	int nSaveDrawn = drawn;
 	bool bFixedSize = false;
+	Profiler_Push( PROF_BRUSHES );
 	for ( brush = selected_brushes.next ; brush != &selected_brushes ; brush = brush->next )
 	{
 		// spog - added culling of selected brushes in XY window
-		if ( brush->mins[nDim1] > maxs[0] ||
+		if ( !BrushIndex_IsMarked( brush ) ||
+			 brush->mins[nDim1] > maxs[0] ||
 			 brush->mins[nDim2] > maxs[1] ||
 			 brush->maxs[nDim1] < mins[0] ||
 			 brush->maxs[nDim2] < mins[1] ) {
@@ -3339,6 +3371,8 @@ void XYWnd::XY_Draw(){
 		}
 	}
 
+	Profiler_Pop();
+
 	if ( g_PrefsDlg.m_bNoStipple == FALSE ) {
 		qglDisable( GL_LINE_STIPPLE );
 	}
@@ -3444,17 +3478,20 @@ void XYWnd::XY_Draw(){
 		}
 	}
 
+	Profiler_DrawOverlay( PROF_VIEW_2D + m_nViewType, m_nWidth, m_nHeight );
+
 	qglFinish();
 
 	if ( m_bTiming ) {
+		static const char *viewNames[] = { "YZ", "XZ", "XY" };
 		end = Sys_DoubleTime();
-		i = (int)( 1000 * ( end - start ) );
-		int i3 = (int)( 1000 * ( end2 - start2 ) );
-		g_lCount++;
-		g_lTotal += i;
-		int i2 = g_lTotal / g_lCount;
-		Sys_Printf( "xy: %i ab: %i  avg: %i\n", i, i3, i2 );
+		m_nTimingCount++;
+		m_dTimingTotal += end - start;
+		Sys_Printf( "%s: %.2f ms  active brushes: %.2f ms (%d drawn, %d culled)  avg: %.2f ms\n",
+					viewNames[m_nViewType], 1000 * ( end - start ), 1000 * ( end2 - start2 ), drawn, culled,
+					1000 * m_dTimingTotal / m_nTimingCount );
 	}
+	Profiler_EndFrame( PROF_VIEW_2D + m_nViewType );
 
 	// Fishman - Add antialiazed points and lines support. 09/03/00
 	if ( g_PrefsDlg.m_bAntialiasedPointsAndLines ) {
@@ -151,6 +151,8 @@ int m_nUpdateBits;
 int m_nWidth;
 int m_nHeight;
 bool m_bTiming;
+int m_nTimingCount;           // frames timed and their total draw time, per view
+double m_dTimingTotal;
 double m_fScale;
 float m_TopClip;
 float m_BottomClip;
@@ -173,6 +175,8 @@ private:
 static GtkWidget* m_mnuDrop;
 
 int m_nViewType;
+// brushes the index returned for the visible area, refilled every frame
+CPtrArray m_ViewBrushes;
 
 int m_nScrollFlags;
 int m_ptDragX, m_ptDragY;
@@ -193,6 +197,8 @@ int m_ptDownX, m_ptDownY;
 public:
 void OnEntityCreate( const char* item );
 int GetViewType() { return m_nViewType; }
+bool GetTiming() { return m_bTiming; }
+void SetTiming( bool bTiming ) { m_bTiming = bTiming; m_nTimingCount = 0; m_dTimingTotal = 0; }
 void SetScale( double f ) { m_fScale = f; }
 double Scale() { return m_fScale; }
 int Width() { return m_nWidth; }
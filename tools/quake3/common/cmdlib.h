@@ -53,6 +53,13 @@
 #endif
 
 
+// per-thread storage for state that worker threads each need their own copy of
+#ifdef _MSC_VER
+#define Q_THREAD_LOCAL __declspec( thread )
+#else
+#define Q_THREAD_LOCAL __thread
+#endif
+
 #define MAX_OS_PATH     4096
 #define MEM_BLOCKSIZE 4096
 
@@ -43,13 +43,13 @@ typedef struct
 } script_t;
 
 #define MAX_INCLUDES    8
-script_t scriptstack[MAX_INCLUDES];
-script_t    *script;
-int scriptline;
+Q_THREAD_LOCAL script_t scriptstack[MAX_INCLUDES];
+Q_THREAD_LOCAL script_t *script;
+Q_THREAD_LOCAL int scriptline;
 
-char token[MAXTOKEN];
-qboolean endofscript;
-qboolean tokenready;                     // only qtrue if UnGetToken was just called
+Q_THREAD_LOCAL char token[MAXTOKEN];
+Q_THREAD_LOCAL qboolean endofscript;
+Q_THREAD_LOCAL qboolean tokenready;      // only qtrue if UnGetToken was just called
 
 /*
    ==============
@@ -126,6 +126,26 @@ void ParseFromMemory( char *buffer, int size ){
 }
 
 
+/*
+   ==============
+   CloseScriptFile
+
+   Frees the script files still open when a parse stops before their end
+   ==============
+ */
+void CloseScriptFile( void ){
+	while ( script != NULL && script > scriptstack )
+	{
+		if ( strcmp( script->filename, "memory buffer" ) ) {
+			free( script->buffer );
+		}
+		script->buffer = NULL;
+		script--;
+	}
+	endofscript = qtrue;
+}
+
+
 /*
    ==============
    UnGetToken
@@ -30,15 +30,17 @@
 
 #define MAXTOKEN    1024
 
-extern char token[MAXTOKEN];
+// the tokenizer state is per thread, so scripts can be parsed from worker threads
+extern Q_THREAD_LOCAL char token[MAXTOKEN];
 extern char    *scriptbuffer,*script_p,*scriptend_p;
 extern int grabbed;
-extern int scriptline;
-extern qboolean endofscript;
+extern Q_THREAD_LOCAL int scriptline;
+extern Q_THREAD_LOCAL qboolean endofscript;
 
 
 void LoadScriptFile( const char *filename, int index );
 void ParseFromMemory( char *buffer, int size );
+void CloseScriptFile( void );
 
 qboolean GetToken( qboolean crossline );
 void UnGetToken( void );
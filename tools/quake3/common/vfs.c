@@ -46,6 +46,9 @@
 #if defined( __linux__ ) || defined( __FreeBSD__ ) || defined( __APPLE__ )
 #include <dirent.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#define VFS_USE_MMAP
 #else
 #include <wtypes.h>
 #include <io.h>
@@ -66,23 +69,63 @@
 #include "inout.h"
 #include "vfs.h"
 
-typedef struct
+typedef struct VFS_PAKARCHIVE_s
+{
+	char*   filename;
+	unzFile zipfile;
+	void*   mapped;         // whole archive, mapped on the first zero-copy request
+	size_t mappedSize;
+} VFS_PAKARCHIVE;
+
+typedef struct VFS_PAKFILE_s
 {
 	char*   name;
 	unz_file_pos zipinfo;
-	unzFile zipfile;
+	VFS_PAKARCHIVE* pak;
 	guint32 size;
+	guint32 method;         // zip compression method, 0 means stored
+	struct VFS_PAKFILE_s* next; // next entry with the same name, in search order
 } VFS_PAKFILE;
 
+// how a buffer handed out by vfsMapFile has to be released
+typedef enum
+{
+	VFS_MAP_HEAP,           // safe_malloc'ed copy
+	VFS_MAP_LOOSE,          // private mapping of a loose file
+	VFS_MAP_PAK             // points into a mapped pk3, nothing to release
+} vfsMapType_t;
+
+typedef struct
+{
+	vfsMapType_t type;
+	void*   base;
+	size_t size;
+	int refCount;           // pk3 entries hand out the same buffer to every caller
+} VFS_MAPPING;
+
 // =============================================================================
 // Global variables
 
 static GSList*  g_unzFiles;
 static GSList*  g_pakFiles;
+static GHashTable* g_pakIndex;      // lowercase name -> first VFS_PAKFILE in search order
+static GHashTable* g_mappings;      // buffer returned by vfsMapFile -> VFS_MAPPING
 static char g_strDirs[VFS_MAXDIRS][PATH_MAX];
 static int g_numDirs;
 static gboolean g_bUsePak = TRUE;
 
+// unzFile handles keep a read cursor, so pk3 access has to be serialized
+G_LOCK_DEFINE_STATIC( vfsPak );
+G_LOCK_DEFINE_STATIC( vfsStats );
+
+static int g_numPaks;
+static int g_numPakEntries;
+static int g_numLoads;
+static int g_numMapped;
+static int g_numZeroCopy;
+static gint64 g_indexTime;
+static gint64 g_loadTime;
+
 // =============================================================================
 // Static functions
 
@@ -109,12 +152,52 @@ static void vfsFixDOSName( char *src ){
 	}
 }
 
+static void vfsAddLoadTime( gint64 start, gboolean mapped, gboolean zeroCopy ){
+	G_LOCK( vfsStats );
+	g_loadTime += g_get_monotonic_time() - start;
+	g_numLoads++;
+	if ( mapped ) {
+		g_numMapped++;
+	}
+	if ( zeroCopy ) {
+		g_numZeroCopy++;
+	}
+	G_UNLOCK( vfsStats );
+}
+
 //!\todo Define globally or use heap-allocated string.
 #define NAME_MAX 255
 
+// adds an entry to the end of its name chain, so earlier paks keep precedence
+static void vfsIndexPakFile( VFS_PAKFILE *file ){
+	VFS_PAKFILE *chain;
+
+	if ( g_pakIndex == NULL ) {
+		g_pakIndex = g_hash_table_new( g_str_hash, g_str_equal );
+	}
+
+	chain = (VFS_PAKFILE*)g_hash_table_lookup( g_pakIndex, file->name );
+	if ( chain == NULL ) {
+		g_hash_table_insert( g_pakIndex, file->name, file );
+		return;
+	}
+
+	while ( chain->next != NULL )
+		chain = chain->next;
+	chain->next = file;
+}
+
+static VFS_PAKFILE *vfsFindPakFile( const char *lower ){
+	if ( g_pakIndex == NULL ) {
+		return NULL;
+	}
+	return (VFS_PAKFILE*)g_hash_table_lookup( g_pakIndex, lower );
+}
+
 static void vfsInitPakFile( const char *filename ){
 	unz_global_info gi;
 	unzFile uf;
+	VFS_PAKARCHIVE* pak;
 	guint32 i;
 	int err;
 
@@ -123,7 +206,13 @@ static void vfsInitPakFile( const char *filename ){
 		return;
 	}
 
-	g_unzFiles = g_slist_append( g_unzFiles, uf );
+	pak = (VFS_PAKARCHIVE*)safe_malloc( sizeof( VFS_PAKARCHIVE ) );
+	pak->filename = strdup( filename );
+	pak->zipfile = uf;
+	pak->mapped = NULL;
+	pak->mappedSize = 0;
+	g_unzFiles = g_slist_prepend( g_unzFiles, pak );
+	g_numPaks++;
 
 	err = unzGetGlobalInfo( uf,&gi );
 	if ( err != UNZ_OK ) {
@@ -144,7 +233,7 @@ static void vfsInitPakFile( const char *filename ){
 		}
 
 		file = (VFS_PAKFILE*)safe_malloc( sizeof( VFS_PAKFILE ) );
-		g_pakFiles = g_slist_append( g_pakFiles, file );
+		g_pakFiles = g_slist_prepend( g_pakFiles, file );
 
 		vfsFixDOSName( filename_inzip );
 		//-1 null terminated string
@@ -152,8 +241,12 @@ static void vfsInitPakFile( const char *filename ){
 
 		file->name = strdup( filename_lower );
 		file->size = file_info.uncompressed_size;
-		file->zipfile = uf;
-		unzGetFilePos(file->zipfile, &file->zipinfo);
+		file->method = file_info.compression_method;
+		file->pak = pak;
+		file->next = NULL;
+		unzGetFilePos( uf, &file->zipinfo );
+		vfsIndexPakFile( file );
+		g_numPakEntries++;
 
 		if ( ( i + 1 ) < gi.number_entry ) {
 			err = unzGoToNextFile( uf );
@@ -165,6 +258,114 @@ static void vfsInitPakFile( const char *filename ){
 	}
 }
 
+// decompresses a pak entry into a new buffer with a trailing 0, returns the size or -1
+// the caller must hold the vfsPak lock
+static int vfsReadPakFile( VFS_PAKFILE *file, void **bufferptr ){
+	int len;
+
+	unzGoToFilePos( file->pak->zipfile, &file->zipinfo );
+
+	if ( unzOpenCurrentFile( file->pak->zipfile ) != UNZ_OK ) {
+		return -1;
+	}
+
+	*bufferptr = safe_malloc( file->size + 1 );
+	// we need to end the buffer with a 0
+	( (char*) ( *bufferptr ) )[file->size] = 0;
+
+	len = unzReadCurrentFile( file->pak->zipfile, *bufferptr, file->size );
+	unzCloseCurrentFile( file->pak->zipfile );
+	if ( len < 0 ) {
+		free( *bufferptr );
+		*bufferptr = NULL;
+		return -1;
+	}
+
+	return file->size;
+}
+
+#ifdef VFS_USE_MMAP
+// maps a whole file read-only, returns the size or -1
+static int vfsMapPath( const char *path, void **base, int prot ){
+	struct stat st;
+	int fd;
+
+	fd = open( path, O_RDONLY );
+	if ( fd < 0 ) {
+		return -1;
+	}
+	if ( fstat( fd, &st ) != 0 || st.st_size <= 0 ) {
+		close( fd );
+		return -1;
+	}
+
+	*base = mmap( NULL, st.st_size, prot, MAP_PRIVATE, fd, 0 );
+	close( fd );
+	if ( *base == MAP_FAILED ) {
+		*base = NULL;
+		return -1;
+	}
+
+	return (int)st.st_size;
+}
+
+// returns a pointer to the data of a stored pak entry inside the mapped archive
+// the caller must hold the vfsPak lock
+static const void *vfsPakFileData( VFS_PAKFILE *file ){
+	VFS_PAKARCHIVE *pak = file->pak;
+	ZPOS64_T offset;
+
+	if ( file->method != 0 ) {
+		return NULL;
+	}
+
+	if ( pak->mapped == NULL ) {
+		int size = vfsMapPath( pak->filename, &pak->mapped, PROT_READ );
+		if ( size < 0 ) {
+			return NULL;
+		}
+		pak->mappedSize = size;
+	}
+
+	// the local header has a variable length, so let minizip find the data
+	unzGoToFilePos( pak->zipfile, &file->zipinfo );
+	if ( unzOpenCurrentFile( pak->zipfile ) != UNZ_OK ) {
+		return NULL;
+	}
+	offset = unzGetCurrentFileZStreamPos64( pak->zipfile );
+	unzCloseCurrentFile( pak->zipfile );
+
+	if ( offset == 0 || offset + file->size > pak->mappedSize ) {
+		return NULL;
+	}
+
+	return (const byte*)pak->mapped + offset;
+}
+#endif
+
+static void vfsAddMapping( const void *buffer, vfsMapType_t type, void *base, size_t size ){
+	VFS_MAPPING *mapping;
+
+	G_LOCK( vfsPak );
+	if ( g_mappings == NULL ) {
+		g_mappings = g_hash_table_new( g_direct_hash, g_direct_equal );
+	}
+	mapping = (VFS_MAPPING*)g_hash_table_lookup( g_mappings, buffer );
+	if ( mapping != NULL ) {
+		mapping->refCount++;
+	}
+	else
+	{
+		mapping = (VFS_MAPPING*)safe_malloc( sizeof( VFS_MAPPING ) );
+		mapping->type = type;
+		mapping->base = base;
+		mapping->size = size;
+		mapping->refCount = 1;
+		g_hash_table_insert( g_mappings, (gpointer)buffer, mapping );
+	}
+	G_UNLOCK( vfsPak );
+}
+
 static int vfsPakSort(const void *a, const void *b) {
 	char    *s1, *s2;
 	int c1, c2;
@@ -216,6 +417,8 @@ void vfsInitDirectory( const char *path ){
 	char filename[PATH_MAX];
 	GSList *dirlist = NULL;
 	GDir *dir;
+	gint64 start;
+	int numPakEntries;
 
 	if ( g_numDirs == ( VFS_MAXDIRS - 1 ) ) {
 		return;
@@ -223,6 +426,9 @@ void vfsInitDirectory( const char *path ){
 
 	Sys_Printf( "VFS Init: %s\n", path );
 
+	start = g_get_monotonic_time();
+	numPakEntries = g_numPakEntries;
+
 	strcpy( g_strDirs[g_numDirs], path );
 	vfsFixDOSName( g_strDirs[g_numDirs] );
 	vfsAddSlash( g_strDirs[g_numDirs] );
@@ -278,14 +484,28 @@ void vfsInitDirectory( const char *path ){
 			g_dir_close( dir );
 		}
 	}
+
+	g_indexTime += g_get_monotonic_time() - start;
+	if ( g_numPakEntries > numPakEntries ) {
+		Sys_Printf( "VFS Init: indexed %d pak entries in %.3f seconds\n",
+					g_numPakEntries - numPakEntries, ( g_get_monotonic_time() - start ) / 1000000.0 );
+	}
 }
 
 // frees all memory that we allocated
 void vfsShutdown(){
 	while ( g_unzFiles )
 	{
-		unzClose( (unzFile)g_unzFiles->data );
-		g_unzFiles = g_slist_remove( g_unzFiles, g_unzFiles->data );
+		VFS_PAKARCHIVE* pak = (VFS_PAKARCHIVE*)g_unzFiles->data;
+		unzClose( pak->zipfile );
+#ifdef VFS_USE_MMAP
+		if ( pak->mapped != NULL ) {
+			munmap( pak->mapped, pak->mappedSize );
+		}
+#endif
+		free( pak->filename );
+		free( pak );
+		g_unzFiles = g_slist_remove( g_unzFiles, pak );
 	}
 
 	while ( g_pakFiles )
@@ -295,6 +515,19 @@ void vfsShutdown(){
 		free( file );
 		g_pakFiles = g_slist_remove( g_pakFiles, file );
 	}
+
+	if ( g_pakIndex != NULL ) {
+		g_hash_table_destroy( g_pakIndex );
+		g_pakIndex = NULL;
+	}
+}
+
+// prints index and load statistics
+void vfsPrintStats(){
+	Sys_Printf( "VFS: %d pk3 files, %d entries indexed in %.3f seconds\n",
+				g_numPaks, g_numPakEntries, g_indexTime / 1000000.0 );
+	Sys_Printf( "VFS: %d files loaded (%d mapped, %d zero-copy) in %.3f seconds\n",
+				g_numLoads, g_numMapped, g_numZeroCopy, g_loadTime / 1000000.0 );
 }
 
 // return the number of files that match
@@ -302,19 +535,15 @@ int vfsGetFileCount( const char *filename ){
 	int i, count = 0;
 	char fixed[NAME_MAX], tmp[NAME_MAX];
 	char *lower;
-	GSList *lst;
+	VFS_PAKFILE *file;
 
 	strcpy( fixed, filename );
 	vfsFixDOSName( fixed );
 	lower = g_ascii_strdown( fixed, -1 );
 
-	for ( lst = g_pakFiles; lst != NULL; lst = g_slist_next( lst ) )
+	for ( file = vfsFindPakFile( lower ); file != NULL; file = file->next )
 	{
-		VFS_PAKFILE* file = (VFS_PAKFILE*)lst->data;
-
-		if ( strcmp( file->name, lower ) == 0 ) {
-			count++;
-		}
+		count++;
 	}
 
 	for ( i = 0; i < g_numDirs; i++ )
@@ -334,7 +563,8 @@ int vfsLoadFile( const char *filename, void **bufferptr, int index ){
 	int i, count = 0;
 	char tmp[NAME_MAX], fixed[NAME_MAX];
 	char *lower;
-	GSList *lst;
+	VFS_PAKFILE *file;
+	gint64 start;
 
 	// filename is a full path
 	if ( index == -1 ) {
@@ -368,6 +598,7 @@ int vfsLoadFile( const char *filename, void **bufferptr, int index ){
 		return len;
 	}
 
+	start = g_get_monotonic_time();
 	*bufferptr = NULL;
 	strcpy( fixed, filename );
 	vfsFixDOSName( fixed );
@@ -382,6 +613,8 @@ int vfsLoadFile( const char *filename, void **bufferptr, int index ){
 				long len;
 				FILE *f;
 
+				g_free( lower );
+
 				f = fopen( tmp, "rb" );
 				if ( f == NULL ) {
 					return -1;
@@ -406,6 +639,7 @@ int vfsLoadFile( const char *filename, void **bufferptr, int index ){
 				// we need to end the buffer with a 0
 				( (char*) ( *bufferptr ) )[len] = 0;
 
+				vfsAddLoadTime( start, FALSE, FALSE );
 				return len;
 			}
 
@@ -413,34 +647,104 @@ int vfsLoadFile( const char *filename, void **bufferptr, int index ){
 		}
 	}
 
-	for ( lst = g_pakFiles; lst != NULL; lst = g_slist_next( lst ) )
+	for ( file = vfsFindPakFile( lower ); file != NULL; file = file->next )
 	{
-		VFS_PAKFILE* file = (VFS_PAKFILE*)lst->data;
+		if ( count == index ) {
+			g_free( lower );
+
+			G_LOCK( vfsPak );
+			i = vfsReadPakFile( file, bufferptr );
+			G_UNLOCK( vfsPak );
 
-		if ( strcmp( file->name, lower ) != 0 ) {
-			continue;
+			if ( i >= 0 ) {
+				vfsAddLoadTime( start, FALSE, FALSE );
+			}
+			return i;
 		}
 
-		if ( count == index ) {
-			unzGoToFilePos( file->zipfile, &file->zipinfo );
+		count++;
+	}
+	g_free( lower );
+	return -1;
+}
 
-			if ( unzOpenCurrentFile( file->zipfile ) != UNZ_OK ) {
-				return -1;
+// like vfsLoadFile, but the buffer is read-only and must be released with vfsFreeMappedFile
+// loose files are mapped, stored pk3 entries point straight into the mapped archive
+// mapped buffers are not 0-terminated
+int vfsMapFile( const char *filename, const void **bufferptr, int index ){
+	int i, count = 0;
+	char tmp[NAME_MAX], fixed[NAME_MAX];
+	char *lower;
+	VFS_PAKFILE *file;
+	void *buffer;
+	gint64 start;
+
+	start = g_get_monotonic_time();
+	*bufferptr = NULL;
+	strcpy( fixed, filename );
+	vfsFixDOSName( fixed );
+	lower = g_ascii_strdown( fixed, -1 );
+
+	for ( i = 0; i < g_numDirs; i++ )
+	{
+		strcpy( tmp, g_strDirs[i] );
+		strcat( tmp, filename );
+		if ( access( tmp, R_OK ) == 0 ) {
+			if ( count == index ) {
+				g_free( lower );
+
+#ifdef VFS_USE_MMAP
+				i = vfsMapPath( tmp, &buffer, PROT_READ );
+				if ( i > 0 ) {
+					vfsAddMapping( buffer, VFS_MAP_LOOSE, buffer, i );
+					*bufferptr = buffer;
+					vfsAddLoadTime( start, TRUE, FALSE );
+					return i;
+				}
+#endif
+				i = vfsLoadFile( tmp, &buffer, -1 );
+				if ( i < 0 ) {
+					return -1;
+				}
+				vfsAddMapping( buffer, VFS_MAP_HEAP, buffer, i + 1 );
+				*bufferptr = buffer;
+				vfsAddLoadTime( start, FALSE, FALSE );
+				return i;
 			}
 
-			*bufferptr = safe_malloc( file->size + 1 );
-			// we need to end the buffer with a 0
-			( (char*) ( *bufferptr ) )[file->size] = 0;
+			count++;
+		}
+	}
 
-			i = unzReadCurrentFile( file->zipfile, *bufferptr, file->size );
-			unzCloseCurrentFile( file->zipfile );
-			if ( i < 0 ) {
-				return -1;
+	for ( file = vfsFindPakFile( lower ); file != NULL; file = file->next )
+	{
+		if ( count == index ) {
+			const void *data = NULL;
+
+			g_free( lower );
+
+			G_LOCK( vfsPak );
+#ifdef VFS_USE_MMAP
+			data = vfsPakFileData( file );
+#endif
+			if ( data == NULL ) {
+				i = vfsReadPakFile( file, &buffer );
 			}
-			else{
-				g_free( lower );
+			G_UNLOCK( vfsPak );
+
+			if ( data != NULL ) {
+				vfsAddMapping( data, VFS_MAP_PAK, NULL, file->size );
+				*bufferptr = data;
+				vfsAddLoadTime( start, TRUE, TRUE );
 				return file->size;
 			}
+			if ( i < 0 ) {
+				return -1;
+			}
+			vfsAddMapping( buffer, VFS_MAP_HEAP, buffer, i + 1 );
+			*bufferptr = buffer;
+			vfsAddLoadTime( start, FALSE, FALSE );
+			return i;
 		}
 
 		count++;
@@ -448,3 +752,50 @@ int vfsLoadFile( const char *filename, void **bufferptr, int index ){
 	g_free( lower );
 	return -1;
 }
+
+// releases a buffer returned by vfsMapFile
+void vfsFreeMappedFile( const void *buffer ){
+	VFS_MAPPING *mapping = NULL;
+	gboolean bShared = FALSE;
+
+	if ( buffer == NULL ) {
+		return;
+	}
+
+	G_LOCK( vfsPak );
+	if ( g_mappings != NULL ) {
+		mapping = (VFS_MAPPING*)g_hash_table_lookup( g_mappings, buffer );
+		if ( mapping != NULL ) {
+			if ( --mapping->refCount == 0 ) {
+				g_hash_table_remove( g_mappings, buffer );
+			}
+			else{
+				bShared = TRUE;
+			}
+		}
+	}
+	G_UNLOCK( vfsPak );
+
+	if ( mapping == NULL ) {
+		Sys_FPrintf( SYS_WRN, "WARNING: vfsFreeMappedFile: unknown buffer\n" );
+		return;
+	}
+	if ( bShared ) {
+		return;
+	}
+
+	switch ( mapping->type )
+	{
+	case VFS_MAP_HEAP:
+		free( mapping->base );
+		break;
+#ifdef VFS_USE_MMAP
+	case VFS_MAP_LOOSE:
+		munmap( mapping->base, mapping->size );
+		break;
+#endif
+	default:
+		break;
+	}
+	free( mapping );
+}
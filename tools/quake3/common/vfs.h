@@ -37,5 +37,8 @@ void vfsInitDirectory( const char *path );
 void vfsShutdown();
 int vfsGetFileCount( const char *filename );
 int vfsLoadFile( const char *filename, void **buffer, int index );
+int vfsMapFile( const char *filename, const void **buffer, int index );
+void vfsFreeMappedFile( const void *buffer );
+void vfsPrintStats();
 
 #endif // _VFS_H_
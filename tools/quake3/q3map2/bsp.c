@@ -585,6 +585,9 @@ void ProcessModels( void ){
 	/* create map fogs */
 	CreateMapFogs();
 
+	/* parse the models the entities will insert on all threads up front */
+	ModelPreload();
+
 	/* walk entity list */
 	for ( mapEntityNum = 0; mapEntityNum < numEntities; mapEntityNum++ )
 	{
@@ -36,6 +36,22 @@
 /* dependencies */
 #include "q3map2.h"
 
+#if defined( __linux__ ) || defined( __FreeBSD__ ) || defined( __APPLE__ )
+	#define BSP_USE_MMAP
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#endif
+
+/* the on-disk bsp formats are little endian, so there is nothing to swap on little endian hosts */
+#if defined( __BIG_ENDIAN__ ) || defined( _SGI_SOURCE )
+	#define BSP_SWAP_BYTES
+#endif
+
+/* size of the stdio buffer used for writing bsp files */
+#define BSP_WRITE_BUFFER_SIZE   ( 1 << 20 )
+
 
 
 
@@ -155,6 +171,7 @@ void BSPFilesCleanup(){
  */
 
 void SwapBlock( int *block, int size ){
+#ifdef BSP_SWAP_BYTES
 	int i;
 
 
@@ -167,6 +184,7 @@ void SwapBlock( int *block, int size ){
 	size >>= 2;
 	for ( i = 0; i < size; i++ )
 		block[ i ] = LittleLong( block[ i ] );
+#endif
 }
 
 
@@ -177,6 +195,7 @@ void SwapBlock( int *block, int size ){
  */
 
 void SwapBSPFile( void ){
+#ifdef BSP_SWAP_BYTES
 	int i, j;
 
 
@@ -264,6 +283,7 @@ void SwapBSPFile( void ){
 
 		//bspAds[ i ].model[ MAX_QPATH ];
 	}
+#endif
 }
 
 
@@ -337,21 +357,150 @@ int CopyLump( bspHeader_t *header, int lump, void *dest, int size ){
 
 
 /*
-   AddLump()
-   adds a lump to an outgoing bsp file
+   BeginLump()
+   starts a lump in an outgoing bsp file, the lump data is then written with SafeWrite()
  */
 
-void AddLump( FILE *file, bspHeader_t *header, int lumpNum, const void *data, int length ){
+void BeginLump( FILE *file, bspHeader_t *header, int lumpNum ){
 	bspLump_t   *lump;
 
 
 	/* add lump to bsp file header */
 	lump = &header->lumps[ lumpNum ];
 	lump->offset = LittleLong( ftell( file ) );
+	lump->length = 0;
+}
+
+
+
+/*
+   EndLump()
+   finishes a lump started with BeginLump(), padding it to 4 bytes
+ */
+
+void EndLump( FILE *file, bspHeader_t *header, int lumpNum ){
+	bspLump_t   *lump;
+	int length;
+	static const byte pad[ 4 ] = { 0, 0, 0, 0 };
+
+
+	/* set the length */
+	lump = &header->lumps[ lumpNum ];
+	length = ftell( file ) - LittleLong( lump->offset );
 	lump->length = LittleLong( length );
 
-	/* write lump to file */
-	SafeWrite( file, data, ( length + 3 ) & ~3 );
+	/* pad */
+	if ( length & 3 ) {
+		SafeWrite( file, pad, 4 - ( length & 3 ) );
+	}
+}
+
+
+
+/*
+   AddLump()
+   adds a lump to an outgoing bsp file
+ */
+
+void AddLump( FILE *file, bspHeader_t *header, int lumpNum, const void *data, int length ){
+	BeginLump( file, header, lumpNum );
+	if ( length > 0 ) {
+		SafeWrite( file, data, length );
+	}
+	EndLump( file, header, lumpNum );
+}
+
+
+
+/*
+   OpenBSPFileWrite()
+   opens a bsp file for writing through a single large buffer
+ */
+
+FILE *OpenBSPFileWrite( const char *filename ){
+	FILE    *file;
+
+
+	file = SafeOpenWrite( filename );
+	setvbuf( file, NULL, _IOFBF, BSP_WRITE_BUFFER_SIZE );
+	return file;
+}
+
+
+
+/*
+   MapBSPFile()
+   maps a bsp file for reading without copying it to the heap
+   the data is private to the caller and may be modified (byte swapped) in place
+ */
+
+#ifdef BSP_USE_MMAP
+static void *mappedBSPBuffer = NULL;
+static size_t mappedBSPSize = 0;
+#endif
+
+int MapBSPFile( const char *filename, void **bufferptr ){
+#ifdef BSP_USE_MMAP
+	int fd;
+	struct stat st;
+	void        *buffer;
+
+
+	/* only one mapping at a time */
+	if ( mappedBSPBuffer != NULL ) {
+		return LoadFile( filename, bufferptr );
+	}
+
+	/* open and map the file */
+	fd = open( filename, O_RDONLY );
+	if ( fd < 0 ) {
+		Error( "Error opening %s: %s", filename, strerror( errno ) );
+	}
+	if ( fstat( fd, &st ) != 0 || st.st_size <= 0 ) {
+		close( fd );
+		return LoadFile( filename, bufferptr );
+	}
+	buffer = mmap( NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+	close( fd );
+
+	/* fall back to reading it */
+	if ( buffer == MAP_FAILED ) {
+		return LoadFile( filename, bufferptr );
+	}
+	madvise( buffer, st.st_size, MADV_SEQUENTIAL );
+
+	/* return it */
+	mappedBSPBuffer = buffer;
+	mappedBSPSize = st.st_size;
+	*bufferptr = buffer;
+	return (int) st.st_size;
+#else
+	return LoadFile( filename, bufferptr );
+#endif
+}
+
+
+
+/*
+   UnmapBSPFile()
+   releases a bsp file returned by MapBSPFile()
+ */
+
+void UnmapBSPFile( void *buffer ){
+	/* dummy check */
+	if ( buffer == NULL ) {
+		return;
+	}
+
+#ifdef BSP_USE_MMAP
+	if ( buffer == mappedBSPBuffer ) {
+		munmap( mappedBSPBuffer, mappedBSPSize );
+		mappedBSPBuffer = NULL;
+		mappedBSPSize = 0;
+		return;
+	}
+#endif
+	free( buffer );
 }
 
 
@@ -381,7 +530,6 @@ void LoadBSPFile( const char *filename ){
 
 void WriteBSPFile( const char *filename ){
 	char tempname[ 1024 ];
-	time_t tm;
 
 
 	/* dummy check */
@@ -389,18 +537,21 @@ void WriteBSPFile( const char *filename ){
 		Error( "WriteBSPFile: unsupported BSP file format" );
 	}
 
-	/* make fake temp name so existing bsp file isn't damaged in case write process fails */
-	time( &tm );
-	sprintf( tempname, "%s.%08X", filename, (int) tm );
+	/* write next to the existing bsp file so it isn't damaged in case the write process fails */
+	sprintf( tempname, "%s.tmp", filename );
 
-	/* byteswap, write the bsp, then swap back so it can be manipulated further */
+	/* byteswap, write the bsp, then swap back so it can be manipulated further (no-ops on little endian hosts) */
 	SwapBSPFile();
 	game->write( tempname );
 	SwapBSPFile();
 
 	/* replace existing bsp file */
+#ifdef WIN32
 	remove( filename );
-	rename( tempname, filename );
+#endif
+	if ( rename( tempname, filename ) != 0 ) {
+		Error( "Error renaming %s to %s: %s", tempname, filename, strerror( errno ) );
+	}
 }
 
 
@@ -79,6 +79,10 @@ typedef struct
 ibspHeader_t;
 
 
+/* converted lumps are written in chunks of this many elements to keep the write buffers small */
+#define LUMP_CHUNK_ELEMENTS     4096
+
+
 
 /* brush sides */
 typedef struct
@@ -113,17 +117,17 @@ static void CopyBrushSidesLump( ibspHeader_t *header ){
 
 
 static void AddBrushSidesLump( FILE *file, ibspHeader_t *header ){
-	int i, size;
+	int i, numChunk;
 	bspBrushSide_t  *in;
 	ibspBrushSide_t *buffer, *out;
 
 
-	/* allocate output buffer */
-	size = numBSPBrushSides * sizeof( *buffer );
-	buffer = safe_malloc( size );
-	memset( buffer, 0, size );
+	/* allocate chunk buffer */
+	buffer = safe_malloc( LUMP_CHUNK_ELEMENTS * sizeof( *buffer ) );
+	memset( buffer, 0, LUMP_CHUNK_ELEMENTS * sizeof( *buffer ) );
 
-	/* convert */
+	/* convert and write in chunks */
+	BeginLump( file, (bspHeader_t*) header, LUMP_BRUSHSIDES );
 	in = bspBrushSides;
 	out = buffer;
 	for ( i = 0; i < numBSPBrushSides; i++ )
@@ -132,10 +136,15 @@ static void AddBrushSidesLump( FILE *file, ibspHeader_t *header ){
 		out->shaderNum = in->shaderNum;
 		in++;
 		out++;
-	}
 
-	/* write lump */
-	AddLump( file, (bspHeader_t*) header, LUMP_BRUSHSIDES, buffer, size );
+		/* flush */
+		numChunk = out - buffer;
+		if ( numChunk == LUMP_CHUNK_ELEMENTS || i == numBSPBrushSides - 1 ) {
+			SafeWrite( file, buffer, numChunk * sizeof( *buffer ) );
+			out = buffer;
+		}
+	}
+	EndLump( file, (bspHeader_t*) header, LUMP_BRUSHSIDES );
 
 	/* free buffer */
 	free( buffer );
@@ -225,17 +234,17 @@ static void CopyDrawSurfacesLump( ibspHeader_t *header ){
 
 
 static void AddDrawSurfacesLump( FILE *file, ibspHeader_t *header ){
-	int i, size;
+	int i, numChunk;
 	bspDrawSurface_t    *in;
 	ibspDrawSurface_t   *buffer, *out;
 
 
-	/* allocate output buffer */
-	size = numBSPDrawSurfaces * sizeof( *buffer );
-	buffer = safe_malloc( size );
-	memset( buffer, 0, size );
+	/* allocate chunk buffer */
+	buffer = safe_malloc( LUMP_CHUNK_ELEMENTS * sizeof( *buffer ) );
+	memset( buffer, 0, LUMP_CHUNK_ELEMENTS * sizeof( *buffer ) );
 
-	/* convert */
+	/* convert and write in chunks */
+	BeginLump( file, (bspHeader_t*) header, LUMP_SURFACES );
 	in = bspDrawSurfaces;
 	out = buffer;
 	for ( i = 0; i < numBSPDrawSurfaces; i++ )
@@ -264,10 +273,15 @@ static void AddDrawSurfacesLump( FILE *file, ibspHeader_t *header ){
 
 		in++;
 		out++;
-	}
 
-	/* write lump */
-	AddLump( file, (bspHeader_t*) header, LUMP_SURFACES, buffer, size );
+		/* flush */
+		numChunk = out - buffer;
+		if ( numChunk == LUMP_CHUNK_ELEMENTS || i == numBSPDrawSurfaces - 1 ) {
+			SafeWrite( file, buffer, numChunk * sizeof( *buffer ) );
+			out = buffer;
+		}
+	}
+	EndLump( file, (bspHeader_t*) header, LUMP_SURFACES );
 
 	/* free buffer */
 	free( buffer );
@@ -323,17 +337,17 @@ static void CopyDrawVertsLump( ibspHeader_t *header ){
 
 
 static void AddDrawVertsLump( FILE *file, ibspHeader_t *header ){
-	int i, size;
+	int i, numChunk;
 	bspDrawVert_t   *in;
 	ibspDrawVert_t  *buffer, *out;
 
 
-	/* allocate output buffer */
-	size = numBSPDrawVerts * sizeof( *buffer );
-	buffer = safe_malloc( size );
-	memset( buffer, 0, size );
+	/* allocate chunk buffer */
+	buffer = safe_malloc( LUMP_CHUNK_ELEMENTS * sizeof( *buffer ) );
+	memset( buffer, 0, LUMP_CHUNK_ELEMENTS * sizeof( *buffer ) );
 
-	/* convert */
+	/* convert and write in chunks */
+	BeginLump( file, (bspHeader_t*) header, LUMP_DRAWVERTS );
 	in = bspDrawVerts;
 	out = buffer;
 	for ( i = 0; i < numBSPDrawVerts; i++ )
@@ -354,10 +368,15 @@ static void AddDrawVertsLump( FILE *file, ibspHeader_t *header ){
 
 		in++;
 		out++;
-	}
 
-	/* write lump */
-	AddLump( file, (bspHeader_t*) header, LUMP_DRAWVERTS, buffer, size );
+		/* flush */
+		numChunk = out - buffer;
+		if ( numChunk == LUMP_CHUNK_ELEMENTS || i == numBSPDrawVerts - 1 ) {
+			SafeWrite( file, buffer, numChunk * sizeof( *buffer ) );
+			out = buffer;
+		}
+	}
+	EndLump( file, (bspHeader_t*) header, LUMP_DRAWVERTS );
 
 	/* free buffer */
 	free( buffer );
@@ -412,7 +431,7 @@ static void CopyLightGridLumps( ibspHeader_t *header ){
 
 
 static void AddLightGridLumps( FILE *file, ibspHeader_t *header ){
-	int i;
+	int i, numChunk;
 	bspGridPoint_t  *in;
 	ibspGridPoint_t *buffer, *out;
 
@@ -422,10 +441,11 @@ static void AddLightGridLumps( FILE *file, ibspHeader_t *header ){
 		return;
 	}
 
-	/* allocate temporary buffer */
-	buffer = safe_malloc( numBSPGridPoints * sizeof( *out ) );
+	/* allocate chunk buffer */
+	buffer = safe_malloc( LUMP_CHUNK_ELEMENTS * sizeof( *out ) );
 
-	/* convert */
+	/* convert and write in chunks */
+	BeginLump( file, (bspHeader_t*) header, LUMP_LIGHTGRID );
 	in = bspGridPoints;
 	out = buffer;
 	for ( i = 0; i < numBSPGridPoints; i++ )
@@ -438,10 +458,15 @@ static void AddLightGridLumps( FILE *file, ibspHeader_t *header ){
 
 		in++;
 		out++;
-	}
 
-	/* write lumps */
-	AddLump( file, (bspHeader_t*) header, LUMP_LIGHTGRID, buffer, ( numBSPGridPoints * sizeof( *out ) ) );
+		/* flush */
+		numChunk = out - buffer;
+		if ( numChunk == LUMP_CHUNK_ELEMENTS || i == numBSPGridPoints - 1 ) {
+			SafeWrite( file, buffer, numChunk * sizeof( *buffer ) );
+			out = buffer;
+		}
+	}
+	EndLump( file, (bspHeader_t*) header, LUMP_LIGHTGRID );
 
 	/* free buffer (ydnar 2002-10-22: [bug 641] thanks Rap70r! */
 	free( buffer );
@@ -456,8 +481,8 @@ void LoadIBSPFile( const char *filename ){
 	ibspHeader_t    *header;
 
 
-	/* load the file header */
-	LoadFile( filename, (void**) &header );
+	/* map the file */
+	MapBSPFile( filename, (void**) &header );
 
 	/* swap the header (except the first 4 bytes) */
 	SwapBlock( (int*) ( (byte*) header + sizeof( int ) ), sizeof( *header ) - sizeof( int ) );
@@ -515,8 +540,8 @@ void LoadIBSPFile( const char *filename ){
 		numBSPAds = 0;
 	}
 
-	/* free the file buffer */
-	free( header );
+	/* release the file */
+	UnmapBSPFile( header );
 }
 
 
@@ -545,7 +570,7 @@ void WriteIBSPFile( const char *filename ){
 	header->version = LittleLong( game->bspVersion );
 
 	/* write initial header */
-	file = SafeOpenWrite( filename );
+	file = OpenBSPFileWrite( filename );
 	SafeWrite( file, (bspHeader_t*) header, sizeof( *header ) );    /* overwritten later */
 
 	/* add marker lump */
@@ -215,8 +215,8 @@ void LoadRBSPFile( const char *filename ){
 	rbspHeader_t    *header;
 
 
-	/* load the file header */
-	LoadFile( filename, (void**) &header );
+	/* map the file */
+	MapBSPFile( filename, (void**) &header );
 
 	/* swap the header (except the first 4 bytes) */
 	SwapBlock( (int*) ( (byte*) header + sizeof( int ) ), sizeof( *header ) - sizeof( int ) );
@@ -270,8 +270,8 @@ void LoadRBSPFile( const char *filename ){
 
 	CopyLightGridLumps( header );
 
-	/* free the file buffer */
-	free( header );
+	/* release the file */
+	UnmapBSPFile( header );
 }
 
 
@@ -300,7 +300,7 @@ void WriteRBSPFile( const char *filename ){
 	header->version = LittleLong( game->bspVersion );
 
 	/* write initial header */
-	file = SafeOpenWrite( filename );
+	file = OpenBSPFileWrite( filename );
 	SafeWrite( file, (bspHeader_t*) header, sizeof( *header ) );    /* overwritten later */
 
 	/* add marker lump */
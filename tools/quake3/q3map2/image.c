@@ -331,81 +331,52 @@ image_t *ImageFind( const char *filename ){
 
 
 /*
-   ImageLoad()
-   loads an rgba image and returns a pointer to the image_t struct or NULL if not found
+   ImageDecode()
+   loads and decodes the first of name.tga/png/jpg/dds that exists
+   on success name is changed to the file that was found
+   on failure *pixels is NULL, anything else in it was allocated by the decoder
+   safe to call from worker threads
  */
 
-image_t *ImageLoad( const char *filename ){
-	int i;
-	image_t     *image;
-	char name[ 1024 ];
+static int ImageDecode( char *name, byte **pixels, int *width, int *height ){
 	int size;
-	byte        *buffer = NULL;
+	const byte  *buffer = NULL;
 
 
 	/* init */
-	ImageInit();
-
-	/* dummy check */
-	if ( filename == NULL || filename[ 0 ] == '\0' ) {
-		return NULL;
-	}
-
-	/* strip file extension off name */
-	strcpy( name, filename );
-	StripExtension( name );
-
-	/* try to find existing image */
-	image = ImageFind( name );
-	if ( image != NULL ) {
-		image->refCount++;
-		return image;
-	}
-
-	/* none found, so find first non-null image */
-	image = NULL;
-	for ( i = 0; i < MAX_IMAGES; i++ )
-	{
-		if ( images[ i ].name == NULL ) {
-			image = &images[ i ];
-			break;
-		}
-	}
-
-	/* too many images? */
-	if ( image == NULL ) {
-		Error( "MAX_IMAGES (%d) exceeded, there are too many image files referenced by the map.", MAX_IMAGES );
-	}
-
-	/* set it up */
-	image->name = safe_malloc( strlen( name ) + 1 );
-	strcpy( image->name, name );
+	*pixels = NULL;
+	*width = 0;
+	*height = 0;
 
 	/* attempt to load tga */
 	StripExtension( name );
 	strcat( name, ".tga" );
-	size = vfsLoadFile( (const char*) name, (void**) &buffer, 0 );
+	size = vfsMapFile( (const char*) name, (const void**) &buffer, 0 );
 	if ( size > 0 ) {
-		LoadTGABuffer( buffer, buffer + size, &image->pixels, &image->width, &image->height );
+		LoadTGABuffer( buffer, buffer + size, pixels, width, height );
 	}
 	else
 	{
 		/* attempt to load png */
 		StripExtension( name );
 		strcat( name, ".png" );
-		size = vfsLoadFile( (const char*) name, (void**) &buffer, 0 );
+		size = vfsMapFile( (const char*) name, (const void**) &buffer, 0 );
 		if ( size > 0 ) {
-			LoadPNGBuffer( name, buffer, size, &image->pixels, &image->width, &image->height );
+			LoadPNGBuffer( name, (byte*) buffer, size, pixels, width, height );
 		}
 		else
 		{
 			/* attempt to load jpg */
 			StripExtension( name );
 			strcat( name, ".jpg" );
-			size = vfsLoadFile( (const char*) name, (void**) &buffer, 0 );
+			size = vfsMapFile( (const char*) name, (const void**) &buffer, 0 );
 			if ( size > 0 ) {
-				if ( LoadJPGBuff( buffer, size, &image->pixels, &image->width, &image->height ) == -1 && image->pixels != NULL ) {
-					Sys_FPrintf( SYS_WRN, "WARNING: LoadJPGBuff: %s\n", (unsigned char*) image->pixels );
+				/* on failure LoadJPGBuff points pixels at its static error message */
+				if ( LoadJPGBuff( (void*) buffer, size, pixels, width, height ) == -1 ) {
+					if ( *pixels != NULL ) {
+						Sys_FPrintf( SYS_WRN, "WARNING: LoadJPGBuff: %s\n", (unsigned char*) *pixels );
+					}
+					*pixels = NULL;
 				}
 			}
 			else
@@ -413,9 +384,9 @@ image_t *ImageLoad( const char *filename ){
 				/* attempt to load dds */
 				StripExtension( name );
 				strcat( name, ".dds" );
-				size = vfsLoadFile( (const char*) name, (void**) &buffer, 0 );
+				size = vfsMapFile( (const char*) name, (const void**) &buffer, 0 );
 				if ( size > 0 ) {
-					LoadDDSBuffer( buffer, size, &image->pixels, &image->width, &image->height );
+					LoadDDSBuffer( (byte*) buffer, size, pixels, width, height );
 
 					/* debug code */
 					#if 1
@@ -423,10 +394,10 @@ image_t *ImageLoad( const char *filename ){
 						ddsPF_t pf;
 						DDSGetInfo( (ddsBuffer_t*) buffer, NULL, NULL, &pf );
 						Sys_Printf( "pf = %d\n", pf );
-						if ( image->width > 0 ) {
+						if ( *width > 0 ) {
 							StripExtension( name );
 							strcat( name, "_converted.tga" );
-							WriteTGA( "C:\\games\\quake3\\baseq3\\textures\\rad\\dds_converted.tga", image->pixels, image->width, image->height );
+							WriteTGA( "C:\\games\\quake3\\baseq3\\textures\\rad\\dds_converted.tga", *pixels, *width, *height );
 						}
 					}
 					#endif
@@ -435,8 +406,67 @@ image_t *ImageLoad( const char *filename ){
 		}
 	}
 
-	/* free file buffer */
-	free( buffer );
+	/* release file buffer */
+	vfsFreeMappedFile( buffer );
+
+	/* return size of the image file */
+	return size;
+}
+
+
+
+/*
+   ImageLoad()
+   loads an rgba image and returns a pointer to the image_t struct or NULL if not found
+ */
+
+image_t *ImageLoad( const char *filename ){
+	int i;
+	image_t     *image;
+	char name[ 1024 ];
+	int size;
+
+
+	/* init */
+	ImageInit();
+
+	/* dummy check */
+	if ( filename == NULL || filename[ 0 ] == '\0' ) {
+		return NULL;
+	}
+
+	/* strip file extension off name */
+	strcpy( name, filename );
+	StripExtension( name );
+
+	/* try to find existing image */
+	image = ImageFind( name );
+	if ( image != NULL ) {
+		image->refCount++;
+		return image;
+	}
+
+	/* none found, so find first non-null image */
+	image = NULL;
+	for ( i = 0; i < MAX_IMAGES; i++ )
+	{
+		if ( images[ i ].name == NULL ) {
+			image = &images[ i ];
+			break;
+		}
+	}
+
+	/* too many images? */
+	if ( image == NULL ) {
+		Error( "MAX_IMAGES (%d) exceeded, there are too many image files referenced by the map.", MAX_IMAGES );
+	}
+
+	/* set it up */
+	image->name = safe_malloc( strlen( name ) + 1 );
+	strcpy( image->name, name );
+
+	/* load it */
+	size = ImageDecode( name, &image->pixels, &image->width, &image->height );
 
 	/* make sure everything's kosher */
 	if ( size <= 0 || image->width <= 0 || image->height <= 0 || image->pixels == NULL ) {
@@ -458,3 +488,127 @@ image_t *ImageLoad( const char *filename ){
 	/* return the image */
 	return image;
 }
+
+
+
+/*
+   ImagePreload()
+   decodes a set of images on worker threads so later ImageLoad calls find them ready
+   preloaded images start out unreferenced, ImageLoad takes the first reference
+ */
+
+typedef struct preloadImage_s
+{
+	char name[ 1024 ];
+	byte        *pixels;
+	int width, height;
+}
+preloadImage_t;
+
+static preloadImage_t   *preloadImages;
+
+static void ImagePreloadThread( int num ){
+	preloadImage_t  *pi = &preloadImages[ num ];
+
+	if ( ImageDecode( pi->name, &pi->pixels, &pi->width, &pi->height ) <= 0 || pi->pixels == NULL || pi->width <= 0 || pi->height <= 0 ) {
+		free( pi->pixels );
+		pi->pixels = NULL;
+	}
+}
+
+static int ImagePreloadCompare( const void *a, const void *b ){
+	return strcmp( ( (const preloadImage_t*) a )->name, ( (const preloadImage_t*) b )->name );
+}
+
+void ImagePreload( int numNames, const char **names ){
+	int i, j, numPreload, numLoaded;
+	image_t     *image;
+	char name[ 1024 ];
+
+
+	/* init */
+	ImageInit();
+	if ( numNames <= 0 ) {
+		return;
+	}
+
+	/* collect images that aren't loaded yet */
+	preloadImages = safe_malloc( sizeof( preloadImage_t ) * numNames );
+	memset( preloadImages, 0, sizeof( preloadImage_t ) * numNames );
+	numPreload = 0;
+	for ( i = 0; i < numNames; i++ )
+	{
+		if ( names[ i ] == NULL || names[ i ][ 0 ] == '\0' || strlen( names[ i ] ) >= sizeof( name ) - 16 ) {
+			continue;
+		}
+		strcpy( name, names[ i ] );
+		StripExtension( name );
+		if ( ImageFind( name ) != NULL ) {
+			continue;
+		}
+		strcpy( preloadImages[ numPreload++ ].name, name );
+	}
+
+	/* remove duplicates */
+	qsort( preloadImages, numPreload, sizeof( preloadImage_t ), ImagePreloadCompare );
+	for ( i = 0, j = 0; i < numPreload; i++ )
+	{
+		if ( j > 0 && !strcmp( preloadImages[ j - 1 ].name, preloadImages[ i ].name ) ) {
+			continue;
+		}
+		if ( i != j ) {
+			memcpy( &preloadImages[ j ], &preloadImages[ i ], sizeof( preloadImage_t ) );
+		}
+		j++;
+	}
+	numPreload = j;
+
+	/* decode */
+	Sys_FPrintf( SYS_VRB, "--- ImagePreload ---\n" );
+	RunThreadsOnIndividual( numPreload, qfalse, ImagePreloadThread );
+
+	/* register the decoded images */
+	numLoaded = 0;
+	for ( i = 0; i < numPreload; i++ )
+	{
+		preloadImage_t  *pi = &preloadImages[ i ];
+
+		if ( pi->pixels == NULL ) {
+			continue;
+		}
+
+		/* find a free slot */
+		image = NULL;
+		for ( j = 0; j < MAX_IMAGES; j++ )
+		{
+			if ( images[ j ].name == NULL ) {
+				image = &images[ j ];
+				break;
+			}
+		}
+		if ( image == NULL ) {
+			free( pi->pixels );
+			continue;
+		}
+
+		/* the filename keeps its extension, the name doesn't */
+		image->filename = safe_malloc( strlen( pi->name ) + 1 );
+		strcpy( image->filename, pi->name );
+		StripExtension( pi->name );
+		image->name = safe_malloc( strlen( pi->name ) + 1 );
+		strcpy( image->name, pi->name );
+		image->pixels = pi->pixels;
+		image->width = pi->width;
+		image->height = pi->height;
+		image->refCount = 0;
+		numImages++;
+		numLoaded++;
+	}
+
+	/* emit some statistics */
+	Sys_FPrintf( SYS_VRB, "%9d images preloaded (%d requested)\n", numLoaded, numPreload );
+
+	/* clean up */
+	free( preloadImages );
+	preloadImages = NULL;
+}
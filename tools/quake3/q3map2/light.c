@@ -2249,6 +2249,10 @@ int LightMain( int argc, char **argv ){
 			noSurfaces = qtrue;
 			Sys_Printf( "Not tracing against surfaces\n" );
 		}
+		else if ( !strcmp( argv[ i ], "-noinstancing" ) ) {
+			noModelInstancing = qtrue;
+			Sys_Printf( "Not instancing entity models for tracing\n" );
+		}
 		else if ( !strcmp( argv[ i ], "-dump" ) ) {
 			dump = qtrue;
 			Sys_Printf( "Dumping radiosity lights into numbered prefabs\n" );
@@ -2352,6 +2356,15 @@ int LightMain( int argc, char **argv ){
 	/* load bsp file */
 	LoadBSPFile( source );
 
+	/* decode the images of the shaders it uses up front */
+	if ( numBSPShaders > 0 ) {
+		const char  **shaderNames = safe_malloc( sizeof( *shaderNames ) * numBSPShaders );
+		for ( i = 0; i < numBSPShaders; i++ )
+			shaderNames[ i ] = bspShaders[ i ].shader;
+		PreloadShaderImages( numBSPShaders, shaderNames );
+		free( shaderNames );
+	}
+
 	/* parse bsp entities */
 	ParseEntities();
 
@@ -121,6 +121,60 @@ int numTraceNodes = 0, maxTraceNodes = 0;
 traceNode_t                     *traceNodes = NULL;
 
 
+/* instanced models: each model used by more than one shadow casting entity keeps its triangles
+   once, in model space, under its own bvh, and the instances are found through a second bvh
+   over their world bounds */
+
+#define GROW_TRACE_MODELS       64
+#define GROW_TRACE_INSTANCES    1024
+#define GROW_TRACE_BVH_NODES    4096
+#define MAX_BVH_LEAF_ITEMS      4
+#define MAX_BVH_DEPTH           48
+
+typedef struct traceBVHNode_s
+{
+	vec3_t mins, maxs;
+	int children[ 2 ];                  /* -1 on leaves */
+	int firstItem, numItems;
+}
+traceBVHNode_t;
+
+typedef struct traceModel_s
+{
+	picoModel_t                 *model;
+	int castShadows;
+	int numInstances;
+	int firstTriangle, numTriangles;    /* into traceModelTriangles and traceModelItems */
+	int headNode;
+	vec3_t mins, maxs;
+}
+traceModel_t;
+
+typedef struct traceInstance_s
+{
+	int modelNum;
+	m4x4_t transform, inverse;
+	vec_t volume;                       /* abs determinant of transform, for the model space epsilons */
+	vec3_t mins, maxs;
+}
+traceInstance_t;
+
+int numTraceModels = 0, maxTraceModels = 0;
+traceModel_t                    *traceModels = NULL;
+
+int numTraceInstances = 0, maxTraceInstances = 0;
+traceInstance_t                 *traceInstances = NULL;
+int                             *traceInstanceItems = NULL;
+int instanceHeadNode = -1;
+
+int numTraceModelTriangles = 0, maxTraceModelTriangles = 0;
+traceTriangle_t                 *traceModelTriangles = NULL;
+int                             *traceModelItems = NULL;
+
+int numTraceBVHNodes = 0, maxTraceBVHNodes = 0;
+traceBVHNode_t                  *traceBVHNodes = NULL;
+
+
 
 /* -------------------------------------------------------------------------------
 
@@ -1140,6 +1194,397 @@ static void PopulateWithPicoModel( int castShadows, picoModel_t *model, m4x4_t t
 
 
 
+/*
+   AllocTraceBVHNode()
+   allocates a new bvh node for instanced model tracing
+ */
+
+static int AllocTraceBVHNode( void ){
+	traceBVHNode_t  *temp;
+
+
+	/* enough space? */
+	if ( numTraceBVHNodes >= maxTraceBVHNodes ) {
+		maxTraceBVHNodes += GROW_TRACE_BVH_NODES;
+		temp = safe_malloc( maxTraceBVHNodes * sizeof( traceBVHNode_t ) );
+		if ( traceBVHNodes != NULL ) {
+			memcpy( temp, traceBVHNodes, numTraceBVHNodes * sizeof( traceBVHNode_t ) );
+			free( traceBVHNodes );
+		}
+		traceBVHNodes = temp;
+	}
+
+	/* add the node */
+	memset( &traceBVHNodes[ numTraceBVHNodes ], 0, sizeof( traceBVHNode_t ) );
+	traceBVHNodes[ numTraceBVHNodes ].children[ 0 ] = -1;
+	traceBVHNodes[ numTraceBVHNodes ].children[ 1 ] = -1;
+	numTraceBVHNodes++;
+
+	/* return the node number */
+	return ( numTraceBVHNodes - 1 );
+}
+
+
+
+/*
+   BuildTraceBVH_r()
+   builds a bvh over item boxes, reordering items[ first ] .. items[ first + numItems - 1 ] in place
+   item values index the box arrays
+ */
+
+static int BuildTraceBVH_r( int *items, int first, int numItems, vec3_t *itemMins, vec3_t *itemMaxs, int depth ){
+	int i, nodeNum, axis, numFront, item, child;
+	vec3_t cMins, cMaxs, center;
+	float split;
+	traceBVHNode_t  *node;
+
+
+	/* allocate the node and find its bounds */
+	nodeNum = AllocTraceBVHNode();
+	node = &traceBVHNodes[ nodeNum ];
+	ClearBounds( node->mins, node->maxs );
+	ClearBounds( cMins, cMaxs );
+	for ( i = first; i < first + numItems; i++ )
+	{
+		item = items[ i ];
+		AddPointToBounds( itemMins[ item ], node->mins, node->maxs );
+		AddPointToBounds( itemMaxs[ item ], node->mins, node->maxs );
+		VectorAdd( itemMins[ item ], itemMaxs[ item ], center );
+		VectorScale( center, 0.5f, center );
+		AddPointToBounds( center, cMins, cMaxs );
+	}
+	node->firstItem = first;
+	node->numItems = numItems;
+
+	/* leaf? */
+	if ( numItems <= MAX_BVH_LEAF_ITEMS || depth >= MAX_BVH_DEPTH ) {
+		return nodeNum;
+	}
+
+	/* split the longest axis of the item centers in the middle */
+	axis = 0;
+	for ( i = 1; i < 3; i++ )
+	{
+		if ( ( cMaxs[ i ] - cMins[ i ] ) > ( cMaxs[ axis ] - cMins[ axis ] ) ) {
+			axis = i;
+		}
+	}
+	split = ( cMins[ axis ] + cMaxs[ axis ] ) * 0.5f;
+
+	/* partition */
+	numFront = 0;
+	for ( i = first; i < first + numItems; i++ )
+	{
+		item = items[ i ];
+		if ( ( itemMins[ item ][ axis ] + itemMaxs[ item ][ axis ] ) * 0.5f < split ) {
+			items[ i ] = items[ first + numFront ];
+			items[ first + numFront ] = item;
+			numFront++;
+		}
+	}
+
+	/* all on one side (coincident centers), so split by count */
+	if ( numFront == 0 || numFront == numItems ) {
+		numFront = numItems / 2;
+	}
+
+	/* recurse (note: the node array may move) */
+	child = BuildTraceBVH_r( items, first, numFront, itemMins, itemMaxs, depth + 1 );
+	traceBVHNodes[ nodeNum ].children[ 0 ] = child;
+	child = BuildTraceBVH_r( items, first + numFront, numItems - numFront, itemMins, itemMaxs, depth + 1 );
+	traceBVHNodes[ nodeNum ].children[ 1 ] = child;
+	traceBVHNodes[ nodeNum ].numItems = 0;
+
+	/* return the node */
+	return nodeNum;
+}
+
+
+
+/*
+   AddTraceModelInstance()
+   records a shadow casting entity model, deferring the choice between baking and instancing it
+ */
+
+static void AddTraceModelInstance( int castShadows, picoModel_t *model, m4x4_t transform ){
+	int i;
+	void            *temp;
+	traceModel_t    *tm;
+	traceInstance_t *inst;
+
+
+	/* dummy check */
+	if ( model == NULL || transform == NULL ) {
+		return;
+	}
+
+	/* find the model */
+	for ( i = 0; i < numTraceModels; i++ )
+	{
+		if ( traceModels[ i ].model == model && traceModels[ i ].castShadows == castShadows ) {
+			break;
+		}
+	}
+
+	/* add a new one */
+	if ( i == numTraceModels ) {
+		if ( numTraceModels >= maxTraceModels ) {
+			maxTraceModels += GROW_TRACE_MODELS;
+			temp = safe_malloc( maxTraceModels * sizeof( *traceModels ) );
+			if ( traceModels != NULL ) {
+				memcpy( temp, traceModels, numTraceModels * sizeof( *traceModels ) );
+				free( traceModels );
+			}
+			traceModels = (traceModel_t*) temp;
+		}
+		tm = &traceModels[ numTraceModels++ ];
+		memset( tm, 0, sizeof( *tm ) );
+		tm->model = model;
+		tm->castShadows = castShadows;
+		tm->headNode = -1;
+	}
+	tm = &traceModels[ i ];
+
+	/* add the instance */
+	if ( numTraceInstances >= maxTraceInstances ) {
+		maxTraceInstances += GROW_TRACE_INSTANCES;
+		temp = safe_malloc( maxTraceInstances * sizeof( *traceInstances ) );
+		if ( traceInstances != NULL ) {
+			memcpy( temp, traceInstances, numTraceInstances * sizeof( *traceInstances ) );
+			free( traceInstances );
+		}
+		traceInstances = (traceInstance_t*) temp;
+	}
+	inst = &traceInstances[ numTraceInstances ];
+	inst->modelNum = i;
+	memcpy( inst->transform, transform, sizeof( m4x4_t ) );
+	memcpy( inst->inverse, transform, sizeof( m4x4_t ) );
+
+	/* singular transforms can't be traced in model space, so bake them right away */
+	if ( m4x4_invert( inst->inverse ) ) {
+		PopulateWithPicoModel( castShadows, model, transform );
+		return;
+	}
+	inst->volume = fabs( transform[ 0 ] * ( transform[ 5 ] * transform[ 10 ] - transform[ 6 ] * transform[ 9 ] )
+						 - transform[ 1 ] * ( transform[ 4 ] * transform[ 10 ] - transform[ 6 ] * transform[ 8 ] )
+						 + transform[ 2 ] * ( transform[ 4 ] * transform[ 9 ] - transform[ 5 ] * transform[ 8 ] ) );
+	numTraceInstances++;
+	tm->numInstances++;
+}
+
+
+
+/*
+   AddTraceModelTriangles()
+   stores a model's shadow casting triangles once, in model space
+   uses the same surface rules as PopulateWithPicoModel()
+ */
+
+static void AddTraceModelTriangles( traceModel_t *tm ){
+	int i, j, k, numSurfaces, numIndexes, infoNum;
+	picoSurface_t       *surface;
+	picoShader_t        *shader;
+	picoVec_t           *xyz, *st;
+	picoIndex_t         *indexes;
+	traceInfo_t ti;
+	traceTriangle_t     *tt;
+	void                *temp;
+
+
+	/* setup */
+	tm->firstTriangle = numTraceModelTriangles;
+	tm->numTriangles = 0;
+	ClearBounds( tm->mins, tm->maxs );
+
+	/* walk the list of surfaces */
+	numSurfaces = PicoGetModelNumSurfaces( tm->model );
+	for ( i = 0; i < numSurfaces; i++ )
+	{
+		/* get surface */
+		surface = PicoGetModelSurface( tm->model, i );
+		if ( surface == NULL || PicoGetSurfaceType( surface ) != PICO_TRIANGLES ) {
+			continue;
+		}
+
+		/* get shader */
+		shader = PicoGetSurfaceShader( surface );
+		if ( shader == NULL ) {
+			continue;
+		}
+		ti.si = ShaderInfoForShaderNull( PicoGetShaderName( shader ) );
+		if ( ti.si == NULL ) {
+			continue;
+		}
+
+		/* translucent surfaces that are neither alphashadow or lightfilter don't cast shadows */
+		if ( ( ti.si->compileFlags & C_NODRAW ) ) {
+			continue;
+		}
+		if ( ( ti.si->compileFlags & C_TRANSLUCENT ) &&
+			 !( ti.si->compileFlags & C_ALPHASHADOW ) &&
+			 !( ti.si->compileFlags & C_LIGHTFILTER ) ) {
+			continue;
+		}
+
+		/* setup trace info */
+		ti.castShadows = tm->castShadows;
+		ti.surfaceNum = -1;
+		infoNum = AddTraceInfo( &ti );
+
+		/* walk the triangle list */
+		numIndexes = PicoGetSurfaceNumIndexes( surface );
+		indexes = PicoGetSurfaceIndexes( surface, 0 );
+		for ( j = 0; j + 2 < numIndexes; j += 3, indexes += 3 )
+		{
+			/* enough space? */
+			if ( numTraceModelTriangles >= maxTraceModelTriangles ) {
+				maxTraceModelTriangles += GROW_TRACE_TRIANGLES;
+				temp = safe_malloc( maxTraceModelTriangles * sizeof( *traceModelTriangles ) );
+				if ( traceModelTriangles != NULL ) {
+					memcpy( temp, traceModelTriangles, numTraceModelTriangles * sizeof( *traceModelTriangles ) );
+					free( traceModelTriangles );
+				}
+				traceModelTriangles = (traceTriangle_t*) temp;
+			}
+
+			/* add the triangle */
+			tt = &traceModelTriangles[ numTraceModelTriangles++ ];
+			tt->infoNum = infoNum;
+			for ( k = 0; k < 3; k++ )
+			{
+				xyz = PicoGetSurfaceXYZ( surface, indexes[ k ] );
+				st = PicoGetSurfaceST( surface, 0, indexes[ k ] );
+				VectorCopy( xyz, tt->v[ k ].xyz );
+				Vector2Copy( st, tt->v[ k ].st );
+				AddPointToBounds( tt->v[ k ].xyz, tm->mins, tm->maxs );
+			}
+			VectorSubtract( tt->v[ 1 ].xyz, tt->v[ 0 ].xyz, tt->edge1 );
+			VectorSubtract( tt->v[ 2 ].xyz, tt->v[ 0 ].xyz, tt->edge2 );
+			tm->numTriangles++;
+		}
+	}
+}
+
+
+
+/*
+   SetupTraceModelInstances()
+   bakes models used once into the trace tree and builds the two-level bvh for the others
+ */
+
+static void SetupTraceModelInstances( void ){
+	int i, j, k, numInstanced, numInstances;
+	traceModel_t    *tm;
+	traceInstance_t *inst;
+	traceTriangle_t *tt;
+	vec3_t          *itemMins, *itemMaxs, corner;
+	float savedMB;
+
+
+	/* walk the models */
+	numInstanced = 0;
+	savedMB = 0.0f;
+	for ( i = 0; i < numTraceModels; i++ )
+	{
+		tm = &traceModels[ i ];
+
+		/* models used once (or everything when disabled) go into the tree as before */
+		if ( tm->numInstances < 2 || noModelInstancing ) {
+			for ( j = 0; j < numTraceInstances; j++ )
+			{
+				if ( traceInstances[ j ].modelNum == i ) {
+					PopulateWithPicoModel( tm->castShadows, tm->model, traceInstances[ j ].transform );
+					traceInstances[ j ].modelNum = -1;
+				}
+			}
+			continue;
+		}
+
+		/* store the triangles once */
+		AddTraceModelTriangles( tm );
+		numInstanced++;
+		savedMB += (float) ( ( tm->numInstances - 1 ) * tm->numTriangles * sizeof( traceTriangle_t ) ) / ( 1024.0f * 1024.0f );
+	}
+
+	/* nothing instanced? */
+	if ( numInstanced == 0 ) {
+		numTraceInstances = 0;
+		return;
+	}
+
+	/* build the per-model bvhs */
+	traceModelItems = safe_malloc( numTraceModelTriangles * sizeof( *traceModelItems ) + 1 );
+	itemMins = safe_malloc( numTraceModelTriangles * sizeof( *itemMins ) + 1 );
+	itemMaxs = safe_malloc( numTraceModelTriangles * sizeof( *itemMaxs ) + 1 );
+	for ( i = 0; i < numTraceModelTriangles; i++ )
+	{
+		tt = &traceModelTriangles[ i ];
+		traceModelItems[ i ] = i;
+		ClearBounds( itemMins[ i ], itemMaxs[ i ] );
+		for ( k = 0; k < 3; k++ )
+			AddPointToBounds( tt->v[ k ].xyz, itemMins[ i ], itemMaxs[ i ] );
+	}
+	for ( i = 0; i < numTraceModels; i++ )
+	{
+		tm = &traceModels[ i ];
+		if ( tm->numTriangles > 0 ) {
+			tm->headNode = BuildTraceBVH_r( traceModelItems, tm->firstTriangle, tm->numTriangles, itemMins, itemMaxs, 0 );
+		}
+	}
+	free( itemMins );
+	free( itemMaxs );
+
+	/* drop baked and empty instances, and find world bounds for the rest */
+	numInstances = 0;
+	for ( i = 0; i < numTraceInstances; i++ )
+	{
+		inst = &traceInstances[ i ];
+		if ( inst->modelNum < 0 || traceModels[ inst->modelNum ].headNode < 0 ) {
+			continue;
+		}
+		tm = &traceModels[ inst->modelNum ];
+		ClearBounds( inst->mins, inst->maxs );
+		for ( k = 0; k < 8; k++ )
+		{
+			corner[ 0 ] = ( k & 1 ) ? tm->maxs[ 0 ] : tm->mins[ 0 ];
+			corner[ 1 ] = ( k & 2 ) ? tm->maxs[ 1 ] : tm->mins[ 1 ];
+			corner[ 2 ] = ( k & 4 ) ? tm->maxs[ 2 ] : tm->mins[ 2 ];
+			m4x4_transform_point( inst->transform, corner );
+			AddPointToBounds( corner, inst->mins, inst->maxs );
+		}
+		if ( i != numInstances ) {
+			memcpy( &traceInstances[ numInstances ], inst, sizeof( *inst ) );
+		}
+		numInstances++;
+	}
+	numTraceInstances = numInstances;
+
+	/* build the instance bvh */
+	if ( numTraceInstances > 0 ) {
+		traceInstanceItems = safe_malloc( numTraceInstances * sizeof( *traceInstanceItems ) );
+		itemMins = safe_malloc( numTraceInstances * sizeof( *itemMins ) );
+		itemMaxs = safe_malloc( numTraceInstances * sizeof( *itemMaxs ) );
+		for ( i = 0; i < numTraceInstances; i++ )
+		{
+			traceInstanceItems[ i ] = i;
+			VectorCopy( traceInstances[ i ].mins, itemMins[ i ] );
+			VectorCopy( traceInstances[ i ].maxs, itemMaxs[ i ] );
+		}
+		instanceHeadNode = BuildTraceBVH_r( traceInstanceItems, 0, numTraceInstances, itemMins, itemMaxs, 0 );
+		free( itemMins );
+		free( itemMaxs );
+	}
+
+	/* emit some stats */
+	Sys_FPrintf( SYS_VRB, "%9d instanced models\n", numInstanced );
+	Sys_FPrintf( SYS_VRB, "%9d model instances\n", numTraceInstances );
+	Sys_FPrintf( SYS_VRB, "%9d instanced model triangles (%.2fMB)\n", numTraceModelTriangles, (float) ( numTraceModelTriangles * sizeof( *traceModelTriangles ) ) / ( 1024.0f * 1024.0f ) );
+	Sys_FPrintf( SYS_VRB, "%9d bvh nodes (%.2fMB)\n", numTraceBVHNodes, (float) ( numTraceBVHNodes * sizeof( *traceBVHNodes ) ) / ( 1024.0f * 1024.0f ) );
+	Sys_Printf( "Model instancing saved %.2fMB of trace triangles\n", savedMB );
+}
+
+
+
 /*
    PopulateTraceNodes() - ydnar
    fills the raytracing tree with world and entity occluders
@@ -1231,7 +1676,7 @@ static void PopulateTraceNodes( void ){
 			if ( model == NULL ) {
 				continue;
 			}
-			PopulateWithPicoModel( castShadows, model, transform );
+			AddTraceModelInstance( castShadows, model, transform );
 			continue;
 		}
 
@@ -1261,10 +1706,13 @@ static void PopulateTraceNodes( void ){
 			if ( model == NULL ) {
 				continue;
 			}
-			PopulateWithPicoModel( castShadows, model, transform );
+			AddTraceModelInstance( castShadows, model, transform );
 			continue;
 		}
 	}
+
+	/* bake single models into the tree and set up instancing for the rest */
+	SetupTraceModelInstances();
 }
 
 
@@ -1378,7 +1826,14 @@ void SetupTraceNodes( void ){
 #define NEAR_SHADOW_EPSILON     1.5f    //%	1.25f
 #define SELF_SHADOW_EPSILON     0.5f
 
-qboolean TraceTriangle( traceInfo_t *ti, traceTriangle_t *tt, trace_t *trace ){
+/*
+   TraceTriangleScaled()
+   the epsilons above are world space sizes, instanced models are traced in model space
+   lengthScale takes a distance along the trace into the triangle's space, coplanarScale
+   does the same for the determinant (length squared, stretched by the transform's volume)
+ */
+
+static qboolean TraceTriangleScaled( traceInfo_t *ti, traceTriangle_t *tt, trace_t *trace, float lengthScale, float coplanarScale ){
 	int i;
 	float tvec[ 3 ], pvec[ 3 ], qvec[ 3 ];
 	float det, invDet, depth;
@@ -1425,7 +1880,7 @@ qboolean TraceTriangle( traceInfo_t *ti, traceTriangle_t *tt, trace_t *trace ){
 	det = DotProduct( tt->edge1, pvec );
 
 	/* the non-culling branch */
-	if ( fabs( det ) < COPLANAR_EPSILON ) {
+	if ( fabs( det ) < COPLANAR_EPSILON * coplanarScale ) {
 		return qfalse;
 	}
 	invDet = 1.0f / det;
@@ -1455,7 +1910,7 @@ qboolean TraceTriangle( traceInfo_t *ti, traceTriangle_t *tt, trace_t *trace ){
 	}
 
 	/* if hitpoint is really close to trace origin (sample point), then check for self-shadowing */
-	if ( depth <= SELF_SHADOW_EPSILON ) {
+	if ( depth <= SELF_SHADOW_EPSILON * lengthScale ) {
 		/* don't self-shadow */
 		for ( i = 0; i < trace->numSurfaces; i++ )
 		{
@@ -1530,6 +1985,10 @@ qboolean TraceTriangle( traceInfo_t *ti, traceTriangle_t *tt, trace_t *trace ){
 	return qfalse;
 }
 
+qboolean TraceTriangle( traceInfo_t *ti, traceTriangle_t *tt, trace_t *trace ){
+	return TraceTriangleScaled( ti, tt, trace, 1.0f, 1.0f );
+}
+
 
 
 /*
@@ -1674,6 +2133,174 @@ static qboolean TraceLine_r( int nodeNum, vec3_t origin, vec3_t end, trace_t *tr
 
 
 
+/*
+   TraceBVHBox()
+   slab test of a ray against a bvh node's bounds
+ */
+
+static qboolean TraceBVHBox( traceBVHNode_t *node, vec3_t origin, vec3_t invDir, float distance ){
+	int i;
+	float t0, t1, tNear, tFar, temp;
+
+
+	tNear = 0.0f;
+	tFar = distance;
+	for ( i = 0; i < 3; i++ )
+	{
+		t0 = ( node->mins[ i ] - TRACE_ON_EPSILON - origin[ i ] ) * invDir[ i ];
+		t1 = ( node->maxs[ i ] + TRACE_ON_EPSILON - origin[ i ] ) * invDir[ i ];
+		if ( t0 > t1 ) {
+			temp = t0;
+			t0 = t1;
+			t1 = temp;
+		}
+		if ( t0 > tNear ) {
+			tNear = t0;
+		}
+		if ( t1 < tFar ) {
+			tFar = t1;
+		}
+		if ( tNear > tFar ) {
+			return qfalse;
+		}
+	}
+	return qtrue;
+}
+
+static void TraceInvDir( vec3_t direction, vec3_t invDir ){
+	int i;
+
+	for ( i = 0; i < 3; i++ )
+		invDir[ i ] = fabs( direction[ i ] ) > 0.000001f ? 1.0f / direction[ i ] : ( direction[ i ] < 0.0f ? -1.0e30f : 1.0e30f );
+}
+
+
+
+/*
+   TraceModelInstance()
+   traces an instanced model by moving the trace into model space
+   returns qtrue if something is hit and tracing can stop
+ */
+
+static qboolean TraceModelInstance( traceInstance_t *inst, trace_t *trace ){
+	int i, sp, stack[ MAX_BVH_DEPTH * 2 + 2 ];
+	traceModel_t    *tm;
+	traceBVHNode_t  *node;
+	traceTriangle_t *tt;
+	vec3_t origin, end, direction, displacement, invDir;
+	vec_t distance, inhibitRadius, lengthScale, coplanarScale;
+	qboolean r;
+
+
+	/* save the world space trace */
+	VectorCopy( trace->origin, origin );
+	VectorCopy( trace->end, end );
+	VectorCopy( trace->direction, direction );
+	distance = trace->distance;
+	inhibitRadius = trace->inhibitRadius;
+
+	/* move it into model space */
+	m4x4_transform_point( inst->inverse, trace->origin );
+	m4x4_transform_point( inst->inverse, trace->end );
+	VectorSubtract( trace->end, trace->origin, displacement );
+	trace->distance = VectorNormalize( displacement, trace->direction );
+	r = qfalse;
+	if ( trace->distance > 0.00001f ) {
+		/* a world space length along the trace is this long in model space, the
+		   determinant of a world space triangle comes out volume * lengthScale times bigger */
+		lengthScale = trace->distance / distance;
+		coplanarScale = 1.0f / ( inst->volume * lengthScale );
+		trace->inhibitRadius = inhibitRadius * lengthScale;
+		TraceInvDir( trace->direction, invDir );
+
+		/* walk the model's bvh */
+		tm = &traceModels[ inst->modelNum ];
+		sp = 0;
+		stack[ sp++ ] = tm->headNode;
+		while ( sp > 0 && !r )
+		{
+			node = &traceBVHNodes[ stack[ --sp ] ];
+			if ( !TraceBVHBox( node, trace->origin, invDir, trace->distance ) ) {
+				continue;
+			}
+			if ( node->children[ 0 ] >= 0 ) {
+				stack[ sp++ ] = node->children[ 0 ];
+				stack[ sp++ ] = node->children[ 1 ];
+				continue;
+			}
+			for ( i = 0; i < node->numItems; i++ )
+			{
+				tt = &traceModelTriangles[ traceModelItems[ node->firstItem + i ] ];
+				if ( TraceTriangleScaled( &traceInfos[ tt->infoNum ], tt, trace, lengthScale, coplanarScale ) ) {
+					r = qtrue;
+					break;
+				}
+			}
+		}
+
+		/* move the hit back into world space */
+		if ( r ) {
+			m4x4_transform_point( inst->transform, trace->hit );
+		}
+	}
+
+	/* restore the world space trace */
+	VectorCopy( origin, trace->origin );
+	VectorCopy( end, trace->end );
+	VectorCopy( direction, trace->direction );
+	trace->distance = distance;
+	trace->inhibitRadius = inhibitRadius;
+	return r;
+}
+
+
+
+/*
+   TraceModelInstances()
+   traces the instanced models through the instance bvh
+   returns qtrue if something is hit and tracing can stop
+ */
+
+static qboolean TraceModelInstances( trace_t *trace ){
+	int i, sp, stack[ MAX_BVH_DEPTH * 2 + 2 ];
+	traceBVHNode_t  *node;
+	vec3_t invDir;
+
+
+	/* any? */
+	if ( instanceHeadNode < 0 ) {
+		return qfalse;
+	}
+
+	/* walk the instance bvh */
+	TraceInvDir( trace->direction, invDir );
+	sp = 0;
+	stack[ sp++ ] = instanceHeadNode;
+	while ( sp > 0 )
+	{
+		node = &traceBVHNodes[ stack[ --sp ] ];
+		if ( !TraceBVHBox( node, trace->origin, invDir, trace->distance ) ) {
+			continue;
+		}
+		if ( node->children[ 0 ] >= 0 ) {
+			stack[ sp++ ] = node->children[ 0 ];
+			stack[ sp++ ] = node->children[ 1 ];
+			continue;
+		}
+		for ( i = 0; i < node->numItems; i++ )
+		{
+			if ( TraceModelInstance( &traceInstances[ traceInstanceItems[ node->firstItem + i ] ], trace ) ) {
+				return qtrue;
+			}
+		}
+	}
+
+	/* nothing opaque hit */
+	return qfalse;
+}
+
+
+
 /*
    TraceLine() - ydnar
    rewrote this function a bit :)
@@ -1735,6 +2362,9 @@ void TraceLine( trace_t *trace ){
 			//%		return;
 		}
 	}
+
+	/* trace instanced models */
+	TraceModelInstances( trace );
 }
 
 
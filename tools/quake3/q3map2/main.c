@@ -164,6 +164,8 @@ int main( int argc, char **argv ){
 	PicoSetPrintFunc( PicoPrintFunc );
 	PicoSetLoadFileFunc( PicoLoadFileFunc );
 	PicoSetFreeFileFunc( free );
+	PicoSetMapFileFunc( PicoMapFileFunc );
+	PicoSetUnmapFileFunc( vfsFreeMappedFile );
 
 	/* set number of threads */
 	ThreadSetDefault();
@@ -258,6 +260,9 @@ int main( int argc, char **argv ){
 		r = BSPMain( argc, argv );
 	}
 
+	/* emit vfs statistics */
+	vfsPrintStats();
+
 	/* emit time */
 	end = I_FloatTime();
 	Sys_Printf( "%9.0f seconds elapsed\n", end - start );
@@ -1765,6 +1765,68 @@ static qboolean ParseMapEntity( qboolean onlyLights ){
 
 
 
+/*
+   PreloadMapShaderImages()
+   scans a map file for the shaders its brushes and patches use and preloads their images
+   brush sides name their shader right after the closing parenthesis of the plane (or texture matrix),
+   patches right after the opening brace
+ */
+
+static void PreloadMapShaderImages( const char *filename ){
+	int i, size, numShaders, maxShaders;
+	char            *buffer, **shaders;
+	char prev[ 2 ][ MAXTOKEN ];
+
+
+	/* only worth it with more than one thread */
+	if ( numthreads <= 1 ) {
+		return;
+	}
+
+	/* load the map file into our own buffer */
+	size = vfsLoadFile( filename, (void**) &buffer, -1 );
+	if ( size <= 0 ) {
+		return;
+	}
+	ParseFromMemory( buffer, size );
+
+	/* collect shader names */
+	numShaders = 0;
+	maxShaders = 1024;
+	shaders = safe_malloc( sizeof( *shaders ) * maxShaders );
+	prev[ 0 ][ 0 ] = prev[ 1 ][ 0 ] = '\0';
+	while ( GetToken( qtrue ) )
+	{
+		if ( ( !strcmp( prev[ 0 ], ")" ) || ( !strcmp( prev[ 0 ], "{" ) && !Q_strncasecmp( prev[ 1 ], "patchDef", 8 ) ) ) &&
+			 token[ 0 ] != '(' && token[ 0 ] != ')' && token[ 0 ] != '{' && token[ 0 ] != '}' &&
+			 token[ 0 ] != '-' && token[ 0 ] != '.' && !isdigit( token[ 0 ] ) ) {
+			if ( numShaders == maxShaders ) {
+				maxShaders *= 2;
+				shaders = realloc( shaders, sizeof( *shaders ) * maxShaders );
+				if ( shaders == NULL ) {
+					Error( "PreloadMapShaderImages: out of memory" );
+				}
+			}
+			shaders[ numShaders ] = safe_malloc( strlen( token ) + 10 );
+			sprintf( shaders[ numShaders ], "textures/%s", token );
+			numShaders++;
+		}
+		strcpy( prev[ 1 ], prev[ 0 ] );
+		strcpy( prev[ 0 ], token );
+	}
+	free( buffer );
+
+	/* decode the images */
+	PreloadShaderImages( numShaders, (const char**) shaders );
+
+	/* clean up */
+	for ( i = 0; i < numShaders; i++ )
+		free( shaders[ i ] );
+	free( shaders );
+}
+
+
+
 /*
    LoadMapFile()
    loads a map file into a list of entities
@@ -1784,6 +1846,11 @@ void LoadMapFile( char *filename, qboolean onlyLights ){
 	file = SafeOpenRead( filename );
 	fclose( file );
 
+	/* decode the images of the shaders it uses up front */
+	if ( !onlyLights ) {
+		PreloadMapShaderImages( filename );
+	}
+
 	/* load the map file */
 	LoadScriptFile( filename, -1 );
 
@@ -84,6 +84,37 @@ void PicoLoadFileFunc( const char *name, byte **buffer, int *bufSize ){
 
 
 
+/*
+   PicoMapFileFunc()
+   callback for picomodel.lib, binary models are parsed straight from the mapped file
+ */
+
+void PicoMapFileFunc( const char *name, const byte **buffer, int *bufSize ){
+	*bufSize = vfsMapFile( name, (const void**) buffer, 0 );
+}
+
+
+
+/*
+   picoModels are found by name and frame through a hash of their slots,
+   the chains hold slot + 1 so a cleared table is empty
+ */
+
+#define MODEL_HASH_SIZE         1024
+
+static int picoModelHash[ MODEL_HASH_SIZE ];
+static int picoModelHashNext[ MAX_MODELS ];
+
+static int ModelHashKey( const char *name, int frame ){
+	unsigned int hash = (unsigned int) frame;
+
+	for ( ; *name; name++ )
+		hash = hash * 31 + (unsigned char) *name;
+	return hash & ( MODEL_HASH_SIZE - 1 );
+}
+
+
+
 /*
    FindModel() - ydnar
    finds an existing picoModel and returns a pointer to the picoModel_t struct or NULL if not found
@@ -96,6 +127,7 @@ picoModel_t *FindModel( char *name, int frame ){
 	/* init */
 	if ( numPicoModels <= 0 ) {
 		memset( picoModels, 0, sizeof( picoModels ) );
+		memset( picoModelHash, 0, sizeof( picoModelHash ) );
 	}
 
 	/* dummy check */
@@ -103,13 +135,13 @@ picoModel_t *FindModel( char *name, int frame ){
 		return NULL;
 	}
 
-	/* search list */
-	for ( i = 0; i < MAX_MODELS; i++ )
+	/* search hash chain */
+	for ( i = picoModelHash[ ModelHashKey( name, frame ) ]; i != 0; i = picoModelHashNext[ i - 1 ] )
 	{
-		if ( picoModels[ i ] != NULL &&
-			 !strcmp( PicoGetModelName( picoModels[ i ] ), name ) &&
-			 PicoGetModelFrameNum( picoModels[ i ] ) == frame ) {
-			return picoModels[ i ];
+		if ( picoModels[ i - 1 ] != NULL &&
+			 !strcmp( PicoGetModelName( picoModels[ i - 1 ] ), name ) &&
+			 PicoGetModelFrameNum( picoModels[ i - 1 ] ) == frame ) {
+			return picoModels[ i - 1 ];
 		}
 	}
 
@@ -120,34 +152,19 @@ picoModel_t *FindModel( char *name, int frame ){
 
 
 /*
-   LoadModel() - ydnar
-   loads a picoModel and returns a pointer to the picoModel_t struct or NULL if not found
+   StoreModel()
+   puts a parsed picoModel into the first free picoModels slot and hashes it,
+   a model that failed to load is stored as a bogus one to silence the rest of the warnings
  */
 
-picoModel_t *LoadModel( char *name, int frame ){
-	int i;
-	picoModel_t     *model, **pm;
-
-
-	/* init */
-	if ( numPicoModels <= 0 ) {
-		memset( picoModels, 0, sizeof( picoModels ) );
-	}
-
-	/* dummy check */
-	if ( name == NULL || name[ 0 ] == '\0' ) {
-		return NULL;
-	}
+static picoModel_t *StoreModel( const char *name, int frame, picoModel_t *model ){
+	int i, hash;
+	picoModel_t     **pm;
 
-	/* try to find existing picoModel */
-	model = FindModel( name, frame );
-	if ( model != NULL ) {
-		return model;
-	}
 
-	/* none found, so find first non-null picoModel */
+	/* find first non-null picoModel */
 	pm = NULL;
-	for ( i = 0; i < MAX_MODELS; i++ )
+	for ( i = numPicoModels; i < MAX_MODELS; i++ )
 	{
 		if ( picoModels[ i ] == NULL ) {
 			pm = &picoModels[ i ];
@@ -160,10 +177,8 @@ picoModel_t *LoadModel( char *name, int frame ){
 		Error( "MAX_MODELS (%d) exceeded, there are too many model files referenced by the map.", MAX_MODELS );
 	}
 
-	/* attempt to parse model */
-	*pm = PicoLoadModel( name, frame );
-
 	/* if loading failed, make a bogus model to silence the rest of the warnings */
+	*pm = model;
 	if ( *pm == NULL ) {
 		/* allocate a new model */
 		*pm = PicoNewModel();
@@ -172,10 +187,16 @@ picoModel_t *LoadModel( char *name, int frame ){
 		}
 
 		/* set data */
-		PicoSetModelName( *pm, name );
+		PicoSetModelName( *pm, (char*) name );
 		PicoSetModelFrameNum( *pm, frame );
 	}
 
+	/* set count and hash it under the name it was asked for */
+	numPicoModels++;
+	hash = ModelHashKey( name, frame );
+	picoModelHashNext[ i ] = picoModelHash[ hash ];
+	picoModelHash[ hash ] = i + 1;
+
 	/* debug code */
 	#if 0
 	{
@@ -194,17 +215,176 @@ picoModel_t *LoadModel( char *name, int frame ){
 	}
 	#endif
 
-	/* set count */
-	if ( *pm != NULL ) {
-		numPicoModels++;
-	}
-
 	/* return the picoModel */
 	return *pm;
 }
 
 
 
+/*
+   LoadModel() - ydnar
+   loads a picoModel and returns a pointer to the picoModel_t struct or NULL if not found
+ */
+
+picoModel_t *LoadModel( char *name, int frame ){
+	picoModel_t     *model;
+
+
+	/* init */
+	if ( numPicoModels <= 0 ) {
+		memset( picoModels, 0, sizeof( picoModels ) );
+		memset( picoModelHash, 0, sizeof( picoModelHash ) );
+	}
+
+	/* dummy check */
+	if ( name == NULL || name[ 0 ] == '\0' ) {
+		return NULL;
+	}
+
+	/* try to find existing picoModel */
+	model = FindModel( name, frame );
+	if ( model != NULL ) {
+		return model;
+	}
+
+	/* attempt to parse model */
+	return StoreModel( name, frame, PicoLoadModel( name, frame ) );
+}
+
+
+
+/*
+   ModelPreload()
+   parses every model the map's misc_models and surface models reference on worker threads,
+   so the serial AddTriangleModels/AddEntitySurfaceModels passes only find them in the cache
+ */
+
+typedef struct preloadModel_s
+{
+	const char      *name;
+	int frame;
+	picoModel_t     *model;
+}
+preloadModel_t;
+
+static preloadModel_t   *preloadModels;
+
+static void ModelPreloadThread( int num ){
+	preloadModels[ num ].model = PicoLoadModel( preloadModels[ num ].name, preloadModels[ num ].frame );
+}
+
+static int ModelPreloadCompare( const void *a, const void *b ){
+	const preloadModel_t *pa = (const preloadModel_t*) a, *pb = (const preloadModel_t*) b;
+	int cmp = strcmp( pa->name, pb->name );
+
+	return cmp != 0 ? cmp : pa->frame - pb->frame;
+}
+
+static void ModelPreloadAdd( const char *name, int frame, int *numPreload, int *maxPreload ){
+	if ( name == NULL || name[ 0 ] == '\0' || FindModel( (char*) name, frame ) != NULL ) {
+		return;
+	}
+	if ( *numPreload >= *maxPreload ) {
+		*maxPreload = *maxPreload > 0 ? *maxPreload * 2 : 64;
+		preloadModels = realloc( preloadModels, sizeof( preloadModel_t ) * *maxPreload );
+		if ( preloadModels == NULL ) {
+			Error( "ModelPreload: out of memory" );
+		}
+	}
+	preloadModels[ *numPreload ].name = name;
+	preloadModels[ *numPreload ].frame = frame;
+	preloadModels[ *numPreload ].model = NULL;
+	( *numPreload )++;
+}
+
+void ModelPreload( void ){
+	int i, j, numPreload, maxPreload, numLoaded;
+	entity_t        *e;
+	brush_t         *b;
+	parseMesh_t     *p;
+	surfaceModel_t  *sm;
+	shaderInfo_t    *si, *lastSi;
+
+
+	/* init */
+	if ( numPicoModels <= 0 ) {
+		memset( picoModels, 0, sizeof( picoModels ) );
+		memset( picoModelHash, 0, sizeof( picoModelHash ) );
+	}
+	preloadModels = NULL;
+	numPreload = maxPreload = 0;
+
+	/* collect misc_model models and the surface models of shaders used by brushes and patches */
+	for ( i = 0; i < numEntities; i++ )
+	{
+		e = &entities[ i ];
+		if ( !Q_stricmp( "misc_model", ValueForKey( e, "classname" ) ) ) {
+			ModelPreloadAdd( ValueForKey( e, "model" ), IntForKey( e, "_frame" ), &numPreload, &maxPreload );
+		}
+
+		lastSi = NULL;
+		for ( b = e->brushes; b != NULL; b = b->next )
+		{
+			for ( j = 0; j < b->numsides; j++ )
+			{
+				si = b->sides[ j ].shaderInfo;
+				if ( si == NULL || si == lastSi ) {
+					continue;
+				}
+				lastSi = si;
+				for ( sm = si->surfaceModel; sm != NULL; sm = sm->next )
+					ModelPreloadAdd( sm->model, 0, &numPreload, &maxPreload );
+			}
+		}
+		for ( p = e->patches; p != NULL; p = p->next )
+		{
+			if ( p->shaderInfo == NULL ) {
+				continue;
+			}
+			for ( sm = p->shaderInfo->surfaceModel; sm != NULL; sm = sm->next )
+				ModelPreloadAdd( sm->model, 0, &numPreload, &maxPreload );
+		}
+	}
+	if ( numPreload <= 0 ) {
+		free( preloadModels );
+		preloadModels = NULL;
+		return;
+	}
+
+	/* remove duplicates */
+	qsort( preloadModels, numPreload, sizeof( preloadModel_t ), ModelPreloadCompare );
+	for ( i = 0, j = 0; i < numPreload; i++ )
+	{
+		if ( j > 0 && !ModelPreloadCompare( &preloadModels[ j - 1 ], &preloadModels[ i ] ) ) {
+			continue;
+		}
+		preloadModels[ j++ ] = preloadModels[ i ];
+	}
+	numPreload = j;
+
+	/* parse */
+	Sys_FPrintf( SYS_VRB, "--- ModelPreload ---\n" );
+	RunThreadsOnIndividual( numPreload, qfalse, ModelPreloadThread );
+
+	/* register the parsed models, in order so the slots don't depend on thread timing */
+	numLoaded = 0;
+	for ( i = 0; i < numPreload; i++ )
+	{
+		if ( preloadModels[ i ].model != NULL ) {
+			numLoaded++;
+		}
+		StoreModel( preloadModels[ i ].name, preloadModels[ i ].frame, preloadModels[ i ].model );
+	}
+
+	/* emit some statistics */
+	Sys_FPrintf( SYS_VRB, "%9d models preloaded (%d requested)\n", numLoaded, numPreload );
+
+	free( preloadModels );
+	preloadModels = NULL;
+}
+
+
+
 /*
    InsertModel() - ydnar
    adds a picomodel into the bsp
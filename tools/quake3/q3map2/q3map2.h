@@ -1642,8 +1642,10 @@ tree_t                      *FaceBSP( face_t *list );
 /* model.c */
 void                        PicoPrintFunc( int level, const char *str );
 void                        PicoLoadFileFunc( const char *name, byte **buffer, int *bufSize );
+void                        PicoMapFileFunc( const char *name, const byte **buffer, int *bufSize );
 picoModel_t                 *FindModel( char *name, int frame );
 picoModel_t                 *LoadModel( char *name, int frame );
+void                        ModelPreload( void );
 void                        InsertModel( char *name, int frame, m4x4_t transform, remap_t *remap, shaderInfo_t *celShader, int eNum, int castShadows, int recvShadows, int spawnFlags, float lightmapScale );
 void                        AddTriangleModels( entity_t *e );
 
@@ -1809,6 +1811,7 @@ int                         ExportEntitiesMain( int argc, char **argv );
 void                        ImageFree( image_t *image );
 image_t                     *ImageFind( const char *filename );
 image_t                     *ImageLoad( const char *filename );
+void                        ImagePreload( int numNames, const char **names );
 
 
 /* shaders.c */
@@ -1831,6 +1834,7 @@ void                        EmitVertexRemapShader( char *from, char *to );
 void                        LoadShaderInfo( void );
 shaderInfo_t                *ShaderInfoForShader( const char *shader );
 shaderInfo_t                *ShaderInfoForShaderNull( const char *shader );
+void                        PreloadShaderImages( int numShaders, const char **shaderNames );
 
 
 /* bspfile_abstract.c */
@@ -1846,7 +1850,12 @@ void                        SwapBlock( int *block, int size );
 int                         GetLumpElements( bspHeader_t *header, int lump, int size );
 void                        *GetLump( bspHeader_t *header, int lump );
 int                         CopyLump( bspHeader_t *header, int lump, void *dest, int size );
+void                        BeginLump( FILE *file, bspHeader_t *header, int lumpNum );
+void                        EndLump( FILE *file, bspHeader_t *header, int lumpNum );
 void                        AddLump( FILE *file, bspHeader_t *header, int lumpNum, const void *data, int length );
+FILE                        *OpenBSPFileWrite( const char *filename );
+int                         MapBSPFile( const char *filename, void **bufferptr );
+void                        UnmapBSPFile( void *buffer );
 
 void                        LoadBSPFile( const char *filename );
 void                        WriteBSPFile( const char *filename );
@@ -2168,6 +2177,7 @@ Q_EXTERN qboolean noGridLighting Q_ASSIGN( qfalse );
 
 Q_EXTERN qboolean noTrace Q_ASSIGN( qfalse );
 Q_EXTERN qboolean noSurfaces Q_ASSIGN( qfalse );
+Q_EXTERN qboolean noModelInstancing Q_ASSIGN( qfalse );
 Q_EXTERN qboolean patchShadows Q_ASSIGN( qfalse );
 Q_EXTERN qboolean cpmaHack Q_ASSIGN( qfalse );
 
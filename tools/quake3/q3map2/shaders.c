@@ -598,27 +598,30 @@ void EmitVertexRemapShader( char *from, char *to ){
 
 
 /*
-   AllocShaderInfo()
-   allocates and initializes a new shader
+   per-file results of a threaded shader script parse
+   they are merged into shaderInfo in shaderlist.txt order, so the first definition of a shader still wins
  */
 
-static shaderInfo_t *AllocShaderInfo( void ){
-	shaderInfo_t    *si;
+typedef struct shaderFile_s
+{
+	char filename[ 1024 ];
+	shaderInfo_t        *shaderInfo;
+	int numShaderInfo, maxShaderInfo;
+	qboolean serial;                        /* uses q3map_baseShader, so it must be parsed in order */
+}
+shaderFile_t;
 
+static shaderFile_t         *shaderFiles;
+static Q_THREAD_LOCAL shaderFile_t *parseShaderFile = NULL;
 
-	/* allocate? */
-	if ( shaderInfo == NULL ) {
-		shaderInfo = safe_malloc( sizeof( shaderInfo_t ) * MAX_SHADER_INFO );
-		numShaderInfo = 0;
-	}
 
-	/* bounds check */
-	if ( numShaderInfo == MAX_SHADER_INFO ) {
-		Error( "MAX_SHADER_INFO exceeded. Remove some PK3 files or shader scripts from shaderlist.txt and try again." );
-	}
-	si = &shaderInfo[ numShaderInfo ];
-	numShaderInfo++;
 
+/*
+   InitShaderInfo()
+   sets a shader to its default values
+ */
+
+static void InitShaderInfo( shaderInfo_t *si ){
 	/* ydnar: clear to 0 first */
 	memset( si, 0, sizeof( shaderInfo_t ) );
 
@@ -649,6 +652,50 @@ static shaderInfo_t *AllocShaderInfo( void ){
 	/* ydnar: lightmaps can now be > 128x128 in certain games or an externally generated tga */
 	si->lmCustomWidth = lmCustomSize;
 	si->lmCustomHeight = lmCustomSize;
+}
+
+
+
+/*
+   AllocShaderInfo()
+   allocates and initializes a new shader
+   worker threads parsing a shader file allocate into that file's results instead
+ */
+
+static shaderInfo_t *AllocShaderInfo( void ){
+	shaderInfo_t    *si;
+
+
+	/* threaded parse? */
+	if ( parseShaderFile != NULL ) {
+		if ( parseShaderFile->numShaderInfo == parseShaderFile->maxShaderInfo ) {
+			parseShaderFile->maxShaderInfo = parseShaderFile->maxShaderInfo > 0 ? parseShaderFile->maxShaderInfo * 2 : 64;
+			parseShaderFile->shaderInfo = realloc( parseShaderFile->shaderInfo, sizeof( shaderInfo_t ) * parseShaderFile->maxShaderInfo );
+			if ( parseShaderFile->shaderInfo == NULL ) {
+				Error( "AllocShaderInfo: out of memory" );
+			}
+		}
+		si = &parseShaderFile->shaderInfo[ parseShaderFile->numShaderInfo ];
+		parseShaderFile->numShaderInfo++;
+		InitShaderInfo( si );
+		return si;
+	}
+
+	/* allocate? */
+	if ( shaderInfo == NULL ) {
+		shaderInfo = safe_malloc( sizeof( shaderInfo_t ) * MAX_SHADER_INFO );
+		numShaderInfo = 0;
+	}
+
+	/* bounds check */
+	if ( numShaderInfo == MAX_SHADER_INFO ) {
+		Error( "MAX_SHADER_INFO exceeded. Remove some PK3 files or shader scripts from shaderlist.txt and try again." );
+	}
+	si = &shaderInfo[ numShaderInfo ];
+	numShaderInfo++;
+
+	/* set defaults */
+	InitShaderInfo( si );
 
 	/* return to sender */
 	return si;
@@ -851,13 +898,127 @@ shaderInfo_t *ShaderInfoForShader( const char *shaderName ){
 
 
 
+/*
+   PreloadShaderImages()
+   decodes the images a set of shaders will ask for on worker threads, before they are looked up
+   only the first candidate of each image search is preloaded, anything else is still loaded on demand
+   the names usually come one per face, so both they and the shaders are hashed and each name is looked at once
+ */
+
+#define PRELOAD_HASH_SIZE   4096
+
+static int PreloadHashName( const char *name ){
+	unsigned int hash = 0;
+	for ( ; *name != '\0'; name++ )
+		hash = hash * 31 + tolower( *name );
+	return hash & ( PRELOAD_HASH_SIZE - 1 );
+}
+
+void PreloadShaderImages( int numShaders, const char **shaderNames ){
+	int i, j, h, numNames, numUnique;
+	shaderInfo_t    *si;
+	const char      **names;
+	char ( *unique )[ MAX_QPATH ];
+	int             *shaderChain, *uniqueChain;
+	int shaderHash[ PRELOAD_HASH_SIZE ], uniqueHash[ PRELOAD_HASH_SIZE ];
+
+
+	/* only worth it with more than one thread */
+	if ( numthreads <= 1 || numShaders <= 0 ) {
+		return;
+	}
+
+	/* hash the shaders, each chain starts with the first definition like ShaderInfoForShader finds it */
+	for ( h = 0; h < PRELOAD_HASH_SIZE; h++ )
+		shaderHash[ h ] = uniqueHash[ h ] = -1;
+	shaderChain = safe_malloc( sizeof( *shaderChain ) * ( numShaderInfo > 0 ? numShaderInfo : 1 ) );
+	for ( j = numShaderInfo - 1; j >= 0; j-- )
+	{
+		h = PreloadHashName( shaderInfo[ j ].shader );
+		shaderChain[ j ] = shaderHash[ h ];
+		shaderHash[ h ] = j;
+	}
+
+	/* collect image names */
+	unique = safe_malloc( sizeof( *unique ) * numShaders );
+	uniqueChain = safe_malloc( sizeof( *uniqueChain ) * numShaders );
+	names = safe_malloc( sizeof( *names ) * numShaders * 3 );
+	numUnique = numNames = 0;
+	for ( i = 0; i < numShaders; i++ )
+	{
+		if ( shaderNames[ i ] == NULL || shaderNames[ i ][ 0 ] == '\0' || strlen( shaderNames[ i ] ) >= MAX_QPATH ) {
+			continue;
+		}
+		strcpy( unique[ numUnique ], shaderNames[ i ] );
+		StripExtension( unique[ numUnique ] );
+
+		/* skip names already seen */
+		h = PreloadHashName( unique[ numUnique ] );
+		for ( j = uniqueHash[ h ]; j >= 0; j = uniqueChain[ j ] )
+		{
+			if ( !Q_stricmp( unique[ j ], unique[ numUnique ] ) ) {
+				break;
+			}
+		}
+		if ( j >= 0 ) {
+			continue;
+		}
+		uniqueChain[ numUnique ] = uniqueHash[ h ];
+		uniqueHash[ h ] = numUnique++;
+
+		/* find the shader without loading it */
+		si = NULL;
+		for ( j = shaderHash[ h ]; j >= 0; j = shaderChain[ j ] )
+		{
+			if ( !Q_stricmp( unique[ numUnique - 1 ], shaderInfo[ j ].shader ) ) {
+				si = &shaderInfo[ j ];
+				break;
+			}
+		}
+
+		/* implicit shader, the image has the shader's name */
+		if ( si == NULL ) {
+			names[ numNames++ ] = unique[ numUnique - 1 ];
+			continue;
+		}
+
+		/* already loaded or doesn't need images */
+		if ( si->finished || ( si->compileFlags & C_NODRAW ) ) {
+			continue;
+		}
+
+		/* same order as LoadShaderImages */
+		if ( si->editorImagePath[ 0 ] != '\0' ) {
+			names[ numNames++ ] = si->editorImagePath;
+		}
+		else{
+			names[ numNames++ ] = si->shader;
+		}
+		if ( si->lightImagePath[ 0 ] != '\0' ) {
+			names[ numNames++ ] = si->lightImagePath;
+		}
+		if ( si->normalImagePath[ 0 ] != '\0' ) {
+			names[ numNames++ ] = si->normalImagePath;
+		}
+	}
+
+	/* decode them */
+	ImagePreload( numNames, names );
+	free( names );
+	free( uniqueChain );
+	free( unique );
+	free( shaderChain );
+}
+
+
+
 /*
    GetTokenAppend() - ydnar
    gets a token and appends its text to the specified buffer
  */
 
-static int oldScriptLine = 0;
-static int tabDepth = 0;
+static Q_THREAD_LOCAL int oldScriptLine = 0;
+static Q_THREAD_LOCAL int tabDepth = 0;
 
 qboolean GetTokenAppend( char *buffer, qboolean crossline ){
 	qboolean r;
@@ -1310,6 +1471,13 @@ static void ParseShaderFile( const char *filename ){
 					qboolean oldWarnImage;
 
 
+					/* the base shader may come from an earlier file, so leave this file to the ordered pass */
+					if ( parseShaderFile != NULL ) {
+						parseShaderFile->serial = qtrue;
+						CloseScriptFile();
+						return;
+					}
+
 					/* get shader */
 					GetTokenAppend( shaderText, qfalse );
 					//%	Sys_FPrintf( SYS_VRB, "Shader %s has base shader %s\n", si->shader, token );
@@ -1972,6 +2140,117 @@ static void ParseCustomInfoParms( void ){
 
 
 
+/*
+   FreeParsedShaderInfo()
+   frees what a threaded parse allocated for a shader that won't be merged
+   nothing is shared, the threaded parse stops before q3map_baseShader copies another shader
+ */
+
+static void FreeParsedShaderInfo( shaderInfo_t *si ){
+	sun_t           *sun;
+	surfaceModel_t  *model;
+	foliage_t       *foliage;
+	colorMod_t      *cm;
+
+
+	free( si->shaderText );
+	free( si->damageShader );
+	if ( si->flareShader != game->flareShader ) {
+		free( si->flareShader );
+	}
+	free( si->backShader );
+	free( si->cloneShader );
+	free( si->remapShader );
+	while ( si->sun != NULL )
+	{
+		sun = si->sun->next;
+		free( si->sun );
+		si->sun = sun;
+	}
+	while ( si->surfaceModel != NULL )
+	{
+		model = si->surfaceModel->next;
+		free( si->surfaceModel );
+		si->surfaceModel = model;
+	}
+	while ( si->foliage != NULL )
+	{
+		foliage = si->foliage->next;
+		free( si->foliage );
+		si->foliage = foliage;
+	}
+	while ( si->colorMod != NULL )
+	{
+		cm = si->colorMod->next;
+		free( si->colorMod );
+		si->colorMod = cm;
+	}
+}
+
+
+
+/*
+   ParseShaderFileThread()
+   parses one shader file into its own results on a worker thread
+ */
+
+static void ParseShaderFileThread( int num ){
+	parseShaderFile = &shaderFiles[ num ];
+	ParseShaderFile( parseShaderFile->filename );
+	parseShaderFile = NULL;
+}
+
+
+
+/*
+   ParseShaderFilesThreaded()
+   parses the shader files concurrently, then merges them in shaderlist.txt order
+ */
+
+static void ParseShaderFilesThreaded( int numFiles, char **fileNames ){
+	int i, j;
+	shaderFile_t    *sf;
+	shaderInfo_t    *si;
+
+
+	/* set up per-file results */
+	shaderFiles = safe_malloc( sizeof( shaderFile_t ) * numFiles );
+	memset( shaderFiles, 0, sizeof( shaderFile_t ) * numFiles );
+	for ( i = 0; i < numFiles; i++ )
+		sprintf( shaderFiles[ i ].filename, "%s/%s.shader", game->shaderPath, fileNames[ i ] );
+
+	/* parse */
+	RunThreadsOnIndividual( numFiles, qfalse, ParseShaderFileThread );
+
+	/* merge */
+	for ( i = 0; i < numFiles; i++ )
+	{
+		sf = &shaderFiles[ i ];
+
+		/* files using q3map_baseShader are reparsed here, with everything before them already merged */
+		if ( sf->serial ) {
+			for ( j = 0; j < sf->numShaderInfo; j++ )
+				FreeParsedShaderInfo( &sf->shaderInfo[ j ] );
+			ParseShaderFile( sf->filename );
+		}
+		else
+		{
+			for ( j = 0; j < sf->numShaderInfo; j++ )
+			{
+				si = AllocShaderInfo();
+				memcpy( si, &sf->shaderInfo[ j ], sizeof( *si ) );
+			}
+		}
+		free( sf->shaderInfo );
+	}
+
+	/* clean up */
+	free( shaderFiles );
+	shaderFiles = NULL;
+}
+
+
+
 /*
    LoadShaderInfo()
    the shaders are parsed out of shaderlist.txt from a main directory
@@ -1984,7 +2263,7 @@ static void ParseCustomInfoParms( void ){
 void LoadShaderInfo( void ){
 	int i, j, numShaderFiles, count;
 	char filename[ 1024 ];
-	char            *shaderFiles[ MAX_SHADER_FILES ];
+	char            *shaderFileNames[ MAX_SHADER_FILES ];
 
 
 	/* rr2do2: parse custom infoparms first */
@@ -2011,7 +2290,7 @@ void LoadShaderInfo( void ){
 		{
 			/* check for duplicate entries */
 			for ( j = 0; j < numShaderFiles; j++ )
-				if ( !strcmp( shaderFiles[ j ], token ) ) {
+				if ( !strcmp( shaderFileNames[ j ], token ) ) {
 					break;
 				}
 
@@ -2022,20 +2301,27 @@ void LoadShaderInfo( void ){
 
 			/* new shader file */
 			if ( j == numShaderFiles ) {
-				shaderFiles[ numShaderFiles ] = safe_malloc( MAX_OS_PATH );
-				strcpy( shaderFiles[ numShaderFiles ], token );
+				shaderFileNames[ numShaderFiles ] = safe_malloc( MAX_OS_PATH );
+				strcpy( shaderFileNames[ numShaderFiles ], token );
 				numShaderFiles++;
 			}
 		}
 	}
 
 	/* parse the shader files */
-	for ( i = 0; i < numShaderFiles; i++ )
+	if ( numthreads > 1 && numShaderFiles > 1 ) {
+		ParseShaderFilesThreaded( numShaderFiles, shaderFileNames );
+	}
+	else
 	{
-		sprintf( filename, "%s/%s.shader", game->shaderPath, shaderFiles[ i ] );
-		ParseShaderFile( filename );
-		free( shaderFiles[ i ] );
+		for ( i = 0; i < numShaderFiles; i++ )
+		{
+			sprintf( filename, "%s/%s.shader", game->shaderPath, shaderFileNames[ i ] );
+			ParseShaderFile( filename );
+		}
 	}
+	for ( i = 0; i < numShaderFiles; i++ )
+		free( shaderFileNames[ i ] );
 
 	/* emit some statistics */
 	Sys_FPrintf( SYS_VRB, "%9d shaderInfo\n", numShaderInfo );
@@ -1820,6 +1820,26 @@ void CullSides( entity_t *e ){
 
 
 
+/*
+   ClipSideIntoTreeThread()
+   clips one side from ClipSidesIntoTree() into the tree on a worker thread
+ */
+
+static side_t           **clipSides;
+static tree_t           *clipTree;
+
+static void ClipSideIntoTreeThread( int num ){
+	side_t      *side;
+
+
+	/* each side only touches its own visible hull */
+	side = clipSides[ num ];
+	side->visibleHull = NULL;
+	ClipSideIntoTree_r( CopyWinding( side->winding ), side, clipTree->headnode );
+}
+
+
+
 /*
    ClipSidesIntoTree()
 
@@ -1832,7 +1852,7 @@ void CullSides( entity_t *e ){
 
 void ClipSidesIntoTree( entity_t *e, tree_t *tree ){
 	brush_t     *b;
-	int i;
+	int i, numSides;
 	winding_t       *w;
 	side_t          *side, *newSide;
 	shaderInfo_t    *si;
@@ -1844,6 +1864,30 @@ void ClipSidesIntoTree( entity_t *e, tree_t *tree ){
 	/* note it */
 	Sys_FPrintf( SYS_VRB, "--- ClipSidesIntoTree ---\n" );
 
+	/* clip the sides on all threads, the drawsurfs are then created below in brush order */
+	if ( numthreads > 1 ) {
+		numSides = 0;
+		for ( b = e->brushes; b; b = b->next )
+			numSides += b->numsides;
+		clipSides = safe_malloc( ( numSides + 1 ) * sizeof( *clipSides ) );
+		numSides = 0;
+		for ( b = e->brushes; b; b = b->next )
+		{
+			for ( i = 0; i < b->numsides; i++ )
+			{
+				if ( b->sides[ i ].winding != NULL ) {
+					clipSides[ numSides++ ] = &b->sides[ i ];
+				}
+			}
+		}
+		clipTree = tree;
+		if ( numSides > 0 ) {
+			RunThreadsOnIndividual( numSides, qfalse, ClipSideIntoTreeThread );
+		}
+		free( clipSides );
+		clipSides = NULL;
+	}
+
 	/* walk the brush list */
 	for ( b = e->brushes; b; b = b->next )
 	{
@@ -1857,9 +1901,11 @@ void ClipSidesIntoTree( entity_t *e, tree_t *tree ){
 			}
 
 			/* copy the winding */
-			w = CopyWinding( side->winding );
-			side->visibleHull = NULL;
-			ClipSideIntoTree_r( w, side, tree->headnode );
+			if ( numthreads <= 1 ) {
+				w = CopyWinding( side->winding );
+				side->visibleHull = NULL;
+				ClipSideIntoTree_r( w, side, tree->headnode );
+			}
 
 			/* anything left? */
 			w = side->visibleHull;
@@ -1914,13 +1960,27 @@ void ClipSidesIntoTree( entity_t *e, tree_t *tree ){
 
  */
 
+/* leafs touched by a surface, gathered on a worker thread and added to the tree afterwards */
+typedef struct surfaceLeafs_s
+{
+	int numLeafs, maxLeafs;
+	node_t              **leafs;
+}
+surfaceLeafs_t;
+
+static Q_THREAD_LOCAL surfaceLeafs_t *collectLeafs = NULL;
+
+
+
 /*
    AddReferenceToLeaf() - ydnar
    adds a reference to surface ds in the bsp leaf node
  */
 
 int AddReferenceToLeaf( mapDrawSurface_t *ds, node_t *node ){
+	int i;
 	drawSurfRef_t   *dsr;
+	node_t          **leafs;
 
 
 	/* dummy check */
@@ -1928,6 +1988,27 @@ int AddReferenceToLeaf( mapDrawSurface_t *ds, node_t *node ){
 		return 0;
 	}
 
+	/* only record the leaf when filtering on a worker thread */
+	if ( collectLeafs != NULL ) {
+		for ( i = 0; i < collectLeafs->numLeafs; i++ )
+		{
+			if ( collectLeafs->leafs[ i ] == node ) {
+				return 0;
+			}
+		}
+		if ( collectLeafs->numLeafs >= collectLeafs->maxLeafs ) {
+			collectLeafs->maxLeafs = collectLeafs->maxLeafs > 0 ? collectLeafs->maxLeafs * 2 : 16;
+			leafs = safe_malloc( collectLeafs->maxLeafs * sizeof( *leafs ) );
+			if ( collectLeafs->leafs != NULL ) {
+				memcpy( leafs, collectLeafs->leafs, collectLeafs->numLeafs * sizeof( *leafs ) );
+				free( collectLeafs->leafs );
+			}
+			collectLeafs->leafs = leafs;
+		}
+		collectLeafs->leafs[ collectLeafs->numLeafs++ ] = node;
+		return 1;
+	}
+
 	/* try to find an existing reference */
 	for ( dsr = node->drawSurfReferences; dsr; dsr = dsr->nextRef )
 	{
@@ -3477,6 +3558,163 @@ static void VolumeColorMods( entity_t *e, mapDrawSurface_t *ds ){
 
 
 
+/*
+   PrepareDrawSurfForTree()
+   applies the shader and entity mods to a surface before it is filtered into the tree
+   this can add new surfaces (fur, foliage, flares)
+ */
+
+#define FILTER_SKIP             0
+#define FILTER_SURFACE          1
+#define FILTER_SKYBOX           2
+
+static int PrepareDrawSurfForTree( entity_t *e, mapDrawSurface_t *ds ){
+	int j;
+	shaderInfo_t        *si;
+	vec3_t origin, mins, maxs;
+
+
+	/* try to early out */
+	if ( ds->numVerts == 0 && ds->type != SURFACE_FLARE && ds->type != SURFACE_SHADER ) {
+		return FILTER_SKIP;
+	}
+
+	/* ydnar: skybox surfaces are special */
+	if ( ds->skybox ) {
+		return FILTER_SKYBOX;
+	}
+
+	/* get shader */
+	si = ds->shaderInfo;
+
+	/* apply texture coordinate mods */
+	for ( j = 0; j < ds->numVerts; j++ )
+		TCMod( si->mod, ds->verts[ j ].st );
+
+	/* ydnar: apply shader colormod */
+	ColorMod( ds->shaderInfo->colorMod, ds->numVerts, ds->verts );
+
+	/* ydnar: apply brush colormod */
+	VolumeColorMods( e, ds );
+
+	/* ydnar: make fur surfaces */
+	if ( si->furNumLayers > 0 ) {
+		Fur( ds );
+	}
+
+	/* ydnar/sd: make foliage surfaces */
+	if ( si->foliage != NULL ) {
+		Foliage( ds );
+	}
+
+	/* create a flare surface if necessary */
+	if ( si->flareShader != NULL && si->flareShader[ 0 ] ) {
+		AddSurfaceFlare( ds, e->origin );
+	}
+
+	/* ydnar: don't emit nodraw surfaces (like nodraw fog) */
+	if ( si != NULL && ( si->compileFlags & C_NODRAW ) && ds->type != SURFACE_PATCH ) {
+		return FILTER_SKIP;
+	}
+
+	/* ydnar: bias the surface textures */
+	BiasSurfaceTextures( ds );
+
+	/* ydnar: globalizing of fog volume handling (eek a hack) */
+	if ( e != entities && si->noFog == qfalse ) {
+		/* find surface origin and offset by entity origin */
+		VectorAdd( ds->mins, ds->maxs, origin );
+		VectorScale( origin, 0.5f, origin );
+		VectorAdd( origin, e->origin, origin );
+
+		VectorAdd( ds->mins, e->origin, mins );
+		VectorAdd( ds->maxs, e->origin, maxs );
+
+		/* set the fog number for this surface */
+		ds->fogNum = FogForBounds( mins, maxs, 1.0f );  //%	FogForPoint( origin, 0.0f );
+	}
+
+	/* ydnar: remap shader */
+	if ( ds->shaderInfo->remapShader && ds->shaderInfo->remapShader[ 0 ] ) {
+		ds->shaderInfo = ShaderInfoForShader( ds->shaderInfo->remapShader );
+	}
+
+	return FILTER_SURFACE;
+}
+
+
+
+/*
+   FilterDrawSurfIntoTree()
+   filters a prepared surface into the tree by type, returning the number of references
+ */
+
+static int FilterDrawSurfIntoTree( mapDrawSurface_t *ds, tree_t *tree ){
+	/* ydnar: gs mods: handle the various types of surfaces */
+	switch ( ds->type )
+	{
+	case SURFACE_FACE:
+	case SURFACE_DECAL:
+		return FilterFaceIntoTree( ds, tree );
+
+	case SURFACE_PATCH:
+		return FilterPatchIntoTree( ds, tree );
+
+	case SURFACE_TRIANGLES:
+	case SURFACE_FORCED_META:
+	case SURFACE_META:
+		return FilterTrianglesIntoTree( ds, tree );
+
+	case SURFACE_FOLIAGE:
+		return FilterFoliageIntoTree( ds, tree );
+
+	case SURFACE_FOGHULL:
+		return AddReferenceToTree_r( ds, tree->headnode, qfalse );
+
+	case SURFACE_FLARE:
+		return FilterFlareSurfIntoTree( ds, tree );
+
+	case SURFACE_SHADER:
+		return 1;
+
+	default:
+		return 0;
+	}
+}
+
+
+
+/*
+   FilterDrawSurfThread()
+   gathers the leafs a prepared surface touches on a worker thread
+ */
+
+static int filterFirstSurf;
+static byte                 *filterStates;
+static surfaceLeafs_t       *filterLeafs;
+static tree_t               *filterTree;
+
+static void FilterDrawSurfThread( int num ){
+	mapDrawSurface_t    *ds;
+
+
+	/* only plain surfaces are filtered here, skyboxes depend on the references made before them */
+	if ( filterStates[ num ] != FILTER_SURFACE ) {
+		return;
+	}
+	ds = &mapDrawSurfs[ filterFirstSurf + num ];
+	if ( ds->type == SURFACE_SHADER ) {
+		return;
+	}
+
+	/* filter it, recording the leafs instead of touching the tree */
+	collectLeafs = &filterLeafs[ num ];
+	FilterDrawSurfIntoTree( ds, filterTree );
+	collectLeafs = NULL;
+}
+
+
+
 /*
    FilterDrawsurfsIntoTree()
    upon completion, all drawsurfs that actually generate a reference
@@ -3485,164 +3723,112 @@ static void VolumeColorMods( entity_t *e, mapDrawSurface_t *ds ){
  */
 
 void FilterDrawsurfsIntoTree( entity_t *e, tree_t *tree ){
-	int i, j;
+	int i, j, state;
 	mapDrawSurface_t    *ds;
 	shaderInfo_t        *si;
-	vec3_t origin, mins, maxs;
 	int refs;
-	int numSurfs, numRefs, numSkyboxSurfaces;
+	int numSurfs, numRefs, numSkyboxSurfaces, numPrepared;
+	qboolean filtered;
 
 
 	/* note it */
 	Sys_FPrintf( SYS_VRB, "--- FilterDrawsurfsIntoTree ---\n" );
 
-	/* filter surfaces into the tree */
+	/* prepare the surfaces, including any that get added along the way */
+	filterFirstSurf = e->firstDrawSurf;
+	filterStates = safe_malloc( MAX_MAP_DRAW_SURFS );
+	for ( i = e->firstDrawSurf; i < numMapDrawSurfs; i++ )
+		filterStates[ i - e->firstDrawSurf ] = PrepareDrawSurfForTree( e, &mapDrawSurfs[ i ] );
+	numPrepared = numMapDrawSurfs - e->firstDrawSurf;
+
+	/* filter them into the tree on all threads, the references are added below in surface order */
+	filterLeafs = NULL;
+	if ( numthreads > 1 && numPrepared > 0 ) {
+		filterLeafs = safe_malloc( numPrepared * sizeof( *filterLeafs ) );
+		memset( filterLeafs, 0, numPrepared * sizeof( *filterLeafs ) );
+		filterTree = tree;
+		RunThreadsOnIndividual( numPrepared, qfalse, FilterDrawSurfThread );
+	}
+
+	/* add references and emit the surfaces */
 	numSurfs = 0;
 	numRefs = 0;
 	numSkyboxSurfaces = 0;
 	for ( i = e->firstDrawSurf; i < numMapDrawSurfs; i++ )
 	{
-		/* get surface and try to early out */
+		/* get surface (skybox surfaces made below have not been prepared yet) */
 		ds = &mapDrawSurfs[ i ];
-		if ( ds->numVerts == 0 && ds->type != SURFACE_FLARE && ds->type != SURFACE_SHADER ) {
+		if ( i - e->firstDrawSurf < numPrepared ) {
+			state = filterStates[ i - e->firstDrawSurf ];
+		}
+		else{
+			state = PrepareDrawSurfForTree( e, ds );
+		}
+		if ( state == FILTER_SKIP ) {
 			continue;
 		}
 
-		/* get shader */
-		si = ds->shaderInfo;
+		/* refs initially zero */
+		refs = 0;
+		filtered = qfalse;
 
 		/* ydnar: skybox surfaces are special */
-		if ( ds->skybox ) {
+		if ( state == FILTER_SKYBOX ) {
 			refs = AddReferenceToTree_r( ds, tree->headnode, qtrue );
 			ds->skybox = qfalse;
-		}
-		else
-		{
-			/* refs initially zero */
-			refs = 0;
-
-			/* apply texture coordinate mods */
-			for ( j = 0; j < ds->numVerts; j++ )
-				TCMod( si->mod, ds->verts[ j ].st );
-
-			/* ydnar: apply shader colormod */
-			ColorMod( ds->shaderInfo->colorMod, ds->numVerts, ds->verts );
-
-			/* ydnar: apply brush colormod */
-			VolumeColorMods( e, ds );
-
-			/* ydnar: make fur surfaces */
-			if ( si->furNumLayers > 0 ) {
-				Fur( ds );
-			}
-
-			/* ydnar/sd: make foliage surfaces */
-			if ( si->foliage != NULL ) {
-				Foliage( ds );
-			}
-
-			/* create a flare surface if necessary */
-			if ( si->flareShader != NULL && si->flareShader[ 0 ] ) {
-				AddSurfaceFlare( ds, e->origin );
-			}
 
-			/* ydnar: don't emit nodraw surfaces (like nodraw fog) */
-			if ( si != NULL && ( si->compileFlags & C_NODRAW ) && ds->type != SURFACE_PATCH ) {
-				continue;
+			/* ydnar: remap shader */
+			if ( ds->shaderInfo->remapShader && ds->shaderInfo->remapShader[ 0 ] ) {
+				ds->shaderInfo = ShaderInfoForShader( ds->shaderInfo->remapShader );
 			}
+		}
 
-			/* ydnar: bias the surface textures */
-			BiasSurfaceTextures( ds );
-
-			/* ydnar: globalizing of fog volume handling (eek a hack) */
-			if ( e != entities && si->noFog == qfalse ) {
-				/* find surface origin and offset by entity origin */
-				VectorAdd( ds->mins, ds->maxs, origin );
-				VectorScale( origin, 0.5f, origin );
-				VectorAdd( origin, e->origin, origin );
-
-				VectorAdd( ds->mins, e->origin, mins );
-				VectorAdd( ds->maxs, e->origin, maxs );
-
-				/* set the fog number for this surface */
-				ds->fogNum = FogForBounds( mins, maxs, 1.0f );  //%	FogForPoint( origin, 0.0f );
-			}
+		/* add the references found on the worker threads */
+		else if ( filterLeafs != NULL && i - e->firstDrawSurf < numPrepared && ds->type != SURFACE_SHADER ) {
+			for ( j = 0; j < filterLeafs[ i - e->firstDrawSurf ].numLeafs; j++ )
+				refs += AddReferenceToLeaf( ds, filterLeafs[ i - e->firstDrawSurf ].leafs[ j ] );
+			filtered = qtrue;
 		}
 
-		/* ydnar: remap shader */
-		if ( ds->shaderInfo->remapShader && ds->shaderInfo->remapShader[ 0 ] ) {
-			ds->shaderInfo = ShaderInfoForShader( ds->shaderInfo->remapShader );
+		/* filter it now */
+		if ( refs == 0 && !filtered ) {
+			refs = FilterDrawSurfIntoTree( ds, tree );
 		}
+		si = ds->shaderInfo;
 
-		/* ydnar: gs mods: handle the various types of surfaces */
+		/* emit the surface */
 		switch ( ds->type )
 		{
-		/* handle brush faces */
 		case SURFACE_FACE:
 		case SURFACE_DECAL:
-			if ( refs == 0 ) {
-				refs = FilterFaceIntoTree( ds, tree );
-			}
 			if ( refs > 0 ) {
 				EmitFaceSurface( ds );
 			}
 			break;
 
-		/* handle patches */
 		case SURFACE_PATCH:
-			if ( refs == 0 ) {
-				refs = FilterPatchIntoTree( ds, tree );
-			}
 			if ( refs > 0 ) {
 				EmitPatchSurface( ds );
 			}
 			break;
 
-		/* handle triangle surfaces */
 		case SURFACE_TRIANGLES:
 		case SURFACE_FORCED_META:
 		case SURFACE_META:
-			//%	Sys_FPrintf( SYS_VRB, "Surface %4d: [%1d] %4d verts %s\n", numSurfs, ds->planar, ds->numVerts, si->shader );
-			if ( refs == 0 ) {
-				refs = FilterTrianglesIntoTree( ds, tree );
-			}
-			if ( refs > 0 ) {
-				EmitTriangleSurface( ds );
-			}
-			break;
-
-		/* handle foliage surfaces (splash damage/wolf et) */
 		case SURFACE_FOLIAGE:
-			//%	Sys_FPrintf( SYS_VRB, "Surface %4d: [%d] %4d verts %s\n", numSurfs, ds->numFoliageInstances, ds->numVerts, si->shader );
-			if ( refs == 0 ) {
-				refs = FilterFoliageIntoTree( ds, tree );
-			}
-			if ( refs > 0 ) {
-				EmitTriangleSurface( ds );
-			}
-			break;
-
-		/* handle foghull surfaces */
 		case SURFACE_FOGHULL:
-			if ( refs == 0 ) {
-				refs = AddReferenceToTree_r( ds, tree->headnode, qfalse );
-			}
+			//%	Sys_FPrintf( SYS_VRB, "Surface %4d: [%1d] %4d verts %s\n", numSurfs, ds->planar, ds->numVerts, si->shader );
 			if ( refs > 0 ) {
 				EmitTriangleSurface( ds );
 			}
 			break;
 
-		/* handle flares */
 		case SURFACE_FLARE:
-			if ( refs == 0 ) {
-				refs = FilterFlareSurfIntoTree( ds, tree );
-			}
 			if ( refs > 0 ) {
 				EmitFlareSurface( ds );
 			}
 			break;
 
-		/* handle shader-only surfaces */
 		case SURFACE_SHADER:
 			refs = 1;
 			EmitFlareSurface( ds );
@@ -3683,6 +3869,16 @@ void FilterDrawsurfsIntoTree( entity_t *e, tree_t *tree ){
 		}
 	}
 
+	/* free the leaf lists */
+	if ( filterLeafs != NULL ) {
+		for ( i = 0; i < numPrepared; i++ )
+			free( filterLeafs[ i ].leafs );
+		free( filterLeafs );
+		filterLeafs = NULL;
+	}
+	free( filterStates );
+	filterStates = NULL;
+
 	/* emit some statistics */
 	Sys_FPrintf( SYS_VRB, "%9d references\n", numRefs );
 	Sys_FPrintf( SYS_VRB, "%9d (%d) emitted drawsurfs\n", numSurfs, numBSPDrawSurfaces );